@@ -113,16 +113,10 @@ extern "C" {
 #define ENCODER_PCNT_LOW_LIMIT -1000    // Low limit for PCNT counter
 #define ENCODER_PCNT_GLITCH_NS 1000     // Glitch filter threshold in nanoseconds
 
-// Adaptive speed thresholds for encoder (in milliseconds)
-#define ENCODER_SPEED_THRESHOLD_SLOW_MS      500  // Threshold for slow speed
-#define ENCODER_SPEED_THRESHOLD_NORMAL_MS    200  // Threshold for normal speed
-#define ENCODER_SPEED_THRESHOLD_FAST_MS      100  // Threshold for fast speed
-
-// Minimum intervals for each speed level (in milliseconds)
-#define ENCODER_MIN_INTERVAL_SLOW_MS         200  // Slow speed min interval
-#define ENCODER_MIN_INTERVAL_NORMAL_MS       100  // Normal speed min interval
-#define ENCODER_MIN_INTERVAL_FAST_MS         50   // Fast speed min interval
-#define ENCODER_MIN_INTERVAL_SUPER_FAST_MS   30   // Super fast speed min interval
+// Encoder events and speed estimation
+#define ENCODER_EVENT_PERIOD_MS      10   // Detents turned in a period make one event
+#define ENCODER_VELOCITY_SMOOTHING   4    // Weight of new speed in average is 1/N
+#define ENCODER_VELOCITY_RESET_MS    200  // Speed restarts from 0 after this pause
 
 /* 4-Position Switch Configuration */
 #define SWITCH_POS_1_PIN    GPIO_NUM_34
@@ -138,6 +132,15 @@ extern "C" {
 #define ANALOG_ADC_ATTEN_DB      ADC_ATTEN_DB_12
 #define ANALOG_FILTER_ENABLED_FLAG 1
 #define ANALOG_FILTER_SAMPLES_NB 5  // Number of samples for filtering
+#define ANALOG_CONTINUOUS_FLAG   1      // DMA continuous conversion instead of one-shot reads
+#define ANALOG_SAMPLE_FREQ_HZ    20000  // Lowest continuous rate of ESP32
+#define ANALOG_OVERSAMPLING_NB   256    // Samples averaged per value, about 78 values/s
+#define ANALOG_MEDIAN_SIZE       5      // Values in median filter window
+#define ANALOG_IIR_SHIFT         2      // Weight of new value in IIR filter is 1/4
+#define ANALOG_RAW_MIN           40     // Raw value at start of course
+#define ANALOG_RAW_MAX           4050   // Raw value at end of course
+#define ANALOG_POSITION_MAX      100    // Position range reported in events
+#define ANALOG_HYSTERESIS        12     // Units past a position edge to leave it
 
 /* Buzzer Configuration */
 /* SC8002B Module Configuration */
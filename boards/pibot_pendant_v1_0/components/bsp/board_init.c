@@ -8,6 +8,7 @@
 #include "board_config.h"
 #include "esp3d_log.h"
 #include "control_event.h"
+#include "control_input.h"
 
 // Include drivers and libraries
 #include "disp_backlight.h"
@@ -75,7 +76,8 @@ static void lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px
     esp_lcd_panel_draw_bitmap(panel_handle, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, px_map);
 }
 #if (ESP3D_TOUCH_FEATURE)
-// LVGL touch input read callback
+// LVGL touch input read callback, with the touch interrupt it copies the
+// touch read by the input task
 static void touch_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
 {
     touch_ft6336u_data_t touch_data = touch_ft6336u_read();
@@ -95,63 +97,41 @@ static void touch_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
 #endif // ESP3D_TOUCH_FEATURE
 
 #if (ESP3D_HARDWARE_BUTTONS_FEATURE)
-// LVGL button input read callback
+// LVGL button input read callback, buttons are sampled by the input task
 void button_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
 {
-    static bool last_states[3] = {0, 0, 0};
-    static control_event_t button_events[3] = {
-        {NULL, 0, LV_INDEV_TYPE_BUTTON, CONTROL_FAMILY_BUTTONS, 0, 0},
-        {NULL, 1, LV_INDEV_TYPE_BUTTON, CONTROL_FAMILY_BUTTONS, 0, 0},
-        {NULL, 2, LV_INDEV_TYPE_BUTTON, CONTROL_FAMILY_BUTTONS, 0, 0}
-    };
-    static uint32_t press_start_time[3] = {0, 0, 0};
-    bool states[3];
-    phy_buttons_read(states);
+    control_event_t button_event;
     lv_obj_t *active_screen = lv_screen_active();
     if (!active_screen) {
         esp3d_log_e("Active screen is NULL in button_read_cb");
         data->state = LV_INDEV_STATE_RELEASED;
         return;
     }
-    // Initialize indev handles
-    for (int i = 0; i < 3; i++) {
-        button_events[i].indev = indev;
-    }
-    uint32_t current_time = esp_timer_get_time() / 1000; // Temps en ms
-    for (int i = 0; i < 3; i++) {
-        if (states[i] && !last_states[i]) {
-            // Button pressed
-            data->state = LV_INDEV_STATE_PRESSED;
-            press_start_time[i] = current_time;
-            button_events[i].press_duration = 0;
-            lv_obj_send_event(active_screen, LV_EVENT_PRESSED, &button_events[i]);
-            esp3d_log("Button %d pressed (btn_id: %d)", i + 1, i);
-            last_states[i] = states[i];
-            return;
-        } else if (!states[i] && last_states[i]) {
-            // Button released
-            data->state = LV_INDEV_STATE_RELEASED;
-            button_events[i].press_duration = current_time - press_start_time[i];
-            lv_obj_send_event(active_screen, LV_EVENT_RELEASED, &button_events[i]);
-            esp3d_log("Button %d released (btn_id: %d, duration: %ld ms)", i + 1, i, button_events[i].press_duration);
-            last_states[i] = states[i];
-            return;
-        }
-    }
-    data->state = LV_INDEV_STATE_RELEASED;
+    if (!control_input_pop_ui(CONTROL_FAMILY_BUTTONS, &button_event)) {
+        data->state = LV_INDEV_STATE_RELEASED;
+        return;
+    }
+    button_event.indev = indev;
+    data->state = button_event.state;
+    // One event per read, next ones are read in same LVGL cycle
+    data->continue_reading = true;
+    if (button_event.state == LV_INDEV_STATE_PRESSED) {
+        lv_obj_send_event(active_screen, LV_EVENT_PRESSED, &button_event);
+        esp3d_log("Button %ld pressed (btn_id: %ld)", button_event.btn_id + 1, button_event.btn_id);
+    } else {
+        lv_obj_send_event(active_screen, LV_EVENT_RELEASED, &button_event);
+        esp3d_log("Button %ld released (btn_id: %ld, duration: %ld ms)", button_event.btn_id + 1, button_event.btn_id, button_event.press_duration);
+    }
 }
 
 #endif // ESP3D_HARDWARE_BUTTONS_FEATURE
 
 #if (ESP3D_HARDWARE_ENCODER_FEATURE)
-// LVGL encoder input read callback
+// LVGL encoder input read callback, encoder is sampled by the input task
+// Detents turned since last read make a single event
 void encoder_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
 {
-    static control_event_t encoder_event = {
-        NULL, 0, LV_INDEV_TYPE_ENCODER, CONTROL_FAMILY_ENCODER, 0, 0
-    };
-    static uint32_t last_output_time = 0;
-    uint32_t current_time = esp_timer_get_time() / 1000; // Temps en ms
+    control_event_t encoder_event;
     lv_obj_t *active_screen = lv_screen_active();
     if (!active_screen) {
         esp3d_log_e("Active screen is NULL in encoder_read_cb");
@@ -159,136 +139,76 @@ void encoder_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
         data->state = LV_INDEV_STATE_RELEASED;
         return;
     }
-    // Initialize indev handle
-    encoder_event.indev = indev;
-    int32_t clicks;
-    if (phy_encoder_read(&clicks) == ESP_OK && clicks != 0) {
-        uint32_t time_since_last = current_time - last_output_time;
-        if (time_since_last == 40) {
-            data->key = 0;
-            data->state = LV_INDEV_STATE_RELEASED;
-            return;
-        }
-        uint32_t min_interval;
-        // Adaptive speed levels based on time_since_last
-        if (time_since_last >= ENCODER_SPEED_THRESHOLD_SLOW_MS) {
-            min_interval = ENCODER_MIN_INTERVAL_SLOW_MS; // Slow speed
-        } else if (time_since_last >= ENCODER_SPEED_THRESHOLD_NORMAL_MS) {
-            min_interval = ENCODER_MIN_INTERVAL_NORMAL_MS; // Normal speed
-        } else if (time_since_last >= ENCODER_SPEED_THRESHOLD_FAST_MS) {
-            min_interval = ENCODER_MIN_INTERVAL_FAST_MS; // Fast speed
-        } else {
-            min_interval = ENCODER_MIN_INTERVAL_SUPER_FAST_MS; // Super fast speed
-        }
-        if (time_since_last >= min_interval) {
-            // Adjust steps based on ENCODER_INVERT_ROTATION
-            int32_t adjusted_clicks = ENCODER_INVERT_ROTATION ? -clicks : clicks;
-            data->key = (adjusted_clicks > 0) ? LV_KEY_RIGHT : LV_KEY_LEFT;
-            data->state = LV_INDEV_STATE_PRESSED;
-            encoder_event.steps = adjusted_clicks;
-            // Generate multiple events based on the total clicks accumulated
-            int32_t abs_clicks = abs(adjusted_clicks);
-            for (int32_t i = 0; i < abs_clicks; i++) {
-                lv_obj_send_event(active_screen, LV_EVENT_KEY, &encoder_event);
-                esp3d_log("LVGL encoder: key=%ld (clicks: %ld, adjusted_clicks: %ld, interval: %lu)",
-                           data->key, clicks, adjusted_clicks, time_since_last);
-            }
-            last_output_time = current_time;
-        } else {
-            data->key = 0;
-            data->state = LV_INDEV_STATE_RELEASED;
-        }
-    } else {
+    // Rotation is already adjusted by input task
+    int32_t clicks = 0;
+    while (control_input_pop_ui(CONTROL_FAMILY_ENCODER, &encoder_event)) {
+        clicks += encoder_event.steps;
+    }
+    if (clicks == 0) {
         data->key = 0;
         data->state = LV_INDEV_STATE_RELEASED;
+        return;
     }
+    encoder_event.indev = indev;
+    encoder_event.steps = clicks;
+    data->key = (clicks > 0) ? LV_KEY_RIGHT : LV_KEY_LEFT;
+    data->state = LV_INDEV_STATE_PRESSED;
+    lv_obj_send_event(active_screen, LV_EVENT_KEY, &encoder_event);
+    esp3d_log("LVGL encoder: key=%ld (clicks: %ld, velocity: %lu)", data->key, clicks, encoder_event.velocity);
 }
 #endif // ESP3D_HARDWARE_ENCODER_FEATURE
 
 #if (ESP3D_HARDWARE_SWITCH_FEATURE) 
-// LVGL switch input read callback
+// LVGL switch input read callback, switch is sampled by the input task
 void switch_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
 {
-    static bool last_states[4] = {0, 0, 0, 0};
-    static control_event_t switch_events[4] = {
-        {NULL, 0, LV_INDEV_TYPE_BUTTON, CONTROL_FAMILY_SWITCH, 0, 0},
-        {NULL, 1, LV_INDEV_TYPE_BUTTON, CONTROL_FAMILY_SWITCH, 0, 0},
-        {NULL, 2, LV_INDEV_TYPE_BUTTON, CONTROL_FAMILY_SWITCH, 0, 0},
-        {NULL, 3, LV_INDEV_TYPE_BUTTON, CONTROL_FAMILY_SWITCH, 0, 0}
-    };
-    bool states[4];
+    control_event_t switch_event;
     lv_obj_t *active_screen = lv_screen_active();
     if (!active_screen) {
         esp3d_log_e("Active screen is NULL in switch_read_cb");
         data->state = LV_INDEV_STATE_RELEASED;
         return;
     }
-    // Initialize indev handles
-    for (int i = 0; i < 4; i++) {
-        switch_events[i].indev = indev;
-    }
-    if (phy_switch_read(states) == ESP_OK) {
-        for (int i = 0; i < 4; i++) {
-            if (states[i] && !last_states[i]) {
-                data->state = LV_INDEV_STATE_PRESSED;
-                lv_obj_send_event(active_screen, LV_EVENT_PRESSED, &switch_events[i]);
-                esp3d_log("Switch button %d pressed (btn_id: %d)", i, i);
-                last_states[i] = states[i];
-                return;
-            } else if (!states[i] && last_states[i]) {
-                data->state = LV_INDEV_STATE_RELEASED;
-                lv_obj_send_event(active_screen, LV_EVENT_RELEASED, &switch_events[i]);
-                esp3d_log("Switch button %d released (btn_id: %d)", i, i);
-                last_states[i] = states[i];
-                return;
-            }
-        }
+    if (!control_input_pop_ui(CONTROL_FAMILY_SWITCH, &switch_event)) {
         data->state = LV_INDEV_STATE_RELEASED;
+        return;
+    }
+    switch_event.indev = indev;
+    data->state = switch_event.state;
+    data->continue_reading = true;
+    if (switch_event.state == LV_INDEV_STATE_PRESSED) {
+        lv_obj_send_event(active_screen, LV_EVENT_PRESSED, &switch_event);
+        esp3d_log("Switch button %ld pressed (btn_id: %ld)", switch_event.btn_id, switch_event.btn_id);
     } else {
-        esp3d_log_e("Failed to read switch");
-        data->state = LV_INDEV_STATE_RELEASED;
+        lv_obj_send_event(active_screen, LV_EVENT_RELEASED, &switch_event);
+        esp3d_log("Switch button %ld released (btn_id: %ld)", switch_event.btn_id, switch_event.btn_id);
     }
 }
 #endif // ESP3D_HARDWARE_SWITCH_FEATURE
 
 
 #if (ESP3D_HARDWARE_POTENTIOMETER_FEATURE)
-// LVGL potentiometer input read callback
+// LVGL potentiometer input read callback, potentiometer is sampled by the input task
 void potentiometer_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
 {
-    static control_event_t potentiometer_event = {
-        NULL, 0, LV_INDEV_TYPE_POINTER, CONTROL_FAMILY_POTENTIOMETER, 0, 0
-    };
-    static uint32_t last_value = UINT32_MAX;
+    control_event_t potentiometer_event;
     lv_obj_t *active_screen = lv_screen_active();
     if (!active_screen) {
         esp3d_log_e("Active screen is NULL in potentiometer_read_cb");
         data->state = LV_INDEV_STATE_RELEASED;
         return;
     }
-    // Initialize indev handle
-    potentiometer_event.indev = indev;
-    uint32_t adc_value;
-    if (phy_potentiometer_read(&adc_value) == ESP_OK) {
-        // Map ADC value (0–4095) to 0–100
-        int32_t mapped_value = (adc_value * 100) / 4095;
-        if (last_value == UINT32_MAX) {
-            last_value = mapped_value;
-        }
-        int32_t delta = mapped_value - last_value;
-        // Only send event if change is significant (e.g., ±5)
-        if (abs(delta) >= 5) {
-            potentiometer_event.steps = mapped_value;
-            data->state = LV_INDEV_STATE_PRESSED;
-            lv_obj_send_event(active_screen, LV_EVENT_VALUE_CHANGED, &potentiometer_event);
-            esp3d_log("Potentiometer: adc_value=%ld, mapped_value=%ld, delta=%ld", 
-                       adc_value, mapped_value, delta);
-            last_value = mapped_value;
-        } else {
-            data->state = LV_INDEV_STATE_RELEASED;
-        }
+    // Only last value matters
+    bool changed = false;
+    while (control_input_pop_ui(CONTROL_FAMILY_POTENTIOMETER, &potentiometer_event)) {
+        changed = true;
+    }
+    if (changed) {
+        potentiometer_event.indev = indev;
+        data->state = LV_INDEV_STATE_PRESSED;
+        lv_obj_send_event(active_screen, LV_EVENT_VALUE_CHANGED, &potentiometer_event);
+        esp3d_log("Potentiometer: mapped_value=%ld", potentiometer_event.steps);
     } else {
-        esp3d_log_e("Failed to read potentiometer");
         data->state = LV_INDEV_STATE_RELEASED;
     }
 }
@@ -566,6 +486,11 @@ esp_err_t board_init(void)
         return ret;
     }
 #endif  // ESP3D_BUZZER_FEATURE
+    ret = control_input_start();
+    if (ret != ESP_OK) {
+        esp3d_log_e("Input task initialization failed");
+        return ret;
+    }
     ret = init_lvgl();
     if (ret != ESP_OK) {
         esp3d_log_e("LVGL initialization failed");
@@ -17,6 +17,9 @@ typedef struct {
     control_family_t family_id;
     int32_t steps;
     uint32_t press_duration; // Duration of press in milliseconds
+    lv_indev_state_t state; // Pressed or released
+    uint32_t velocity; // Encoder speed in detents per second, smoothed
+    int64_t timestamp_us; // esp_timer time of the interrupt which reported the change
 } control_event_t;
 
 #endif // CONTROL_EVENT_H
\ No newline at end of file
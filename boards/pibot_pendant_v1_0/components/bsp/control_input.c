@@ -0,0 +1,459 @@
+/*
+  control_input.c - Input task for PiBot CNC Pendant physical controls
+  Copyright (c) 2025 Luc LEBOSSE. All rights reserved.
+  Licensed under GNU Lesser General Public License v2.1 or later.
+*/
+
+#include "control_input.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include "board_config.h"
+#include "esp3d_log.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+#include "driver/gpio.h"
+#include "tasks_def.h"
+#include "phy_buttons.h"
+#include "phy_encoder.h"
+#include "phy_switch.h"
+#include "phy_potentiometer.h"
+#include "touch_ft6336u.h"
+
+// Notification bits of input task
+#define CONTROL_INPUT_NOTIFY_GPIO (1 << 0)
+#define CONTROL_INPUT_NOTIFY_ENCODER (1 << 1)
+#define CONTROL_INPUT_NOTIFY_TOUCH (1 << 2)
+#define CONTROL_INPUT_NOTIFY_POTENTIOMETER (1 << 3)
+
+// Single producer single consumer queue: only the input task writes head
+// and only the consumer writes tail, so no lock is needed
+typedef struct {
+    control_event_t events[CONTROL_INPUT_QUEUE_SIZE];
+    atomic_uint head;
+    atomic_uint tail;
+} control_queue_t;
+
+static TaskHandle_t input_task = NULL;
+static control_queue_t consumer_queue;
+static control_queue_t ui_queues[CONTROL_INPUT_FAMILY_COUNT];
+static control_input_stats_t input_stats;
+// Shared with interrupts and consumer setter
+static portMUX_TYPE input_lock = portMUX_INITIALIZER_UNLOCKED;
+static int64_t irq_time_us = 0; // First interrupt not yet handled by task
+static TaskHandle_t consumer_task = NULL;
+static UBaseType_t consumer_notify_index = 0;
+static volatile bool potentiometer_notified = false; // Polled until set
+
+static bool queue_push(control_queue_t *queue, const control_event_t *event)
+{
+    unsigned int head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    if (head - tail >= CONTROL_INPUT_QUEUE_SIZE) {
+        return false;
+    }
+    queue->events[head & (CONTROL_INPUT_QUEUE_SIZE - 1)] = *event;
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+    return true;
+}
+
+static bool queue_pop(control_queue_t *queue, control_event_t *event)
+{
+    unsigned int tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    if (head == tail) {
+        return false;
+    }
+    *event = queue->events[tail & (CONTROL_INPUT_QUEUE_SIZE - 1)];
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+// Notify input task from interrupt, time of first interrupt is kept for events
+static bool IRAM_ATTR control_input_notify_from_isr(uint32_t bits)
+{
+    BaseType_t high_task_wakeup = pdFALSE;
+    portENTER_CRITICAL_ISR(&input_lock);
+    if (irq_time_us == 0) {
+        irq_time_us = esp_timer_get_time();
+    }
+    portEXIT_CRITICAL_ISR(&input_lock);
+    xTaskNotifyFromISR(input_task, bits, eSetBits, &high_task_wakeup);
+    return high_task_wakeup == pdTRUE;
+}
+
+#if (ESP3D_HARDWARE_BUTTONS_FEATURE || ESP3D_HARDWARE_SWITCH_FEATURE)
+static void IRAM_ATTR gpio_isr_handler(void *arg)
+{
+    if (control_input_notify_from_isr(CONTROL_INPUT_NOTIFY_GPIO)) {
+        portYIELD_FROM_ISR();
+    }
+}
+#endif // ESP3D_HARDWARE_BUTTONS_FEATURE || ESP3D_HARDWARE_SWITCH_FEATURE
+
+#if (ESP3D_HARDWARE_ENCODER_FEATURE)
+static bool encoder_notify_cb(void *arg)
+{
+    return control_input_notify_from_isr(CONTROL_INPUT_NOTIFY_ENCODER);
+}
+#endif // ESP3D_HARDWARE_ENCODER_FEATURE
+
+#if (ESP3D_TOUCH_FEATURE)
+static bool touch_notify_cb(void *arg)
+{
+    return control_input_notify_from_isr(CONTROL_INPUT_NOTIFY_TOUCH);
+}
+#endif // ESP3D_TOUCH_FEATURE
+
+#if (ESP3D_HARDWARE_POTENTIOMETER_FEATURE)
+static bool potentiometer_notify_cb(void *arg)
+{
+    return control_input_notify_from_isr(CONTROL_INPUT_NOTIFY_POTENTIOMETER);
+}
+#endif // ESP3D_HARDWARE_POTENTIOMETER_FEATURE
+
+// Event goes to the consumer and to the UI, returns true if consumer got it
+static bool control_input_push(const control_event_t *event)
+{
+    bool notify = false;
+    input_stats.events++;
+    portENTER_CRITICAL(&input_lock);
+    bool has_consumer = consumer_task != NULL;
+    portEXIT_CRITICAL(&input_lock);
+    if (has_consumer) {
+        notify = queue_push(&consumer_queue, event);
+        if (!notify) {
+            input_stats.dropped++;
+        }
+    }
+    // UI queues are only read by indevs of current screen, a full one is
+    // expected and not counted
+    queue_push(&ui_queues[event->family_id], event);
+    return notify;
+}
+
+#if (ESP3D_HARDWARE_BUTTONS_FEATURE)
+static bool sample_buttons(int64_t timestamp_us)
+{
+    static bool last_states[3] = {0, 0, 0};
+    static int64_t press_start_time[3] = {0, 0, 0};
+    bool states[3];
+    bool pushed = false;
+    if (phy_buttons_read(states) != ESP_OK) {
+        return false;
+    }
+    for (int i = 0; i < 3; i++) {
+        if (states[i] == last_states[i]) {
+            continue;
+        }
+        control_event_t event = {
+            .btn_id = i,
+            .type = LV_INDEV_TYPE_BUTTON,
+            .family_id = CONTROL_FAMILY_BUTTONS,
+            .state = states[i] ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED,
+            .timestamp_us = timestamp_us
+        };
+        if (states[i]) {
+            press_start_time[i] = timestamp_us;
+        } else {
+            event.press_duration = (timestamp_us - press_start_time[i]) / 1000;
+        }
+        last_states[i] = states[i];
+        pushed |= control_input_push(&event);
+    }
+    return pushed;
+}
+#endif // ESP3D_HARDWARE_BUTTONS_FEATURE
+
+#if (ESP3D_HARDWARE_ENCODER_FEATURE)
+// Detents turned during a period are read at once, so a fast spin gives one
+// event per period instead of one per detent
+// Speed is an average of detents over time between reads, in 1/16 detent/s
+static bool sample_encoder(int64_t timestamp_us)
+{
+    static int64_t last_event_time = 0;
+    static int32_t velocity_x16 = 0;
+    int32_t clicks;
+    if (timestamp_us - last_event_time < ENCODER_EVENT_PERIOD_MS * 1000) {
+        return false;
+    }
+    if (phy_encoder_read(&clicks) != ESP_OK || clicks == 0) {
+        return false;
+    }
+    int64_t elapsed = timestamp_us - last_event_time;
+    if (elapsed > ENCODER_VELOCITY_RESET_MS * 1000) {
+        velocity_x16 = 0;
+    } else {
+        int32_t instant = (int32_t)((int64_t)abs(clicks) * 16 * 1000000 / elapsed);
+        velocity_x16 += (instant - velocity_x16) / ENCODER_VELOCITY_SMOOTHING;
+    }
+    last_event_time = timestamp_us;
+    control_event_t event = {
+        .type = LV_INDEV_TYPE_ENCODER,
+        .family_id = CONTROL_FAMILY_ENCODER,
+        // Adjust steps based on ENCODER_INVERT_ROTATION
+        .steps = ENCODER_INVERT_ROTATION ? -clicks : clicks,
+        .state = LV_INDEV_STATE_PRESSED,
+        .velocity = velocity_x16 / 16,
+        .timestamp_us = timestamp_us
+    };
+    return control_input_push(&event);
+}
+#endif // ESP3D_HARDWARE_ENCODER_FEATURE
+
+#if (ESP3D_HARDWARE_SWITCH_FEATURE)
+static bool sample_switch(int64_t timestamp_us)
+{
+    static bool last_states[4] = {0, 0, 0, 0};
+    bool states[4];
+    bool pushed = false;
+    if (phy_switch_read(states) != ESP_OK) {
+        return false;
+    }
+    // Released position first, so consumers see the new position last
+    for (int pressed = 0; pressed < 2; pressed++) {
+        for (int i = 0; i < 4; i++) {
+            if (states[i] == last_states[i] || states[i] != pressed) {
+                continue;
+            }
+            control_event_t event = {
+                .btn_id = i,
+                .type = LV_INDEV_TYPE_BUTTON,
+                .family_id = CONTROL_FAMILY_SWITCH,
+                .state = pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED,
+                .timestamp_us = timestamp_us
+            };
+            last_states[i] = states[i];
+            pushed |= control_input_push(&event);
+        }
+    }
+    return pushed;
+}
+#endif // ESP3D_HARDWARE_SWITCH_FEATURE
+
+#if (ESP3D_HARDWARE_POTENTIOMETER_FEATURE)
+// Driver filters the value, position only changes when it goes past the
+// edge of current position by the hysteresis, so noise around an edge does
+// not make it toggle
+static bool sample_potentiometer(int64_t timestamp_us)
+{
+    static int32_t position = -1;
+    uint32_t value;
+    if (phy_potentiometer_read(&value) != ESP_OK) {
+        esp3d_log_e("Failed to read potentiometer");
+        return false;
+    }
+    int32_t level = (int32_t)value;
+    int32_t new_position = (level * ANALOG_POSITION_MAX + PHY_POTENTIOMETER_MAX_VALUE / 2) / PHY_POTENTIOMETER_MAX_VALUE;
+    // First position is only a reference, nothing changes at startup
+    if (position == -1) {
+        position = new_position;
+        return false;
+    }
+    // Distance from middle of current position, ends of course have no
+    // hysteresis so they are always reached
+    int32_t distance = abs(level - position * PHY_POTENTIOMETER_MAX_VALUE / ANALOG_POSITION_MAX);
+    bool at_end = new_position == 0 || new_position == ANALOG_POSITION_MAX;
+    if (new_position == position
+        || (!at_end && distance <= PHY_POTENTIOMETER_MAX_VALUE / (2 * ANALOG_POSITION_MAX) + ANALOG_HYSTERESIS)) {
+        return false;
+    }
+    position = new_position;
+    control_event_t event = {
+        .type = LV_INDEV_TYPE_POINTER,
+        .family_id = CONTROL_FAMILY_POTENTIOMETER,
+        .steps = position,
+        .state = LV_INDEV_STATE_PRESSED,
+        .timestamp_us = timestamp_us
+    };
+    return control_input_push(&event);
+}
+#endif // ESP3D_HARDWARE_POTENTIOMETER_FEATURE
+
+static TickType_t ms_to_ticks(int64_t ms)
+{
+    TickType_t ticks = pdMS_TO_TICKS(ms);
+    return ticks > 0 ? ticks : 1;
+}
+
+// Task sleeps until an interrupt, and only polls while controls settle
+static void control_input_task(void *arg)
+{
+    int64_t settle_until = 0;
+    int64_t potentiometer_next = 0;
+    bool touch_pressed = false;
+    int64_t touch_check = 0;
+    for (;;) {
+        int64_t now = esp_timer_get_time();
+        TickType_t wait = portMAX_DELAY;
+        if (settle_until > now) {
+            wait = ms_to_ticks(CONTROL_INPUT_POLL_MS);
+        }
+#if (ESP3D_HARDWARE_POTENTIOMETER_FEATURE)
+        if (!potentiometer_notified) {
+            TickType_t potentiometer_wait = ms_to_ticks((potentiometer_next - now) / 1000);
+            if (potentiometer_next <= now) {
+                potentiometer_wait = 0;
+            }
+            if (potentiometer_wait < wait) {
+                wait = potentiometer_wait;
+            }
+        }
+#endif // ESP3D_HARDWARE_POTENTIOMETER_FEATURE
+#if (ESP3D_TOUCH_FEATURE)
+        if (touch_pressed) {
+            TickType_t touch_wait = ms_to_ticks((touch_check - now) / 1000);
+            if (touch_check <= now) {
+                touch_wait = 0;
+            }
+            if (touch_wait < wait) {
+                wait = touch_wait;
+            }
+        }
+#endif // ESP3D_TOUCH_FEATURE
+        uint32_t bits = 0;
+        xTaskNotifyWait(0, UINT32_MAX, &bits, wait);
+        now = esp_timer_get_time();
+        portENTER_CRITICAL(&input_lock);
+        int64_t irq_time = irq_time_us;
+        irq_time_us = 0;
+        portEXIT_CRITICAL(&input_lock);
+        int64_t timestamp = now;
+        if (irq_time != 0) {
+            timestamp = irq_time;
+            uint32_t latency = (uint32_t)(now - irq_time);
+            input_stats.wakeups++;
+            input_stats.latency_avg_us = input_stats.latency_avg_us ? (input_stats.latency_avg_us * 7 + latency) / 8 : latency;
+            if (latency > input_stats.latency_max_us) {
+                input_stats.latency_max_us = latency;
+            }
+        }
+        if ((bits & CONTROL_INPUT_NOTIFY_GPIO) && settle_until < now + CONTROL_INPUT_SETTLE_MS * 1000) {
+            settle_until = now + CONTROL_INPUT_SETTLE_MS * 1000;
+        }
+        if ((bits & CONTROL_INPUT_NOTIFY_ENCODER) && settle_until < now + CONTROL_INPUT_ENCODER_SETTLE_MS * 1000) {
+            settle_until = now + CONTROL_INPUT_ENCODER_SETTLE_MS * 1000;
+        }
+        bool pushed = false;
+#if (ESP3D_HARDWARE_ENCODER_FEATURE)
+        pushed |= sample_encoder(timestamp);
+#endif // ESP3D_HARDWARE_ENCODER_FEATURE
+#if (ESP3D_HARDWARE_BUTTONS_FEATURE)
+        pushed |= sample_buttons(timestamp);
+#endif // ESP3D_HARDWARE_BUTTONS_FEATURE
+#if (ESP3D_HARDWARE_SWITCH_FEATURE)
+        pushed |= sample_switch(timestamp);
+#endif // ESP3D_HARDWARE_SWITCH_FEATURE
+#if (ESP3D_HARDWARE_POTENTIOMETER_FEATURE)
+        if (potentiometer_notified ? (bits & CONTROL_INPUT_NOTIFY_POTENTIOMETER) != 0 : potentiometer_next <= now) {
+            pushed |= sample_potentiometer(timestamp);
+            potentiometer_next = now + CONTROL_INPUT_POTENTIOMETER_PERIOD_MS * 1000;
+        }
+#endif // ESP3D_HARDWARE_POTENTIOMETER_FEATURE
+#if (ESP3D_TOUCH_FEATURE)
+        // LVGL only copies the touch read here, it does no I2C access
+        if ((bits & CONTROL_INPUT_NOTIFY_TOUCH) || (touch_pressed && touch_check <= now)) {
+            touch_ft6336u_update();
+            touch_pressed = touch_ft6336u_get_data().is_pressed;
+            touch_check = now + CONTROL_INPUT_TOUCH_RELEASE_MS * 1000;
+        }
+#endif // ESP3D_TOUCH_FEATURE
+        if (pushed) {
+            portENTER_CRITICAL(&input_lock);
+            TaskHandle_t task = consumer_task;
+            UBaseType_t index = consumer_notify_index;
+            portEXIT_CRITICAL(&input_lock);
+            if (task) {
+                xTaskNotifyGiveIndexed(task, index);
+            }
+        }
+    }
+}
+
+esp_err_t control_input_start(void)
+{
+    if (input_task != NULL) {
+        return ESP_OK;
+    }
+    esp3d_log("Starting input task");
+    BaseType_t res = xTaskCreatePinnedToCore(control_input_task, "controlInput", CONTROL_INPUT_TASK_SIZE, NULL,
+                                             CONTROL_INPUT_TASK_PRIORITY, &input_task, CONTROL_INPUT_TASK_CORE);
+    if (res != pdPASS || input_task == NULL) {
+        esp3d_log_e("Input task creation failed");
+        input_task = NULL;
+        return ESP_FAIL;
+    }
+    esp_err_t ret = ESP_OK;
+#if (ESP3D_HARDWARE_BUTTONS_FEATURE || ESP3D_HARDWARE_SWITCH_FEATURE)
+    // Service may already be installed by another driver
+    ret = gpio_install_isr_service(0);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+        esp3d_log_e("GPIO ISR service installation failed");
+        return ret;
+    }
+#endif // ESP3D_HARDWARE_BUTTONS_FEATURE || ESP3D_HARDWARE_SWITCH_FEATURE
+#if (ESP3D_HARDWARE_BUTTONS_FEATURE)
+    ret = phy_buttons_set_isr(gpio_isr_handler, NULL);
+    if (ret != ESP_OK) {
+        esp3d_log_e("Buttons interrupt setup failed");
+        return ret;
+    }
+#endif // ESP3D_HARDWARE_BUTTONS_FEATURE
+#if (ESP3D_HARDWARE_SWITCH_FEATURE)
+    // GPIO 36 and 39 may have spurious interrupts, it only costs a wakeup
+    ret = phy_switch_set_isr(gpio_isr_handler, NULL);
+    if (ret != ESP_OK) {
+        esp3d_log_e("Switch interrupt setup failed");
+        return ret;
+    }
+#endif // ESP3D_HARDWARE_SWITCH_FEATURE
+#if (ESP3D_HARDWARE_ENCODER_FEATURE)
+    ret = phy_encoder_set_notify(encoder_notify_cb, NULL);
+    if (ret != ESP_OK) {
+        esp3d_log_e("Encoder notification setup failed");
+        return ret;
+    }
+#endif // ESP3D_HARDWARE_ENCODER_FEATURE
+#if (ESP3D_TOUCH_FEATURE)
+    ret = touch_ft6336u_set_notify(touch_notify_cb, NULL);
+    if (ret == ESP_ERR_NOT_SUPPORTED) {
+        esp3d_log_w("No touch interrupt, touch is polled by LVGL");
+        ret = ESP_OK;
+    } else if (ret != ESP_OK) {
+        esp3d_log_e("Touch notification setup failed");
+        return ret;
+    }
+#endif // ESP3D_TOUCH_FEATURE
+#if (ESP3D_HARDWARE_POTENTIOMETER_FEATURE)
+    // Task only wakes on value changes, one-shot mode is polled
+    potentiometer_notified = phy_potentiometer_set_notify(potentiometer_notify_cb, NULL) == ESP_OK;
+#endif // ESP3D_HARDWARE_POTENTIOMETER_FEATURE
+    // Initial states, before any interrupt
+    xTaskNotify(input_task, CONTROL_INPUT_NOTIFY_GPIO, eSetBits);
+    return ret;
+}
+
+void control_input_set_consumer(TaskHandle_t task, UBaseType_t notify_index)
+{
+    portENTER_CRITICAL(&input_lock);
+    consumer_task = task;
+    consumer_notify_index = notify_index;
+    portEXIT_CRITICAL(&input_lock);
+}
+
+bool control_input_pop(control_event_t *event)
+{
+    return queue_pop(&consumer_queue, event);
+}
+
+bool control_input_pop_ui(control_family_t family, control_event_t *event)
+{
+    if (family >= CONTROL_INPUT_FAMILY_COUNT) {
+        return false;
+    }
+    return queue_pop(&ui_queues[family], event);
+}
+
+void control_input_get_stats(control_input_stats_t *stats)
+{
+    *stats = input_stats;
+}
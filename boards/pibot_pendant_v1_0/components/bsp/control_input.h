@@ -0,0 +1,96 @@
+/*
+  control_input.h - Input task for PiBot CNC Pendant physical controls
+  Copyright (c) 2025 Luc LEBOSSE. All rights reserved.
+  Licensed under GNU Lesser General Public License v2.1 or later.
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "control_event.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Events in each queue, must be a power of 2
+#define CONTROL_INPUT_QUEUE_SIZE 32
+#define CONTROL_INPUT_FAMILY_COUNT (CONTROL_FAMILY_POTENTIOMETER + 1)
+// Polling period while buttons or switch settle, at least one tick
+#define CONTROL_INPUT_POLL_MS 10
+// Polling lasts this long after last edge, longer than the switch transient position
+#define CONTROL_INPUT_SETTLE_MS 1200
+// Polling lasts this long after last detent, to catch the part of detent left
+#define CONTROL_INPUT_ENCODER_SETTLE_MS 100
+// Continuous potentiometer notifies when its filtered value changes, a
+// one-shot potentiometer has no interrupt and is read at this period
+#define CONTROL_INPUT_POTENTIOMETER_PERIOD_MS 20
+// Touch controller interrupts on each report while touched, a touch is read
+// again after this long without one, in case the release had no report
+#define CONTROL_INPUT_TOUCH_RELEASE_MS 50
+
+typedef struct {
+    uint32_t events;          // Events produced since start
+    uint32_t dropped;         // Events lost because consumer queue was full
+    uint32_t wakeups;         // Task wakeups by interrupt
+    uint32_t latency_avg_us;  // Interrupt to sampling delay, smoothed over last 8
+    uint32_t latency_max_us;
+} control_input_stats_t;
+
+/**
+ * @brief Start the input task
+ *
+ * Controls are sampled by a dedicated task woken by the encoder and GPIO interrupts,
+ * so sampling does not depend on LVGL timer cadence nor on rendering load.
+ * Drivers must be configured before.
+ *
+ * @return ESP_OK on success, or an error code on failure
+ */
+esp_err_t control_input_start(void);
+
+/**
+ * @brief Set the task consuming events with control_input_pop
+ *
+ * Task is notified at notify_index each time events are queued. Events are only
+ * queued for the consumer while one is set.
+ *
+ * @param task Consumer task, or NULL to remove it
+ * @param notify_index Task notification index
+ */
+void control_input_set_consumer(TaskHandle_t task, UBaseType_t notify_index);
+
+/**
+ * @brief Get next event for the consumer task, all families are in same queue
+ *
+ * Only one task can call this function.
+ *
+ * @param event Event copy, indev is NULL
+ * @return true if an event was available
+ */
+bool control_input_pop(control_event_t *event);
+
+/**
+ * @brief Get next event of a family for UI feedback
+ *
+ * Only the LVGL task can call this function, from the indev read callbacks.
+ *
+ * @param family Family of event
+ * @param event Event copy, indev is NULL
+ * @return true if an event was available
+ */
+bool control_input_pop_ui(control_family_t family, control_event_t *event);
+
+/**
+ * @brief Get the input task statistics
+ *
+ * @param stats Pointer to store the statistics
+ */
+void control_input_get_stats(control_input_stats_t *stats);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -20,7 +20,14 @@ phy_potentiometer_config_t phy_potentiometer_cfg = {
     .width = ANALOG_ADC_WIDTH_BITS,
     .atten = ADC_ATTEN_DB_12,
     .filter_enabled = ANALOG_FILTER_ENABLED_FLAG,
-    .filter_samples = ANALOG_FILTER_SAMPLES_NB
+    .filter_samples = ANALOG_FILTER_SAMPLES_NB,
+    .continuous = ANALOG_CONTINUOUS_FLAG,
+    .sample_freq_hz = ANALOG_SAMPLE_FREQ_HZ,
+    .oversampling = ANALOG_OVERSAMPLING_NB,
+    .median_size = ANALOG_MEDIAN_SIZE,
+    .iir_shift = ANALOG_IIR_SHIFT,
+    .raw_min = ANALOG_RAW_MIN,
+    .raw_max = ANALOG_RAW_MAX
 };
 
 #ifdef __cplusplus
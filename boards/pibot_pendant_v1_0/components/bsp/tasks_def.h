@@ -15,6 +15,7 @@ extern "C" {
 #define STREAM_STACK_DEPTH 4096
 
 #define STREAM_CHUNK_SIZE 1024
+#define STREAM_CHUNK_COUNT 3
 
 #define ESP3D_SOCKET_RX_BUFFER_SIZE 512
 #define ESP3D_SOCKET_TASK_SIZE 4096
@@ -34,6 +35,15 @@ extern "C" {
 #define ESP3D_GCODE_HOST_TASK_PRIORITY 2
 #define ESP3D_GCODE_HOST_TASK_CORE 1
 
+#define ESP3D_GCODE_PREFETCH_TASK_SIZE 4096
+#define ESP3D_GCODE_PREFETCH_TASK_PRIORITY 3
+#define ESP3D_GCODE_PREFETCH_TASK_CORE 1
+
+// Physical controls, above rendering and LVGL so a redraw does not delay a jog stop
+#define CONTROL_INPUT_TASK_SIZE 3072
+#define CONTROL_INPUT_TASK_PRIORITY 10
+#define CONTROL_INPUT_TASK_CORE 1
+
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -47,7 +47,7 @@ esp_err_t phy_buttons_configure(const phy_buttons_config_t *config)
             .mode = GPIO_MODE_INPUT,
             .pull_up_en = buttons_config.pullups_enabled ? GPIO_PULLUP_ENABLE : GPIO_PULLUP_DISABLE,
             .pull_down_en = GPIO_PULLDOWN_DISABLE,
-            .intr_type = GPIO_INTR_DISABLE // Pas d'interruptions pour l'instant
+            .intr_type = GPIO_INTR_DISABLE // Enabled by phy_buttons_set_isr
         };
         if (gpio_config(&io_conf) != ESP_OK) {
             esp3d_log_e("Failed to configure GPIO for button %d", i + 1);
@@ -96,3 +96,33 @@ esp_err_t phy_buttons_read(bool button_states[3])
 
     return ESP_OK;
 }
+
+/**
+ * @brief Set an interrupt handler called on each edge of the buttons pins
+ */
+esp_err_t phy_buttons_set_isr(gpio_isr_t isr_handler, void *arg)
+{
+    if (!is_initialized) {
+        esp3d_log_e("Buttons not configured");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    for (int i = 0; i < 3; i++) {
+        gpio_num_t pin = buttons_config.button_pins[i];
+        esp_err_t ret;
+        if (isr_handler == NULL) {
+            gpio_set_intr_type(pin, GPIO_INTR_DISABLE);
+            ret = gpio_isr_handler_remove(pin);
+        } else {
+            ret = gpio_set_intr_type(pin, GPIO_INTR_ANYEDGE);
+            if (ret == ESP_OK) {
+                ret = gpio_isr_handler_add(pin, isr_handler, arg);
+            }
+        }
+        if (ret != ESP_OK) {
+            esp3d_log_e("Failed to set interrupt for button %d", i + 1);
+            return ret;
+        }
+    }
+    return ESP_OK;
+}
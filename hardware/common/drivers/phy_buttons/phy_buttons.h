@@ -8,6 +8,7 @@
 #pragma once
 
 #include <esp_err.h>
+#include "driver/gpio.h"
 #include "phy_buttons_config.h"
 
 #ifdef __cplusplus
@@ -34,6 +35,18 @@ esp_err_t phy_buttons_configure(const phy_buttons_config_t *config);
  */
 esp_err_t phy_buttons_read(bool button_states[3]);
 
+/**
+ * @brief Set an interrupt handler called on each edge of the buttons pins
+ *
+ * The handler only tells the reader that a pin changed, phy_buttons_read still does the debounce.
+ * The GPIO ISR service must be installed before.
+ *
+ * @param isr_handler Handler called in interrupt context, or NULL to disable interrupts
+ * @param arg User argument given to handler
+ * @return ESP_OK on success, or an error code on failure
+ */
+esp_err_t phy_buttons_set_isr(gpio_isr_t isr_handler, void *arg);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -18,13 +18,22 @@ static volatile int32_t encoder_steps = 0;
 static QueueHandle_t encoder_queue = NULL;
 static pcnt_unit_handle_t pcnt_unit = NULL;
 static int32_t accumulated_pulses = 0; // Accumulate all pulses from PCNT
+static phy_encoder_notify_cb_t notify_cb = NULL;
+static void *notify_arg = NULL;
 
-// Callback function for PCNT watch events (limit reached)
+#define PHY_ENCODER_PULSES_PER_CLICK 4 // 4 pulses per click in 4X mode
+
+// Callback function for PCNT watch events (limit or detent reached)
 static bool encoder_pcnt_on_reach(pcnt_unit_handle_t unit, const pcnt_watch_event_data_t *edata, void *user_ctx)
 {
     BaseType_t high_task_wakeup;
     QueueHandle_t queue = (QueueHandle_t)user_ctx;
     int watch_point_value = edata->watch_point_value;
+    // Count is cleared on each read, so a detent watch point means one detent since last read
+    if (watch_point_value == PHY_ENCODER_PULSES_PER_CLICK || watch_point_value == -PHY_ENCODER_PULSES_PER_CLICK) {
+        phy_encoder_notify_cb_t callback = notify_cb;
+        return callback ? callback(notify_arg) : false;
+    }
     // Send the watch point value to the queue
     xQueueSendFromISR(queue, &watch_point_value, &high_task_wakeup);
     return (high_task_wakeup == pdTRUE);
@@ -90,9 +99,10 @@ esp_err_t phy_encoder_configure(const phy_encoder_config_t *config)
     ESP_ERROR_CHECK(pcnt_channel_set_edge_action(pcnt_chan_b, PCNT_CHANNEL_EDGE_ACTION_INCREASE, PCNT_CHANNEL_EDGE_ACTION_DECREASE));
     ESP_ERROR_CHECK(pcnt_channel_set_level_action(pcnt_chan_b, PCNT_CHANNEL_LEVEL_ACTION_KEEP, PCNT_CHANNEL_LEVEL_ACTION_INVERSE));
 
-    // Add watch points for limits (only high and low limits)
+    // Add watch points for limits, and for one detent each way to notify reader
     esp3d_log("Add watch points and register callbacks");
-    int watch_points[] = {encoder_config.pcnt_low_limit, encoder_config.pcnt_high_limit};
+    int watch_points[] = {encoder_config.pcnt_low_limit, encoder_config.pcnt_high_limit,
+                          -PHY_ENCODER_PULSES_PER_CLICK, PHY_ENCODER_PULSES_PER_CLICK};
     for (size_t i = 0; i < sizeof(watch_points) / sizeof(watch_points[0]); i++) {
         ESP_ERROR_CHECK(pcnt_unit_add_watch_point(pcnt_unit, watch_points[i]));
     }
@@ -169,7 +179,7 @@ esp_err_t phy_encoder_read(int32_t *steps)
     accumulated_pulses += pulse_count;
 
     // Calculate clicks based on accumulated pulses
-    int32_t new_clicks = accumulated_pulses / 4; // 4 pulses per click in 4X mode
+    int32_t new_clicks = accumulated_pulses / PHY_ENCODER_PULSES_PER_CLICK;
     int32_t clicks = new_clicks - encoder_steps; // Difference since last read
 
     // Update global steps
@@ -184,6 +194,26 @@ esp_err_t phy_encoder_read(int32_t *steps)
     return ESP_OK;
 }
 
+/**
+ * @brief Set the callback called when a detent is turned
+ *
+ * @param callback Callback, or NULL to remove it
+ * @param arg User argument given to callback
+ * @return ESP_OK on success, or an error code on failure
+ */
+esp_err_t phy_encoder_set_notify(phy_encoder_notify_cb_t callback, void *arg)
+{
+    if (!is_initialized) {
+        esp3d_log_e("Encoder not configured");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    notify_cb = NULL;
+    notify_arg = arg;
+    notify_cb = callback;
+    return ESP_OK;
+}
+
 /**
  * @brief Get the total accumulated steps since initialization
  *
@@ -276,6 +306,7 @@ esp_err_t phy_encoder_deinit(void)
     // Reset variables
     encoder_steps = 0;
     accumulated_pulses = 0;
+    notify_cb = NULL;
     is_initialized = false;
 
     esp3d_log("Rotary encoder deinitialized");
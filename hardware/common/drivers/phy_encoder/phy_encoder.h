@@ -7,6 +7,7 @@
 #pragma once
 
 #include <esp_err.h>
+#include <stdbool.h>
 #include "phy_encoder_config.h"
 
 #ifdef __cplusplus
@@ -33,6 +34,26 @@ esp_err_t phy_encoder_configure(const phy_encoder_config_t *config);
  */
 esp_err_t phy_encoder_read(int32_t *steps);
 
+/**
+ * @brief Callback called from PCNT interrupt when a detent is turned
+ *
+ * @param arg User argument given to phy_encoder_set_notify
+ * @return true if a higher priority task was woken
+ */
+typedef bool (*phy_encoder_notify_cb_t)(void *arg);
+
+/**
+ * @brief Set the callback called when a detent is turned
+ *
+ * The callback runs in interrupt context, so the reader can wait for it instead of polling.
+ * It is called once the count reached one detent since the last phy_encoder_read call.
+ *
+ * @param callback Callback, or NULL to remove it
+ * @param arg User argument given to callback
+ * @return ESP_OK on success, or an error code on failure
+ */
+esp_err_t phy_encoder_set_notify(phy_encoder_notify_cb_t callback, void *arg);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
\ No newline at end of file
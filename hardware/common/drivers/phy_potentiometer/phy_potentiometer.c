@@ -5,36 +5,232 @@
 */
 
 #include "phy_potentiometer.h"
+#include <string.h>
 #include "esp3d_log.h"
 #include "esp_adc/adc_oneshot.h"
+#include "esp_adc/adc_continuous.h"
 #include "esp_adc/adc_cali.h"
 #include "esp_adc/adc_cali_scheme.h"
+#include "esp_attr.h"
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
+#if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+#define POT_OUTPUT_FORMAT ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define POT_GET_CHANNEL(p) ((p)->type1.channel)
+#define POT_GET_DATA(p) ((p)->type1.data)
+#else
+#define POT_OUTPUT_FORMAT ADC_DIGI_OUTPUT_FORMAT_TYPE2
+#define POT_GET_CHANNEL(p) ((p)->type2.channel)
+#define POT_GET_DATA(p) ((p)->type2.data)
+#endif
+
+// Max wait for first continuous value at configuration
+#define POT_FIRST_VALUE_TIMEOUT_MS 100
+
 static phy_potentiometer_config_t pot_config;
 static bool is_initialized = false;
 static adc_cali_handle_t adc_cali_handle = NULL;
 static adc_oneshot_unit_handle_t adc1_handle = NULL;
+static adc_continuous_handle_t adc_continuous_handle = NULL;
+
+// Filter state, only used by the conversion done interrupt in continuous mode
+static uint32_t median_window[PHY_POTENTIOMETER_MEDIAN_MAX];
+static uint32_t median_count = 0;
+static uint32_t median_index = 0;
+static int32_t iir_x256 = 0;
+
+// Shared with the conversion done interrupt
+static portMUX_TYPE pot_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile uint32_t latest_value = 0;  // Aligned 32 bits, read without lock
+static volatile bool has_value = false;
+static phy_potentiometer_stats_t pot_stats;
+static phy_potentiometer_notify_cb_t notify_cb = NULL;
+static void *notify_arg = NULL;
+static uint32_t notified_value = UINT32_MAX;  // None yet, first value notifies
 
 /**
- * @brief Configure the potentiometer
+ * @brief Map raw value between calibrated endpoints to full scale
  */
-esp_err_t phy_potentiometer_configure(const phy_potentiometer_config_t *config)
+static uint32_t IRAM_ATTR calibrate_value(uint32_t raw)
 {
-    if (config == NULL) {
-        esp3d_log_e("Invalid potentiometer configuration");
-        return ESP_ERR_INVALID_ARG;
+    if (raw <= pot_config.raw_min) {
+        return 0;
+    }
+    if (raw >= pot_config.raw_max) {
+        return PHY_POTENTIOMETER_MAX_VALUE;
     }
+    return (raw - pot_config.raw_min) * PHY_POTENTIOMETER_MAX_VALUE / (pot_config.raw_max - pot_config.raw_min);
+}
 
-    memcpy(&pot_config, config, sizeof(phy_potentiometer_config_t));
+/**
+ * @brief Median drops spikes, then IIR smooths what is left
+ */
+static uint32_t IRAM_ATTR filter_value(uint32_t average)
+{
+    median_window[median_index] = average;
+    median_index = (median_index + 1) % pot_config.median_size;
+    if (median_count < pot_config.median_size) {
+        median_count++;
+    }
+    // Insertion sort, window is a few values
+    uint32_t sorted[PHY_POTENTIOMETER_MEDIAN_MAX];
+    for (uint32_t i = 0; i < median_count; i++) {
+        uint32_t j = i;
+        while (j > 0 && sorted[j - 1] > median_window[i]) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = median_window[i];
+    }
+    int32_t median_x256 = (int32_t)sorted[median_count / 2] * 256;
+    if (!has_value) {
+        iir_x256 = median_x256;
+    } else {
+        iir_x256 += (median_x256 - iir_x256) / (1 << pot_config.iir_shift);
+    }
+    return (uint32_t)(iir_x256 / 256);
+}
 
-    // Validate GPIO pin and ADC channel
-    if (!GPIO_IS_VALID_GPIO(pot_config.pin)) {
-        esp3d_log_e("Invalid GPIO number for potentiometer pin");
-        return ESP_ERR_INVALID_ARG;
+/**
+ * @brief Account CPU cycles spent for samples, caller holds pot_lock
+ */
+static void IRAM_ATTR update_stats(uint32_t cycles, uint32_t samples)
+{
+    uint32_t ns = cycles * 1000 / esp_rom_get_cpu_ticks_per_us() / samples;
+    pot_stats.values++;
+    pot_stats.samples += samples;
+    pot_stats.cpu_ns_per_sample = pot_stats.cpu_ns_per_sample ? (pot_stats.cpu_ns_per_sample * 7 + ns) / 8 : ns;
+}
+
+/**
+ * @brief True if value moved enough since last notification, caller holds pot_lock
+ */
+static bool IRAM_ATTR value_changed(uint32_t value)
+{
+    if (notified_value == UINT32_MAX) {
+        return true;
     }
+    uint32_t delta = value > notified_value ? value - notified_value : notified_value - value;
+    return delta >= PHY_POTENTIOMETER_NOTIFY_DELTA;
+}
+
+/**
+ * @brief Conversion done interrupt, a frame is averaged and filtered in place
+ *
+ * Frames are not read from the driver pool, which is flushed when full. The
+ * driver still copies each frame to the pool after this callback.
+ */
+static bool IRAM_ATTR on_conversion_done(adc_continuous_handle_t handle,
+                                         const adc_continuous_evt_data_t *edata,
+                                         void *user_data)
+{
+    uint32_t start = esp_cpu_get_cycle_count();
+    uint32_t sum = 0;
+    uint32_t count = 0;
+    for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= edata->size; i += SOC_ADC_DIGI_RESULT_BYTES) {
+        const adc_digi_output_data_t *p = (const adc_digi_output_data_t *)&edata->conv_frame_buffer[i];
+        if (POT_GET_CHANNEL(p) == pot_config.channel) {
+            sum += POT_GET_DATA(p);
+            count++;
+        }
+    }
+    if (count == 0) {
+        return false;
+    }
+    uint32_t value = calibrate_value(filter_value(sum / count));
+    uint32_t cycles = esp_cpu_get_cycle_count() - start;
+    phy_potentiometer_notify_cb_t callback = NULL;
+    void *arg = NULL;
+    portENTER_CRITICAL_ISR(&pot_lock);
+    latest_value = value;
+    has_value = true;
+    update_stats(cycles, count);
+    if (notify_cb && value_changed(value)) {
+        notified_value = value;
+        pot_stats.notifications++;
+        callback = notify_cb;
+        arg = notify_arg;
+    }
+    portEXIT_CRITICAL_ISR(&pot_lock);
+    return callback ? callback(arg) : false;
+}
 
+/**
+ * @brief Start DMA conversions of the potentiometer channel
+ */
+static esp_err_t configure_continuous(void)
+{
+    // Frame holds the oversampled values, in whole conversions
+    uint32_t frame_size = pot_config.oversampling * SOC_ADC_DIGI_RESULT_BYTES;
+    frame_size = (frame_size + SOC_ADC_DIGI_DATA_BYTES_PER_CONV - 1) / SOC_ADC_DIGI_DATA_BYTES_PER_CONV
+                 * SOC_ADC_DIGI_DATA_BYTES_PER_CONV;
+    adc_continuous_handle_cfg_t handle_cfg = {
+        .max_store_buf_size = frame_size * 2,
+        .conv_frame_size = frame_size,
+        .flags.flush_pool = 1,
+    };
+    esp_err_t ret = adc_continuous_new_handle(&handle_cfg, &adc_continuous_handle);
+    if (ret != ESP_OK) {
+        esp3d_log_e("Failed to create ADC continuous handle: %d", ret);
+        return ret;
+    }
+
+    adc_digi_pattern_config_t pattern = {
+        .atten = pot_config.atten,
+        .channel = pot_config.channel,
+        .unit = ADC_UNIT_1,
+        .bit_width = SOC_ADC_DIGI_MAX_BITWIDTH,
+    };
+    adc_continuous_config_t dig_cfg = {
+        .pattern_num = 1,
+        .adc_pattern = &pattern,
+        .sample_freq_hz = pot_config.sample_freq_hz,
+        .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+        .format = POT_OUTPUT_FORMAT,
+    };
+    ret = adc_continuous_config(adc_continuous_handle, &dig_cfg);
+    if (ret != ESP_OK) {
+        esp3d_log_e("Failed to configure ADC continuous mode: %d", ret);
+        adc_continuous_deinit(adc_continuous_handle);
+        return ret;
+    }
+
+    adc_continuous_evt_cbs_t cbs = {
+        .on_conv_done = on_conversion_done,
+    };
+    ret = adc_continuous_register_event_callbacks(adc_continuous_handle, &cbs, NULL);
+    if (ret != ESP_OK) {
+        esp3d_log_e("Failed to register ADC callbacks: %d", ret);
+        adc_continuous_deinit(adc_continuous_handle);
+        return ret;
+    }
+
+    ret = adc_continuous_start(adc_continuous_handle);
+    if (ret != ESP_OK) {
+        esp3d_log_e("Failed to start ADC continuous mode: %d", ret);
+        adc_continuous_deinit(adc_continuous_handle);
+        return ret;
+    }
+
+    // First read must be a real value
+    TickType_t start = xTaskGetTickCount();
+    while (!has_value && xTaskGetTickCount() - start < pdMS_TO_TICKS(POT_FIRST_VALUE_TIMEOUT_MS)) {
+        vTaskDelay(1);
+    }
+    if (!has_value) {
+        esp3d_log_w("No potentiometer value yet");
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Configure the ADC unit for one-shot reads
+ */
+static esp_err_t configure_oneshot(void)
+{
     // Initialize ADC oneshot unit
     adc_oneshot_unit_init_cfg_t init_cfg = {
         .unit_id = ADC_UNIT_1,
@@ -71,9 +267,43 @@ esp_err_t phy_potentiometer_configure(const phy_potentiometer_config_t *config)
         adc_oneshot_del_unit(adc1_handle);
         return ret;
     }
+    return ESP_OK;
+}
+
+/**
+ * @brief Configure the potentiometer
+ */
+esp_err_t phy_potentiometer_configure(const phy_potentiometer_config_t *config)
+{
+    if (config == NULL) {
+        esp3d_log_e("Invalid potentiometer configuration");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memcpy(&pot_config, config, sizeof(phy_potentiometer_config_t));
+
+    // Validate GPIO pin and ADC channel
+    if (!GPIO_IS_VALID_GPIO(pot_config.pin)) {
+        esp3d_log_e("Invalid GPIO number for potentiometer pin");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Validate filters and endpoints
+    if (pot_config.raw_max <= pot_config.raw_min || pot_config.median_size == 0
+        || pot_config.median_size > PHY_POTENTIOMETER_MEDIAN_MAX || pot_config.oversampling == 0
+        || pot_config.iir_shift > 8) {
+        esp3d_log_e("Invalid potentiometer filter or calibration");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(&pot_stats, 0, sizeof(pot_stats));
+    esp_err_t ret = pot_config.continuous ? configure_continuous() : configure_oneshot();
+    if (ret != ESP_OK) {
+        return ret;
+    }
 
     is_initialized = true;
-    esp3d_log("Potentiometer configured successfully");
+    esp3d_log("Potentiometer configured successfully (%s)", pot_config.continuous ? "continuous" : "one-shot");
     return ESP_OK;
 }
 
@@ -92,13 +322,22 @@ esp_err_t phy_potentiometer_read(uint32_t *value)
         return ESP_ERR_INVALID_ARG;
     }
 
+    // Latest filtered value, the interrupt keeps it up to date
+    if (pot_config.continuous) {
+        *value = latest_value;
+        return ESP_OK;
+    }
+
     uint32_t adc_sum = 0;
     uint32_t samples = pot_config.filter_enabled ? pot_config.filter_samples : 1;
+    uint32_t cycles = 0;
 
     // Lire plusieurs échantillons et faire la moyenne
     for (uint32_t i = 0; i < samples; i++) {
         int raw;
+        uint32_t start = esp_cpu_get_cycle_count();
         esp_err_t ret = adc_oneshot_read(adc1_handle, pot_config.channel, &raw);
+        cycles += esp_cpu_get_cycle_count() - start;
         if (ret != ESP_OK) {
             esp3d_log_e("Failed to read ADC: %d", ret);
             return ret;
@@ -108,16 +347,57 @@ esp_err_t phy_potentiometer_read(uint32_t *value)
     }
 
     // Calculer la moyenne
-    *value = adc_sum / samples;
+    uint32_t average = adc_sum / samples;
 
     // Convertir la valeur brute en tension pour débogage
     int voltage;
-    esp_err_t ret = adc_cali_raw_to_voltage(adc_cali_handle, *value, &voltage);
+    esp_err_t ret = adc_cali_raw_to_voltage(adc_cali_handle, average, &voltage);
     if (ret != ESP_OK) {
         esp3d_log_e("Failed to convert ADC raw to voltage: %d", ret);
         return ret;
     }
-    //esp3d_log("Potentiometer: raw=%ld, voltage=%d mV", *value, voltage);
+    //esp3d_log("Potentiometer: raw=%ld, voltage=%d mV", average, voltage);
+
+    *value = calibrate_value(average);
+    portENTER_CRITICAL(&pot_lock);
+    update_stats(cycles, samples);
+    portEXIT_CRITICAL(&pot_lock);
 
     return ESP_OK;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Set the callback called when the filtered value changes
+ */
+esp_err_t phy_potentiometer_set_notify(phy_potentiometer_notify_cb_t callback, void *arg)
+{
+    if (!is_initialized) {
+        esp3d_log_e("Potentiometer not configured");
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!pot_config.continuous) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    portENTER_CRITICAL(&pot_lock);
+    notify_cb = callback;
+    notify_arg = arg;
+    notified_value = UINT32_MAX;
+    portEXIT_CRITICAL(&pot_lock);
+    return ESP_OK;
+}
+
+/**
+ * @brief Get the acquisition statistics
+ */
+esp_err_t phy_potentiometer_get_stats(phy_potentiometer_stats_t *stats)
+{
+    if (stats == NULL) {
+        esp3d_log_e("Invalid stats pointer");
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&pot_lock);
+    *stats = pot_stats;
+    portEXIT_CRITICAL(&pot_lock);
+    return ESP_OK;
+}
@@ -13,6 +13,28 @@
 extern "C" {
 #endif
 
+// Full scale of values read, after endpoints calibration
+#define PHY_POTENTIOMETER_MAX_VALUE 4095
+// Largest median filter window
+#define PHY_POTENTIOMETER_MEDIAN_MAX 7
+// Filtered value change that notifies, above the noise left by the filters
+#define PHY_POTENTIOMETER_NOTIFY_DELTA 4
+
+typedef struct {
+    uint32_t values;             // Filtered values produced
+    uint32_t samples;            // ADC samples used for them
+    uint32_t cpu_ns_per_sample;  // CPU time per ADC sample, smoothed over last 8 values
+    uint32_t notifications;      // Filtered value changes notified
+} phy_potentiometer_stats_t;
+
+/**
+ * @brief Callback called from interrupt when the filtered value changed
+ *
+ * @param arg User argument given to phy_potentiometer_set_notify
+ * @return true if a higher priority task was woken
+ */
+typedef bool (*phy_potentiometer_notify_cb_t)(void *arg);
+
 /**
  * @brief Configure the potentiometer
  *
@@ -26,13 +48,41 @@ esp_err_t phy_potentiometer_configure(const phy_potentiometer_config_t *config);
 /**
  * @brief Read the potentiometer value
  *
- * This function reads the current ADC value and applies filtering if enabled.
+ * In continuous mode, this function returns the last value filtered from the DMA
+ * frames, without touching the ADC. In one-shot mode, it reads the ADC and applies
+ * filtering if enabled.
  *
- * @param value Pointer to store the filtered ADC value (0-4095 for 12 bits)
+ * @param value Pointer to store the filtered value (0 to PHY_POTENTIOMETER_MAX_VALUE)
  * @return ESP_OK on success, or an error code on failure
  */
 esp_err_t phy_potentiometer_read(uint32_t *value);
 
+/**
+ * @brief Set the callback called when the filtered value changes
+ *
+ * Only continuous mode filters in interrupt, the callback is called when the
+ * value moved by PHY_POTENTIOMETER_NOTIFY_DELTA since the last notification,
+ * and once for the first value after it is set.
+ *
+ * @param callback Callback, called from ISR, NULL to stop notifications
+ * @param arg User argument given to callback
+ * @return ESP_OK on success, ESP_ERR_NOT_SUPPORTED in one-shot mode
+ */
+esp_err_t phy_potentiometer_set_notify(phy_potentiometer_notify_cb_t callback, void *arg);
+
+/**
+ * @brief Get the acquisition statistics
+ *
+ * CPU time per sample is the conversion wait in one-shot mode, and the frame
+ * processing in continuous mode, so both modes can be compared. In continuous
+ * mode, the copy of each frame to the driver pool, done by the driver in the
+ * same interrupt after the callback, is not measured.
+ *
+ * @param stats Pointer to store the statistics
+ * @return ESP_OK on success, or an error code on failure
+ */
+esp_err_t phy_potentiometer_get_stats(phy_potentiometer_stats_t *stats);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
\ No newline at end of file
@@ -25,6 +25,13 @@ typedef struct {
     adc_atten_t atten;           // ADC attenuation
     bool filter_enabled;         // true: Enable filtering, false: Disable
     uint32_t filter_samples;     // Number of samples for filtering
+    bool continuous;             // true: DMA continuous conversion, false: One-shot reads
+    uint32_t sample_freq_hz;     // Continuous conversion rate
+    uint32_t oversampling;       // Continuous samples averaged in each value
+    uint32_t median_size;        // Values in median filter window, 1 to disable
+    uint32_t iir_shift;          // Weight of new value in IIR filter is 1/2^shift, 0 to disable
+    uint32_t raw_min;            // Raw value at start of course, read as 0
+    uint32_t raw_max;            // Raw value at end of course, read as full scale
 } phy_potentiometer_config_t;
 
 #ifdef __cplusplus
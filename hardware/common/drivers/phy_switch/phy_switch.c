@@ -163,4 +163,34 @@ esp_err_t phy_switch_get_state(uint32_t *key_code)
     // Mapper l'état à un code de touche
     *key_code = state_to_key_code[state];
     return ESP_OK;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Set an interrupt handler called on each edge of the switch pins
+ */
+esp_err_t phy_switch_set_isr(gpio_isr_t isr_handler, void *arg)
+{
+    if (!is_initialized) {
+        esp3d_log_e("Switch not configured");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    for (int i = 0; i < 3; i++) {
+        gpio_num_t pin = switch_config.pins[i];
+        esp_err_t ret;
+        if (isr_handler == NULL) {
+            gpio_set_intr_type(pin, GPIO_INTR_DISABLE);
+            ret = gpio_isr_handler_remove(pin);
+        } else {
+            ret = gpio_set_intr_type(pin, GPIO_INTR_ANYEDGE);
+            if (ret == ESP_OK) {
+                ret = gpio_isr_handler_add(pin, isr_handler, arg);
+            }
+        }
+        if (ret != ESP_OK) {
+            esp3d_log_e("Failed to set interrupt for switch pin %d", i + 1);
+            return ret;
+        }
+    }
+    return ESP_OK;
+}
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <esp_err.h>
+#include "driver/gpio.h"
 #include "phy_switch_config.h"
 
 #ifdef __cplusplus
@@ -43,6 +44,18 @@ esp_err_t phy_switch_read(bool *states);
  */
 esp_err_t phy_switch_get_state(uint32_t *key_code);
 
+/**
+ * @brief Set an interrupt handler called on each edge of the switch pins
+ *
+ * The handler only tells the reader that a pin changed, phy_switch_read still does the debounce.
+ * The GPIO ISR service must be installed before.
+ *
+ * @param isr_handler Handler called in interrupt context, or NULL to disable interrupts
+ * @param arg User argument given to handler
+ * @return ESP_OK on success, or an error code on failure
+ */
+esp_err_t phy_switch_set_isr(gpio_isr_t isr_handler, void *arg);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
\ No newline at end of file
@@ -22,8 +22,8 @@
 #include "esp3d_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
-#include "freertos/semphr.h"
 #include "driver/gpio.h"
+#include "esp_timer.h"
 #include <string.h>
 
 /* Register definitions */
@@ -50,32 +50,41 @@
 #define FT6336U_VENDID            0x11
 #define FT6336U_CHIPID            0x36
 
+/* Registers read for a touch: mode, gesture, points and first point */
+#define FT6336U_TOUCH_READ_SIZE   (FT6336U_TOUCH1_YL + 1)
+
 /* Static variables */
 static touch_ft6336u_config_t _config;
 static bool _is_initialized = false;
 static uint16_t _x_max = 0;
 static uint16_t _y_max = 0;
-static volatile bool _touch_interrupt = false;
-static SemaphoreHandle_t touch_semaphore = NULL;
-
-/* ISR handler for touch interrupt */
+static touch_ft6336u_notify_cb_t notify_cb = NULL;
+static void *notify_arg = NULL;
+/* Last touch read by the reader, shared with LVGL task */
+static portMUX_TYPE _touch_lock = portMUX_INITIALIZER_UNLOCKED;
+static touch_ft6336u_data_t _touch_data = {.is_pressed = false, .x = -1, .y = -1};
+/* Statistics */
+static volatile uint32_t _transactions = 0;
+static volatile uint32_t _interrupts = 0;
+static uint32_t _reads = 0;
+static uint32_t _rejected = 0;
+static int64_t _start_time_us = 0;
+
+/* ISR handler for touch interrupt, the reader does the I2C read */
 static void IRAM_ATTR touch_ft6336u_touch_isr_handler(void *arg) {
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    
-    // Give semaphore from ISR
-    if (touch_semaphore != NULL) {
-        xSemaphoreGiveFromISR(touch_semaphore, &xHigherPriorityTaskWoken);
-    }
-    
-    // Set flag for compatibility with existing code
-    _touch_interrupt = true;
-    
-    // Yield if a higher priority task is woken
-    if (xHigherPriorityTaskWoken) {
+    _interrupts++;
+    touch_ft6336u_notify_cb_t callback = notify_cb;
+    if (callback != NULL && callback(notify_arg)) {
         portYIELD_FROM_ISR();
     }
 }
 
+/* Every I2C transaction goes through here to be counted */
+static esp_err_t touch_ft6336u_cmd_begin(i2c_cmd_handle_t cmd) {
+    _transactions++;
+    return i2c_master_cmd_begin(_config.i2c_port, cmd, 1000 / portTICK_PERIOD_MS);
+}
+
 /* I2C communication functions with STOP/START sequence */
 static esp_err_t touch_ft6336u_read_byte(uint8_t reg, uint8_t *data) {
     i2c_cmd_handle_t cmd = i2c_cmd_link_create();
@@ -86,7 +95,7 @@ static esp_err_t touch_ft6336u_read_byte(uint8_t reg, uint8_t *data) {
     i2c_master_write_byte(cmd, reg, ACK_CHECK_EN);
     i2c_master_stop(cmd);
     
-    esp_err_t ret = i2c_master_cmd_begin(_config.i2c_port, cmd, 1000 / portTICK_PERIOD_MS);
+    esp_err_t ret = touch_ft6336u_cmd_begin(cmd);
     i2c_cmd_link_delete(cmd);
     
     if (ret != ESP_OK) {
@@ -100,7 +109,7 @@ static esp_err_t touch_ft6336u_read_byte(uint8_t reg, uint8_t *data) {
     i2c_master_read_byte(cmd, data, I2C_MASTER_NACK);
     i2c_master_stop(cmd);
     
-    ret = i2c_master_cmd_begin(_config.i2c_port, cmd, 1000 / portTICK_PERIOD_MS);
+    ret = touch_ft6336u_cmd_begin(cmd);
     i2c_cmd_link_delete(cmd);
     
     return ret;
@@ -114,7 +123,7 @@ static esp_err_t touch_ft6336u_write_byte(uint8_t reg, uint8_t data) {
     i2c_master_write_byte(cmd, data, ACK_CHECK_EN);
     i2c_master_stop(cmd);
     
-    esp_err_t ret = i2c_master_cmd_begin(_config.i2c_port, cmd, 1000 / portTICK_PERIOD_MS);
+    esp_err_t ret = touch_ft6336u_cmd_begin(cmd);
     i2c_cmd_link_delete(cmd);
     
     return ret;
@@ -130,7 +139,7 @@ static esp_err_t touch_ft6336u_read_data(uint8_t *data, size_t len) {
     i2c_master_write_byte(cmd, 0, ACK_CHECK_EN);
     i2c_master_stop(cmd);
     
-    esp_err_t ret = i2c_master_cmd_begin(_config.i2c_port, cmd, 1000 / portTICK_PERIOD_MS);
+    esp_err_t ret = touch_ft6336u_cmd_begin(cmd);
     i2c_cmd_link_delete(cmd);
     
     if (ret != ESP_OK) {
@@ -147,7 +156,7 @@ static esp_err_t touch_ft6336u_read_data(uint8_t *data, size_t len) {
     i2c_master_read_byte(cmd, data + len - 1, I2C_MASTER_NACK);
     i2c_master_stop(cmd);
     
-    ret = i2c_master_cmd_begin(_config.i2c_port, cmd, 1000 / portTICK_PERIOD_MS);
+    ret = touch_ft6336u_cmd_begin(cmd);
     i2c_cmd_link_delete(cmd);
     
     return ret;
@@ -160,23 +169,12 @@ static esp_err_t touch_ft6336u_ping(void) {
     i2c_master_write_byte(cmd, (_config.i2c_addr << 1) | I2C_MASTER_WRITE, ACK_CHECK_EN);
     i2c_master_stop(cmd);
     
-    esp_err_t ret = i2c_master_cmd_begin(_config.i2c_port, cmd, 1000 / portTICK_PERIOD_MS);
+    esp_err_t ret = touch_ft6336u_cmd_begin(cmd);
     i2c_cmd_link_delete(cmd);
     
     return ret;
 }
 
-static bool touch_ft6336u_detect_touch(void) {
-    uint8_t touch_points = 0;
-    esp_err_t ret = touch_ft6336u_read_byte(FT6336U_TOUCH_POINTS, &touch_points);
-    
-    if (ret != ESP_OK) {
-        return false;
-    }
-    
-    return (touch_points > 0 && touch_points < 6); // FT6336U supports up to 5 touch points
-}
-
 /* Public functions */
 esp_err_t touch_ft6336u_configure(const touch_ft6336u_config_t *config) {
     if (_is_initialized) {
@@ -198,15 +196,6 @@ esp_err_t touch_ft6336u_configure(const touch_ft6336u_config_t *config) {
 
     esp3d_log("FT6336U init with x_max=%d, y_max=%d", _x_max, _y_max);
 
-    // Create interrupt semaphore
-    if (touch_semaphore == NULL) {
-        touch_semaphore = xSemaphoreCreateBinary();
-        if (touch_semaphore == NULL) {
-            esp3d_log_e("Failed to create touch semaphore");
-            return ESP_ERR_NO_MEM;
-        }
-    }
-    
     // Configure I2C
     i2c_config_t i2c_conf = {
         .mode = I2C_MODE_MASTER,
@@ -316,7 +305,9 @@ esp_err_t touch_ft6336u_configure(const touch_ft6336u_config_t *config) {
     
     // Configure interrupt mode if needed
     if (GPIO_IS_VALID_GPIO(config->int_pin)) {
-        ret = touch_ft6336u_write_byte(FT6336U_INTERRUPT_MODE, 1);  // 1 = Interrupt mode
+        // 0 = INT held low while touched: the falling edge wakes the reader and
+        // the pin level tells a real touch from a spurious edge
+        ret = touch_ft6336u_write_byte(FT6336U_INTERRUPT_MODE, 0);
         if (ret != ESP_OK) {
             esp3d_log_e("Failed to set interrupt mode: %d", ret);
         } else {
@@ -349,6 +340,11 @@ esp_err_t touch_ft6336u_configure(const touch_ft6336u_config_t *config) {
     
     esp3d_log("FT6336U detected with Vendor ID: 0x%02x, Chip ID: 0x%02x", vendor_id, chip_id);
 
+    _transactions = 0;
+    _interrupts = 0;
+    _reads = 0;
+    _rejected = 0;
+    _start_time_us = esp_timer_get_time();
     _is_initialized = true;
     esp3d_log("FT6336U initialized successfully");
     return ESP_OK;
@@ -364,11 +360,7 @@ void touch_ft6336u_deinit(void) {
         gpio_isr_handler_remove(_config.int_pin);
     }
     
-    // Free the semaphore
-    if (touch_semaphore != NULL) {
-        vSemaphoreDelete(touch_semaphore);
-        touch_semaphore = NULL;
-    }
+    notify_cb = NULL;
     
     // Uninstall I2C driver
     i2c_driver_delete(_config.i2c_port);
@@ -376,38 +368,37 @@ void touch_ft6336u_deinit(void) {
     _is_initialized = false;
 }
 
-touch_ft6336u_data_t touch_ft6336u_read(void) {
+esp_err_t touch_ft6336u_update(void) {
+    if (!_is_initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
     touch_ft6336u_data_t data = {
         .is_pressed = false,
         .x = -1,
         .y = -1
     };
 
-    if (!_is_initialized) {
-        return data;
-    }
-
-    // If interrupt mode is enabled and INT pin is configured
-    if (touch_semaphore != NULL && GPIO_IS_VALID_GPIO(_config.int_pin)) {
-        // Wait for at most 10ms for an interrupt (non-blocking for LVGL)
-        if (xSemaphoreTake(touch_semaphore, pdMS_TO_TICKS(10)) != pdTRUE) {
-            // No interrupt in the timeout period, no touch
-            return data;
-        }
-    } else {
-        // In polling mode, directly check for touch
-        if (!touch_ft6336u_detect_touch()) {
-            return data;
+    // INT stays high without a touch: GPIO36 sees spurious falling edges from
+    // ADC and WiFi activity, so an idle pin needs no I2C read
+    if (notify_cb != NULL && gpio_get_level(_config.int_pin) != 0) {
+        portENTER_CRITICAL(&_touch_lock);
+        if (!_touch_data.is_pressed) {
+            _rejected++;
         }
+        _touch_data = data;
+        portEXIT_CRITICAL(&_touch_lock);
+        return ESP_OK;
     }
 
-    // Read all registers in a single transaction
-    uint8_t touch_registers[16];  // Read first 16 registers
-    esp_err_t ret = touch_ft6336u_read_data(touch_registers, 16);
-    
+    // Points count and first point come with one block read
+    uint8_t touch_registers[FT6336U_TOUCH_READ_SIZE];
+    esp_err_t ret = touch_ft6336u_read_data(touch_registers, FT6336U_TOUCH_READ_SIZE);
+    _reads++;
+
     if (ret != ESP_OK) {
         esp3d_log_e("Failed to read touch data: %d", ret);
-        return data;
+        return ret;
     }
     
     uint8_t touch_points = touch_registers[FT6336U_TOUCH_POINTS];
@@ -433,13 +424,57 @@ touch_ft6336u_data_t touch_ft6336u_read(void) {
         if (_config.invert_y) {
             data.y = _y_max - data.y;
         }
-        
-        esp3d_log("Touch detected at (%d, %d)", data.x, data.y);
     }
-    
+
+    portENTER_CRITICAL(&_touch_lock);
+    _touch_data = data;
+    portEXIT_CRITICAL(&_touch_lock);
+    return ESP_OK;
+}
+
+touch_ft6336u_data_t touch_ft6336u_get_data(void) {
+    portENTER_CRITICAL(&_touch_lock);
+    touch_ft6336u_data_t data = _touch_data;
+    portEXIT_CRITICAL(&_touch_lock);
     return data;
 }
 
+touch_ft6336u_data_t touch_ft6336u_read(void) {
+    // Without a reader woken by the interrupt, the controller is polled
+    if (notify_cb == NULL) {
+        touch_ft6336u_update();
+    }
+    return touch_ft6336u_get_data();
+}
+
+esp_err_t touch_ft6336u_set_notify(touch_ft6336u_notify_cb_t callback, void *arg) {
+    if (!_is_initialized) {
+        esp3d_log_e("FT6336U not configured");
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!GPIO_IS_VALID_GPIO(_config.int_pin)) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    notify_cb = NULL;
+    notify_arg = arg;
+    notify_cb = callback;
+    return ESP_OK;
+}
+
+esp_err_t touch_ft6336u_get_stats(touch_ft6336u_stats_t *stats) {
+    if (!_is_initialized || stats == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    stats->transactions = _transactions;
+    stats->reads = _reads;
+    stats->interrupts = _interrupts;
+    stats->rejected = _rejected;
+    stats->interrupt_mode = notify_cb != NULL;
+    int64_t elapsed_ms = (esp_timer_get_time() - _start_time_us) / 1000;
+    stats->transactions_per_s = elapsed_ms > 0 ? (uint32_t)((uint64_t)_transactions * 1000 / elapsed_ms) : 0;
+    return ESP_OK;
+}
+
 uint16_t touch_ft6336u_get_x_max(void) {
     return _x_max;
 }
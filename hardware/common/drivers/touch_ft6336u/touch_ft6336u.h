@@ -38,10 +38,69 @@ esp_err_t touch_ft6336u_configure(const touch_ft6336u_config_t *config);
 /**
  * @brief Read touch data from FT6336U
  * 
+ * When a reader is notified by the interrupt, this only returns the last
+ * touch it read, otherwise the controller is polled over I2C
+ * 
  * @return touch_ft6336u_data_t Touch data
  */
 touch_ft6336u_data_t touch_ft6336u_read(void);
 
+/**
+ * @brief Read the controller over I2C and keep the touch for readers
+ * 
+ * Called by the task notified by the interrupt, one block read per call
+ * 
+ * @return esp_err_t ESP_OK on success, error otherwise
+ */
+esp_err_t touch_ft6336u_update(void);
+
+/**
+ * @brief Get the last touch read by touch_ft6336u_update, without I2C access
+ * 
+ * @return touch_ft6336u_data_t Touch data
+ */
+touch_ft6336u_data_t touch_ft6336u_get_data(void);
+
+/**
+ * @brief Callback called from interrupt when the controller has a new touch report
+ * 
+ * @param arg User argument given to touch_ft6336u_set_notify
+ * @return true if a higher priority task was woken
+ */
+typedef bool (*touch_ft6336u_notify_cb_t)(void *arg);
+
+/**
+ * @brief Set the callback called when the controller raises its interrupt
+ * 
+ * Once set, touch_ft6336u_read no longer polls the controller, the notified
+ * task must call touch_ft6336u_update
+ * 
+ * @param callback Callback, called from ISR, NULL to go back to polling
+ * @param arg User argument given to callback
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_SUPPORTED without interrupt pin
+ */
+esp_err_t touch_ft6336u_set_notify(touch_ft6336u_notify_cb_t callback, void *arg);
+
+/**
+ * @brief I2C usage of the driver, to compare interrupt and polling modes
+ */
+typedef struct {
+    uint32_t transactions;        /*!< I2C transactions since configuration */
+    uint32_t transactions_per_s;  /*!< Average I2C transactions per second */
+    uint32_t reads;               /*!< Touch reads */
+    uint32_t interrupts;          /*!< Interrupts from controller */
+    uint32_t rejected;            /*!< Interrupts with INT high, not read */
+    bool interrupt_mode;          /*!< A reader is notified by the interrupt */
+} touch_ft6336u_stats_t;
+
+/**
+ * @brief Get I2C usage statistics
+ * 
+ * @param stats Pointer to store the statistics
+ * @return esp_err_t ESP_OK on success, error if not configured
+ */
+esp_err_t touch_ft6336u_get_stats(touch_ft6336u_stats_t *stats);
+
 /**
  * @brief Get the maximum X coordinate
  * 
@@ -108,6 +108,7 @@ const char* help[] = {
     "[ESP410]<WIFI/BTSERIAL/BTBLE>- display available AP/BT Devices list",
 #endif  // ESP3D_WIFI_FEATURE
     "[ESP420] - display ESP3D current status",
+    "[ESP421](RESET) - display performance statistics, reset pool usage",
     "[ESP444](state) - set ESP3D state (RESET/RESTART)",
 #if ESP3D_MDNS_FEATURE
     "[ESP450]display ESP3D list on network",
@@ -124,10 +125,11 @@ const char* help[] = {
     "[ESP610](type=NONE/PUSHOVER/EMAIL/LINE/IFTTT) (AUTO=YES/NO) (T1=token1) "
     "(T2=token2) (TS=Settings)",
 #endif  // ESP3D_NOTIFICATIONS_FEATURE
-    "[ESP700](stream=file name) or (macro name) - read and process/stream "
-    "file/macro",
+    "[ESP700](stream=file name) (line=line/percent=percent) or (macro name) - "
+    "read and process/stream file/macro",
     "[ESP701]action=(PAUSE/RESUME/ABORT) - query and control ESP700 stream",
     "[ESP702](pause/stop/resume)=(script) - display/set ESP700 stream scripts",
+    "[ESP703](file name) - compile file to job for faster streaming",
     "[ESP710]FORMATFS - Format ESP3D Filesystem",
     "[ESP720](path) - List ESP3D Filesystem",
     "[ESP730](Action)=(path) - rmdir / remove / mkdir / exists / create on "
@@ -219,7 +221,7 @@ const uint cmdlist[] = {
 #if ESP3D_WIFI_FEATURE || ESP3D_BT_FEATURE
     410, 
 #endif  // ESP3D_WIFI_FEATURE || ESP3D_BT_FEATURE
-    420, 444,
+    420, 421, 444,
 #if ESP3D_MDNS_FEATURE
     450,
 #endif  // ESP3D_MDNS_FEATURE
@@ -230,7 +232,7 @@ const uint cmdlist[] = {
 #if ESP3D_NOTIFICATIONS_FEATURE
     600, 610,
 #endif  // ESP3D_NOTIFICATIONS_FEATURE
-    700, 701, 702, 710, 720, 730,
+    700, 701, 702, 703, 710, 720, 730,
 #if ESP3D_SD_CARD_FEATURE
     740, 750,
 #endif  // ESP3D_SD_CARD_FEATURE
@@ -23,6 +23,9 @@
 #include "esp3d_string.h"
 #include "translations/esp3d_translation_service.h"
 #include "board_config.h"
+#if TARGET_IS_GRBLHAL
+#include "esp3d_target_settings.h"
+#endif  // TARGET_IS_GRBLHAL
 
 
 #define COMMAND_ID 400
@@ -58,6 +61,9 @@ const char* IpModeValues[] = {"0", "1"};
 const char* FallbackLabels[] = {"none", "setup"};
 const char* FallbackValues[] = {"0", "3"};
 
+const char* StreamingModeLabels[] = {"send-response", "char-counting"};
+const char* StreamingModeValues[] = {"0", "1"};
+
 const char* ApChannelsList[] = {"1", "2", "3",  "4",  "5",  "6",  "7",
                                 "8", "9", "10", "11", "12", "13", "14"};
 
@@ -434,6 +440,32 @@ void ESP3DCommands::ESP400(int cmd_params_pos, ESP3DMessage* msg) {
                        false, target, requestId)) {
     esp3d_log_e("Error sending response to clients");
   }
+  // Gcode host streaming mode
+  if (!dispatchSetting(json, "service/gcodehost",
+                       ESP3DSettingIndex::esp3d_streaming_mode, "streaming",
+                       StreamingModeValues, StreamingModeLabels,
+                       sizeof(StreamingModeValues) / sizeof(char*), -1, -1, -1,
+                       nullptr, false, target, requestId)) {
+    esp3d_log_e("Error sending response to clients");
+  }
+  // Compile uploaded gcode files into jobs
+  if (!dispatchSetting(json, "service/gcodehost",
+                       ESP3DSettingIndex::esp3d_job_compile, "compile on upload",
+                       YesNoValues, YesNoLabels,
+                       sizeof(YesNoValues) / sizeof(char*), -1, -1, -1, nullptr,
+                       false, target, requestId)) {
+    esp3d_log_e("Error sending response to clients");
+  }
+#if TARGET_IS_GRBLHAL
+  // Encoder jog acceleration curve
+  if (!dispatchSetting(json, "device/jog",
+                       ESP3DSettingIndex::esp3d_jog_acceleration,
+                       "jog acceleration", nullptr, nullptr,
+                       SIZE_OF_JOG_ACCELERATION, 0, 0, -1, nullptr, false,
+                       target, requestId)) {
+    esp3d_log_e("Error sending response to clients");
+  }
+#endif  // TARGET_IS_GRBLHAL
 #if ESP3D_SD_CARD_FEATURE
 #if SD_INTERFACE_TYPE == 0
   // SPI Divider factor
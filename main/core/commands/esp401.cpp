@@ -29,6 +29,9 @@
 #endif  // ESP3D_SD_CARD_FEATURE
 #include "gcode_host/esp3d_gcode_host_service.h"
 #include "gcode_host/esp3d_tft_stream.h"
+#if TARGET_IS_GRBLHAL
+#include "esp3d_jog_engine.h"
+#endif  // TARGET_IS_GRBLHAL
 #if ESP3D_NOTIFICATIONS_FEATURE
 #include "notifications/esp3d_notifications_service.h"
 #endif  // ESP3D_NOTIFICATIONS_FEATURE
@@ -260,6 +263,14 @@ void ESP3DCommands::ESP401(int cmd_params_pos, ESP3DMessage* msg) {
         case ESP3DSettingIndex::esp3d_resume_script:
           gcodeHostService.updateScripts();
           break;
+        case ESP3DSettingIndex::esp3d_streaming_mode:
+          gcodeHostService.updateStreamingMode();
+          break;
+#if TARGET_IS_GRBLHAL
+        case ESP3DSettingIndex::esp3d_jog_acceleration:
+          esp3dJogEngine.loadAcceleration();
+          break;
+#endif  // TARGET_IS_GRBLHAL
         case ESP3DSettingIndex::esp3d_target_firmware:
           esp3dTftstream.getTargetFirmware(true);
 
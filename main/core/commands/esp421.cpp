@@ -0,0 +1,325 @@
+/*
+  esp3d_commands member
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#include <string>
+
+#include "authentication/esp3d_authentication.h"
+#include "esp3d_client.h"
+#include "esp3d_commands.h"
+#include "esp3d_gcode_parser_service.h"
+#include "esp3d_message_pool.h"
+#include "esp3d_string.h"
+#include "gcode_host/esp3d_gcode_host_service.h"
+
+#if ESP3D_DISPLAY_FEATURE
+#include "control_input.h"
+#if ESP3D_HARDWARE_POTENTIOMETER_FEATURE
+#include "phy_potentiometer.h"
+#endif  // ESP3D_HARDWARE_POTENTIOMETER_FEATURE
+#if ESP3D_TOUCH_FEATURE
+#include "touch_ft6336u.h"
+#endif  // ESP3D_TOUCH_FEATURE
+#if TARGET_IS_GRBLHAL
+#include "esp3d_jog_engine.h"
+#include "esp3d_override_engine.h"
+#endif  // TARGET_IS_GRBLHAL
+#include "rendering/esp3d_rendering_client.h"
+#endif  // ESP3D_DISPLAY_FEATURE
+
+#define COMMAND_ID 421
+
+static std::string esp3d_pool_stats_str(const ESP3DMessagePoolStats &stats) {
+  std::string res = std::to_string(stats.used);
+  res += "/";
+  res += std::to_string(stats.count);
+  res += ", max ";
+  res += std::to_string(stats.high_water);
+  res += ", heap ";
+  res += std::to_string(stats.fallbacks);
+  return res;
+}
+
+static std::string esp3d_rate_str(uint32_t count, uint32_t duration) {
+  std::string res = std::to_string(count);
+  res += " (";
+  res += std::to_string(duration ? (uint64_t)count * 1000 / duration : 0);
+  res += "/s)";
+  return res;
+}
+
+// Get performance statistics: message pool usage (blocks used, high water
+// mark and heap fallbacks, then payloads stored inline or allocated since
+// reset, with their rate), then streaming, realtime, status polling and
+// physical controls counters
+// RESET restarts pool high water marks from current usage and clears pool
+// counters
+//[ESP421](RESET) json=<no> pwd=<admin/user password>
+void ESP3DCommands::ESP421(int cmd_params_pos, ESP3DMessage *msg) {
+  ESP3DClientType target = msg->origin;
+  ESP3DRequest requestId = msg->request_id;
+  msg->target = target;
+  msg->origin = ESP3DClientType::command;
+  bool json = hasTag(msg, cmd_params_pos, "json");
+  bool isReset = hasTag(msg, cmd_params_pos, "RESET");
+  std::string tmpstr;
+  ESP3DMessagePoolStats stats;
+#if ESP3D_AUTHENTICATION_FEATURE
+  if (msg->authentication_level == ESP3DAuthenticationLevel::guest) {
+    dispatchAuthenticationError(msg, COMMAND_ID, json);
+    return;
+  }
+#endif  // ESP3D_AUTHENTICATION_FEATURE
+  if (isReset) {
+    esp3d_message_pool::resetStats();
+  }
+  if (json) {
+    tmpstr = "{\"cmd\":\"421\",\"status\":\"ok\",\"data\":[";
+  } else {
+    tmpstr = "Statistics:\n";
+  }
+  msg->type = ESP3DMessageType::head;
+  if (!dispatch(msg, tmpstr.c_str())) {
+    esp3d_log_e("Error sending response to clients");
+    return;
+  }
+  esp3d_message_pool::getMsgStats(&stats);
+  if (!dispatchIdValue(json, "messages", esp3d_pool_stats_str(stats).c_str(),
+                       target, requestId, true)) {
+    return;
+  }
+  for (uint8_t i = 0; esp3d_message_pool::getSlabStats(i, &stats); i++) {
+    tmpstr = "slab ";
+    tmpstr += std::to_string(stats.block_size);
+    tmpstr += "B";
+    if (!dispatchIdValue(json, tmpstr.c_str(),
+                         esp3d_pool_stats_str(stats).c_str(), target,
+                         requestId)) {
+      return;
+    }
+  }
+  tmpstr = std::to_string(esp3d_message_pool::getOversizedCount());
+  if (!dispatchIdValue(json, "oversized", tmpstr.c_str(), target,
+                       requestId)) {
+    return;
+  }
+  // copies sharing the payload instead of allocating one
+  tmpstr = std::to_string(esp3d_message_pool::getSharedCount());
+  if (!dispatchIdValue(json, "shared payloads", tmpstr.c_str(), target,
+                       requestId)) {
+    return;
+  }
+  // payloads set since reset, with rate per second
+  uint32_t duration = esp3d_message_pool::getStatsDuration();
+  uint32_t count = esp3d_message_pool::getInlineCount();
+  tmpstr = esp3d_rate_str(count, duration);
+  if (!dispatchIdValue(json, "inline payloads", tmpstr.c_str(), target,
+                       requestId)) {
+    return;
+  }
+  count = esp3d_message_pool::getDataAllocCount();
+  tmpstr = esp3d_rate_str(count, duration);
+  if (!dispatchIdValue(json, "allocated payloads", tmpstr.c_str(), target,
+                       requestId)) {
+    return;
+  }
+  // Streaming protocol and throughput of current / last job
+  tmpstr = ESP3DGcodeHostStreamingModeStr[static_cast<uint8_t>(
+      gcodeHostService.getStreamingMode())];
+  tmpstr += ", ";
+  tmpstr += std::to_string(gcodeHostService.getLinesPerSecond());
+  tmpstr += " lines/s";
+  if (gcodeHostService.getStreamingMode() ==
+      ESP3DGcodeHostStreamingMode::character_counting) {
+    tmpstr += ", ";
+    tmpstr += std::to_string(gcodeHostService.getBytesInFlight());
+    tmpstr += "/";
+    tmpstr += std::to_string(gcodeHostService.getRxBufferSize());
+    tmpstr += " bytes";
+  }
+  if (!dispatchIdValue(json, "Streaming", tmpstr.c_str(), target, requestId)) {
+    return;
+  }
+  // Controller buffer: free planner blocks and RX bytes of last Bf:, and
+  // streaming waits caused by them
+  tmpstr = std::to_string(esp3dGcodeParser.getPlannerBlocksFree());
+  tmpstr += "/";
+  tmpstr += std::to_string(esp3dGcodeParser.getPlannerBlocksCount());
+  tmpstr += " blocks, ";
+  tmpstr += std::to_string(esp3dGcodeParser.getRxBytesFree());
+  tmpstr += "/";
+  tmpstr += std::to_string(gcodeHostService.getRxBufferSize());
+  tmpstr += " bytes free, ";
+  tmpstr += std::to_string(gcodeHostService.getBfWaits());
+  tmpstr += " waits";
+  if (!dispatchIdValue(json, "Controller buffer", tmpstr.c_str(), target,
+                       requestId)) {
+    return;
+  }
+  // Host latency between ack and next line written
+  tmpstr = std::to_string(gcodeHostService.getLineLatencyAvg());
+  tmpstr += "us / ";
+  tmpstr += std::to_string(gcodeHostService.getLineLatencyMax());
+  tmpstr += "us";
+  if (!dispatchIdValue(json, "Host latency", tmpstr.c_str(), target,
+                       requestId)) {
+    return;
+  }
+  // Realtime lane: worst time to put a realtime command on output client,
+  // waits for the UART tx lock held by a line being written included
+  tmpstr = std::to_string(esp3dCommands.getRealTimeCount());
+  tmpstr += " sent, max ";
+  tmpstr += std::to_string(esp3dCommands.getRealTimeMaxLatency());
+  tmpstr += "us";
+  if (!dispatchIdValue(json, "Realtime commands", tmpstr.c_str(), target,
+                       requestId)) {
+    return;
+  }
+#if ESP3D_DISPLAY_FEATURE
+  // Status polling: reports per second, pushed by controller or asked
+  // with '?', and round trip time of '?'
+  tmpstr = std::to_string(renderingClient.getPollRate());
+  tmpstr += renderingClient.isStatusPushed() ? "/s pushed, rtt " : "/s, rtt ";
+  tmpstr += std::to_string(renderingClient.getPollRttAvg());
+  tmpstr += "us (max ";
+  tmpstr += std::to_string(renderingClient.getPollRttMax());
+  tmpstr += "us), ";
+  tmpstr += std::to_string(renderingClient.getPollTimeouts());
+  tmpstr += "/";
+  tmpstr += std::to_string(renderingClient.getPollCount());
+  tmpstr += " lost";
+  if (!dispatchIdValue(json, "Status polling", tmpstr.c_str(), target,
+                       requestId)) {
+    return;
+  }
+#if TARGET_IS_GRBLHAL
+  // Encoder jog: first detent to motion, and last detent to stop, as seen
+  // by status reports
+  tmpstr = std::to_string(esp3dJogEngine.getJogCount());
+  tmpstr += " jogs, start ";
+  tmpstr += std::to_string(esp3dJogEngine.getStartLatencyAvg());
+  tmpstr += "ms (max ";
+  tmpstr += std::to_string(esp3dJogEngine.getStartLatencyMax());
+  tmpstr += "ms), stop ";
+  tmpstr += std::to_string(esp3dJogEngine.getStopLatencyAvg());
+  tmpstr += "ms (max ";
+  tmpstr += std::to_string(esp3dJogEngine.getStopLatencyMax());
+  tmpstr += "ms)";
+  if (!dispatchIdValue(json, "Jog latency", tmpstr.c_str(), target,
+                       requestId)) {
+    return;
+  }
+  // Potentiometer overrides: realtime commands sent, and bursts not
+  // confirmed by a status report
+  tmpstr = std::to_string(esp3dOverrideEngine.getCommandsCount());
+  tmpstr += " commands in ";
+  tmpstr += std::to_string(esp3dOverrideEngine.getBurstsCount());
+  tmpstr += " bursts, ";
+  tmpstr += std::to_string(esp3dOverrideEngine.getTimeoutsCount());
+  tmpstr += " unconfirmed";
+  if (!dispatchIdValue(json, "Overrides", tmpstr.c_str(), target,
+                       requestId)) {
+    return;
+  }
+#endif  // TARGET_IS_GRBLHAL
+  // Physical controls: events of input task, and delay from interrupt to
+  // sampling
+  control_input_stats_t input_stats;
+  control_input_get_stats(&input_stats);
+  tmpstr = std::to_string(input_stats.events);
+  tmpstr += " events, ";
+  tmpstr += std::to_string(input_stats.dropped);
+  tmpstr += " dropped, wakeup ";
+  tmpstr += std::to_string(input_stats.latency_avg_us);
+  tmpstr += "us (max ";
+  tmpstr += std::to_string(input_stats.latency_max_us);
+  tmpstr += "us)";
+  if (!dispatchIdValue(json, "Input", tmpstr.c_str(), target, requestId)) {
+    return;
+  }
+#if ESP3D_HARDWARE_POTENTIOMETER_FEATURE
+  // Potentiometer acquisition: CPU time per ADC sample, to compare DMA
+  // frames with one-shot reads, the driver copy of DMA frames is not counted
+  phy_potentiometer_stats_t pot_stats;
+  if (phy_potentiometer_get_stats(&pot_stats) == ESP_OK) {
+    tmpstr = std::to_string(pot_stats.values);
+    tmpstr += " values of ";
+    tmpstr += std::to_string(pot_stats.samples);
+    tmpstr += " samples, ";
+    tmpstr += std::to_string(pot_stats.cpu_ns_per_sample);
+    tmpstr += "ns/sample, ";
+    tmpstr += std::to_string(pot_stats.notifications);
+    tmpstr += " notifications";
+    if (!dispatchIdValue(json, "Potentiometer", tmpstr.c_str(), target,
+                         requestId)) {
+      return;
+    }
+  }
+#endif  // ESP3D_HARDWARE_POTENTIOMETER_FEATURE
+#if ESP3D_TOUCH_FEATURE
+  // Touch controller I2C load: read on interrupt, or polled by LVGL
+  touch_ft6336u_stats_t touch_stats;
+  if (touch_ft6336u_get_stats(&touch_stats) == ESP_OK) {
+    tmpstr = touch_stats.interrupt_mode ? "interrupt, " : "polling, ";
+    tmpstr += std::to_string(touch_stats.transactions_per_s);
+    tmpstr += " I2C/s, ";
+    tmpstr += std::to_string(touch_stats.reads);
+    tmpstr += " reads, ";
+    tmpstr += std::to_string(touch_stats.interrupts);
+    tmpstr += " interrupts, ";
+    tmpstr += std::to_string(touch_stats.rejected);
+    tmpstr += " rejected";
+    if (!dispatchIdValue(json, "Touch", tmpstr.c_str(), target, requestId)) {
+      return;
+    }
+  }
+#endif  // ESP3D_TOUCH_FEATURE
+#endif  // ESP3D_DISPLAY_FEATURE
+  // File read ahead: reader stalls mean the host is the bottleneck,
+  // consumer stalls mean the card is the bottleneck
+  ESP3DGcodePrefetcher* prefetcher = gcodeHostService.getPrefetcher();
+  tmpstr = std::to_string(STREAM_CHUNK_COUNT);
+  tmpstr += "x";
+  tmpstr += esp3d_string::formatBytes(STREAM_CHUNK_SIZE);
+  tmpstr += ", reader stalls: ";
+  tmpstr += std::to_string(prefetcher->getReaderStalls());
+  tmpstr += ", host stalls: ";
+  tmpstr += std::to_string(prefetcher->getConsumerStalls());
+  tmpstr += " (max ";
+  tmpstr += std::to_string(prefetcher->getConsumerMaxWait());
+  tmpstr += "ms)";
+  if (!dispatchIdValue(json, "File prefetch", tmpstr.c_str(), target,
+                       requestId)) {
+    return;
+  }
+  tmpstr = std::to_string(gcodeHostService.getScannedLines());
+  tmpstr += " lines, ";
+  tmpstr += std::to_string(gcodeHostService.getStraddledLines());
+  tmpstr += " copied across chunks";
+  if (!dispatchIdValue(json, "File lines", tmpstr.c_str(), target,
+                       requestId)) {
+    return;
+  }
+  if (json) {
+    tmpstr = "]}";
+  } else {
+    tmpstr = "ok\n";
+  }
+  if (!dispatch(tmpstr.c_str(), target, requestId, ESP3DMessageType::tail)) {
+    esp3d_log_e("Error sending answer to clients");
+  }
+}
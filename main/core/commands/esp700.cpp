@@ -20,12 +20,16 @@
 #include "esp3d_client.h"
 #include "esp3d_commands.h"
 #include "esp3d_string.h"
+#include "filesystem/esp3d_globalfs.h"
 #include "gcode_host/esp3d_gcode_host_service.h"
+#include "gcode_host/esp3d_gcode_job.h"
 
 #define COMMAND_ID 700
 
 // Read / Stream  / Process FS file
 //[ESP700]<filename> json=<no> pwd=<admin/user password>
+//[ESP700]stream=<filename> line=<line>/percent=<percent> json=<no>
+// pwd=<admin/user password>
 void ESP3DCommands::ESP700(int cmd_params_pos, ESP3DMessage* msg) {
   ESP3DClientType target = msg->origin;
   ESP3DRequest requestId = msg->request_id;
@@ -56,9 +60,38 @@ void ESP3DCommands::ESP700(int cmd_params_pos, ESP3DMessage* msg) {
     } else {  // it is a macro
       filename = get_clean_param(msg, cmd_params_pos);
     }
+    // stream can start from a line or a percentage of the file
+    uint32_t startLine = 0;
+    uint8_t startPercent = 0;
+    if (!isMacro) {
+      tmpstr = get_param(msg, cmd_params_pos, "line=");
+      if (tmpstr.length() > 0) {
+        startLine = atoi(tmpstr.c_str());
+      }
+      tmpstr = get_param(msg, cmd_params_pos, "percent=");
+      if (tmpstr.length() > 0) {
+        startPercent = atoi(tmpstr.c_str()) > 100 ? 100 : atoi(tmpstr.c_str());
+      }
+    }
     esp3d_log("Stream: %s", filename.c_str());
-    if (gcodeHostService.addStream(filename.c_str(), msg->authentication_level,
-                                   isMacro)) {
+    // start line is found with the index of the compiled job, the job is
+    // not compiled when the stream starts as it would stall the host task
+    bool has_job = true;
+    if (startLine != 0 || startPercent != 0) {
+      ESP3DGcodeJobHeader header;
+      has_job = false;
+      if (globalFs.accessFS(filename.c_str())) {
+        has_job = esp3d_gcode_job::getJob(filename.c_str(), &header);
+        globalFs.releaseFS(filename.c_str());
+      }
+    }
+    if (!has_job) {
+      hasError = true;
+      error_msg = "No compiled job, use [ESP703] first";
+      esp3d_log_e("No compiled job for %s", filename.c_str());
+    } else if (gcodeHostService.addStream(
+                   filename.c_str(), msg->authentication_level, isMacro,
+                   startLine, startPercent)) {
       esp3d_log("Stream: %s added as %s", filename.c_str(),
                 isMacro ? "Macro" : "File");
     } else {
@@ -0,0 +1,80 @@
+/*
+  esp3d_commands member
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#include "authentication/esp3d_authentication.h"
+#include "esp3d_client.h"
+#include "esp3d_commands.h"
+#include "esp3d_string.h"
+#include "filesystem/esp3d_globalfs.h"
+#include "gcode_host/esp3d_gcode_job.h"
+
+#define COMMAND_ID 703
+
+// Compile file to job so it is faster to stream
+//[ESP703]<filename> json=<no> pwd=<admin/user password>
+void ESP3DCommands::ESP703(int cmd_params_pos, ESP3DMessage* msg) {
+  ESP3DClientType target = msg->origin;
+  ESP3DRequest requestId = msg->request_id;
+  (void)requestId;
+  msg->target = target;
+  msg->origin = ESP3DClientType::command;
+  bool hasError = false;
+  std::string error_msg = "Invalid parameters";
+  std::string ok_msg = "ok";
+  bool json = hasTag(msg, cmd_params_pos, "json");
+  std::string filename;
+#if ESP3D_AUTHENTICATION_FEATURE
+  if (msg->authentication_level == ESP3DAuthenticationLevel::guest) {
+    dispatchAuthenticationError(msg, COMMAND_ID, json);
+    return;
+  }
+#endif  // ESP3D_AUTHENTICATION_FEATURE
+  filename = get_clean_param(msg, cmd_params_pos);
+  if (filename.length() == 0) {
+    hasError = true;
+    error_msg = "Missing parameter";
+    esp3d_log_e("Error missing");
+  } else if (!globalFs.accessFS(filename.c_str())) {
+    hasError = true;
+    error_msg = "Filesystem not available";
+    esp3d_log_e("Cannot access FS for %s", filename.c_str());
+  } else {
+    ESP3DGcodeJobHeader header;
+    if (!globalFs.exists(filename.c_str())) {
+      hasError = true;
+      error_msg = "File not found";
+    } else if (!esp3d_gcode_job::compile(filename.c_str()) ||
+               !esp3d_gcode_job::getJob(filename.c_str(), &header)) {
+      hasError = true;
+      error_msg = "Compilation failed";
+    } else if (json) {
+      ok_msg = "{\"lines\":\"" + std::to_string(header.source_lines) +
+               "\",\"commands\":\"" + std::to_string(header.commands_count) +
+               "\",\"size\":\"" + std::to_string(header.commands_size) + "\"}";
+    } else {
+      ok_msg = std::to_string(header.source_lines) + " lines, " +
+               std::to_string(header.commands_count) + " commands, " +
+               esp3d_string::formatBytes(header.commands_size);
+    }
+    globalFs.releaseFS(filename.c_str());
+  }
+  if (!dispatchAnswer(msg, COMMAND_ID, json, hasError,
+                      hasError ? error_msg.c_str() : ok_msg.c_str())) {
+    esp3d_log_e("Error sending response to clients");
+  }
+}
@@ -24,7 +24,9 @@
 
 #include <string>
 
+#include "esp3d_gcode_parser_service.h"
 #include "esp3d_log.h"
+#include "esp3d_message_pool.h"
 #include "esp_timer.h"
 
 #if ESP3D_TFT_LOG
@@ -38,9 +40,24 @@ ESP3DClient::ESP3DClient() {
   _tx_max_size = 1024;
   _rx_mutex = nullptr;
   _tx_mutex = nullptr;
+  _notify_task = NULL;
+}
+
+void ESP3DClient::_notifyData() {
+  if (_notify_task) {
+    xTaskNotifyGiveIndexed(_notify_task, ESP3D_CLIENT_NOTIFY_INDEX);
+  }
+}
+
+// Block calling task until one of the clients it is notified by got a
+// message, timeout in milliseconds is for housekeeping
+// return false on timeout
+bool ESP3DClient::waitForData(uint32_t timeout) {
+  return ulTaskNotifyTakeIndexed(ESP3D_CLIENT_NOTIFY_INDEX, pdTRUE,
+                                 pdMS_TO_TICKS(timeout)) > 0;
 }
 bool ESP3DClient::clearRxQueue() {
-  while (!_rx_queue.empty()) {
+  while (getRxMsgsCount() > 0) {
     deleteMsg(popRx());
   }
   _rx_size = 0;
@@ -49,7 +66,12 @@ bool ESP3DClient::clearRxQueue() {
 
 ESP3DMessage* ESP3DClient::popRx() {
   ESP3DMessage* msg = nullptr;
-  if (_rx_mutex) {
+  if (_rx_ring.started()) {
+    msg = _rx_ring.pop();
+    if (msg) {
+      __atomic_sub_fetch(&_rx_size, msg->size, __ATOMIC_RELAXED);
+    }
+  } else if (_rx_mutex) {
     if (pthread_mutex_lock(_rx_mutex) == 0) {
       msg = _rx_queue.front();
       _rx_size -= msg->size;
@@ -63,7 +85,12 @@ ESP3DMessage* ESP3DClient::popRx() {
 }
 ESP3DMessage* ESP3DClient::popTx() {
   ESP3DMessage* msg = nullptr;
-  if (_tx_mutex) {
+  if (_tx_ring.started()) {
+    msg = _tx_ring.pop();
+    if (msg) {
+      __atomic_sub_fetch(&_tx_size, msg->size, __ATOMIC_RELAXED);
+    }
+  } else if (_tx_mutex) {
     if (pthread_mutex_lock(_tx_mutex) == 0) {
       msg = _tx_queue.front();
       _tx_size -= msg->size;
@@ -80,14 +107,16 @@ void ESP3DClient::deleteMsg(ESP3DMessage* msg) {
   if (msg) {
     // esp3d_log("Deletion origin: %d, Target: %d, size: %d  : Now we have
     // %ld msg", msg->origin, msg->target, msg->size, --msg_counting);
-    free(msg->data);
-    free(msg);
+    if (!isInlineData(msg)) {
+      esp3d_message_pool::releaseData(msg->data);
+    }
+    esp3d_message_pool::freeMsg(msg);
     msg = nullptr;
   }
 }
 
 bool ESP3DClient::clearTxQueue() {
-  while (!_tx_queue.empty()) {
+  while (getTxMsgsCount() > 0) {
     deleteMsg(popTx());
   }
   // sanity check just in case
@@ -99,9 +128,18 @@ ESP3DClient::~ESP3DClient() {
   clearRxQueue();
 }
 
+// With a ring, only the producer adds to size, so the budget check is safe
+// without lock: the consumer can only decrease it meanwhile
 bool ESP3DClient::addRxData(ESP3DMessage* msg) {
   bool res = false;
-  if (_rx_mutex) {
+  if (_rx_ring.started()) {
+    if (msg->size + __atomic_load_n(&_rx_size, __ATOMIC_RELAXED) <=
+            _rx_max_size &&
+        _rx_ring.push(msg)) {
+      __atomic_add_fetch(&_rx_size, msg->size, __ATOMIC_RELAXED);
+      res = true;
+    }
+  } else if (_rx_mutex) {
     if (pthread_mutex_lock(_rx_mutex) == 0) {
       if (msg->size + _rx_size <= _rx_max_size) {
         _rx_queue.push_back(msg);
@@ -111,11 +149,23 @@ bool ESP3DClient::addRxData(ESP3DMessage* msg) {
       pthread_mutex_unlock(_rx_mutex);
     }
   }
+  if (res) {
+    _notifyData();
+  }
   return res;
 }
 bool ESP3DClient::addTxData(ESP3DMessage* msg) {
   bool res = false;
-  if (_tx_mutex) {
+  if (_tx_ring.started()) {
+    if (msg->size + __atomic_load_n(&_tx_size, __ATOMIC_RELAXED) <=
+            _tx_max_size &&
+        _tx_ring.push(msg)) {
+      __atomic_add_fetch(&_tx_size, msg->size, __ATOMIC_RELAXED);
+      res = true;
+    } else {
+      esp3d_log_e("Queue limit exceeded");
+    }
+  } else if (_tx_mutex) {
     if (pthread_mutex_lock(_tx_mutex) == 0) {
       if (msg->size + _tx_size <= _tx_max_size) {
         _tx_queue.push_back(msg);
@@ -130,11 +180,17 @@ bool ESP3DClient::addTxData(ESP3DMessage* msg) {
   } else {
     esp3d_log_e("no mutex available");
   }
+  if (res) {
+    _notifyData();
+  }
   return res;
 }
+// Not available with a ring: consumer side cannot be written by producer
 bool ESP3DClient::addFrontTxData(ESP3DMessage* msg) {
   bool res = false;
-  if (_tx_mutex) {
+  if (_tx_ring.started()) {
+    esp3d_log_e("No front insertion in tx ring");
+  } else if (_tx_mutex) {
     if (pthread_mutex_lock(_tx_mutex) == 0) {
       if (msg->size + _tx_size <= _tx_max_size) {
         _tx_queue.push_front(msg);
@@ -144,11 +200,14 @@ bool ESP3DClient::addFrontTxData(ESP3DMessage* msg) {
       pthread_mutex_unlock(_tx_mutex);
     }
   }
+  if (res) {
+    _notifyData();
+  }
   return res;
 }
 
 ESP3DMessage* ESP3DClient::newMsg() {
-  ESP3DMessage* newMsgPtr = (ESP3DMessage*)malloc(sizeof(ESP3DMessage));
+  ESP3DMessage* newMsgPtr = esp3d_message_pool::allocMsg();
   if (newMsgPtr) {
     // esp3d_log("Creation : Now we have %ld msg", ++msg_counting);
     newMsgPtr->data = nullptr;
@@ -158,6 +217,8 @@ ESP3DMessage* ESP3DClient::newMsg() {
     newMsgPtr->authentication_level = ESP3DAuthenticationLevel::guest;
     newMsgPtr->request_id.id = esp_timer_get_time();
     newMsgPtr->type = ESP3DMessageType::head;
+    newMsgPtr->data_type = ESP3DDataType::unknown;
+    newMsgPtr->data_value = 0;
   }
   return newMsgPtr;
 }
@@ -171,7 +232,8 @@ ESP3DMessage* ESP3DClient::newMsg(ESP3DRequest requestId) {
   return newMsgPtr;
 }
 
-bool ESP3DClient::copyMsgInfos(ESP3DMessage* newMsgPtr, ESP3DMessage msg) {
+bool ESP3DClient::copyMsgInfos(ESP3DMessage* newMsgPtr,
+                               const ESP3DMessage& msg) {
   if (!newMsgPtr) {
     return false;
   }
@@ -180,10 +242,12 @@ bool ESP3DClient::copyMsgInfos(ESP3DMessage* newMsgPtr, ESP3DMessage msg) {
   newMsgPtr->authentication_level = msg.authentication_level;
   newMsgPtr->request_id = msg.request_id;
   newMsgPtr->type = msg.type;
+  newMsgPtr->data_type = msg.data_type;
+  newMsgPtr->data_value = msg.data_value;
   return true;
 }
 
-ESP3DMessage* ESP3DClient::copyMsgInfos(ESP3DMessage msg) {
+ESP3DMessage* ESP3DClient::copyMsgInfos(const ESP3DMessage& msg) {
   ESP3DMessage* newMsgPtr = newMsg();
   if (newMsgPtr) {
     copyMsgInfos(newMsgPtr, msg);
@@ -191,12 +255,18 @@ ESP3DMessage* ESP3DClient::copyMsgInfos(ESP3DMessage msg) {
   return newMsgPtr;
 }
 
-ESP3DMessage* ESP3DClient::copyMsg(ESP3DMessage msg) {
-  ESP3DMessage* newMsgPtr = newMsg(msg.origin, msg.target, msg.data, msg.size,
-                                   msg.authentication_level);
+// The copy shares the payload of the original message, only the envelope
+// is allocated, an inline payload is small enough to be copied instead
+ESP3DMessage* ESP3DClient::copyMsg(const ESP3DMessage& msg) {
+  ESP3DMessage* newMsgPtr = copyMsgInfos(msg);
   if (newMsgPtr) {
-    newMsgPtr->request_id = msg.request_id;
-    newMsgPtr->type = msg.type;
+    if (isInlineData(&msg)) {
+      memcpy(newMsgPtr->inline_data, msg.inline_data, msg.size + 1);
+      newMsgPtr->data = newMsgPtr->inline_data;
+    } else {
+      newMsgPtr->data = esp3d_message_pool::retainData(msg.data);
+    }
+    newMsgPtr->size = msg.size;
   }
   return newMsgPtr;
 }
@@ -237,8 +307,15 @@ bool ESP3DClient::setDataContent(ESP3DMessage* msg, const uint8_t* data,
     return false;
   }
   if (msg->data) {
-    free(msg->data);
+    if (!isInlineData(msg)) {
+      esp3d_message_pool::releaseData(msg->data);
+    }
+    msg->data = nullptr;
+    msg->size = 0;
   }
+  // new content is not classified yet
+  msg->data_type = ESP3DDataType::unknown;
+  msg->data_value = 0;
 
   // this is centralize if a `\n` is missing at the end of the message, if a
   // client need another end it will handle on it's own
@@ -253,7 +330,12 @@ bool ESP3DClient::setDataContent(ESP3DMessage* msg, const uint8_t* data,
     }
   }
   // add some security in case data is called as string so add 1 byte for \0
-  msg->data = (uint8_t*)malloc(sizeof(uint8_t) * (allocation_needed));
+  if (allocation_needed <= ESP3D_MSG_INLINE_SIZE) {
+    msg->data = msg->inline_data;
+    esp3d_message_pool::countInlineData();
+  } else {
+    msg->data = esp3d_message_pool::allocData(allocation_needed);
+  }
   if (msg->data) {
     memcpy(msg->data, data, length);
     if (missing_endline) {
@@ -268,3 +350,11 @@ bool ESP3DClient::setDataContent(ESP3DMessage* msg, const uint8_t* data,
   esp3d_log_e("Out of memory");
   return false;
 }
+
+// Received lines are parsed once by the rx task, so gcode host, broadcast
+// and other consumers only check data_type and data_value
+void ESP3DClient::classifyMsg(ESP3DMessage* msg) {
+  msg->data_value = 0;
+  msg->data_type =
+      esp3dGcodeParser.getType((const char*)msg->data, &msg->data_value);
+}
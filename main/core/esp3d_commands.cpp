@@ -46,6 +46,7 @@
 #include <string>
 
 #include "esp3d_string.h"
+#include "esp_timer.h"
 #include "gcode_host/esp3d_gcode_host_service.h"
 
 #if ESP3D_TFT_LOG
@@ -83,7 +84,14 @@ ESP3DCommands::ESP3DCommands()
 #if ESP3D_TFT_LOG
     (void)esp3dclientstr;
 #endif  // ESP3D_TFT_LOG
-    _output_client = ESP3DClientType::stream;
+    _output_client        = ESP3DClientType::stream;
+    _realtime_count       = 0;
+    _realtime_max_latency = 0;
+    for (uint8_t i = 0; i < ESP3D_CLIENT_ROUTES_COUNT; i++)
+    {
+        unregisterClient(static_cast<ESP3DClientType>(i));
+    }
+    _registerClients();
 }  //_output_client = ESP3DClientType::serial; }
 ESP3DCommands::~ESP3DCommands() {}
 bool ESP3DCommands::is_esp_command(uint8_t *sbuf, size_t len)
@@ -556,7 +564,11 @@ bool ESP3DCommands::dispatch(ESP3DMessage *msg, uint8_t *sbuf, size_t len)
 
 bool ESP3DCommands::dispatch(ESP3DMessage *msg)
 {
-    bool sendOk = true;
+    if (!msg)
+    {
+        esp3d_log_e("no msg");
+        return false;
+    }
     esp3d_log("Dispatch message origin %d(%s) to client %d(%s) , size: %d,  type: "
               "%d(%s)",
               static_cast<uint8_t>(msg->origin),
@@ -566,306 +578,219 @@ bool ESP3DCommands::dispatch(ESP3DMessage *msg)
               msg->size,
               static_cast<uint8_t>(msg->type),
               GETMSGTYPESTR(msg->type));
-    if (!msg)
+    if (msg->target == ESP3DClientType::no_client)
     {
-        esp3d_log_e("no msg");
-        return false;
+        ESP3DClient::deleteMsg(msg);
+        esp3d_log("No client message");
+        return true;
+    }
+    if (msg->target == ESP3DClientType::all_clients)
+    {
+        return _broadcast(msg);
     }
     // currently only echo back no test done on success
     // TODO check add is successful
-    switch (msg->target)
+    uint8_t index = static_cast<uint8_t>(msg->target);
+    if (index < ESP3D_CLIENT_ROUTES_COUNT && _routes[index].process)
     {
-        case ESP3DClientType::no_client:
-            ESP3DClient::deleteMsg(msg);
-            esp3d_log("No client message");
-            break;
-#if ESP3D_HTTP_FEATURE
-        case ESP3DClientType::webui:
-            if (esp3dHttpService.started())
-            {
-                esp3dHttpService.process(msg);
-            }
-            else
-            {
-                sendOk = false;
-                esp3d_log_w("esp3dHttpService not started for message size  %d", msg->size);
-            }
-            break;
-        case ESP3DClientType::webui_websocket:
-            if (esp3dWsWebUiService.started())
-            {
-                esp3dWsWebUiService.process(msg);
-            }
-            else
-            {
-                sendOk = false;
-                esp3d_log_w("esp3dWsWebUiService not started for message size  %d", msg->size);
-            }
-            break;
-#if ESP3D_WS_SERVICE_FEATURE
-        case ESP3DClientType::websocket:
-            if (esp3dWsDataService.started())
-            {
-                esp3dWsDataService.process(msg);
-            }
-            else
-            {
-                sendOk = false;
-                esp3d_log_w("esp3dWsDataService not started for message size  %d", msg->size);
-            }
-            break;
-#endif  // ESP3D_WS_SERVICE_FEATURE
-#endif  // ESP3D_HTTP_FEATURE
-#if ESP3D_TELNET_FEATURE
-        case ESP3DClientType::telnet:
-            if (esp3dSocketServer.started())
-            {
-                esp3dSocketServer.process(msg);
-            }
-            else
-            {
-                sendOk = false;
-                esp3d_log_w("esp3dSocketServer not started for message size  %d", msg->size);
-            }
-            break;
-#endif  // ESP3D_TELNET_FEATURE
-
-        case ESP3DClientType::stream:
-            if (gcodeHostService.started())
-            {
-                gcodeHostService.process(msg);
-            }
-            else
-            {
-                sendOk = false;
-                esp3d_log_w("gcodeHostService not started for message size  %d", msg->size);
-            }
-            break;
+        if (_routes[index].started())
+        {
+            _routes[index].process(msg);
+            return true;
+        }
+        esp3d_log_w("Client %d(%s) not started for message size  %d",
+                    index,
+                    GETCLIENTSTR(msg->target),
+                    msg->size);
+    }
+    else
+    {
+        esp3d_log_e("No valid target specified %d", index);
+    }
+    esp3d_log_w("Send msg failed");
+    ESP3DClient::deleteMsg(msg);
+    return false;
+}
 
-#if ESP3D_DISPLAY_FEATURE
-        case ESP3DClientType::rendering:
-            if (renderingClient.started())
+// Message goes to every subscriber of its class except its origin, the
+// original message is sent to the last one and the others get a copy
+bool ESP3DCommands::_broadcast(ESP3DMessage *msg)
+{
+    uint8_t class_mask = 1 << static_cast<uint8_t>(getMessageClass(msg));
+    uint8_t origin     = static_cast<uint8_t>(msg->origin);
+    uint8_t last       = 0;
+    for (uint8_t i = 1; i < ESP3D_CLIENT_ROUTES_COUNT; i++)
+    {
+        ESP3DClientRoute &route = _routes[i];
+        if (i == origin || !(route.subscriptions & class_mask)
+            || !(route.connected ? route.connected() : route.started()))
+        {
+            continue;
+        }
+        if (last != 0)
+        {
+            // duplicate message because current is already pending
+            ESP3DMessage *copy_msg = ESP3DClient::copyMsg(*msg);
+            if (copy_msg)
             {
-                renderingClient.process(msg);
+                copy_msg->target = static_cast<ESP3DClientType>(last);
+                if (_routes[last].anonymous)
+                {
+                    copy_msg->request_id.id = 0;
+                }
+                dispatch(copy_msg);
             }
             else
             {
-                sendOk = false;
-                esp3d_log_w("rendering not started for message size  %d", msg->size);
+                esp3d_log_e("Cannot duplicate message for client %d", last);
             }
-            break;
-#endif  // ESP3D_DISPLAY_FEATURE
+        }
+        last = i;
+    }
+    if (last == 0)
+    {
+        esp3d_log("No subscriber for message");
+        ESP3DClient::deleteMsg(msg);
+        return false;
+    }
+    msg->target = static_cast<ESP3DClientType>(last);
+    if (_routes[last].anonymous)
+    {
+        msg->request_id.id = 0;
+    }
+    return dispatch(msg);
+}
 
-        case ESP3DClientType::serial:
-            esp3d_log("Serial client got message");
-            if (serialClient.started())
-            {
-                serialClient.process(msg);
-            }
-            else
-            {
-                sendOk = false;
-                esp3d_log_w("serialClient not started for message size  %d", msg->size);
-            }
-            break;
-#if ESP3D_USB_SERIAL_FEATURE
-        case ESP3DClientType::usb_serial:
-            esp3d_log("USB Serial client got message");
-            if (usbSerialClient.started())
-            {
-                esp3d_log("USB Serial process message");
-                usbSerialClient.process(msg);
-            }
-            else
-            {
-                sendOk = false;
-                esp3d_log_e("usbSerialClient not started for message size  %d", msg->size);
-            }
-            break;
-#endif  // #if ESP3D_USB_SERIAL_FEATURE
-#if ESP3D_BT_FEATURE
-        case ESP3DClientType::bt_serial:
-            esp3d_log("Bluetooth Serial client got message");
-            if (btSerialClient.started())
-            {
-                btSerialClient.process(msg);
-            }
-            else
-            {
-                sendOk = false;
-                esp3d_log_e("btSerialClient not started for message size  %d", msg->size);
-            }
-            break;
-        case ESP3DClientType::bt_ble:
-            esp3d_log("Bluetooth BLE client got message");
-            if (btBleClient.started())
-            {
-                btBleClient.process(msg);
-            }
-            else
-            {
-                sendOk = false;
-                esp3d_log_e("btBleClient not started for message size  %d", msg->size);
-            }
+// Class used to select subscribers of a broadcast message
+ESP3DMessageClass ESP3DCommands::getMessageClass(ESP3DMessage *msg)
+{
+    switch (msg->origin)
+    {
+        case ESP3DClientType::system:
+            return ESP3DMessageClass::system;
+        case ESP3DClientType::command:
+        case ESP3DClientType::no_client:
+            return ESP3DMessageClass::esp_response;
+        default:
             break;
-#endif  // ESP3D_BT_FEATURE
+    }
+    if (msg->origin != getOutputClient())
+    {
+        return ESP3DMessageClass::console;
+    }
+    // classified when received
+    switch (msg->data_type)
+    {
+        case ESP3DDataType::ack:
+            return ESP3DMessageClass::ack;
+        case ESP3DDataType::status:
+            return ESP3DMessageClass::status;
+        case ESP3DDataType::error:
+        case ESP3DDataType::resend:
+            return ESP3DMessageClass::error;
+        default:
+            return ESP3DMessageClass::console;
+    }
+}
 
-        case ESP3DClientType::all_clients:
-            // msg need to be duplicate for each target
-            // Do not broadcast system messages to printer output
-            // printer may receive unwhished messages
+void ESP3DCommands::registerClient(ESP3DClientType client, const ESP3DClientRoute &route)
+{
+    uint8_t index = static_cast<uint8_t>(client);
+    if (index == 0 || index >= ESP3D_CLIENT_ROUTES_COUNT || !route.started || !route.process)
+    {
+        esp3d_log_e("Invalid route for client %d", index);
+        return;
+    }
+    _routes[index] = route;
+}
 
-            if (msg->origin != ESP3DClientType::stream && msg->origin != ESP3DClientType::system)
-            {
-                if (msg->target == ESP3DClientType::all_clients)
-                {
-                    // become the reference message
-                    msg->target = ESP3DClientType::stream;
-                }
-                else
-                {
-                    // duplicate message because current is already pending
-                    ESP3DMessage *copy_msg =
-                        gcodeHostService.copyMsg(*msg);  // ESP3DClient::copyMsg(*msg);
-                    if (copy_msg)
-                    {
-                        copy_msg->target = ESP3DClientType::stream;
-                        dispatch(copy_msg);
-                    }
-                    else
-                    {
-                        esp3d_log_e("Cannot duplicate message for stream");
-                    }
-                }
-            }
+void ESP3DCommands::unregisterClient(ESP3DClientType client)
+{
+    uint8_t index = static_cast<uint8_t>(client);
+    if (index < ESP3D_CLIENT_ROUTES_COUNT)
+    {
+        _routes[index] = {nullptr, nullptr, nullptr, 0, false};
+    }
+}
 
+// Clients of this build, broadcast reaches them in ESP3DClientType order
+void ESP3DCommands::_registerClients()
+{
+    registerClient(ESP3DClientType::serial,
+                   {[]() { return serialClient.started(); },
+                    nullptr,
+                    [](ESP3DMessage *msg) { serialClient.process(msg); },
+                    0,
+                    false});
+#if ESP3D_USB_SERIAL_FEATURE
+    registerClient(ESP3DClientType::usb_serial,
+                   {[]() { return usbSerialClient.started(); },
+                    nullptr,
+                    [](ESP3DMessage *msg) { usbSerialClient.process(msg); },
+                    0,
+                    false});
+#endif  // ESP3D_USB_SERIAL_FEATURE
+    // Do not broadcast system messages to printer output
+    // printer may receive unwhished messages
+    registerClient(ESP3DClientType::stream,
+                   {[]() { return gcodeHostService.started(); },
+                    nullptr,
+                    [](ESP3DMessage *msg) { gcodeHostService.process(msg); },
+                    static_cast<uint8_t>(ESP3D_MSG_CLASSES_ALL & ~ESP3D_MSG_CLASS_MASK(system)),
+                    false});
+#if ESP3D_TELNET_FEATURE
+    registerClient(ESP3DClientType::telnet,
+                   {[]() { return esp3dSocketServer.started(); },
+                    []() { return esp3dSocketServer.isConnected(); },
+                    [](ESP3DMessage *msg) { esp3dSocketServer.process(msg); },
+                    ESP3D_MSG_CLASSES_ALL,
+                    true});
+#endif  // ESP3D_TELNET_FEATURE
 #if ESP3D_HTTP_FEATURE
-            // ESP3DClientType::webui_websocket
-            if (msg->origin != ESP3DClientType::webui_websocket
-                && esp3dWsWebUiService.isConnected())
-            {
-                if (msg->target == ESP3DClientType::all_clients)
-                {
-                    // become the reference message
-                    msg->target = ESP3DClientType::webui_websocket;
-                }
-                else
-                {
-                    // duplicate message because current is  already pending
-                    ESP3DMessage *copy_msg = ESP3DClient::copyMsg(*msg);
-                    if (copy_msg)
-                    {
-                        copy_msg->target = ESP3DClientType::webui_websocket;
-                        dispatch(copy_msg);
-                    }
-                    else
-                    {
-                        esp3d_log_e("Cannot duplicate message for Websocket");
-                    }
-                }
-            }
+    registerClient(ESP3DClientType::webui,
+                   {[]() { return esp3dHttpService.started(); },
+                    nullptr,
+                    [](ESP3DMessage *msg) { esp3dHttpService.process(msg); },
+                    0,
+                    false});
+    registerClient(ESP3DClientType::webui_websocket,
+                   {[]() { return esp3dWsWebUiService.started(); },
+                    []() { return esp3dWsWebUiService.isConnected(); },
+                    [](ESP3DMessage *msg) { esp3dWsWebUiService.process(msg); },
+                    ESP3D_MSG_CLASSES_ALL,
+                    false});
 #if ESP3D_WS_SERVICE_FEATURE
-            // ESP3DClientType::websocket
-            if (msg->origin != ESP3DClientType::websocket && esp3dWsDataService.isConnected())
-            {
-                msg->request_id.id = 0;
-                if (msg->target == ESP3DClientType::all_clients)
-                {
-                    // become the reference message
-                    msg->target = ESP3DClientType::websocket;
-                }
-                else
-                {
-                    // duplicate message because current is  already pending
-                    ESP3DMessage *copy_msg = ESP3DClient::copyMsg(*msg);
-                    if (copy_msg)
-                    {
-                        copy_msg->target = ESP3DClientType::websocket;
-                        dispatch(copy_msg);
-                    }
-                    else
-                    {
-                        esp3d_log_e("Cannot duplicate message for Websocket");
-                    }
-                }
-            }
+    registerClient(ESP3DClientType::websocket,
+                   {[]() { return esp3dWsDataService.started(); },
+                    []() { return esp3dWsDataService.isConnected(); },
+                    [](ESP3DMessage *msg) { esp3dWsDataService.process(msg); },
+                    ESP3D_MSG_CLASSES_ALL,
+                    true});
 #endif  // ESP3D_WS_SERVICE_FEATURE
-#endif  // #if ESP3D_HTTP_FEATURE
-#if ESP3D_TELNET_FEATURE
-            // ESP3DClientType::telnet
-            if (msg->origin != ESP3DClientType::telnet && esp3dSocketServer.isConnected())
-            {
-                msg->request_id.id = 0;
-                if (msg->target == ESP3DClientType::all_clients)
-                {
-                    // become the reference message
-                    msg->target = ESP3DClientType::telnet;
-                }
-                else
-                {
-                    // duplicate message because current is  already pending
-                    ESP3DMessage *copy_msg = ESP3DClient::copyMsg(*msg);
-                    if (copy_msg)
-                    {
-                        copy_msg->target = ESP3DClientType::telnet;
-                        dispatch(copy_msg);
-                    }
-                    else
-                    {
-                        esp3d_log_e("Cannot duplicate message for Websocket");
-                    }
-                }
-            }
-#endif  // ESP3D_TELNET_FEATURE
+#endif  // ESP3D_HTTP_FEATURE
 #if ESP3D_DISPLAY_FEATURE
-            // ESP3DClientType::rendering
-            if (msg->origin != ESP3DClientType::rendering && msg->origin != ESP3DClientType::command
-                && msg->origin != ESP3DClientType::no_client
-                && msg->origin != ESP3DClientType::system)
-            {
-                msg->request_id.id = 0;
-                if (msg->target == ESP3DClientType::all_clients)
-                {
-                    // become the reference message
-                    msg->target = ESP3DClientType::rendering;
-                }
-                else
-                {
-                    // duplicate message because current is  already pending
-                    ESP3DMessage *copy_msg = ESP3DClient::copyMsg(*msg);
-                    if (copy_msg)
-                    {
-                        copy_msg->target = ESP3DClientType::rendering;
-                        dispatch(copy_msg);
-                    }
-                    else
-                    {
-                        esp3d_log_e("Cannot duplicate message for Rendering");
-                    }
-                }
-            }
+    // Rendering does not get answers of ESP commands nor system messages
+    registerClient(ESP3DClientType::rendering,
+                   {[]() { return renderingClient.started(); },
+                    nullptr,
+                    [](ESP3DMessage *msg) { renderingClient.process(msg); },
+                    ESP3D_RENDERING_MSG_CLASSES,
+                    true});
 #endif  // ESP3D_DISPLAY_FEATURE
-        // Send pending if any or cancel message is no client did handle it
-            if (msg->target == ESP3DClientType::all_clients)
-            {
-                sendOk = false;
-            }
-            else
-            {
-                return dispatch(msg);
-            }
-            break;
-        default:
-            esp3d_log_e("No valid target specified %d", static_cast<uint8_t>(msg->target));
-            sendOk = false;
-    }
-    // clear message
-    if (!sendOk)
-    {
-        esp3d_log_w("Send msg failed");
-        ESP3DClient::deleteMsg(msg);
-    }
-    return sendOk;
+#if ESP3D_BT_FEATURE
+    registerClient(ESP3DClientType::bt_serial,
+                   {[]() { return btSerialClient.started(); },
+                    nullptr,
+                    [](ESP3DMessage *msg) { btSerialClient.process(msg); },
+                    0,
+                    false});
+    registerClient(ESP3DClientType::bt_ble,
+                   {[]() { return btBleClient.started(); },
+                    nullptr,
+                    [](ESP3DMessage *msg) { btBleClient.process(msg); },
+                    0,
+                    false});
+#endif  // ESP3D_BT_FEATURE
 }
 
 bool ESP3DCommands::hasTag(ESP3DMessage *msg, uint start, const char *label)
@@ -1259,6 +1184,9 @@ void ESP3DCommands::execute_internal_command(int cmd, int cmd_params_pos, ESP3DM
         case 420:
             ESP420(cmd_params_pos, msg);
             break;
+        case 421:
+            ESP421(cmd_params_pos, msg);
+            break;
         case 444:
             ESP444(cmd_params_pos, msg);
             break;
@@ -1301,6 +1229,9 @@ void ESP3DCommands::execute_internal_command(int cmd, int cmd_params_pos, ESP3DM
         case 702:
             ESP702(cmd_params_pos, msg);
             break;
+        case 703:
+            ESP703(cmd_params_pos, msg);
+            break;
         case 710:
             ESP710(cmd_params_pos, msg);
             break;
@@ -1384,6 +1315,91 @@ void ESP3DCommands::flush()
     serialClient.flush();
 }
 
+// Queue realtime command in front of pending data of a client without direct
+// access to its transmit path, the client task is notified by the queue and
+// writes it on its next loop, it is not flushed from the calling task
+static bool pushFrontRealTimeCommand(ESP3DClient *client, ESP3DClientType target, uint8_t cmd)
+{
+    ESP3DMessage *msg = ESP3DClient::newMsg(
+        ESP3DClientType::command, target, &cmd, 1, ESP3DAuthenticationLevel::admin);
+    if (!msg)
+    {
+        return false;
+    }
+    if (!client->addFrontTxData(msg))
+    {
+        ESP3DClient::deleteMsg(msg);
+        return false;
+    }
+    return true;
+}
+
+// Realtime counters are updated by every task which sends realtime commands
+static portMUX_TYPE _realtime_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Realtime lane: the byte is written to the output client right now, ahead of
+// any queued data, without new line and without going through the streams
+// On serial it is not always immediate: uart_tx_chars() takes the driver tx
+// lock, which uart_write_bytes() holds while it copies a line to the FIFO, and
+// with no TX ring buffer it holds it until the line is in the FIFO. The wait is
+// then up to (line length - FIFO size) byte times, about 11 ms for a 256 bytes
+// line at 115200 bauds, and the byte is sent after the FIFO content, 11 ms
+// more. The worst case measured here includes the wait for the lock.
+bool ESP3DCommands::dispatchRealTimeCommand(uint8_t cmd)
+{
+    int64_t start_time = esp_timer_get_time();
+    bool res           = false;
+    switch (getOutputClient())
+    {
+#if ESP3D_USB_SERIAL_FEATURE
+        case ESP3DClientType::usb_serial:
+            if (usbSerialClient.started())
+            {
+                res = pushFrontRealTimeCommand(&usbSerialClient, ESP3DClientType::usb_serial, cmd);
+            }
+            break;
+#endif  // #if ESP3D_USB_SERIAL_FEATURE
+#if ESP3D_BT_FEATURE
+        case ESP3DClientType::bt_serial:
+            if (btSerialClient.started())
+            {
+                res = pushFrontRealTimeCommand(&btSerialClient, ESP3DClientType::bt_serial, cmd);
+            }
+            break;
+        case ESP3DClientType::bt_ble:
+            if (btBleClient.started())
+            {
+                res = pushFrontRealTimeCommand(&btBleClient, ESP3DClientType::bt_ble, cmd);
+            }
+            break;
+#endif  // ESP3D_BT_FEATURE
+        default:
+            if (serialClient.started())
+            {
+                res = serialClient.sendRealTimeCommand(cmd);
+            }
+            break;
+    }
+    if (!res)
+    {
+        esp3d_log_e("Failed to send realtime command 0x%02X", cmd);
+        return false;
+    }
+    if (cmd == ESP3D_SOFT_RESET_COMMAND)
+    {
+        gcodeHostService.resetSentLines();
+    }
+    uint32_t latency = (uint32_t)(esp_timer_get_time() - start_time);
+    portENTER_CRITICAL(&_realtime_lock);
+    _realtime_count++;
+    if (latency > _realtime_max_latency)
+    {
+        _realtime_max_latency = latency;
+    }
+    portEXIT_CRITICAL(&_realtime_lock);
+    return true;
+}
+
 bool isRealTimeCommand(char *cmd, size_t len)
 {
     return false;
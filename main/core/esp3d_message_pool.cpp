@@ -0,0 +1,253 @@
+/*
+  esp3d_message_pool
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "esp3d_message_pool.h"
+
+#include <stdlib.h>
+
+#include "esp3d_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+
+// A pool is a block array with a free list linked inside the free blocks
+// Blocks never used are taken in order, so a zero initialized pool is ready
+// to use, even by constructors of other global objects
+struct ESP3DPoolArea {
+  uint8_t *base;
+  size_t block_size;
+  uint16_t count;
+  uint16_t next_unused;
+  void *free_head;
+  uint16_t used;
+  uint16_t high_water;
+  uint32_t fallbacks;
+};
+
+static ESP3DMessage _msg_blocks[ESP3D_MSG_POOL_COUNT];
+static uint8_t _medium_blocks[ESP3D_MSG_SLAB_MEDIUM_COUNT]
+                             [ESP3D_MSG_SLAB_MEDIUM_SIZE] __attribute__((
+                                 aligned(4)));
+static uint8_t _large_blocks[ESP3D_MSG_SLAB_LARGE_COUNT]
+                            [ESP3D_MSG_SLAB_LARGE_SIZE] __attribute__((
+                                aligned(4)));
+
+static ESP3DPoolArea _msg_pool = {(uint8_t *)_msg_blocks,
+                                  sizeof(ESP3DMessage),
+                                  ESP3D_MSG_POOL_COUNT,
+                                  0,
+                                  nullptr,
+                                  0,
+                                  0,
+                                  0};
+// sorted by block size
+static ESP3DPoolArea _slabs[ESP3D_MSG_SLAB_CLASSES] = {
+    {(uint8_t *)_medium_blocks, ESP3D_MSG_SLAB_MEDIUM_SIZE,
+     ESP3D_MSG_SLAB_MEDIUM_COUNT, 0, nullptr, 0, 0, 0},
+    {(uint8_t *)_large_blocks, ESP3D_MSG_SLAB_LARGE_SIZE,
+     ESP3D_MSG_SLAB_LARGE_COUNT, 0, nullptr, 0, 0, 0},
+};
+static uint32_t _oversized_count = 0;
+static uint32_t _shared_count = 0;
+static uint32_t _inline_count = 0;
+static uint32_t _data_alloc_count = 0;
+static int64_t _stats_start = 0;
+
+// Payload is shared by all copies of a message, the references counter is
+// stored just before the data, last release gives the block back
+struct ESP3DPayloadHeader {
+  uint32_t refs;
+};
+#define getPayloadHeader(data) \
+  ((ESP3DPayloadHeader *)((data) - sizeof(ESP3DPayloadHeader)))
+
+// pools are used by all tasks, but only for few instructions
+static portMUX_TYPE _pool_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static void *esp3d_pool_alloc(ESP3DPoolArea *area) {
+  void *block = nullptr;
+  portENTER_CRITICAL(&_pool_lock);
+  if (area->free_head) {
+    block = area->free_head;
+    area->free_head = *(void **)block;
+  } else if (area->next_unused < area->count) {
+    block = area->base + area->block_size * area->next_unused;
+    area->next_unused++;
+  }
+  if (block) {
+    area->used++;
+    if (area->used > area->high_water) {
+      area->high_water = area->used;
+    }
+  } else {
+    area->fallbacks++;
+  }
+  portEXIT_CRITICAL(&_pool_lock);
+  return block;
+}
+
+// return false if block does not belong to the pool
+static bool esp3d_pool_free(ESP3DPoolArea *area, void *block) {
+  if ((uint8_t *)block < area->base ||
+      (uint8_t *)block >= area->base + area->block_size * area->count) {
+    return false;
+  }
+  portENTER_CRITICAL(&_pool_lock);
+  *(void **)block = area->free_head;
+  area->free_head = block;
+  area->used--;
+  portEXIT_CRITICAL(&_pool_lock);
+  return true;
+}
+
+static void esp3d_pool_stats(const ESP3DPoolArea *area,
+                             ESP3DMessagePoolStats *stats) {
+  portENTER_CRITICAL(&_pool_lock);
+  stats->block_size = area->block_size;
+  stats->count = area->count;
+  stats->used = area->used;
+  stats->high_water = area->high_water;
+  stats->fallbacks = area->fallbacks;
+  portEXIT_CRITICAL(&_pool_lock);
+}
+
+namespace esp3d_message_pool {
+
+ESP3DMessage *allocMsg() {
+  ESP3DMessage *msg = (ESP3DMessage *)esp3d_pool_alloc(&_msg_pool);
+  if (!msg) {
+    msg = (ESP3DMessage *)malloc(sizeof(ESP3DMessage));
+  }
+  return msg;
+}
+
+void freeMsg(ESP3DMessage *msg) {
+  if (msg && !esp3d_pool_free(&_msg_pool, msg)) {
+    free(msg);
+  }
+}
+
+// size is the full size needed, including any 0x0 terminator
+// the block also holds the references counter
+uint8_t *allocData(size_t size) {
+  size_t block_size = size + sizeof(ESP3DPayloadHeader);
+  uint8_t *block = nullptr;
+  uint8_t i = 0;
+  for (; i < ESP3D_MSG_SLAB_CLASSES; i++) {
+    if (block_size <= _slabs[i].block_size) {
+      block = (uint8_t *)esp3d_pool_alloc(&_slabs[i]);
+      if (!block) {
+        esp3d_log("Slab of %d bytes is full", (int)_slabs[i].block_size);
+      }
+      break;
+    }
+  }
+  portENTER_CRITICAL(&_pool_lock);
+  _data_alloc_count++;
+  if (i == ESP3D_MSG_SLAB_CLASSES) {
+    _oversized_count++;
+  }
+  portEXIT_CRITICAL(&_pool_lock);
+  if (!block) {
+    block = (uint8_t *)malloc(block_size);
+    if (!block) {
+      return nullptr;
+    }
+  }
+  ((ESP3DPayloadHeader *)block)->refs = 1;
+  return block + sizeof(ESP3DPayloadHeader);
+}
+
+// data is now used by one more message, so it must not be modified anymore
+uint8_t *retainData(uint8_t *data) {
+  if (data) {
+    __atomic_add_fetch(&getPayloadHeader(data)->refs, 1, __ATOMIC_RELAXED);
+    portENTER_CRITICAL(&_pool_lock);
+    _shared_count++;
+    portEXIT_CRITICAL(&_pool_lock);
+  }
+  return data;
+}
+
+void releaseData(uint8_t *data) {
+  if (!data) {
+    return;
+  }
+  ESP3DPayloadHeader *block = getPayloadHeader(data);
+  if (__atomic_sub_fetch(&block->refs, 1, __ATOMIC_ACQ_REL) != 0) {
+    return;
+  }
+  for (uint8_t i = 0; i < ESP3D_MSG_SLAB_CLASSES; i++) {
+    if (esp3d_pool_free(&_slabs[i], block)) {
+      return;
+    }
+  }
+  free(block);
+}
+
+void getMsgStats(ESP3DMessagePoolStats *stats) {
+  esp3d_pool_stats(&_msg_pool, stats);
+}
+
+bool getSlabStats(uint8_t index, ESP3DMessagePoolStats *stats) {
+  if (index >= ESP3D_MSG_SLAB_CLASSES) {
+    return false;
+  }
+  esp3d_pool_stats(&_slabs[index], stats);
+  return true;
+}
+
+uint32_t getOversizedCount() { return _oversized_count; }
+
+uint32_t getSharedCount() { return _shared_count; }
+
+// payload stored in the message itself, no block used
+void countInlineData() {
+  portENTER_CRITICAL(&_pool_lock);
+  _inline_count++;
+  portEXIT_CRITICAL(&_pool_lock);
+}
+
+uint32_t getInlineCount() { return _inline_count; }
+
+uint32_t getDataAllocCount() { return _data_alloc_count; }
+
+// milliseconds since last reset, to get rates of counters
+uint32_t getStatsDuration() {
+  return (uint32_t)((esp_timer_get_time() - _stats_start) / 1000);
+}
+
+// high water marks restart from current usage
+void resetStats() {
+  portENTER_CRITICAL(&_pool_lock);
+  _msg_pool.high_water = _msg_pool.used;
+  _msg_pool.fallbacks = 0;
+  for (uint8_t i = 0; i < ESP3D_MSG_SLAB_CLASSES; i++) {
+    _slabs[i].high_water = _slabs[i].used;
+    _slabs[i].fallbacks = 0;
+  }
+  _oversized_count = 0;
+  _shared_count = 0;
+  _inline_count = 0;
+  _data_alloc_count = 0;
+  _stats_start = esp_timer_get_time();
+  portEXIT_CRITICAL(&_pool_lock);
+}
+
+}  // namespace esp3d_message_pool
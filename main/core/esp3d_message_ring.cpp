@@ -0,0 +1,90 @@
+/*
+  esp3d_message_ring
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "esp3d_message_ring.h"
+
+#include <stdlib.h>
+
+#include "esp3d_log.h"
+
+ESP3DMessageRing::ESP3DMessageRing() {
+  _slots = nullptr;
+  _mask = 0;
+  _head = 0;
+  _tail = 0;
+}
+
+ESP3DMessageRing::~ESP3DMessageRing() { end(); }
+
+bool ESP3DMessageRing::begin(size_t capacity) {
+  end();
+  size_t size = 2;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  _slots = (ESP3DMessage **)calloc(size, sizeof(ESP3DMessage *));
+  if (!_slots) {
+    esp3d_log_e("Failed to allocate ring of %d messages", (int)size);
+    return false;
+  }
+  _mask = size - 1;
+  _head = 0;
+  _tail = 0;
+  return true;
+}
+
+// Queue must be empty, messages left are not deleted
+void ESP3DMessageRing::end() {
+  if (_slots) {
+    free(_slots);
+    _slots = nullptr;
+  }
+  _mask = 0;
+  _head = 0;
+  _tail = 0;
+}
+
+bool ESP3DMessageRing::push(ESP3DMessage *msg) {
+  size_t head = _head;
+  // acquire: slot is really free once consumer published its new tail
+  if (head - __atomic_load_n(&_tail, __ATOMIC_ACQUIRE) > _mask) {
+    return false;
+  }
+  _slots[head & _mask] = msg;
+  // release: slot content is visible before the new head
+  __atomic_store_n(&_head, head + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+ESP3DMessage *ESP3DMessageRing::pop() {
+  size_t tail = _tail;
+  if (tail == __atomic_load_n(&_head, __ATOMIC_ACQUIRE)) {
+    return nullptr;
+  }
+  ESP3DMessage *msg = _slots[tail & _mask];
+  __atomic_store_n(&_tail, tail + 1, __ATOMIC_RELEASE);
+  return msg;
+}
+
+// Can be called by any task, tail is read first so result never underflows
+size_t ESP3DMessageRing::count() {
+  size_t tail = __atomic_load_n(&_tail, __ATOMIC_ACQUIRE);
+  return __atomic_load_n(&_head, __ATOMIC_ACQUIRE) - tail;
+}
@@ -46,6 +46,7 @@
 
 #include "authentication/esp3d_authentication.h"
 #include "board_init.h"
+#include "gcode_host/esp3d_gcode_host_types.h"
 
 #define STORAGE_NAME    "ESP3D_TFT"
 #define SETTING_VERSION "ESP3D_TFT-V1.0.0"
@@ -140,6 +141,8 @@ static const char *esp3d_setting_names[] = {"esp3d_version",
 #endif
                                             // Note: esp3d_target_settings_list.inc devra être géré
                                             // séparément
+                                            "esp3d_streaming_mode",
+                                            "esp3d_job_compile",
                                             "unknown_index"};
 
 // Fonction utilitaire pour obtenir le nom d'un setting
@@ -332,6 +335,8 @@ const ESP3DSettingDescription ESP3DSettingsData[] = {
 #if ESP3D_BUZZER_FEATURE
     {ESP3DSettingIndex::esp3d_buzzer_on, ESP3DSettingType::byte_t, 1, "1"},
 #endif  // ESP3D_BUZZER_FEATURE
+    {ESP3DSettingIndex::esp3d_streaming_mode, ESP3DSettingType::byte_t, 1, "0"},
+    {ESP3DSettingIndex::esp3d_job_compile, ESP3DSettingType::byte_t, 1, "0"},
 
 };
 
@@ -616,6 +621,7 @@ bool ESP3DSettings::isValidByteSetting(uint8_t value, ESP3DSettingIndex settingE
 #if ESP3D_BUZZER_FEATURE
         case ESP3DSettingIndex::esp3d_buzzer_on:
 #endif  // ESP3D_BUZZER_FEATURE
+        case ESP3DSettingIndex::esp3d_job_compile:
             if (value == (uint8_t)ESP3DState::off || value == (uint8_t)ESP3DState::on)
             {
                 return true;
@@ -731,6 +737,13 @@ bool ESP3DSettings::isValidByteSetting(uint8_t value, ESP3DSettingIndex settingE
 #endif  // SD_INTERFACE_TYPE == 0
 #endif  // ESP3D_SD_CARD_FEATURE
 
+        case ESP3DSettingIndex::esp3d_streaming_mode:
+            if (value == (uint8_t)ESP3DGcodeHostStreamingMode::send_response
+                || value == (uint8_t)ESP3DGcodeHostStreamingMode::character_counting)
+            {
+                return true;
+            }
+            break;
         case ESP3DSettingIndex::esp3d_target_firmware:
             if (static_cast<ESP3DTargetFirmware>(value) == ESP3DTargetFirmware::unknown
                 || static_cast<ESP3DTargetFirmware>(value) == ESP3DTargetFirmware::grbl
@@ -28,7 +28,21 @@
 #include <deque>
 
 #include "authentication/esp3d_authentication_types.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "esp3d_client_types.h"
+#include "esp3d_data_type.h"
+#include "esp3d_message_ring.h"
+
+// Messages slots of rx ring, bytes are still limited by rx max size
+#define ESP3D_CLIENT_RX_RING_SIZE 128
+// Task notification used to wake up a task when a message is queued
+#define ESP3D_CLIENT_NOTIFY_INDEX 0
+// Payloads up to this size, 0x0 terminator included, are stored in the
+// message itself: acks, status reports and jog commands need no allocation
+#ifndef ESP3D_MSG_INLINE_SIZE
+#define ESP3D_MSG_INLINE_SIZE 48
+#endif  // ESP3D_MSG_INLINE_SIZE
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,14 +57,31 @@ union ESP3DRequest {
 
 enum class ESP3DMessageType : uint8_t { head, core, tail, unique };
 
+// Classes of broadcast messages, clients subscribe to them with a bit mask
+enum class ESP3DMessageClass : uint8_t {
+  ack = 0,           // controller acknowledge
+  status = 1,        // controller status report
+  error = 2,         // controller error or resend request
+  console = 3,       // other controller output and remote clients commands
+  esp_response = 4,  // answers of ESP commands
+  system = 5,        // internal notifications
+};
+
+#define ESP3D_MSG_CLASS_MASK(msg_class) \
+  (1 << static_cast<uint8_t>(ESP3DMessageClass::msg_class))
+#define ESP3D_MSG_CLASSES_ALL 0xFF
+
 struct ESP3DMessage {
-  uint8_t *data;
+  uint8_t *data;  // shared by copies of the message, so read only
   size_t size;
   ESP3DClientType origin;
   ESP3DClientType target;
   ESP3DAuthenticationLevel authentication_level;
   ESP3DRequest request_id;
   ESP3DMessageType type;
+  ESP3DDataType data_type;  // controller output type, set once when received
+  uint32_t data_value;      // error code or line to resend
+  uint8_t inline_data[ESP3D_MSG_INLINE_SIZE];  // data points here if it fits
 };
 
 class ESP3DClient {
@@ -73,11 +104,23 @@ class ESP3DClient {
   void setTxMutex(pthread_mutex_t *mutex) { _tx_mutex = mutex; };
   bool clearRxQueue();
   bool clearTxQueue();
-  size_t getRxMsgsCount() { return _rx_queue.size(); }
-  size_t getTxMsgsCount() { return _tx_queue.size(); }
-  static ESP3DMessage *copyMsg(ESP3DMessage msg);
-  static ESP3DMessage *copyMsgInfos(ESP3DMessage msg);
-  static bool copyMsgInfos(ESP3DMessage *newMsgPtr, ESP3DMessage msg);
+  size_t getRxMsgsCount() {
+    return _rx_ring.started() ? _rx_ring.count() : _rx_queue.size();
+  }
+  size_t getTxMsgsCount() {
+    return _tx_ring.started() ? _tx_ring.count() : _tx_queue.size();
+  }
+  // Use lock free ring instead of mutex and deque, only if queue has one
+  // producer task and one consumer task
+  bool setRxRing(size_t capacity) { return _rx_ring.begin(capacity); }
+  bool setTxRing(size_t capacity) { return _tx_ring.begin(capacity); }
+  // Task woken up when a message is added to rx or tx queue, several clients
+  // can wake up same task which sleeps in waitForData()
+  void setNotifyTask(TaskHandle_t task) { _notify_task = task; }
+  static bool waitForData(uint32_t timeout);
+  static ESP3DMessage *copyMsg(const ESP3DMessage &msg);
+  static ESP3DMessage *copyMsgInfos(const ESP3DMessage &msg);
+  static bool copyMsgInfos(ESP3DMessage *newMsgPtr, const ESP3DMessage &msg);
   static ESP3DMessage *newMsg();
   static ESP3DMessage *newMsg(ESP3DRequest requestId);
   static ESP3DMessage *newMsg(ESP3DClientType origin, ESP3DClientType target,
@@ -89,16 +132,24 @@ class ESP3DClient {
                                   ESP3DAuthenticationLevel::guest);
   static bool setDataContent(ESP3DMessage *msg, const uint8_t *data,
                              size_t length);
+  static void classifyMsg(ESP3DMessage *msg);
+  static bool isInlineData(const ESP3DMessage *msg) {
+    return msg->data == msg->inline_data;
+  }
 
  private:
   std::deque<ESP3DMessage *> _rx_queue;
   std::deque<ESP3DMessage *> _tx_queue;
+  ESP3DMessageRing _rx_ring;
+  ESP3DMessageRing _tx_ring;
   size_t _rx_size;
   size_t _tx_size;
   size_t _rx_max_size;
   size_t _tx_max_size;
   pthread_mutex_t *_rx_mutex;
   pthread_mutex_t *_tx_mutex;
+  TaskHandle_t _notify_task;
+  void _notifyData();
 };
 
 #ifdef __cplusplus
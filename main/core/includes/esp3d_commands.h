@@ -27,10 +27,22 @@
 #include "esp3d_settings.h"
 #include "board_config.h"
 
+#define ESP3D_CLIENT_ROUTES_COUNT \
+  static_cast<uint8_t>(ESP3DClientType::all_clients)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// How messages reach a client, routes are indexed by ESP3DClientType
+struct ESP3DClientRoute {
+  bool (*started)();     // client can process a message
+  bool (*connected)();   // someone gets broadcast, nullptr if same as started
+  void (*process)(ESP3DMessage* msg);
+  uint8_t subscriptions;  // ESP3DMessageClass bits wanted on broadcast
+  bool anonymous;         // broadcast copies do not keep request id
+};
+
 class ESP3DCommands {
  public:
   ESP3DCommands();
@@ -137,6 +149,7 @@ void ESP290(int cmd_params_pos, ESP3DMessage* msg);
   void ESP410(int cmd_params_pos, ESP3DMessage* msg);
 #endif  // ESP3D_WIFI_FEATURE  || ESP3D_BT_FEATURE
   void ESP420(int cmd_params_pos, ESP3DMessage* msg);
+  void ESP421(int cmd_params_pos, ESP3DMessage* msg);
   void ESP444(int cmd_params_pos, ESP3DMessage* msg);
 #if ESP3D_MDNS_FEATURE
   void ESP450(int cmd_params_pos, ESP3DMessage* msg);
@@ -155,6 +168,7 @@ void ESP290(int cmd_params_pos, ESP3DMessage* msg);
   void ESP700(int cmd_params_pos, ESP3DMessage* msg);
   void ESP701(int cmd_params_pos, ESP3DMessage* msg);
   void ESP702(int cmd_params_pos, ESP3DMessage* msg);
+  void ESP703(int cmd_params_pos, ESP3DMessage* msg);
   void ESP710(int cmd_params_pos, ESP3DMessage* msg);
   void ESP720(int cmd_params_pos, ESP3DMessage* msg);
   void ESP730(int cmd_params_pos, ESP3DMessage* msg);
@@ -191,9 +205,20 @@ void ESP290(int cmd_params_pos, ESP3DMessage* msg);
   void setOutputClient(ESP3DClientType output_client) {
     _output_client = output_client;
   }
+  bool dispatchRealTimeCommand(uint8_t cmd);
+  uint32_t getRealTimeCount() { return _realtime_count; }
+  uint32_t getRealTimeMaxLatency() { return _realtime_max_latency; }
+  void registerClient(ESP3DClientType client, const ESP3DClientRoute& route);
+  void unregisterClient(ESP3DClientType client);
+  ESP3DMessageClass getMessageClass(ESP3DMessage* msg);
 
  private:
+  ESP3DClientRoute _routes[ESP3D_CLIENT_ROUTES_COUNT];
+  void _registerClients();
+  bool _broadcast(ESP3DMessage* msg);
   ESP3DClientType _output_client;
+  uint32_t _realtime_count;
+  uint32_t _realtime_max_latency;  // microseconds
 };
 
 extern ESP3DCommands esp3dCommands;
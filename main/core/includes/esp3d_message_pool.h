@@ -0,0 +1,74 @@
+/*
+  esp3d_message_pool
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+
+#include "esp3d_client.h"
+
+// Messages and their payloads are taken from fixed size blocks allocated
+// once, so the heap is not fragmented by the serial / ack / status traffic
+// Heap is only used when a pool is exhausted or data is bigger than the
+// largest slab
+// Payloads are reference counted, so copies of a message for several clients
+// share the same data, which is read only once shared
+// Small payloads are inline in the message (ESP3D_MSG_INLINE_SIZE), so slabs
+// only start above it
+// Slab sizes include the 4 bytes of references counter
+#define ESP3D_MSG_POOL_COUNT 48
+#define ESP3D_MSG_SLAB_MEDIUM_SIZE 128
+#define ESP3D_MSG_SLAB_MEDIUM_COUNT 16
+#define ESP3D_MSG_SLAB_LARGE_SIZE 512
+#define ESP3D_MSG_SLAB_LARGE_COUNT 6
+#define ESP3D_MSG_SLAB_CLASSES 2
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct ESP3DMessagePoolStats {
+  size_t block_size = 0;
+  uint16_t count = 0;       // blocks in pool
+  uint16_t used = 0;        // blocks currently in use
+  uint16_t high_water = 0;  // max blocks in use since last reset
+  uint32_t fallbacks = 0;   // allocations done on heap because pool was full
+};
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+namespace esp3d_message_pool {
+ESP3DMessage *allocMsg();
+void freeMsg(ESP3DMessage *msg);
+uint8_t *allocData(size_t size);
+uint8_t *retainData(uint8_t *data);
+void releaseData(uint8_t *data);
+void getMsgStats(ESP3DMessagePoolStats *stats);
+bool getSlabStats(uint8_t index, ESP3DMessagePoolStats *stats);
+uint32_t getOversizedCount();
+uint32_t getSharedCount();
+void countInlineData();
+uint32_t getInlineCount();
+uint32_t getDataAllocCount();
+uint32_t getStatsDuration();
+void resetStats();
+}  // namespace esp3d_message_pool
@@ -0,0 +1,62 @@
+/*
+  esp3d_message_ring
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+
+#ifndef ESP3D_CACHE_LINE_SIZE
+#define ESP3D_CACHE_LINE_SIZE 32
+#endif  // ESP3D_CACHE_LINE_SIZE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct ESP3DMessage;
+
+// Bounded lock free queue of messages for one producer task and one consumer
+// task: push() must only be called by the producer, pop() only by the
+// consumer. Slots are allocated once in begin(), capacity is rounded up to a
+// power of 2
+// head is only written by producer and tail only by consumer, each on its own
+// cache line
+class ESP3DMessageRing final {
+ public:
+  ESP3DMessageRing();
+  ~ESP3DMessageRing();
+  bool begin(size_t capacity);
+  void end();
+  bool started() { return _slots != nullptr; }
+  bool push(ESP3DMessage *msg);
+  ESP3DMessage *pop();
+  size_t count();
+  size_t capacity() { return _mask + 1; }
+
+ private:
+  ESP3DMessage **_slots;
+  size_t _mask;
+  alignas(ESP3D_CACHE_LINE_SIZE) size_t _head;  // next slot to write
+  alignas(ESP3D_CACHE_LINE_SIZE) size_t _tail;  // next slot to read
+};
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
@@ -146,6 +146,10 @@ enum class ESP3DSettingIndex : uint16_t
 #endif //ESP3D_BRIGHTNESS_CONTROL_FEATURE
 
 #include "esp3d_target_settings_list.inc"
+    // settings are stored under their index, new ones go here so stored
+    // values of previous ones keep their keys
+    esp3d_streaming_mode,
+    esp3d_job_compile,
     unknown_index
 };
 
@@ -24,14 +24,19 @@
 #include "esp3d_string.h"
 
 void ESP3DValues::initialize_system() {
-
-
+  // machine state, from real time status report
+  _values.push_back({
+      ESP3DValuesIndex::state,
+      ESP3DValuesType::string_t,
+      10,  // size
+      std::string("?"),
+      nullptr,
+  });
   /*
-  state,
 job_status,
 file_name,
 job_duration,
 job_progress,
   */
-  return ;
+  return;
 }
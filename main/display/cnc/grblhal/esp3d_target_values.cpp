@@ -22,19 +22,34 @@
 #include "esp3d_log.h"
 #include "esp3d_string.h"
 
-void ESP3DValues::initialize_target(){
-  /*  
-  m_position_a,
-  m_position_b,
-  m_position_c,
-  w_position_x,
-  w_position_y,
-  w_position_z,
-  w_position_a,
-  w_position_b,
-  w_position_c,
+void ESP3DValues::initialize_target() {
+  // values of real time status report, set when they change
+  //  x machine position
+  _values.push_back({
+      ESP3DValuesIndex::m_position_x,
+      ESP3DValuesType::float_t,
+      4,  // precision
+      std::string("?"),
+      nullptr,
+  });
 
+  //  y machine position
+  _values.push_back({
+      ESP3DValuesIndex::m_position_y,
+      ESP3DValuesType::float_t,
+      4,  // precision
+      std::string("?"),
+      nullptr,
+  });
 
+  //  z machine position
+  _values.push_back({
+      ESP3DValuesIndex::m_position_z,
+      ESP3DValuesType::float_t,
+      4,  // precision
+      std::string("?"),
+      nullptr,
+  });
 
   //  a machine position
   _values.push_back({
@@ -55,7 +70,6 @@ void ESP3DValues::initialize_target(){
   });
 
   //  c machine position
-
   _values.push_back({
       ESP3DValuesIndex::m_position_c,
       ESP3DValuesType::float_t,
@@ -118,12 +132,66 @@ void ESP3DValues::initialize_target(){
       nullptr,
   });
 
-   // state
-  _values.push_back({ESP3DValuesIndex::state, ESP3DValuesType::string_t,
-                     10,  // precision
-                     std::string("idle"),
-                     mainScreen::state_value_cb});
+  //  feed rate
+  _values.push_back({
+      ESP3DValuesIndex::feed_rate,
+      ESP3DValuesType::float_t,
+      1,  // precision
+      std::string("0"),
+      nullptr,
+  });
 
-*/
-    return ;
-}
\ No newline at end of file
+  //  spindle speed
+  _values.push_back({
+      ESP3DValuesIndex::spindle_speed,
+      ESP3DValuesType::float_t,
+      0,  // precision
+      std::string("0"),
+      nullptr,
+  });
+
+  //  feed override
+  _values.push_back({
+      ESP3DValuesIndex::feed_override,
+      ESP3DValuesType::integer_t,
+      0,  // precision
+      std::string("100"),
+      nullptr,
+  });
+
+  //  rapid override
+  _values.push_back({
+      ESP3DValuesIndex::rapid_override,
+      ESP3DValuesType::integer_t,
+      0,  // precision
+      std::string("100"),
+      nullptr,
+  });
+
+  //  spindle override
+  _values.push_back({
+      ESP3DValuesIndex::spindle_override,
+      ESP3DValuesType::integer_t,
+      0,  // precision
+      std::string("100"),
+      nullptr,
+  });
+
+  //  triggered pins, as Pn: letters
+  _values.push_back({
+      ESP3DValuesIndex::pins_state,
+      ESP3DValuesType::string_t,
+      17,  // size
+      std::string(""),
+      nullptr,
+  });
+
+  //  spindle and coolant state, as A: letters
+  _values.push_back({
+      ESP3DValuesIndex::accessories_state,
+      ESP3DValuesType::string_t,
+      5,  // size
+      std::string(""),
+      nullptr,
+  });
+}
@@ -31,8 +31,10 @@
 #include "control_event.h"
 #include "disp_backlight.h"
 #include "esp3d_hal.h"
+#include "esp3d_jog_engine.h"
 #include "esp3d_log.h"
 #include "esp3d_lvgl.h"
+#include "esp3d_override_engine.h"
 #include "esp3d_string.h"
 #include "esp3d_styles.h"
 #include "esp3d_tft_ui.h"
@@ -79,6 +81,8 @@ bool is_locked = false;  // Global variable to track lock state
   static lv_obj_t *connection_status_img = nullptr;  // Image for connection status
   static firmware_state_t current_firmware_state = FIRMWARE_IDLE;  // Current firmware state
     static bool is_connection_ok = false;  // Status of the connection
+// Encoder drives the jog engine instead of the menu
+static bool is_jog_mode = false;
 
 // Configuration structures
 
@@ -158,6 +162,7 @@ static circular_menu_data_t menu_data = {.screen               = nullptr,
 
 static void section_press_cb(int32_t section_id);
 static void bottom_button_press_cb(int32_t button_idx);
+static void bottom_button_override_press_cb(int32_t button_idx);
 static void bottom_button_lock_press_cb(int32_t button_idx);
 
 // Structure for the main menu sections
@@ -176,6 +181,7 @@ static menu_section_conf_t main_menu_sections[] = {
 };
 
 #define ESP3D_MAIN_MENU_INITIAL_SECTION_ID 0
+#define ESP3D_MAIN_MENU_JOG_SECTION_ID 3
 
 // Configuration for the bottom buttons
 // This structure defines the bottom buttons of the main menu
@@ -184,7 +190,7 @@ static circular_menu_conf_t menu_conf =
     {.num_sections   = 9,
      .sections       = main_menu_sections,
      .bottom_buttons = {
-         {MENU_ITEM_IMAGE, {.img_path = &ok_b}, bottom_button_press_cb},           // Button 0
+         {MENU_ITEM_IMAGE, {.img_path = &ok_b}, bottom_button_override_press_cb},  // Button 0
                                                                                    // visible
          {MENU_ITEM_IMAGE, {.img_path = &unlock_b}, bottom_button_lock_press_cb},  // Button 1
                                                                                    // visible
@@ -288,10 +294,30 @@ static void update_icon_styles(void)
 // Function to update center text
 static void update_center_text(void)
 {
+    if (menu_data.center_label && is_jog_mode)
+    {
+        // selected axis and distance per encoder detent
+        char step[16];
+        lv_label_set_text_fmt(menu_data.center_label,
+                              "Jog %c\n%s mm",
+                              esp3dJogEngine.getAxisLetter(),
+                              esp3d_machine_state::formatValue(esp3dJogEngine.getStep(),
+                                                               3,
+                                                               step,
+                                                               sizeof(step)));
+        lv_obj_center(menu_data.center_label);
+        return;
+    }
     if (menu_data.center_label && menu_data.conf.sections)
     {
+        // section name and what the potentiometer overrides
         const char *text = menu_data.conf.sections[menu_data.current_section].center_text.c_str();
-        lv_label_set_text(menu_data.center_label, text ? text : "");
+        lv_label_set_text_fmt(menu_data.center_label,
+                              "%s\n%s override",
+                              text ? text : "",
+                              esp3dOverrideEngine.getTarget() == ESP3DOverrideTarget::feed
+                                  ? "Feed"
+                                  : "Spindle");
         lv_obj_center(menu_data.center_label);
     }
 }
@@ -368,6 +394,12 @@ static void obj_delete_cb(lv_event_t *e)
     esp3d_log("Object deleted: %p", obj);
     if (obj == menu_data.screen)
     {
+        if (is_jog_mode)
+        {
+            esp3dJogEngine.setEnabled(false);
+            is_jog_mode = false;
+        }
+        esp3dOverrideEngine.setEnabled(false);
         if (menu_data.click_zones)
         {
             free(menu_data.click_zones);
@@ -470,24 +502,17 @@ static void encoder_event_cb(lv_event_t *e)
         {
             int32_t steps = event->steps;
             esp3d_log("Encoder steps received: %ld", steps);
-            // Normalize steps to prevent large jumps
-            if (steps > 1)
-                steps = 1;
-            if (steps < -1)
-                steps = -1;
-
-            int32_t prev_section = menu_data.current_section;
-            (void)prev_section;  // Suppress unused variable warning
-            // Update current_section with explicit wrapping
-            menu_data.current_section += steps;
-            if (menu_data.current_section < 0)
-            {
-                menu_data.current_section = menu_data.conf.num_sections - 1;  // Go to last section
-            }
-            else if (menu_data.current_section >= menu_data.conf.num_sections)
+            // jog engine gets detents from input task directly
+            if (is_jog_mode)
             {
-                menu_data.current_section = 0;  // Go to first section
+                return;
             }
+            int32_t prev_section = menu_data.current_section;
+            (void)prev_section;  // Suppress unused variable warning
+            // One event holds all detents turned since previous one, so
+            // wrap around as many sections
+            int32_t count             = (int32_t)menu_data.conf.num_sections;
+            menu_data.current_section = (menu_data.current_section + steps % count + count) % count;
 
             esp3d_log("Encoder: steps=%ld, prev_section=%ld, new_section=%ld",
                         steps,
@@ -506,6 +531,25 @@ static void encoder_event_cb(lv_event_t *e)
     }
 }
 
+// Callback for the 4 positions switch, it selects the jog axis
+static void switch_event_cb(lv_event_t *e)
+{
+    control_event_t *event = (control_event_t *)lv_event_get_param(e);
+    if (!event || event->family_id != CONTROL_FAMILY_SWITCH)
+    {
+        return;
+    }
+    if (lv_event_get_code(e) == LV_EVENT_PRESSED)
+    {
+        esp3d_log("Switch position %ld selected", event->btn_id);
+        esp3dJogEngine.setAxis(event->btn_id);
+        if (is_jog_mode)
+        {
+            update_center_text();
+        }
+    }
+}
+
 // Callback for click areas
 static void click_zone_event_cb(lv_event_t *e)
 {
@@ -641,12 +685,31 @@ static void bottom_button_event_cb(lv_event_t *e)
 static void section_press_cb(int32_t section_id)
 {
     esp3d_log("Menu section %ld pressed", section_id);
+    if (section_id == ESP3D_MAIN_MENU_JOG_SECTION_ID)
+    {
+        // first press enters jog mode, next ones change the step
+        if (is_jog_mode)
+        {
+            esp3dJogEngine.setStepIndex((esp3dJogEngine.getStepIndex() + 1)
+                                        % ESP3D_JOG_STEPS_COUNT);
+        }
+        is_jog_mode = true;
+    }
+    else if (is_jog_mode)
+    {
+        is_jog_mode = false;
+    }
+    esp3dJogEngine.setEnabled(is_jog_mode && !is_locked);
+    update_center_text();
 }
 
 static void bottom_button_lock_press_cb(int32_t button_idx)
 {
     esp3d_log("Bottom button %ld pressed", button_idx);
     is_locked = !is_locked;  // Toggle lock state
+    esp3dJogEngine.stop();
+    esp3dJogEngine.setEnabled(is_jog_mode && !is_locked);
+    esp3dOverrideEngine.setEnabled(!is_locked);
     if (is_locked)
     {
         esp3d_log("Lock button %ld pressed, lock UI", button_idx);
@@ -673,6 +736,20 @@ static void bottom_button_press_cb(int32_t button_idx)
     esp3d_log("Bottom button %ld pressed", button_idx);
 }
 
+// Potentiometer sets feed or spindle override, the button swaps them
+static void bottom_button_override_press_cb(int32_t button_idx)
+{
+    esp3d_log("Bottom button %ld pressed", button_idx);
+    if (is_locked)
+    {
+        return;
+    }
+    esp3dOverrideEngine.setTarget(esp3dOverrideEngine.getTarget() == ESP3DOverrideTarget::feed
+                                      ? ESP3DOverrideTarget::spindle
+                                      : ESP3DOverrideTarget::feed);
+    update_center_text();
+}
+
 void create()
 {
     esp3dTftui.set_current_screen(ESP3DScreenType::none);
@@ -1033,6 +1110,9 @@ void create()
     lv_obj_add_event_cb(menu_data.screen, encoder_event_cb, LV_EVENT_KEY, NULL);
     lv_obj_add_event_cb(menu_data.screen, button_event_cb, LV_EVENT_PRESSED, NULL);
     lv_obj_add_event_cb(menu_data.screen, button_event_cb, LV_EVENT_RELEASED, NULL);
+    lv_obj_add_event_cb(menu_data.screen, switch_event_cb, LV_EVENT_PRESSED, NULL);
+    // potentiometer sets feed override while main screen is unlocked
+    esp3dOverrideEngine.setEnabled(!is_locked);
 
 #pragma GCC diagnostic pop
     // Create the main menu
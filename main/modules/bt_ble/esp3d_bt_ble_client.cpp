@@ -297,13 +297,14 @@ bool ESP3DBTBleClient::pushMsgToRxQueue(const uint8_t* msg, size_t size) {
     if (ESP3DClient::setDataContent(newMsgPtr, msg, size)) {
       newMsgPtr->origin = ESP3DClientType::bt_ble;
       newMsgPtr->type = ESP3DMessageType::unique;
+      ESP3DClient::classifyMsg(newMsgPtr);
       if (!addRxData(newMsgPtr)) {
         ESP3DClient::deleteMsg(newMsgPtr);
         esp3d_log_e("Failed to add message to rx queue");
         return false;
       }
     } else {
-      free(newMsgPtr);
+      ESP3DClient::deleteMsg(newMsgPtr);
       esp3d_log_e("Message creation failed");
       return false;
     }
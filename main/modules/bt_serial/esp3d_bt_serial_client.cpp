@@ -939,6 +939,7 @@ bool ESP3DBTSerialClient::pushMsgToRxQueue(const uint8_t *msg, size_t size)
             esp3d_log_d("Pushing message to RX queue, size: %s", (const char *)newMsgPtr->data);
             newMsgPtr->origin = ESP3DClientType::bt_serial;
             newMsgPtr->type   = ESP3DMessageType::unique;
+            ESP3DClient::classifyMsg(newMsgPtr);
             if (!addRxData(newMsgPtr))
             {
                 ESP3DClient::deleteMsg(newMsgPtr);
@@ -948,7 +949,7 @@ bool ESP3DBTSerialClient::pushMsgToRxQueue(const uint8_t *msg, size_t size)
         }
         else
         {
-            free(newMsgPtr);
+            ESP3DClient::deleteMsg(newMsgPtr);
             esp3d_log_e("Message creation failed");
             return false;
         }
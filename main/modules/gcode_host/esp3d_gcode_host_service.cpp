@@ -20,6 +20,7 @@
 #include "esp3d_gcode_host_service.h"
 
 #include <stdio.h>
+#include <string.h>
 
 #include "serial/esp3d_serial_client.h"
 #if ESP3D_USB_SERIAL_FEATURE
@@ -42,7 +43,9 @@
 #endif  // ESP3D_SD_CARD_FEATURE
 
 #include "esp32/rom/crc.h"
+#include "esp3d_gcode_job.h"
 #include "esp3d_gcode_parser_service.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "tasks_def.h"
@@ -56,10 +59,30 @@ ESP3DGCodeHostService gcodeHostService;
 // Macro definitions
 
 #define RX_FLUSH_TIME_OUT 1500  // milliseconds timeout
-#define MAX_COMMAND_LENGTH 255
+#define MAX_COMMAND_LENGTH ESP3D_GCODE_MAX_LINE_LENGTH
 #define ESP3D_COMMAND_TIMEOUT 10000  // milliseconds timeout
 #define ESP3D_MAX_RETRY 5
 #define ESP3D_REFRESH_INTERVAL 1000  // milliseconds
+// max time without event, only needed for timeouts and progress refresh
+#define ESP3D_HOUSEKEEPING_INTERVAL 100  // milliseconds
+// Bf: of an older status report is not used for credits, in ms
+#define ESP3D_BF_REPORT_MAX_AGE 500
+// max state transitions per wake up before giving hand to other tasks
+#define ESP3D_MAX_STEPS_PER_WAKEUP 100
+
+// In place esp3d_gcode_job::trimLine, so string keeps its capacity, then
+// (...) comments are removed
+static void esp3d_trim_string(std::string* str) {
+  const char* line = str->c_str();
+  size_t length = str->length();
+  esp3d_gcode_job::trimLine(&line, &length);
+  size_t offset = line - str->c_str();
+  str->erase(offset + length);
+  str->erase(0, offset);
+  if (str->find('(') != std::string::npos) {
+    str->resize(esp3d_gcode_job::stripParenComments(&(*str)[0], str->length()));
+  }
+}
 
 #define isFileStreamType(type)                      \
   ((type == ESP3DGcodeHostStreamType::fs_stream) || \
@@ -83,9 +106,9 @@ static void esp3d_gcode_host_task(void* pvParameter) {
   gcodeHostService.updateScripts();
   esp3d_hal::wait(100);
   while (1) {
-    /* Delay */
-    gcodeHostService.handle(); 
-    esp3d_hal::wait(10);
+    gcodeHostService.handle();
+    /* Sleep until next event */
+    gcodeHostService.waitForEvent();
   }
   vTaskDelete(NULL);
 }
@@ -139,6 +162,155 @@ void ESP3DGCodeHostService::updateScripts() {
       ESP3DSettingIndex::esp3d_pause_script, buffer, SIZE_OF_SCRIPT);
 }
 
+// Update streaming protocol from settings
+// lines already in flight are still released by their ack whatever the mode
+void ESP3DGCodeHostService::updateStreamingMode() {
+  uint8_t mode =
+      esp3dTftsettings.readByte(ESP3DSettingIndex::esp3d_streaming_mode);
+  if (mode == static_cast<uint8_t>(
+                  ESP3DGcodeHostStreamingMode::character_counting)) {
+    _streaming_mode = ESP3DGcodeHostStreamingMode::character_counting;
+  } else {
+    _streaming_mode = ESP3DGcodeHostStreamingMode::send_response;
+  }
+  esp3d_log("Streaming mode: %s",
+            ESP3DGcodeHostStreamingModeStr[static_cast<uint8_t>(
+                _streaming_mode)]);
+}
+
+// Size of the controller RX buffer, as reported by firmware if any
+size_t ESP3DGCodeHostService::getRxBufferSize() {
+  size_t size = esp3dGcodeParser.getRxBufferSize();
+  return size != 0 ? size : ESP3D_RX_BUFFER_SIZE;
+}
+
+// Average time in microseconds between an ack and the next line written
+uint32_t ESP3DGCodeHostService::getLineLatencyAvg() {
+  if (_stats_latency_count == 0) {
+    return 0;
+  }
+  return (uint32_t)(_stats_latency_sum / _stats_latency_count);
+}
+
+// Wake up the task to process a new event, queued messages do it already
+void ESP3DGCodeHostService::_notify() {
+  if (_xHandle) {
+    xTaskNotifyGiveIndexed(_xHandle, ESP3D_CLIENT_NOTIFY_INDEX);
+  }
+}
+
+// Block the task until a message, a stream or a notification arrives
+// the timeout is only for housekeeping (ack timeout, progress refresh)
+void ESP3DGCodeHostService::waitForEvent() {
+  if (_has_pending_steps) {
+    // steps budget exhausted, let lower priority tasks run for one tick
+    vTaskDelay(1);
+    return;
+  }
+  waitForData(ESP3D_HOUSEKEEPING_INTERVAL);
+}
+
+// Average of acked lines per second for the current or last main stream
+uint32_t ESP3DGCodeHostService::getLinesPerSecond() {
+  if (_stats_start_time == 0) {
+    return 0;
+  }
+  uint64_t end_time =
+      _stats_end_time != 0 ? _stats_end_time : esp3d_hal::millis();
+  if (end_time <= _stats_start_time) {
+    return 0;
+  }
+  return (uint32_t)((_stats_acked_lines * 1000) /
+                    (end_time - _stats_start_time));
+}
+
+// A line can be sent if it fits in the free part of the controller RX buffer
+// an empty buffer always accepts a line, even a too long one
+bool ESP3DGCodeHostService::_hasRxBufferRoom(size_t length) {
+  if (_sent_lines_length.empty()) {
+    return true;
+  }
+  if ((_bytes_in_flight + length) > getRxBufferSize()) {
+    return false;
+  }
+  return _hasBfRoom(length);
+}
+
+// Bf: is what the controller really has free, including bytes written by
+// other clients, so it can only lower the credits of character counting
+// Bytes sent since the last report are not counted by it yet, and bytes
+// acked since were freed after it
+bool ESP3DGCodeHostService::_hasBfRoom(size_t length) {
+  uint32_t count = esp3dGcodeParser.getBufferReportCount();
+  if (count != _bf_report_count) {
+    _bf_report_count = count;
+    _bf_bytes_sent = 0;
+    _bf_bytes_acked = 0;
+  }
+  // no recent status report, character counting only
+  uint32_t age =
+      (uint32_t)esp3d_hal::millis() - esp3dGcodeParser.getBufferReportTime();
+  if (count == 0 || age > ESP3D_BF_REPORT_MAX_AGE) {
+    return true;
+  }
+  if ((_bf_bytes_sent + length) <=
+      esp3dGcodeParser.getRxBytesFree() + _bf_bytes_acked) {
+    return true;
+  }
+  _bf_limited = true;
+  return false;
+}
+
+void ESP3DGCodeHostService::_pushSentLine(size_t length) {
+  _sent_lines_length.push_back((uint16_t)length);
+  _bytes_in_flight += length;
+  _bf_bytes_sent += length;
+  esp3d_log("Bytes in flight: %d/%d", _bytes_in_flight, getRxBufferSize());
+}
+
+// Release the oldest sent line, return false if no line was in flight
+bool ESP3DGCodeHostService::_popSentLine() {
+  if (_sent_lines_length.empty()) {
+    return false;
+  }
+  size_t length = _sent_lines_length.front();
+  _sent_lines_length.pop_front();
+  _bytes_in_flight =
+      (_bytes_in_flight > length) ? (_bytes_in_flight - length) : 0;
+  _bf_bytes_acked += length;
+  return true;
+}
+
+void ESP3DGCodeHostService::_clearSentLines() {
+  _sent_lines_length.clear();
+  _bytes_in_flight = 0;
+  _acked_lines = _written_lines;
+}
+
+// acks of lines written by other clients are not counted
+void ESP3DGCodeHostService::_countAckedLine() {
+  if (_acked_lines != _written_lines) {
+    _acked_lines = _acked_lines + 1;
+  }
+}
+
+// No ack received in time, the controller is considered as lost
+void ESP3DGCodeHostService::_handle_ack_timeout() {
+  _error = ESP3DGcodeHostError::time_out;
+  _clearSentLines();
+  _setStreamState(ESP3DGcodeStreamState::error);
+  if (!_connection_lost) {
+#if ESP3D_HAS_STATUS_BAR
+    std::string text =
+        esp3dTranslationService.translate(ESP3DLabel::communication_lost);
+
+    esp3dTftValues.set_string_value(ESP3DValuesIndex::status_bar_label,
+                                    text.c_str());
+#endif  // ESP3D_HAS_STATUS_BAR
+  }
+  _connection_lost = true;
+}
+
 // Create a new stream from a command msg
 bool ESP3DGCodeHostService::addStream(
     const char* command, size_t length,
@@ -182,7 +354,8 @@ bool ESP3DGCodeHostService::hasStreamListCommand(const char* command) {
 // Add stream from ESP700 command
 bool ESP3DGCodeHostService::addStream(const char* filename,
                                       ESP3DAuthenticationLevel auth_type,
-                                      bool executeAsMacro) {
+                                      bool executeAsMacro, uint32_t startLine,
+                                      uint8_t startPercent) {
   esp3d_log("Add stream: %s", filename);
   ESP3DGcodeHostStreamType type = _getStreamType(filename);
   //  ESP700 only accepts file names, not commands
@@ -192,12 +365,14 @@ bool ESP3DGCodeHostService::addStream(const char* filename,
                 ESP3DGcodeHostStreamTypeStr[static_cast<uint8_t>(type)]);
     return false;
   }
-  return _add_stream(filename, auth_type, executeAsMacro);
+  return _add_stream(filename, auth_type, executeAsMacro, startLine,
+                     startPercent);
 }
 
 bool ESP3DGCodeHostService::_add_stream(const char* data,
                                         ESP3DAuthenticationLevel auth_type,
-                                        bool executeFirst) {
+                                        bool executeFirst, uint32_t startLine,
+                                        uint8_t startPercent) {
   esp3d_log("Processing stream request: %s, with authentication level=%d", data,
             static_cast<uint8_t>(auth_type));
   // Macro should be executed first like any other command
@@ -246,6 +421,9 @@ bool ESP3DGCodeHostService::_add_stream(const char* data,
   new_stream->processedSize = 0;
   new_stream->totalSize = 0;
   new_stream->active = false;
+  new_stream->compiled = false;
+  new_stream->startLine = startLine;
+  new_stream->startPercent = startPercent;
   new_stream->state = ESP3DGcodeStreamState::start;
   new_stream->dataStream = (char*)malloc(strlen(data) + 1);
   if (new_stream->dataStream == nullptr) {
@@ -291,6 +469,7 @@ bool ESP3DGCodeHostService::_pushBackGCodeStream(ESP3DGcodeStream* stream,
         uint size_after = _streams.size();
         if (size_after == size + 1) {
           esp3d_log("Stream added nb=%d", size_after);
+          _notify();
         } else {
           esp3d_log_e("Failed to add stream");
           res = false;
@@ -316,6 +495,7 @@ bool ESP3DGCodeHostService::_pushBackGCodeStream(ESP3DGcodeStream* stream,
         uint size_after = _scripts.size();
         if (size_after == size + 1) {
           esp3d_log("Script added nb=%d", size_after);
+          _notify();
         } else {
           esp3d_log_e("Failed to add script");
           res = false;
@@ -378,20 +558,25 @@ bool ESP3DGCodeHostService::_popFrontGCodeStream(bool is_stream) {
 }
 
 bool ESP3DGCodeHostService::abort() {
-  xTaskNotifyGive(_xHandle);
   xTaskNotifyGiveIndexed(_xHandle, _xAbortNotifyIndex);
+  _notify();
   return true;
 }
 
+void ESP3DGCodeHostService::resetSentLines() {
+  _reset_sent_lines = true;
+  _notify();
+}
+
 bool ESP3DGCodeHostService::pause() {
-  xTaskNotifyGive(_xHandle);
   xTaskNotifyGiveIndexed(_xHandle, _xPauseNotifyIndex);
+  _notify();
   return true;
 }
 
 bool ESP3DGCodeHostService::resume() {
-  xTaskNotifyGive(_xHandle);
   xTaskNotifyGiveIndexed(_xHandle, _xResumeNotifyIndex);
+  _notify();
   return true;
 }
 
@@ -402,42 +587,95 @@ bool ESP3DGCodeHostService::resume() {
 /// @return True if file opened successfully.
 bool ESP3DGCodeHostService::_openFile(ESP3DGcodeStream* stream) {
   esp3d_log("File name is %s", stream->dataStream);
-  _file_buffer_length = 0;
+  _line_scanner.reset();
   if (globalFs.accessFS(stream->dataStream)) {
     if (globalFs.exists(stream->dataStream)) {
       esp3d_log("File exists");
-      _file_handle = globalFs.open(stream->dataStream, "r");
+      // compiled job is used if up to date, this is decided once per stream
+      // as the cursor position depends on it
+      ESP3DGcodeJobHeader job_header;
+      bool has_job = esp3d_gcode_job::getJob(stream->dataStream, &job_header);
+      if (stream->totalSize == 0 &&
+          (stream->startLine != 0 || stream->startPercent != 0)) {
+        if (!_seekFile(stream, &job_header, has_job)) {
+          globalFs.releaseFS(stream->dataStream);
+          return false;
+        }
+        has_job = true;
+      }
+      if (stream->totalSize == 0) {
+        stream->compiled = has_job;
+        if (has_job) {
+          esp3d_log("Use compiled job");
+          if (job_header.commands_size == 0) {
+            esp3d_log_e("Compiled job is empty");
+            _error = ESP3DGcodeHostError::empty_file;
+            globalFs.releaseFS(stream->dataStream);
+            return false;
+          }
+          stream->totalSize = job_header.commands_size;
+        }
+      } else if (stream->compiled && !has_job) {
+        esp3d_log_e("Compiled job is no more valid: %s", stream->dataStream);
+        _error = ESP3DGcodeHostError::file_system;
+        globalFs.releaseFS(stream->dataStream);
+        return false;
+      }
+      std::string file_path = stream->compiled
+                                  ? esp3d_gcode_job::jobPath(stream->dataStream)
+                                  : stream->dataStream;
+      uint64_t file_offset = stream->cursorPos;
+      if (stream->compiled) {
+        file_offset += job_header.header_size;
+      }
+      // get file size if not set, before the file is opened and read ahead
+      if (stream->totalSize == 0) {
+        struct stat file_stat;
+        if (globalFs.stat(stream->dataStream, &file_stat) == -1) {
+          esp3d_log_e("Failed to get file size");
+          _error = ESP3DGcodeHostError::file_system;
+          globalFs.releaseFS(stream->dataStream);
+          return false;
+        }
+        if (file_stat.st_size > 0) {
+          stream->totalSize = file_stat.st_size;
+        } else {
+          esp3d_log_e("File size is 0");
+          _error = ESP3DGcodeHostError::empty_file;
+          globalFs.releaseFS(stream->dataStream);
+          return false;
+        }
+      }
+      _file_handle = globalFs.open(file_path.c_str(), "r");
       if (_file_handle != nullptr) {
-        if (_current_stream_ptr->cursorPos != 0) {
-          if (fseek(_file_handle, (long)stream->cursorPos,
+        if (file_offset != 0) {
+          if (fseek(_file_handle, (long)file_offset,
                     SEEK_SET) !=
               0) {  // this would need adjusting if concurrrent file access is
                     // implemented (seek to buffer end instead)
             esp3d_log_e("Failed to seek to correct position in file: %s",
                         stream->dataStream);
             _error = ESP3DGcodeHostError::cursor_out_of_range;
+            _prefetcher.stop();
+            globalFs.close(_file_handle, stream->dataStream);
+            _file_handle = nullptr;
             globalFs.releaseFS(stream->dataStream);
             return false;
           }
         }
         esp3d_log("File opened");
-        // get file size if not set
-        if (stream->totalSize == 0) {
-          struct stat file_stat;
-          if (globalFs.stat(stream->dataStream, &file_stat) == -1) {
-            esp3d_log_e("Failed to get file size");
-            _error = ESP3DGcodeHostError::file_system;
-            globalFs.releaseFS(stream->dataStream);
-            return false;
-          }
-          if (file_stat.st_size > 0) {
-            stream->totalSize = file_stat.st_size;
-          } else {
-            esp3d_log_e("File size is 0");
-            _error = ESP3DGcodeHostError::empty_file;
-            globalFs.releaseFS(stream->dataStream);
-            return false;
-          }
+        // read ahead from the current position, job index is not read
+        if (!_prefetcher.start(_file_handle,
+                               stream->compiled
+                                   ? job_header.commands_size - stream->cursorPos
+                                   : UINT64_MAX)) {
+          esp3d_log_e("Failed to start file prefetch");
+          _error = ESP3DGcodeHostError::file_system;
+          _prefetcher.stop();
+          globalFs.close(_file_handle, stream->dataStream);
+          _file_handle = nullptr;
+          globalFs.releaseFS(stream->dataStream);
+          return false;
         }
         _error = ESP3DGcodeHostError::no_error;
         return true;
@@ -459,6 +697,46 @@ bool ESP3DGCodeHostService::_openFile(ESP3DGcodeStream* stream) {
   return false;
 }
 
+/// @brief Sets the cursor of a file stream to its start line, using the
+/// compiled job index.
+/// The job is not compiled here: it reads the whole file and would stall
+/// the host task, so it must be done first with [ESP703].
+/// The modal state before the line is saved to be sent first.
+/// @param stream Pointer to the file stream, FS must be accessed.
+/// @param job_header Pointer to header of the job.
+/// @param has_job True if job header is valid.
+/// @return True if cursor is set.
+bool ESP3DGCodeHostService::_seekFile(ESP3DGcodeStream* stream,
+                                      const ESP3DGcodeJobHeader* job_header,
+                                      bool has_job) {
+  if (!has_job) {
+    esp3d_log_e("No compiled job for %s, use [ESP703] first",
+                stream->dataStream);
+    _error = ESP3DGcodeHostError::job_not_compiled;
+    return false;
+  }
+  uint32_t line = stream->startLine;
+  if (line == 0) {
+    line = esp3d_gcode_job::getPercentLine(job_header, stream->startPercent);
+  }
+  uint32_t offset = 0;
+  ESP3DGcodeModalState modal_state;
+  if (!esp3d_gcode_job::seek(stream->dataStream, job_header, line, &offset,
+                             &modal_state)) {
+    _error = ESP3DGcodeHostError::cursor_out_of_range;
+    return false;
+  }
+  if (!esp3d_gcode_job::canRestoreModalState(&modal_state)) {
+    esp3d_log_e("Arc mode before line %ld cannot be restored", line);
+    _error = ESP3DGcodeHostError::cursor_out_of_range;
+    return false;
+  }
+  esp3d_log("Start %s from line %ld at %ld", stream->dataStream, line, offset);
+  stream->cursorPos = offset;
+  _modal_state_command = esp3d_gcode_job::getModalStateCommand(&modal_state);
+  return true;
+}
+
 /// @brief Closes the File assosciated with the provided file stream.
 /// @param stream Pointer to the file stream to be closed.
 /// @return True if file closed and FS released successfully.
@@ -468,9 +746,11 @@ bool ESP3DGCodeHostService::_closeFile(ESP3DGcodeStream* stream) {
     return false;
   }
   esp3d_log("Closing File: %s", stream->dataStream);
+  // be sure the file is no more read by prefetch task
+  _prefetcher.stop();
   globalFs.close((_file_handle), stream->dataStream);
   _file_handle = nullptr;
-  _file_buffer_length = 0;
+  _line_scanner.reset();
   globalFs.releaseFS(stream->dataStream);
   return true;
 }
@@ -480,7 +760,7 @@ bool ESP3DGCodeHostService::_closeFile(ESP3DGcodeStream* stream) {
 bool ESP3DGCodeHostService::_startStream(ESP3DGcodeStream* stream) {
   _error = ESP3DGcodeHostError::no_error;
   esp3d_log("Starting stream");
-  _file_buffer_length = 0;
+  _line_scanner.reset();
   _current_command_str = "";
   if (isFileStream(stream)) {
     if (_file_handle) {
@@ -502,7 +782,24 @@ bool ESP3DGCodeHostService::_startStream(ESP3DGcodeStream* stream) {
       esp3d_log("Add command: %s", cmd.c_str());
       _add_stream(cmd.c_str(), stream->auth_type, true);
       _command_number = 0;
-      
+      // character counting need the real size of the controller RX buffer
+      if (_streaming_mode == ESP3DGcodeHostStreamingMode::character_counting &&
+          esp3dGcodeParser.getRxBufferSize() == 0) {
+        cmd = esp3dGcodeParser.getFwCommandString(FW_GCodeCommand::build_info);
+        esp3d_log("Add command: %s", cmd.c_str());
+        _add_stream(cmd.c_str(), stream->auth_type, true);
+      }
+      _stats_acked_lines = 0;
+      _stats_start_time = esp3d_hal::millis();
+      _stats_end_time = 0;
+      _stats_ack_time = 0;
+      _stats_latency_sum = 0;
+      _stats_latency_count = 0;
+      _stats_latency_max = 0;
+      _line_scanner.resetStats();
+      _stats_bf_waits = 0;
+      _prefetcher.resetStats();
+
       esp3dTftValues.set_string_value(ESP3DValuesIndex::job_status,
                                       "processing");
       esp3dTftValues.set_string_value(ESP3DValuesIndex::file_name,
@@ -510,11 +807,18 @@ bool ESP3DGCodeHostService::_startStream(ESP3DGcodeStream* stream) {
     }
     // open file take care of cursor position
     // and total size
+    _modal_state_command.clear();
     if (!_openFile(stream)) {
       esp3d_log_e("Failed to open file");
       _error = ESP3DGcodeHostError::file_system;
       return false;
     }
+    // restore modal state when not starting from first line
+    if (_modal_state_command.length() > 0) {
+      esp3d_log("Add command: %s", _modal_state_command.c_str());
+      _add_stream(_modal_state_command.c_str(), stream->auth_type, true);
+      _modal_state_command.clear();
+    }
     return true;
   } else if (isCommandStream(stream)) {
     stream->totalSize = strlen(stream->dataStream);
@@ -565,8 +869,6 @@ bool ESP3DGCodeHostService::_endStream(ESP3DGcodeStream* stream) {
 /// @return True if command is read, False if no command read (end of
 /// stream).
 bool ESP3DGCodeHostService::_readNextCommand(ESP3DGcodeStream* stream) {
-  // No need to put this in class scope
-  static size_t buffer_cursor = 0;
   bool need_search_command = true;
   _error = ESP3DGcodeHostError::no_error;
   esp3d_log("Reading next command");
@@ -592,110 +894,43 @@ bool ESP3DGCodeHostService::_readNextCommand(ESP3DGcodeStream* stream) {
     }
     esp3d_log("Command read: %s", _current_command_str.c_str());
   } else if (isFileStream(stream)) {
-    _current_command_str = "";
-    esp3d_log("File commands cursor pos is %lld and current command is %s",
-              stream->cursorPos, _current_command_str.c_str());
+    _current_command_str.clear();
+    esp3d_log("File commands cursor pos is %lld", stream->cursorPos);
     if (_file_handle == nullptr) {
       esp3d_log_e("No file handle");
       _error = ESP3DGcodeHostError::file_system;
       return false;
     }
 
-    // read from file
     while (need_search_command) {
-      esp3d_log("Buffer pos: %d, in buffer of %d,  for %lld/%lld",
-                buffer_cursor, _file_buffer_length, stream->cursorPos,
-                stream->totalSize);
-      if (buffer_cursor >= _file_buffer_length) {
-        // we need refill buffer from file
-        _file_buffer_length = 0;
-      }
-      // read from file
-      if (_file_buffer_length == 0) {
-        esp3d_log("Buffer is empty, read from file");
-        buffer_cursor = 0;
-        _file_buffer_length = fread(_file_buffer, sizeof(char),
-                                    STREAM_CHUNK_SIZE - 1, _file_handle);
-        _file_buffer[_file_buffer_length] = 0;
-
-        if (_file_buffer_length == 0) {
-          esp3d_log_e("Failed to read from file");
+      if (_line_scanner.needChunk()) {
+        // chunk is already read ahead by prefetch task
+        const char* chunk = nullptr;
+        size_t chunk_length = _prefetcher.read(&chunk);
+        if (chunk_length == 0) {
           if (stream->cursorPos < stream->totalSize) {
             esp3d_log_e("No more data available, but file size is not reached");
             _error = ESP3DGcodeHostError::file_system;
             return false;
           }
-          // we reached the end of the file, so no need to search for a command
-          // any more
-          //  we are done even no final '\n' was found
+          // we reached the end of the file, we are done even no final '\n'
+          // was found
+          esp3d_log("End of file");
           need_search_command = false;
-        } else {
-          // Note displaying the buffer can be problematic as it can contain \n
-          // and \r and so it will be displayed on multiple lines and log char
-          // won't be displayed on each line, which may confuse the simulator
-          // taking the log as command
-          // so may need to format the buffer before displaying it
-          //  esp3d_log("Got %d bytes from file: *%s*", _file_buffer_length,
-          //              _file_buffer);
+          break;
         }
+        _line_scanner.setChunk(chunk, chunk_length);
       }
-      // we did not get the end of line, so we need to search for a command in
-      // the buffer
-      if (need_search_command) {
-        esp3d_log("Parsing buffer to add to command %s",
-                  _current_command_str.c_str());
-        for (buffer_cursor = buffer_cursor; buffer_cursor < _file_buffer_length;
-             buffer_cursor++) {
-          // What ever we read it increase the cursor pos
-          (stream->cursorPos)++;
-          // esp3d_log("Parsing buffer at index:%d, cursor is now %lld",
-          //             buffer_cursor, stream->cursorPos);
-          //   do not add the `\n` on purpose for triming the command
-          if (_file_buffer[buffer_cursor] == '\n' ||
-              _file_buffer[buffer_cursor] == '\r') {
-            esp3d_log("End of line %s found", _current_command_str.c_str());
-            // is it en empty line ?
-            //  if yes we need to continue to read
-            if (_current_command_str.length() == 0) {
-              esp3d_log("Empty line, continue, cursor is now %lld/%lld",
-                        stream->cursorPos, stream->totalSize);
-              continue;
-            } else {
-              buffer_cursor++;
-              esp3d_log("Command found, is now: *%s* of %d bytes",
-                        _current_command_str.c_str(),
-                        _current_command_str.length());
-              need_search_command = false;
-              break;
-            }
-          }
-          // fill the command string
-          _current_command_str += _file_buffer[buffer_cursor];
-          // esp3d_log("Command is now: %s", _current_command_str.c_str());
-          if (_current_command_str.length() > MAX_COMMAND_LENGTH) {
-            esp3d_log_e("Command too long > 255, %s",
-                        _current_command_str.c_str());
-            // is that necessary ? as we are not going to send it
-            buffer_cursor++;
-            _error = ESP3DGcodeHostError::command_too_long;
-            return false;
-          }
-        }
-        // seems we did not find any command end line
-        if (need_search_command) {
-          esp3d_log("No end of line found %lld/%lld", stream->cursorPos,
-                    stream->totalSize);
-          if (stream->cursorPos == stream->totalSize) {
-            esp3d_log("End of file");
-            // no need to search anymore
-            need_search_command = false;
-          } else {
-            esp3d_log("Continue to read from file for %s",
-                      _current_command_str.c_str());
-            // we continue to read from file
-            _file_buffer_length = 0;
-          }
-        }
+      switch (_line_scanner.scan(&_current_command_str, &stream->cursorPos)) {
+        case ESP3DGcodeLineScan::command:
+          need_search_command = false;
+          break;
+        case ESP3DGcodeLineScan::too_long:
+          esp3d_log_e("Command too long > %d", ESP3D_GCODE_MAX_LINE_LENGTH);
+          _error = ESP3DGcodeHostError::command_too_long;
+          return false;
+        default:
+          break;
       }
     }
   } else {
@@ -722,13 +957,14 @@ bool ESP3DGCodeHostService::_readNextCommand(ESP3DGcodeStream* stream) {
   }
   esp3d_log("Cursor pos is now %lld / %lld, %lld, buffer cursor is %d/%d",
             stream->cursorPos, stream->totalSize,
-            100 * stream->cursorPos / stream->totalSize, buffer_cursor,
-            _file_buffer_length);
-  _current_command_str = esp3d_string::str_trim(_current_command_str.c_str());
+            100 * stream->cursorPos / stream->totalSize,
+            _line_scanner.getCursor(), _line_scanner.getLength());
+  esp3d_trim_string(&_current_command_str);
   esp3d_log("Trimmed command read: %s", _current_command_str.c_str());
   if (_current_command_str.length() == 0) {
     esp3d_log("No command read %lld/%lld, on buffer %d/%d", stream->cursorPos,
-              stream->totalSize, buffer_cursor, _file_buffer_length);
+              stream->totalSize, _line_scanner.getCursor(),
+              _line_scanner.getLength());
 
     return false;
   }
@@ -786,15 +1022,21 @@ bool ESP3DGCodeHostService::_CheckSumCommand(char* result_buffer,
 
 bool ESP3DGCodeHostService::_parseResponse(ESP3DMessage* rx) {
   esp3d_log("Parse response %s", (char*)(rx->data));
-  ESP3DDataType response_type = esp3dGcodeParser.getType((char*)(rx->data));
-  esp3d_log("Response type %d", static_cast<uint8_t>(response_type));
-  switch (response_type) {
+  // classified by the rx task of the output client
+  esp3d_log("Response type %d", static_cast<uint8_t>(rx->data_type));
+  switch (rx->data_type) {
     case ESP3DDataType::ack:  // ack
       _startTimeout = esp3d_hal::millis();
       esp3d_log("Reset timeout");
       esp3d_log("Got ack %s", esp3d_string::str_trim((char*)rx->data));
       esp3d_log("for %s", esp3d_string::str_trim(_current_command_str.c_str()));
-      if (_awaitingAck) {
+      _stats_acked_lines++;
+      _stats_ack_time = esp_timer_get_time();
+      _countAckedLine();
+      if (_popSentLine()) {
+        // character counting: the ack only frees room in RX buffer
+        esp3d_log("Bytes in flight: %d", _bytes_in_flight);
+      } else if (_awaitingAck) {
         esp3d_log("When having awaiting ack");
         // we got an ack for the current command
         _awaitingAck = false;
@@ -818,19 +1060,34 @@ bool ESP3DGCodeHostService::_parseResponse(ESP3DMessage* rx) {
       break;
     case ESP3DDataType::error:  // error
       esp3d_log_e("Got Error: %s", ((char*)(rx->data)));
-      if (_awaitingAck) {
+      _countAckedLine();
+      if (_awaitingAck && _sent_lines_length.empty()) {
         _awaitingAck = false;
         // TODO: handle error ?
         // e.g: Marlin raise error first then ask for resend
       } else {
         std::string text = esp3dTranslationService.translate(ESP3DLabel::error);
         text += ": P";
-        text += esp3dGcodeParser.getLastError();
+        // text after "error:" or "Error:", a grbl code or a printer message
+        const char* error_text = (const char*)rx->data;
+        while (*error_text == ' ' || *error_text == '\t') {
+          error_text++;
+        }
+        if (strlen(error_text) > 6) {
+          text += esp3d_string::str_trim(error_text + 6);
+        } else {
+          text += std::to_string(rx->data_value);
+        }
         #if ESP3D_HAS_STATUS_BAR
         esp3dTftValues.set_string_value(ESP3DValuesIndex::status_bar_label,
                                         text.c_str());
         #endif  // ESP3D_HAS_STATUS_BAR
-        esp3d_log("Got error but out of the query");
+        // character counting: the error is the ack of the oldest line
+        if (_popSentLine()) {
+          esp3d_log("Got error for line in flight, continue");
+        } else {
+          esp3d_log("Got error but out of the query");
+        }
       }
       break;
     case ESP3DDataType::resend:  // resend
@@ -839,7 +1096,7 @@ bool ESP3DGCodeHostService::_parseResponse(ESP3DMessage* rx) {
       _startTimeout = esp3d_hal::millis();
       esp3d_log("Reset timeout");
       if (_awaitingAck) {
-        _resend_command_number = esp3dGcodeParser.getLineResend();
+        _resend_command_number = rx->data_value;
         _resend_command_counter++;
         esp3d_log("Got resend %lld", _resend_command_number);
         _setStreamState(ESP3DGcodeStreamState::resend_gcode_command);
@@ -922,7 +1179,30 @@ ESP3DGCodeHostService::ESP3DGCodeHostService() {
 }
 ESP3DGCodeHostService::~ESP3DGCodeHostService() { end(); }
 
+// A message is a realtime command if it is a single realtime byte,
+// optionally followed by end of line
+static bool esp3d_get_realtime_command(ESP3DMessage* msg, uint8_t* cmd) {
+  size_t size = msg->size;
+  while (size > 1 &&
+         (msg->data[size - 1] == '\n' || msg->data[size - 1] == '\r')) {
+    size--;
+  }
+  if (size != 1 || !esp3dGcodeParser.isRealTimeCommand(msg->data[0])) {
+    return false;
+  }
+  *cmd = msg->data[0];
+  return true;
+}
+
 void ESP3DGCodeHostService::process(ESP3DMessage* msg) {
+  uint8_t realtime_cmd = 0;
+  // realtime commands do not wait behind queued lines
+  if (msg->origin != _outputClient &&
+      esp3d_get_realtime_command(msg, &realtime_cmd)) {
+    esp3dCommands.dispatchRealTimeCommand(realtime_cmd);
+    deleteMsg(msg);
+    return;
+  }
   esp3d_log("Add message to queue");
   //  the flush is used to avoid the queue to be full
   if (!addRxData(msg)) {
@@ -930,11 +1210,9 @@ void ESP3DGCodeHostService::process(ESP3DMessage* msg) {
     if (!addRxData(msg)) {
       esp3d_log_e("Cannot add msg to client queue");
       deleteMsg(msg);
+      return;
     }
-  } else {
-    // flush();
   }
-  //}
 }
 
 bool ESP3DGCodeHostService::begin() {
@@ -961,12 +1239,20 @@ bool ESP3DGCodeHostService::begin() {
     return false;
   }
 
+  if (!_prefetcher.begin()) {
+    esp3d_log_e("File prefetch creation failed");
+    return false;
+  }
+  // command never exceeds this size, so reading lines does not reallocate it
+  _current_command_str.reserve(MAX_COMMAND_LENGTH + 2);
+
   // Task is never stopped so no need to kill the task from outside
 
   // this is done once because it is not possible to change the output client
   // after the fw is started
   _outputClient = esp3dCommands.getOutputClient(true);
   esp3d_log("Output client is: %d", static_cast<uint8_t>(_outputClient));
+  updateStreamingMode();
   BaseType_t res = xTaskCreatePinnedToCore(
       esp3d_gcode_host_task, "esp3d_gcode_host_task",
       ESP3D_GCODE_HOST_TASK_SIZE, NULL, ESP3D_GCODE_HOST_TASK_PRIORITY,
@@ -974,6 +1260,8 @@ bool ESP3DGCodeHostService::begin() {
 
   if (res == pdPASS && _xHandle) {
     esp3d_log("Created GCode Host Task");
+    // queued messages wake up the task
+    setNotifyTask(_xHandle);
     esp3d_hal::wait(100);
     esp3d_log("GCode Host service started");
     _started = true;
@@ -987,14 +1275,7 @@ bool ESP3DGCodeHostService::begin() {
 }
 
 bool ESP3DGCodeHostService::_stripCommand() {
-  std::string cmd = "";
-  for (uint i = 0; i < _current_command_str.length(); i++) {
-    if (_current_command_str[i] == ';') {
-      break;
-    }
-    cmd += _current_command_str[i];
-  }
-  _current_command_str = esp3d_string::str_trim(cmd.c_str());
+  esp3d_trim_string(&_current_command_str);
   if (_current_command_str.length() == 0) {
     return false;
   }
@@ -1201,64 +1482,73 @@ ESP3DGcodeStreamState ESP3DGCodeHostService::_getStreamState() {
 }
 
 // Handle the notifications
-// be sure sdkconfig has CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES>=3
+// be sure sdkconfig has CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES>=4
+// entry 0 is only used to wake up the task, so it is taken by waitForEvent()
 void ESP3DGCodeHostService::_handle_notifications() {
   // esp3d_log("Handle notifications");
-  // entry 0
-  if (ulTaskNotifyTake(pdTRUE, 0)) {
-    ESP3DGcodeStreamState state = ESP3DGcodeStreamState::undefined;
-    ESP3DGcodeStream* stream = getCurrentMainStream();
-    if (stream) {
-      state = stream->state;
-    }
-    if (ulTaskNotifyTakeIndexed(_xPauseNotifyIndex, pdTRUE, 0)) {
-      esp3d_log("Received pause notification");
-      if (!_setStreamRequestState(ESP3DGcodeStreamState::pause)) {
-        esp3d_log_e("Failed to request pause stream");
-      } else {  // do not wait to set the state to paused to avoid to
-                // confuse the user
-        esp3dTftValues.set_string_value(ESP3DValuesIndex::job_status, "paused");
-      }
+  ESP3DGcodeStreamState state = ESP3DGcodeStreamState::undefined;
+  ESP3DGcodeStream* stream = getCurrentMainStream();
+  if (stream) {
+    state = stream->state;
+  }
+  if (ulTaskNotifyTakeIndexed(_xPauseNotifyIndex, pdTRUE, 0)) {
+    esp3d_log("Received pause notification");
+    if (!_setStreamRequestState(ESP3DGcodeStreamState::pause)) {
+      esp3d_log_e("Failed to request pause stream");
+    } else {  // do not wait to set the state to paused to avoid to
+              // confuse the user
+      esp3dTftValues.set_string_value(ESP3DValuesIndex::job_status, "paused");
     }
+  }
 
-    if (ulTaskNotifyTakeIndexed(_xResumeNotifyIndex, pdTRUE, 0)) {
-      esp3d_log("Received resume notification");
-      if (state == ESP3DGcodeStreamState::paused) {
-        if (!_setMainStreamState(ESP3DGcodeStreamState::resume)) {
-          esp3d_log_e("Failed to resume stream");
-        } else {  // do not wait to set the state to processing to avoid to
-                  // confuse the user
-          esp3dTftValues.set_string_value(ESP3DValuesIndex::job_status,
-                                          "processing");
-        }
-      } else {
-        esp3d_log("No paused stream - nothing to resume");
+  if (ulTaskNotifyTakeIndexed(_xResumeNotifyIndex, pdTRUE, 0)) {
+    esp3d_log("Received resume notification");
+    if (state == ESP3DGcodeStreamState::paused) {
+      if (!_setMainStreamState(ESP3DGcodeStreamState::resume)) {
+        esp3d_log_e("Failed to resume stream");
+      } else {  // do not wait to set the state to processing to avoid to
+                // confuse the user
+        esp3dTftValues.set_string_value(ESP3DValuesIndex::job_status,
+                                        "processing");
       }
+    } else {
+      esp3d_log("No paused stream - nothing to resume");
     }
-    if (ulTaskNotifyTakeIndexed(_xAbortNotifyIndex, pdTRUE, 0)) {
-      esp3d_log("Received abort notification");
-      if (state != ESP3DGcodeStreamState::undefined) {
-        if (!_setStreamRequestState(ESP3DGcodeStreamState::abort)) {
-          esp3d_log_e("Failed to abort stream");
-        } else {  // do not wait to set the state to processing to avoid to
-                  // confuse the user
-          esp3dTftValues.set_string_value(ESP3DValuesIndex::job_status, "idle");
-        }
+  }
+  // character counting restarts from an empty RX buffer
+  if (_reset_sent_lines) {
+    esp3d_log("Controller reset, clear lines in flight");
+    _reset_sent_lines = false;
+    _clearSentLines();
+    _bf_bytes_sent = 0;
+    _bf_bytes_acked = 0;
+  }
+  if (ulTaskNotifyTakeIndexed(_xAbortNotifyIndex, pdTRUE, 0)) {
+    esp3d_log("Received abort notification");
+    if (state != ESP3DGcodeStreamState::undefined) {
+      if (!_setStreamRequestState(ESP3DGcodeStreamState::abort)) {
+        esp3d_log_e("Failed to abort stream");
+      } else {  // do not wait to set the state to processing to avoid to
+                // confuse the user
+        esp3dTftValues.set_string_value(ESP3DValuesIndex::job_status, "idle");
       }
     }
   }
 }
 
-// Handle the messages in the queue
-void ESP3DGCodeHostService::_handle_msgs() {
+// Handle the messages in the queue, return true if any was processed
+bool ESP3DGCodeHostService::_handle_msgs() {
   // esp3d_log("Handle messages");
+  bool processed = false;
   while (getRxMsgsCount() > 0) {
     ESP3DMessage* msg = popRx();
     esp3d_log("RX popped");
     if (msg) {
       _processRx(msg);
+      processed = true;
     }
   }
+  return processed;
 }
 
 // handle stream state changes
@@ -1276,6 +1566,11 @@ void ESP3DGCodeHostService::_handle_stream_states() {
   }
   ESP3DMessage* msg = nullptr;
   char buffer_str[MAX_COMMAND_LENGTH + 1] = {0};
+  const char* command_str = nullptr;
+  size_t command_size = 0;
+  bool use_checksum = false;
+  bool has_ack = false;
+  bool char_counting = false;
   std::string text;
 
   if (!_current_stream_ptr->active) {
@@ -1444,21 +1739,32 @@ void ESP3DGCodeHostService::_handle_stream_states() {
     /////////////////////////////////////////////////////////
     // send_gcode_command
     /////////////////////////////////////////////////////////
+    case ESP3DGcodeStreamState::wait_for_buffer:
     case ESP3DGcodeStreamState::send_gcode_command:
-      _startTimeout = esp3d_hal::millis();
-      esp3d_log("Reset timeout");
       msg = nullptr;
-      // do we need to forward to screen ?
-      if (esp3dGcodeParser.forwardToScreen(_current_command_str.c_str())) {
+      if (_current_stream_ptr->state ==
+          ESP3DGcodeStreamState::wait_for_buffer) {
+        // the room in RX buffer is only freed by acks
+        if (esp3d_hal::millis() - _startTimeout > ESP3D_COMMAND_TIMEOUT) {
+          esp3d_log_e("Timeout waiting for room in RX buffer");
+          _handle_ack_timeout();
+          break;
+        }
+      } else if (esp3dGcodeParser.forwardToScreen(
+                     _current_command_str.c_str())) {
+        // do we need to forward to screen ?
         esp3d_log("Forwarding to screen %s", _current_command_str.c_str());
       }
-      if (esp3dGcodeParser.isAckNeeded() &&
+      use_checksum =
+          esp3dGcodeParser.isAckNeeded() &&
           (_current_stream_ptr->type == ESP3DGcodeHostStreamType::sd_stream ||
-           _current_stream_ptr->type == ESP3DGcodeHostStreamType::fs_stream)) {
-        _command_number++;
-        esp3d_log("Command number: %lld, need checksum", _command_number);
+           _current_stream_ptr->type == ESP3DGcodeHostStreamType::fs_stream);
+      if (use_checksum) {
+        // the number is only incremented once the command is sent
+        esp3d_log("Command number: %lld, need checksum", _command_number + 1);
         if (!_CheckSumCommand(buffer_str, MAX_COMMAND_LENGTH,
-                              _current_command_str.c_str(), _command_number)) {
+                              _current_command_str.c_str(),
+                              _command_number + 1)) {
           esp3d_log_e("Failed to format command");
           _error = ESP3DGcodeHostError::memory_allocation;
           _setStreamState(ESP3DGcodeStreamState::error);
@@ -1466,36 +1772,67 @@ void ESP3DGCodeHostService::_handle_stream_states() {
         }
         // the checksumed command integrate the final `\n` so no need to add
         // it or check if need to add `\n`
-        esp3d_log("Sending : %d for %s", strlen(buffer_str), buffer_str);
-        msg =
-            newMsg(ESP3DClientType::stream, _outputClient, (uint8_t*)buffer_str,
-                   strlen(buffer_str), _current_stream_ptr->auth_type);
+        command_str = buffer_str;
       } else {
-        // FIXME:
-        // this part is arguable for command that are not command
-        // and so do not have a \n at the end e.g: realtime commands from
-        // grbl so it may be better to check if the command is a gcode
-        // command or real time command and add the \n only if it is a gcode
-        // command
-        esp3d_log("Sending : %d for %s", _current_command_str.length(),
-                  _current_command_str.c_str());
+        // realtime commands never get here, they are sent by
+        // process() on the realtime lane, so this is always a line
         if (_current_command_str[_current_command_str.length() - 1] != '\n') {
           _current_command_str += "\n";
         }
-        msg = newMsg(ESP3DClientType::stream, _outputClient,
-                     (uint8_t*)(_current_command_str.c_str()),
-                     _current_command_str.length(),
-                     _current_stream_ptr->auth_type);
+        command_str = _current_command_str.c_str();
       }
+      command_size = strlen(command_str);
+      has_ack = esp3dGcodeParser.hasAck(_current_command_str.c_str());
+      char_counting = has_ack && _streaming_mode ==
+                                     ESP3DGcodeHostStreamingMode::character_counting;
+      _bf_limited = false;
+      if (char_counting && !_hasRxBufferRoom(command_size)) {
+        if (_current_stream_ptr->state !=
+            ESP3DGcodeStreamState::wait_for_buffer) {
+          esp3d_log("No room for %d bytes, %d/%d in flight", command_size,
+                    _bytes_in_flight, getRxBufferSize());
+          if (_bf_limited) {
+            _stats_bf_waits++;
+          }
+          _setStreamState(ESP3DGcodeStreamState::wait_for_buffer);
+        }
+        break;
+      }
+      esp3d_log("Sending : %d for %s", command_size, command_str);
+      msg = newMsg(ESP3DClientType::stream, _outputClient,
+                   (uint8_t*)command_str, command_size,
+                   _current_stream_ptr->auth_type);
       if (msg) {
+        if (use_checksum) {
+          _command_number++;
+        }
         esp3dCommands.process(msg);
-        _awaitingAck = esp3dGcodeParser.hasAck(_current_command_str.c_str());
+        if (has_ack) {
+          _written_lines = _written_lines + 1;
+        }
+        if (_stats_ack_time != 0) {
+          uint32_t latency = (uint32_t)(esp_timer_get_time() - _stats_ack_time);
+          _stats_ack_time = 0;
+          _stats_latency_sum += latency;
+          _stats_latency_count++;
+          if (latency > _stats_latency_max) {
+            _stats_latency_max = latency;
+          }
+        }
+        _startTimeout = esp3d_hal::millis();
+        esp3d_log("Reset timeout");
+        if (char_counting) {
+          // no need to wait, the ack will only free room in RX buffer
+          _pushSentLine(command_size);
+          _awaitingAck = false;
+        } else {
+          _awaitingAck = has_ack;
+        }
         esp3d_log("Awaiting ack: %s for %s", _awaitingAck ? "true" : "false",
                   _current_command_str.c_str());
         if (_awaitingAck) {
           esp3d_log("change state to Waiting for ack");
           _setStreamState(ESP3DGcodeStreamState::wait_for_ack);
-          _startTimeout = esp3d_hal::millis();
         } else {
           esp3d_log("change state to read cursor");
           _current_command_str = "";
@@ -1517,6 +1854,14 @@ void ESP3DGCodeHostService::_handle_stream_states() {
       // send_esp_command
       /////////////////////////////////////////////////////////
     case ESP3DGcodeStreamState::send_esp_command:
+      // esp command must be executed after the lines already sent
+      if (!_sent_lines_length.empty()) {
+        if (esp3d_hal::millis() - _startTimeout > ESP3D_COMMAND_TIMEOUT) {
+          esp3d_log_e("Timeout waiting for lines in flight");
+          _handle_ack_timeout();
+        }
+        break;
+      }
       if (_current_command_str[_current_command_str.length() - 1] != '\n') {
         _current_command_str += "\n";
       }
@@ -1551,18 +1896,7 @@ void ESP3DGCodeHostService::_handle_stream_states() {
       if (_startTimeout != 0 &&
           esp3d_hal::millis() - _startTimeout > ESP3D_COMMAND_TIMEOUT) {
         esp3d_log_e("Timeout waiting for ack");
-        _error = ESP3DGcodeHostError::time_out;
-        _setStreamState(ESP3DGcodeStreamState::error);
-        if (!_connection_lost) {
-          #if ESP3D_HAS_STATUS_BAR
-          std::string text =
-              esp3dTranslationService.translate(ESP3DLabel::communication_lost);
-
-          esp3dTftValues.set_string_value(ESP3DValuesIndex::status_bar_label,
-                                          text.c_str());
-          #endif  // ESP3D_HAS_STATUS_BAR
-        }
-        _connection_lost = true;
+        _handle_ack_timeout();
       }
       break;
 
@@ -1626,6 +1960,7 @@ void ESP3DGCodeHostService::_handle_stream_states() {
       // sanity check, reset main stream pointer if it is the current stream
       if (_current_stream_ptr == _current_main_stream_ptr) {
         _current_main_stream_ptr = nullptr;
+        _stats_end_time = esp3d_hal::millis();
         esp3dTftValues.set_string_value(ESP3DValuesIndex::job_status, "idle");
         if (_current_stream_ptr->cursorPos >= _current_stream_ptr->totalSize) {
           esp3d_log("Stream is finished send 100");
@@ -1648,7 +1983,7 @@ void ESP3DGCodeHostService::_handle_stream_states() {
       _current_stream_ptr = nullptr;
       _current_command_str = "";
       _file_handle = nullptr;
-      _file_buffer_length = 0;
+      _line_scanner.reset();
       break;
 
       /////////////////////////////////////////////////////////
@@ -1742,22 +2077,44 @@ void ESP3DGCodeHostService::_handle_stream_states() {
   };
 }
 
+// Process as many state transitions as possible, and stop when
+// the stream state does not change anymore, so it is waiting for an event
+// Acks and Bf: reports free RX buffer room without changing the state of a
+// stream waiting for buffer, so they also need another pass
 void ESP3DGCodeHostService::handle() {
   if (!_started) {
     return;
   }
+  ESP3DGcodeStream* previous_stream_ptr = nullptr;
+  ESP3DGcodeStreamState previous_state = ESP3DGcodeStreamState::undefined;
+  size_t previous_in_flight = 0;
+  uint32_t previous_bf_count = 0;
+  bool processed = false;
+  uint16_t steps = 0;
   // Check for notifications, set the current stream state
   _handle_notifications();
-
-  // Handle the stream
-  _handle_stream_selection();
-
-  // Handle the state machine
-  _handle_stream_states();
-
-  // esp3d_log("Host state: %d", static_cast<uint8_t>(state));
-  // handle the messages in the queue
-  _handle_msgs();
+  do {
+    previous_stream_ptr = _current_stream_ptr;
+    previous_state = _getStreamState();
+    previous_in_flight = _bytes_in_flight;
+    previous_bf_count = esp3dGcodeParser.getBufferReportCount();
+
+    // Handle the stream
+    _handle_stream_selection();
+
+    // Handle the state machine
+    _handle_stream_states();
+
+    // esp3d_log("Host state: %d", static_cast<uint8_t>(state));
+    // handle the messages in the queue
+    processed = _handle_msgs();
+    steps++;
+  } while ((previous_stream_ptr != _current_stream_ptr ||
+            previous_state != _getStreamState() || processed ||
+            previous_in_flight != _bytes_in_flight ||
+            previous_bf_count != esp3dGcodeParser.getBufferReportCount()) &&
+           steps < ESP3D_MAX_STEPS_PER_WAKEUP);
+  _has_pending_steps = (steps >= ESP3D_MAX_STEPS_PER_WAKEUP);
 }
 
 void ESP3DGCodeHostService::flush() {  // should only be called when no
@@ -1800,6 +2157,7 @@ void ESP3DGCodeHostService::end() {
     }
   }
   if (_xHandle) {
+    setNotifyTask(NULL);
     vTaskDelete(_xHandle);
     _xHandle = NULL;
   }
@@ -1815,8 +2173,11 @@ void ESP3DGCodeHostService::end() {
     // globalFs.releaseFS("/sd/");
     // globalFs.releaseFS("/fs/");
   }
+  _prefetcher.end();
   _current_main_stream_ptr = nullptr;
   _current_stream_ptr = nullptr;
   _error = ESP3DGcodeHostError::no_error;
   _requested_state = ESP3DGcodeStreamState::undefined;
+  _awaitingAck = false;
+  _clearSentLines();
 }
@@ -22,16 +22,22 @@
 #include <pthread.h>
 #include <stdio.h>
 
+#include <deque>
 #include <list>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "authentication/esp3d_authentication_types.h"
 #include "esp3d_client.h"
 #include "esp3d_gcode_host_types.h"
+#include "esp3d_gcode_job.h"
+#include "esp3d_gcode_line_scanner.h"
+#include "esp3d_gcode_prefetcher.h"
 #include "esp3d_log.h"
 #include "esp3d_string.h"
 #include "tasks_def.h"
 #define ESP3D_MAX_STREAM_SIZE 50
+// Realtime soft reset, controller drops the lines in its RX buffer
+#define ESP3D_SOFT_RESET_COMMAND 0x18
 
 #ifdef __cplusplus
 extern "C" {
@@ -54,8 +60,11 @@ struct ESP3DGcodeStream {
   ESP3DAuthenticationLevel auth_type =
       ESP3DAuthenticationLevel::guest;  // the authentication level of the user
                                         // requesting the stream
-  bool active = false;      // is the stream currently being processed
-  char *dataStream = NULL;  // the name of the file to stream
+  bool active = false;       // is the stream currently being processed
+  bool compiled = false;     // is the stream read from the compiled job
+  uint32_t startLine = 0;    // line to start the file from, 0 means first one
+  uint8_t startPercent = 0;  // used to set start line if not set
+  char *dataStream = NULL;   // the name of the file to stream
 };
 
 class ESP3DGCodeHostService : public ESP3DClient {
@@ -65,11 +74,23 @@ class ESP3DGCodeHostService : public ESP3DClient {
   bool begin();
   void end();
   void handle();
+  void waitForEvent();
   void process(ESP3DMessage *msg);
   void flush();
   bool started() { return _started; }
 
   void updateScripts();
+  void updateStreamingMode();
+  ESP3DGcodeHostStreamingMode getStreamingMode() { return _streaming_mode; }
+  size_t getBytesInFlight() { return _bytes_in_flight; }
+  size_t getRxBufferSize();
+  uint32_t getLinesPerSecond();
+  uint32_t getLineLatencyAvg();
+  uint32_t getLineLatencyMax() { return _stats_latency_max; }
+  uint64_t getScannedLines() { return _line_scanner.getScannedLines(); }
+  uint64_t getStraddledLines() { return _line_scanner.getStraddledLines(); }
+  uint32_t getBfWaits() { return _stats_bf_waits; }
+  ESP3DGcodePrefetcher *getPrefetcher() { return &_prefetcher; }
   bool abort();
   bool pause();
   bool resume();
@@ -79,13 +100,21 @@ class ESP3DGCodeHostService : public ESP3DClient {
   ESP3DGcodeHostError getErrorNum();
   ESP3DGcodeStream *getCurrentMainStream();
   bool addStream(const char *filename, ESP3DAuthenticationLevel auth_type,
-                 bool executeAsMacro);
+                 bool executeAsMacro, uint32_t startLine = 0,
+                 uint8_t startPercent = 0);
   bool addStream(const char *command, size_t length,
                  ESP3DAuthenticationLevel authentication_level);
 
   size_t getScriptsListSize() { return _scripts.size(); }
   size_t getStreamsListSize() { return _scripts.size(); }
   bool hasStreamListCommand(const char *command);
+  // controller was reset, lines in flight will never be acked, can be called
+  // from any task
+  void resetSentLines();
+  // lines written to the controller which need an ack, and acks received
+  // for them, so another task can tell when a line it queued was executed
+  uint32_t getWrittenLineCount() { return _written_lines; }
+  uint32_t getAckedLineCount() { return _acked_lines; }
 
  private:
   ESP3DGcodeHostStreamType _getStreamType(const char *data);
@@ -102,11 +131,14 @@ class ESP3DGCodeHostService : public ESP3DClient {
   bool _popFrontGCodeStream(bool is_stream = false);
 
   void _handle_notifications();
-  void _handle_msgs();
+  bool _handle_msgs();
   void _handle_stream_selection();
   void _handle_stream_states();
   bool _add_stream(const char *data, ESP3DAuthenticationLevel auth_type,
-                   bool executeFirst = false);
+                   bool executeFirst = false, uint32_t startLine = 0,
+                   uint8_t startPercent = 0);
+  bool _seekFile(ESP3DGcodeStream *stream,
+                 const ESP3DGcodeJobHeader *job_header, bool has_job);
 
   bool _readNextCommand(ESP3DGcodeStream *stream);
   uint8_t _Checksum(const char *command, uint32_t commandSize);
@@ -114,23 +146,61 @@ class ESP3DGCodeHostService : public ESP3DClient {
                         const char *command, uint32_t commandnb);
   bool _stripCommand();
 
+  bool _hasRxBufferRoom(size_t length);
+  bool _hasBfRoom(size_t length);
+  void _pushSentLine(size_t length);
+  bool _popSentLine();
+  void _clearSentLines();
+  void _countAckedLine();
+  void _handle_ack_timeout();
+  void _notify();
+
   bool _processRx(ESP3DMessage *rx);
   bool _parseResponse(ESP3DMessage *rx);
 
   std::string _current_command_str;
-  size_t _file_buffer_length = 0;
-  char _file_buffer[STREAM_CHUNK_SIZE];
+  ESP3DGcodeLineScanner _line_scanner;  // splits prefetched chunks
+  ESP3DGcodePrefetcher _prefetcher;
 
   TaskHandle_t _xHandle = NULL;
   bool _started = false;
-  const UBaseType_t _xPauseNotifyIndex = 0;
-  const UBaseType_t _xResumeNotifyIndex = 1;
-  const UBaseType_t _xAbortNotifyIndex = 2;
+  // index 0 is the generic wake up notification of the task
+  const UBaseType_t _xPauseNotifyIndex = 1;
+  const UBaseType_t _xResumeNotifyIndex = 2;
+  const UBaseType_t _xAbortNotifyIndex = 3;
+  bool _has_pending_steps = false;
+  volatile bool _reset_sent_lines = false;
 
   ESP3DClientType _outputClient = ESP3DClientType::no_client;
   bool _awaitingAck = false;
   uint64_t _startTimeout = 0;
 
+  // Character counting: lines sent but not yet acked by the controller
+  ESP3DGcodeHostStreamingMode _streaming_mode =
+      ESP3DGcodeHostStreamingMode::send_response;
+  std::deque<uint16_t> _sent_lines_length;
+  size_t _bytes_in_flight = 0;
+  // read by other tasks, acked never gets past written
+  volatile uint32_t _written_lines = 0;
+  volatile uint32_t _acked_lines = 0;
+  // Bf: of status reports, bytes sent and acked since the last one
+  uint32_t _bf_report_count = 0;
+  size_t _bf_bytes_sent = 0;
+  size_t _bf_bytes_acked = 0;
+  bool _bf_limited = false;
+
+  // Statistics of the last main stream
+  uint64_t _stats_acked_lines = 0;
+  uint64_t _stats_start_time = 0;
+  uint64_t _stats_end_time = 0;
+  // time between an ack and the next line written, in microseconds
+  int64_t _stats_ack_time = 0;
+  uint64_t _stats_latency_sum = 0;
+  uint32_t _stats_latency_count = 0;
+  uint32_t _stats_latency_max = 0;
+  // waits for RX buffer room caused by Bf: and not by character counting
+  uint32_t _stats_bf_waits = 0;
+
   ESP3DGcodeStreamState _requested_state = ESP3DGcodeStreamState::undefined;
   std::list<ESP3DGcodeStream *> _scripts;
   std::list<ESP3DGcodeStream *> _streams;
@@ -143,6 +213,8 @@ class ESP3DGCodeHostService : public ESP3DClient {
   bool _connection_lost = false;
 
   ESP3DGcodeHostError _error = ESP3DGcodeHostError::no_error;
+  // modal state to restore when a file does not start from first line
+  std::string _modal_state_command;
 
   // Stream Variables:
   FILE *_file_handle =
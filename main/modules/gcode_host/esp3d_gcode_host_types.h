@@ -38,6 +38,7 @@ enum class ESP3DGcodeStreamState : uint8_t {
   resend_gcode_command, /**< Gcode command to resend */
   send_esp_command,     /**< ESP command to send */
   wait_for_ack,         /**< Wait for acknowledgement from printer */
+  wait_for_buffer,      /**< Wait for room in controller RX buffer */
   pause,                /**< Pause action */
   resume,               /**< Resume action */
   abort,                /**< Abort action */
@@ -79,6 +80,7 @@ enum class ESP3DGcodeHostError : uint8_t {
   list_full = 16,           /**< List full error */
   aborted = 17,             /**< Aborted error */
   command_too_long = 18,    /**< Command too long error */
+  job_not_compiled = 19,    /**< No compiled job to seek start line error */
 };
 
 /**
@@ -95,6 +97,14 @@ enum class ESP3DGcodeHostStreamType : uint8_t {
   invalid,           /**< Invalid stream type */
 };
 
+/**
+ * @brief Enumeration representing the streaming protocol of the Gcode host.
+ */
+enum class ESP3DGcodeHostStreamingMode : uint8_t {
+  send_response = 0,      /**< Send one line and wait for its ack */
+  character_counting = 1, /**< Fill the controller RX buffer, ack frees it */
+};
+
 #if ESP3D_TFT_LOG
 // be sure size is the same as max length of ESP3DGcodeHostStreamTypeStr
 // Be sure the order is the same as ESP3DGcodeHostStreamType
@@ -112,6 +122,7 @@ const char ESP3DGcodeStreamStateStr[][30] = {"undefined",
                                              "resend_gcode_command",
                                              "send_esp_command",
                                              "wait_for_ack",
+                                             "wait_for_buffer",
                                              "pause",
                                              "resume",
                                              "abort",
@@ -120,6 +131,10 @@ const char ESP3DGcodeStreamStateStr[][30] = {"undefined",
                                              "error"};
 #endif  // ESP3D_TFT_LOG
 
+// Be sure the order is the same as ESP3DGcodeHostStreamingMode
+const char ESP3DGcodeHostStreamingModeStr[][20] = {"send-response",
+                                                   "char-counting"};
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
\ No newline at end of file
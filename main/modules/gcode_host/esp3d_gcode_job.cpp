@@ -0,0 +1,775 @@
+/*
+  esp3d_gcode_job
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#include "esp3d_gcode_job.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/stat.h>
+
+#include <cctype>
+
+#include "esp3d_hal.h"
+#include "esp3d_log.h"
+#include "esp_rom_crc.h"
+#include "filesystem/esp3d_globalfs.h"
+#include "tasks_def.h"
+
+// same limit as the gcode host, longer lines cannot be streamed anyway
+#define ESP3D_JOB_MAX_LINE_LENGTH 255
+// index entries written at once
+#define ESP3D_JOB_INDEX_BLOCK 128
+
+const char *GcodeExtensions[] = {"g", "gc", "gco", "gcode", "nc", "ngc", "tap"};
+
+// Trim spaces and remove comment of a line without copying it
+// ESP commands are only trimmed as ';' is allowed in their parameters
+// A ';' inside a (...) comment does not start a comment, (...) comments
+// themselves are removed by stripParenComments()
+void esp3d_gcode_job::trimLine(const char **line, size_t *length) {
+  const char *start = *line;
+  const char *end = start + *length;
+  while (start < end && std::isspace(static_cast<unsigned char>(*start))) {
+    start++;
+  }
+  bool is_esp_command = (end - start >= 4) && (memcmp(start, "[ESP", 4) == 0);
+  if (!is_esp_command) {
+    const char *comment = (const char *)memchr(start, ';', end - start);
+    const char *paren =
+        (const char *)memchr(start, '(', (comment ? comment : end) - start);
+    if (paren) {
+      comment = nullptr;
+      bool in_paren = false;
+      for (const char *p = paren; p < end; p++) {
+        if (in_paren) {
+          in_paren = (*p != ')');
+        } else if (*p == '(') {
+          in_paren = true;
+        } else if (*p == ';') {
+          comment = p;
+          break;
+        }
+      }
+    }
+    if (comment) {
+      end = comment;
+    }
+  }
+  while (end > start && std::isspace(static_cast<unsigned char>(*(end - 1)))) {
+    end--;
+  }
+  *line = start;
+  *length = end - start;
+}
+
+// Remove (...) comments of a trimmed line in place, an unclosed one ends the
+// line. (MSG,...) is kept as the controller displays it
+// Return the new length, the line is trimmed again
+size_t esp3d_gcode_job::stripParenComments(char *line, size_t length) {
+  if ((length >= 4 && memcmp(line, "[ESP", 4) == 0) ||
+      !memchr(line, '(', length)) {
+    return length;
+  }
+  size_t read = 0;
+  size_t written = 0;
+  while (read < length) {
+    if (line[read] == '(' &&
+        !(length - read >= 5 && strncasecmp(line + read + 1, "MSG,", 4) == 0)) {
+      const char *close =
+          (const char *)memchr(line + read, ')', length - read);
+      read = close ? close - line + 1 : length;
+      continue;
+    }
+    line[written++] = line[read++];
+  }
+  const char *start = line;
+  esp3d_gcode_job::trimLine(&start, &written);
+  memmove(line, start, written);
+  return written;
+}
+
+bool esp3d_gcode_job::isGcodeFile(const char *path) {
+  const char *extension = strrchr(path, '.');
+  if (!extension || strchr(extension, '/')) {
+    return false;
+  }
+  extension++;
+  for (uint8_t i = 0; i < sizeof(GcodeExtensions) / sizeof(char *); i++) {
+    if (strcasecmp(extension, GcodeExtensions[i]) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string esp3d_gcode_job::jobPath(const char *path) {
+  std::string job_path = path;
+  job_path += ESP3D_JOB_EXTENSION;
+  return job_path;
+}
+
+// CRC32 of the whole file if it fits in ESP3D_JOB_CRC_BLOCKS chunks, else of
+// that many chunks spread from start to end, buffer is STREAM_CHUNK_SIZE bytes
+static bool esp3d_job_source_crc(FILE *fd, uint32_t size, char *buffer,
+                                 uint32_t *crc) {
+  *crc = 0;
+  bool sampled = size > (uint32_t)STREAM_CHUNK_SIZE * ESP3D_JOB_CRC_BLOCKS;
+  uint32_t blocks = sampled ? ESP3D_JOB_CRC_BLOCKS
+                            : (size + STREAM_CHUNK_SIZE - 1) / STREAM_CHUNK_SIZE;
+  for (uint32_t i = 0; i < blocks; i++) {
+    uint32_t offset =
+        sampled ? (uint32_t)((uint64_t)(size - STREAM_CHUNK_SIZE) * i /
+                             (ESP3D_JOB_CRC_BLOCKS - 1))
+                : i * STREAM_CHUNK_SIZE;
+    size_t length = size - offset < (uint32_t)STREAM_CHUNK_SIZE
+                        ? size - offset
+                        : STREAM_CHUNK_SIZE;
+    if (fseek(fd, offset, SEEK_SET) != 0 ||
+        fread(buffer, 1, length, fd) != length) {
+      return false;
+    }
+    *crc = esp_rom_crc32_le(*crc, (const uint8_t *)buffer, length);
+  }
+  return true;
+}
+
+// Check if the file has a compiled job which can be used instead
+// FS must already be accessed by caller
+bool esp3d_gcode_job::getJob(const char *path, ESP3DGcodeJobHeader *header) {
+  struct stat source_stat;
+  struct stat job_stat;
+  std::string job_path = jobPath(path);
+  if (globalFs.stat(job_path.c_str(), &job_stat) == -1) {
+    return false;
+  }
+  if (globalFs.stat(path, &source_stat) == -1) {
+    return false;
+  }
+  if (job_stat.st_mtime < source_stat.st_mtime) {
+    esp3d_log("Job %s is older than source", job_path.c_str());
+    return false;
+  }
+  FILE *fd = globalFs.open(job_path.c_str(), "r");
+  if (!fd) {
+    esp3d_log_e("Failed to open job %s", job_path.c_str());
+    return false;
+  }
+  size_t read = fread(header, 1, sizeof(ESP3DGcodeJobHeader), fd);
+  globalFs.close(fd, job_path.c_str());
+  if (read != sizeof(ESP3DGcodeJobHeader) || header->magic != ESP3D_JOB_MAGIC ||
+      header->version != ESP3D_JOB_VERSION ||
+      header->header_size != sizeof(ESP3DGcodeJobHeader)) {
+    esp3d_log("Job %s has wrong format", job_path.c_str());
+    return false;
+  }
+  if (header->source_size != (uint32_t)source_stat.st_size) {
+    esp3d_log("Job %s does not match source", job_path.c_str());
+    return false;
+  }
+  // same size is not enough, an edited coordinate keeps it
+  uint32_t crc = 0;
+  bool crc_read = false;
+  char *buffer = (char *)malloc(STREAM_CHUNK_SIZE);
+  fd = buffer ? globalFs.open(path, "r") : nullptr;
+  if (fd) {
+    crc_read = esp3d_job_source_crc(fd, header->source_size, buffer, &crc);
+    globalFs.close(fd, path);
+  }
+  if (buffer) {
+    free(buffer);
+  }
+  if (!crc_read) {
+    esp3d_log_e("Failed to read source %s", path);
+    return false;
+  }
+  if (crc != header->source_crc) {
+    esp3d_log("Job %s does not match source content", job_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+// Helper to write buffered commands and index of compilation
+struct ESP3DGcodeJobWriter {
+  FILE *job = nullptr;
+  FILE *index = nullptr;
+  FILE *modal = nullptr;
+  char *commands = nullptr;  // STREAM_CHUNK_SIZE bytes
+  size_t commands_length = 0;
+  uint32_t index_block[ESP3D_JOB_INDEX_BLOCK];
+  size_t index_length = 0;
+  char stripped[ESP3D_JOB_MAX_LINE_LENGTH];  // command without (...) comments
+  ESP3DGcodeJobHeader header;
+  ESP3DGcodeModalState modal_state;
+
+  bool flushCommands() {
+    if (commands_length &&
+        fwrite(commands, 1, commands_length, job) != commands_length) {
+      return false;
+    }
+    commands_length = 0;
+    return true;
+  }
+
+  bool flushIndex() {
+    if (index_length && fwrite(index_block, sizeof(uint32_t), index_length,
+                               index) != index_length) {
+      return false;
+    }
+    index_length = 0;
+    return true;
+  }
+
+  bool addIndex(uint32_t offset) {
+    index_block[index_length++] = offset;
+    if (index_length == ESP3D_JOB_INDEX_BLOCK) {
+      return flushIndex();
+    }
+    return true;
+  }
+
+  bool addCommand(const char *command, size_t length) {
+    if (commands_length + length + 1 > STREAM_CHUNK_SIZE && !flushCommands()) {
+      return false;
+    }
+    memcpy(commands + commands_length, command, length);
+    commands_length += length;
+    commands[commands_length++] = '\n';
+    header.commands_size += length + 1;
+    header.commands_count++;
+    esp3d_gcode_job::updateModalState(&modal_state, command, length);
+    return true;
+  }
+
+  // one source line, '\r' is also an end of command like when streaming
+  bool addLine(const char *line, size_t length) {
+    if (!addIndex(header.commands_size)) {
+      return false;
+    }
+    // state before this line
+    if (header.source_lines % header.modal_interval == 0 &&
+        fwrite(&modal_state, sizeof(ESP3DGcodeModalState), 1, modal) != 1) {
+      return false;
+    }
+    header.source_lines++;
+    const char *end = line + length;
+    while (line < end) {
+      const char *eol = (const char *)memchr(line, '\r', end - line);
+      size_t command_length = eol ? eol - line : end - line;
+      const char *command = line;
+      line += command_length + 1;
+      esp3d_gcode_job::trimLine(&command, &command_length);
+      if (memchr(command, '(', command_length)) {
+        memcpy(stripped, command, command_length);
+        command_length =
+            esp3d_gcode_job::stripParenComments(stripped, command_length);
+        command = stripped;
+      }
+      if (command_length > 0 && !addCommand(command, command_length)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Append content of temporary file to job
+  bool append(FILE *fd, char *buffer) {
+    size_t read = 0;
+    rewind(fd);
+    while ((read = fread(buffer, 1, STREAM_CHUNK_SIZE, fd)) > 0) {
+      if (fwrite(buffer, 1, read, job) != read) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Read all source and write job, buffer is STREAM_CHUNK_SIZE bytes
+  bool write(FILE *source, char *buffer) {
+    std::string carry;
+    size_t read = 0;
+    carry.reserve(ESP3D_JOB_MAX_LINE_LENGTH + 1);
+    // header is written again once complete
+    if (fwrite(&header, 1, sizeof(ESP3DGcodeJobHeader), job) !=
+        sizeof(ESP3DGcodeJobHeader)) {
+      return false;
+    }
+    while ((read = fread(buffer, 1, STREAM_CHUNK_SIZE, source)) > 0) {
+      const char *line = buffer;
+      const char *end = buffer + read;
+      while (line < end) {
+        const char *eol = (const char *)memchr(line, '\n', end - line);
+        size_t line_length = eol ? eol - line : end - line;
+        if (carry.length() + line_length > ESP3D_JOB_MAX_LINE_LENGTH) {
+          esp3d_log_e("Line %ld is too long", header.source_lines + 1);
+          return false;
+        }
+        if (!eol) {
+          // end of line is in next chunk
+          carry.append(line, line_length);
+          break;
+        }
+        const char *current = line;
+        line = eol + 1;
+        if (carry.length() > 0) {
+          carry.append(current, line_length);
+          current = carry.c_str();
+          line_length = carry.length();
+        }
+        if (!addLine(current, line_length)) {
+          return false;
+        }
+        carry.clear();
+      }
+    }
+    // last line may have no end of line
+    if (carry.length() > 0 && !addLine(carry.c_str(), carry.length())) {
+      return false;
+    }
+    // last entry is the end of commands
+    if (!addIndex(header.commands_size) || !flushIndex() || !flushCommands()) {
+      return false;
+    }
+    // append index and modal states to commands
+    header.index_offset = sizeof(ESP3DGcodeJobHeader) + header.commands_size;
+    header.modal_offset =
+        header.index_offset + (header.source_lines + 1) * sizeof(uint32_t);
+    if (!append(index, buffer) || !append(modal, buffer)) {
+      return false;
+    }
+    rewind(job);
+    return fwrite(&header, 1, sizeof(ESP3DGcodeJobHeader), job) ==
+           sizeof(ESP3DGcodeJobHeader);
+  }
+};
+
+// Create the compiled job of the file, it is written to a temporary file
+// and renamed once complete so a partial job is never used
+// FS must already be accessed by caller
+bool esp3d_gcode_job::compile(const char *path) {
+  std::string job_path = jobPath(path);
+  std::string tmp_path = job_path + ".tmp";
+  std::string index_path = job_path + ".idx";
+  std::string modal_path = job_path + ".mod";
+  ESP3DGcodeJobWriter writer;
+  struct stat source_stat;
+  bool success = false;
+#if ESP3D_TFT_LOG >= ESP3D_TFT_LOG_LEVEL_ALL
+  uint64_t start_time = esp3d_hal::millis();
+#endif  // ESP3D_TFT_LOG >= ESP3D_TFT_LOG_LEVEL_ALL
+
+  esp3d_log("Compiling %s", path);
+  if (globalFs.stat(path, &source_stat) == -1 || S_ISDIR(source_stat.st_mode)) {
+    esp3d_log_e("Cannot compile %s", path);
+    return false;
+  }
+  writer.header.source_size = source_stat.st_size;
+  char *buffer = (char *)malloc(STREAM_CHUNK_SIZE);
+  writer.commands = (char *)malloc(STREAM_CHUNK_SIZE);
+  FILE *source = globalFs.open(path, "r");
+  writer.job = globalFs.open(tmp_path.c_str(), "w");
+  writer.index = globalFs.open(index_path.c_str(), "w+");
+  writer.modal = globalFs.open(modal_path.c_str(), "w+");
+  if (!buffer || !writer.commands || !source || !writer.job || !writer.index ||
+      !writer.modal) {
+    esp3d_log_e("Failed to prepare compilation of %s", path);
+  } else {
+    // header is packed, CRC is not written through a pointer to it
+    uint32_t source_crc = 0;
+    success = esp3d_job_source_crc(source, writer.header.source_size, buffer,
+                                   &source_crc);
+    writer.header.source_crc = source_crc;
+    success = success && fseek(source, 0, SEEK_SET) == 0 &&
+              writer.write(source, buffer);
+    if (!success) {
+      esp3d_log_e("Failed to write job of %s", path);
+    }
+  }
+  if (buffer) {
+    free(buffer);
+  }
+  if (writer.commands) {
+    free(writer.commands);
+  }
+  if (source) {
+    globalFs.close(source, path);
+  }
+  if (writer.index) {
+    globalFs.close(writer.index, index_path.c_str());
+    globalFs.remove(index_path.c_str());
+  }
+  if (writer.modal) {
+    globalFs.close(writer.modal, modal_path.c_str());
+    globalFs.remove(modal_path.c_str());
+  }
+  if (writer.job) {
+    globalFs.close(writer.job, tmp_path.c_str());
+    if (success) {
+      if (globalFs.exists(job_path.c_str())) {
+        globalFs.remove(job_path.c_str());
+      }
+      success = globalFs.rename(tmp_path.c_str(), job_path.c_str());
+    }
+    if (!success) {
+      globalFs.remove(tmp_path.c_str());
+    }
+  }
+  if (success) {
+    esp3d_log("Job %s: %ld lines, %ld commands of %ld bytes, in %lld ms",
+              job_path.c_str(), writer.header.source_lines,
+              writer.header.commands_count, writer.header.commands_size,
+              esp3d_hal::millis() - start_time);
+  }
+  return success;
+}
+
+// Source line (1 based) at a percentage of the job lines, 0 if job is empty
+uint32_t esp3d_gcode_job::getPercentLine(const ESP3DGcodeJobHeader *header,
+                                         uint8_t percent) {
+  if (header->source_lines == 0) {
+    return 0;
+  }
+  if (percent > 100) {
+    percent = 100;
+  }
+  return 1 + (uint32_t)(((uint64_t)(header->source_lines - 1) * percent) / 100);
+}
+
+// Get position in commands of a source line (1 based), and the modal state
+// before it, index and modal states avoid to parse the file from start
+// FS must already be accessed by caller
+bool esp3d_gcode_job::seek(const char *path, const ESP3DGcodeJobHeader *header,
+                           uint32_t line, uint32_t *offset,
+                           ESP3DGcodeModalState *state) {
+  if (line == 0 || line > header->source_lines) {
+    esp3d_log_e("Line %ld is out of range", line);
+    return false;
+  }
+  std::string job_path = jobPath(path);
+  FILE *fd = globalFs.open(job_path.c_str(), "r");
+  if (!fd) {
+    esp3d_log_e("Failed to open job %s", job_path.c_str());
+    return false;
+  }
+  uint32_t checkpoint = (line - 1) / header->modal_interval;
+  uint32_t checkpoint_offset = 0;
+  bool success =
+      fseek(fd, header->index_offset + (line - 1) * sizeof(uint32_t),
+            SEEK_SET) == 0 &&
+      fread(offset, sizeof(uint32_t), 1, fd) == 1 &&
+      fseek(fd,
+            header->index_offset +
+                checkpoint * header->modal_interval * sizeof(uint32_t),
+            SEEK_SET) == 0 &&
+      fread(&checkpoint_offset, sizeof(uint32_t), 1, fd) == 1 &&
+      fseek(fd,
+            header->modal_offset + checkpoint * sizeof(ESP3DGcodeModalState),
+            SEEK_SET) == 0 &&
+      fread(state, sizeof(ESP3DGcodeModalState), 1, fd) == 1 &&
+      fseek(fd, header->header_size + checkpoint_offset, SEEK_SET) == 0;
+  // commands between checkpoint and line update the modal state
+  size_t remaining = success ? *offset - checkpoint_offset : 0;
+  char *buffer = remaining ? (char *)malloc(STREAM_CHUNK_SIZE) : nullptr;
+  if (remaining && !buffer) {
+    success = false;
+  }
+  size_t buffer_length = 0;
+  while (success && remaining > 0) {
+    size_t size = STREAM_CHUNK_SIZE - buffer_length;
+    if (size > remaining) {
+      size = remaining;
+    }
+    size_t read = fread(buffer + buffer_length, 1, size, fd);
+    if (read == 0) {
+      success = false;
+      break;
+    }
+    remaining -= read;
+    buffer_length += read;
+    // commands are always complete in job, as long as lines are shorter
+    // than buffer
+    const char *command = buffer;
+    const char *end = buffer + buffer_length;
+    const char *eol = nullptr;
+    while ((eol = (const char *)memchr(command, '\n', end - command))) {
+      updateModalState(state, command, eol - command);
+      command = eol + 1;
+    }
+    buffer_length = end - command;
+    memmove(buffer, command, buffer_length);
+  }
+  if (buffer) {
+    free(buffer);
+  }
+  globalFs.close(fd, job_path.c_str());
+  if (!success) {
+    esp3d_log_e("Failed to seek line %ld in job %s", line, job_path.c_str());
+  }
+  return success;
+}
+
+// Read a number of a gcode word, return position after it
+static const char *esp3d_parse_number(const char *str, const char *end,
+                                      float *value) {
+  bool negative = false;
+  float divider = 0;
+  *value = 0;
+  if (str < end && (*str == '-' || *str == '+')) {
+    negative = (*str == '-');
+    str++;
+  }
+  for (; str < end; str++) {
+    if (*str >= '0' && *str <= '9') {
+      if (divider == 0) {
+        *value = *value * 10 + (*str - '0');
+      } else {
+        *value += (*str - '0') / divider;
+        divider *= 10;
+      }
+    } else if (*str == '.' && divider == 0) {
+      divider = 10;
+    } else if (*str != ' ') {
+      break;
+    }
+  }
+  if (negative) {
+    *value = -*value;
+  }
+  return str;
+}
+
+// Update modal state with words of a stripped command
+// Axis words are applied once the whole line is read, as a G code later on
+// the line can tell they are not a move (G10, G92, G43.1...)
+void esp3d_gcode_job::updateModalState(ESP3DGcodeModalState *state,
+                                       const char *command, size_t length) {
+  const char *end = command + length;
+  // system and ESP commands are not gcode
+  if (length == 0 || *command == '$' || *command == '[') {
+    return;
+  }
+  float axis_values[3] = {0, 0, 0};
+  uint8_t axes = 0;
+  float h_value = 0;
+  bool has_h = false;
+  bool not_a_move = false;
+  uint16_t tool_length = 0;
+  while (command < end) {
+    char letter = toupper(static_cast<unsigned char>(*command));
+    command++;
+    if (letter == '(') {
+      // skip inline comment
+      while (command < end && *command != ')') {
+        command++;
+      }
+      continue;
+    }
+    if (letter < 'A' || letter > 'Z') {
+      continue;
+    }
+    float value = 0;
+    command = esp3d_parse_number(command, end, &value);
+    // code with one decimal, like 59.1, as integer
+    int code = (int)(value * 10 + 0.5);
+    switch (letter) {
+      case 'G':
+        if (code == 200 || code == 210) {
+          state->units = code / 10;
+        } else if (code == 900 || code == 910) {
+          state->distance = code / 10;
+        } else if ((code >= 540 && code <= 590 && code % 10 == 0) ||
+                   (code >= 591 && code <= 593)) {
+          state->wcs = code;
+        } else if (code == 0 || code == 10 || code == 20 || code == 30) {
+          state->motion = code / 10;
+        } else if (code == 170 || code == 180 || code == 190) {
+          state->plane = code / 10;
+        } else if (code == 430 || code == 431 || code == 490) {
+          tool_length = code;
+        } else if (code == 40 || code == 100 || code == 280 || code == 300 ||
+                   code == 530 || code == 920 ||
+                   (code >= 382 && code <= 385)) {
+          // dwell, offsets, homing, machine moves and probing
+          not_a_move = true;
+        }
+        break;
+      case 'M':
+        if (code == 30 || code == 40 || code == 50) {
+          state->spindle = code / 10;
+        } else if (code == 70) {
+          state->coolant |= ESP3D_JOB_COOLANT_MIST;
+        } else if (code == 80) {
+          state->coolant |= ESP3D_JOB_COOLANT_FLOOD;
+        } else if (code == 90) {
+          state->coolant = 0;
+        }
+        break;
+      case 'F':
+        state->feedrate = value;
+        break;
+      case 'S':
+        state->spindle_speed = value;
+        break;
+      case 'H':
+        h_value = value;
+        has_h = true;
+        break;
+      case 'X':
+      case 'Y':
+      case 'Z':
+        axis_values[letter - 'X'] = value;
+        axes |= 1 << (letter - 'X');
+        break;
+      default:
+        break;
+    }
+  }
+  if (tool_length != 0) {
+    state->tool_length = tool_length;
+    state->tool_length_value =
+        tool_length == 431 ? axis_values[2] : (has_h ? h_value : 0);
+    // Z of G43.1 is the offset
+    return;
+  }
+  if (not_a_move) {
+    return;
+  }
+  // state is packed, its floats are copied instead of used by pointers which
+  // could be unaligned
+  float positions[3] = {state->x, state->y, state->z};
+  for (uint8_t i = 0; i < 3; i++) {
+    if (!(axes & (1 << i))) {
+      continue;
+    }
+    if (state->distance == 91) {
+      // relative move from an unknown position gives no position
+      if (state->axes & (1 << i)) {
+        positions[i] += axis_values[i];
+      }
+    } else {
+      positions[i] = axis_values[i];
+      state->axes |= 1 << i;
+    }
+  }
+  state->x = positions[0];
+  state->y = positions[1];
+  state->z = positions[2];
+  if ((state->axes & ESP3D_JOB_AXIS_Z) &&
+      (!(state->axes & ESP3D_JOB_Z_MAX_KNOWN) || state->z > state->z_max)) {
+    state->z_max = state->z;
+    state->axes |= ESP3D_JOB_Z_MAX_KNOWN;
+  }
+}
+
+// An arc cannot be made modal without its words, so a start line which
+// relies on the G2 / G3 of a previous line cannot be restored
+bool esp3d_gcode_job::canRestoreModalState(const ESP3DGcodeModalState *state) {
+  return state->motion <= 1;
+}
+
+// Word with 4 decimals at most, enough for inches, without trailing zeros
+static void esp3d_append_word(std::string &command, char letter, float value) {
+  char buffer[20];
+  int length = snprintf(buffer, sizeof(buffer), "%c%.4f", letter, value);
+  while (length > 2 && buffer[length - 1] == '0') {
+    length--;
+  }
+  if (buffer[length - 1] == '.') {
+    length--;
+  }
+  command.append(buffer, length);
+}
+
+// Commands restoring modal state, one per line, like:
+// G21 G90 G17 G54 G49
+// G0 Z5          retract to safe height
+// G0 X10 Y20     above start point
+// S12000 M3 M8   spindle and coolant
+// G4 P2          spindle spin up
+// G1 Z-1 F1000   plunge back
+// G1 G91 F1000   motion and distance mode of the program
+std::string esp3d_gcode_job::getModalStateCommand(
+    const ESP3DGcodeModalState *state) {
+  std::string command = "G" + std::to_string(state->units);
+  command += " G90 G" + std::to_string(state->plane);
+  command += " G" + std::to_string(state->wcs / 10);
+  if (state->wcs % 10) {
+    command += "." + std::to_string(state->wcs % 10);
+  }
+  if (state->tool_length == 431) {
+    command += " G43.1 ";
+    esp3d_append_word(command, 'Z', state->tool_length_value);
+  } else if (state->tool_length == 430) {
+    command += " G43 ";
+    esp3d_append_word(command, 'H', state->tool_length_value);
+  } else {
+    command += " G49";
+  }
+  if (state->axes & ESP3D_JOB_Z_MAX_KNOWN) {
+    command += "\nG0 ";
+    esp3d_append_word(command, 'Z', state->z_max);
+  }
+  if (state->axes & (ESP3D_JOB_AXIS_X | ESP3D_JOB_AXIS_Y)) {
+    command += "\nG0";
+    if (state->axes & ESP3D_JOB_AXIS_X) {
+      command += " ";
+      esp3d_append_word(command, 'X', state->x);
+    }
+    if (state->axes & ESP3D_JOB_AXIS_Y) {
+      command += " ";
+      esp3d_append_word(command, 'Y', state->y);
+    }
+  }
+  bool spindle_on = state->spindle != 5;
+  command += "\n";
+  if (spindle_on && state->spindle_speed > 0) {
+    esp3d_append_word(command, 'S', state->spindle_speed);
+    command += " ";
+  }
+  command += "M" + std::to_string(state->spindle);
+  if (state->coolant & ESP3D_JOB_COOLANT_MIST) {
+    command += " M7";
+  }
+  if (state->coolant & ESP3D_JOB_COOLANT_FLOOD) {
+    command += " M8";
+  }
+  if (!state->coolant) {
+    command += " M9";
+  }
+  if (spindle_on) {
+    command += "\nG4 P" + std::to_string(ESP3D_JOB_SPINDLE_DWELL);
+  }
+  if (state->axes & ESP3D_JOB_AXIS_Z) {
+    command += state->feedrate > 0 ? "\nG1 " : "\nG0 ";
+    esp3d_append_word(command, 'Z', state->z);
+    if (state->feedrate > 0) {
+      command += " ";
+      esp3d_append_word(command, 'F', state->feedrate);
+    }
+  }
+  // G1 alone needs a feed rate
+  command += "\nG" + std::to_string(state->feedrate > 0 ? state->motion : 0);
+  command += " G" + std::to_string(state->distance);
+  if (state->feedrate > 0) {
+    command += " ";
+    esp3d_append_word(command, 'F', state->feedrate);
+  }
+  return command;
+}
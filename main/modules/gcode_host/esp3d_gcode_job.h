@@ -0,0 +1,111 @@
+/*
+  esp3d_gcode_job
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+
+// Compiled job: sidecar of a gcode file, saved as <file>ESP3D_JOB_EXTENSION
+// It only contains the stripped commands, so streaming it needs less card
+// bandwidth and less parsing than the original file
+// Layout: header | commands, '\n' terminated | line index | modal states
+// Line index has one uint32_t per source line + 1: the offset in commands of
+// the first command at or after this line
+// Modal states are the state before line 1, 1 + interval, 1 + 2*interval...
+// so the state before any line is known by parsing less than interval lines
+// Source CRC covers the whole file when it is small, else evenly spaced
+// blocks of it, so checking a job does not read the whole source again
+#define ESP3D_JOB_EXTENSION ".job"
+#define ESP3D_JOB_MAGIC 0x4A443345  // "E3DJ"
+#define ESP3D_JOB_VERSION 5
+#define ESP3D_JOB_MODAL_INTERVAL 256
+#define ESP3D_JOB_CRC_BLOCKS 8
+// spindle spin up before plunging back at start line, in seconds
+#define ESP3D_JOB_SPINDLE_DWELL 2
+// bits of ESP3DGcodeModalState axes
+#define ESP3D_JOB_AXIS_X 0x01
+#define ESP3D_JOB_AXIS_Y 0x02
+#define ESP3D_JOB_AXIS_Z 0x04
+#define ESP3D_JOB_Z_MAX_KNOWN 0x08
+// bits of ESP3DGcodeModalState coolant, 0 is M9
+#define ESP3D_JOB_COOLANT_MIST 0x01
+#define ESP3D_JOB_COOLANT_FLOOD 0x02
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct __attribute__((packed)) ESP3DGcodeJobHeader {
+  uint32_t magic = ESP3D_JOB_MAGIC;
+  uint16_t version = ESP3D_JOB_VERSION;
+  uint16_t header_size = sizeof(ESP3DGcodeJobHeader);
+  uint32_t source_size = 0;     // size of the original file
+  uint32_t source_lines = 0;    // lines in the original file
+  uint32_t source_crc = 0;      // CRC32 of the original file
+  uint32_t commands_count = 0;  // lines in the compiled job
+  uint32_t commands_size = 0;   // bytes of commands after header
+  uint32_t index_offset = 0;    // position of line index in job file
+  uint32_t modal_offset = 0;    // position of modal states in job file
+  uint32_t modal_interval = ESP3D_JOB_MODAL_INTERVAL;
+};
+
+// Modal state restored when a job does not start from first line
+// Positions are in program units and work coordinates, as far as the
+// program tells them: G53, G28 and G30 moves are not followed
+struct __attribute__((packed)) ESP3DGcodeModalState {
+  uint8_t units = 21;           // G20 / G21
+  uint8_t distance = 90;        // G90 / G91
+  uint8_t spindle = 5;          // M3 / M4 / M5
+  uint16_t wcs = 540;           // G54 to G59 as 540 to 590, G59.1 as 591...
+  float feedrate = 0;           // F
+  float spindle_speed = 0;      // S
+  uint8_t motion = 0;           // G0 / G1 / G2 / G3
+  uint8_t plane = 17;           // G17 / G18 / G19
+  uint8_t coolant = 0;          // M7 / M8 bits, M9 clears them
+  uint16_t tool_length = 490;   // G49, G43 as 430, G43.1 as 431
+  float tool_length_value = 0;  // H of G43, Z of G43.1
+  uint8_t axes = 0;             // axes with a known position
+  float x = 0;
+  float y = 0;
+  float z = 0;
+  float z_max = 0;  // highest Z reached, used as safe height
+};
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+namespace esp3d_gcode_job {
+void trimLine(const char **line, size_t *length);
+size_t stripParenComments(char *line, size_t length);
+bool isGcodeFile(const char *path);
+std::string jobPath(const char *path);
+bool getJob(const char *path, ESP3DGcodeJobHeader *header);
+bool compile(const char *path);
+uint32_t getPercentLine(const ESP3DGcodeJobHeader *header, uint8_t percent);
+bool seek(const char *path, const ESP3DGcodeJobHeader *header, uint32_t line,
+          uint32_t *offset, ESP3DGcodeModalState *state);
+void updateModalState(ESP3DGcodeModalState *state, const char *command,
+                      size_t length);
+bool canRestoreModalState(const ESP3DGcodeModalState *state);
+std::string getModalStateCommand(const ESP3DGcodeModalState *state);
+}  // namespace esp3d_gcode_job
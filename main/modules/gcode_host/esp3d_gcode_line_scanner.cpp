@@ -0,0 +1,113 @@
+/*
+  esp3d_gcode_line_scanner
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "esp3d_gcode_line_scanner.h"
+
+#include <string.h>
+
+#include "esp3d_gcode_job.h"
+
+/// @brief Set the chunk to scan, the previous one must be fully scanned as
+/// the carry only keeps the beginning of one line
+/// @param data The chunk, it must stay valid until it is fully scanned
+/// @param length The number of bytes of the chunk
+void ESP3DGcodeLineScanner::setChunk(const char *data, size_t length) {
+  _data = data;
+  _length = length;
+  _cursor = 0;
+}
+
+/// @brief Forget current chunk, when the stream is opened or closed
+void ESP3DGcodeLineScanner::reset() {
+  setChunk(nullptr, 0);
+  _after_cr = false;
+}
+
+void ESP3DGcodeLineScanner::resetStats() {
+  _scanned_lines = 0;
+  _straddled_lines = 0;
+}
+
+/// @brief Scan the current chunk up to the next command, empty lines and
+/// comment only lines are skipped, (...) comments are stripped
+/// @param command The stripped command when found, else the beginning of a
+/// line straddling the next chunk, it must be empty for a new line
+/// @param position Increased by the bytes consumed, end of line included
+/// @return command if a command is found, need_chunk when the chunk is fully
+/// scanned, too_long if the line exceeds ESP3D_GCODE_MAX_LINE_LENGTH
+ESP3DGcodeLineScan ESP3DGcodeLineScanner::scan(std::string *command,
+                                               uint64_t *position) {
+  while (_cursor < _length) {
+    const char *line = _data + _cursor;
+    size_t available = _length - _cursor;
+    const char *eol = (const char *)memchr(line, '\n', available);
+    const char *cr =
+        (const char *)memchr(line, '\r', eol ? eol - line : available);
+    if (cr) {
+      eol = cr;
+    }
+    size_t line_length = eol ? eol - line : available;
+    // What ever we read it increase the cursor pos, end of line included
+    size_t consumed = eol ? line_length + 1 : available;
+    _cursor += consumed;
+    *position += consumed;
+    if (command->length() + line_length > ESP3D_GCODE_MAX_LINE_LENGTH) {
+      return ESP3DGcodeLineScan::too_long;
+    }
+    if (!eol) {
+      // end of line is in next chunk, keep the beginning of the line
+      if (command->length() == 0) {
+        _straddled_lines++;
+      }
+      command->append(line, line_length);
+      _after_cr = false;
+      break;
+    }
+    // '\n' of a "\r\n" end of line is not another line
+    bool crlf = _after_cr && line_length == 0 && *eol == '\n';
+    _after_cr = *eol == '\r';
+    if (crlf) {
+      continue;
+    }
+    _scanned_lines++;
+    if (command->length() > 0) {
+      command->append(line, line_length);
+      line = command->c_str();
+      line_length = command->length();
+    }
+    esp3d_gcode_job::trimLine(&line, &line_length);
+    if (line_length == 0) {
+      // empty line or comment only, continue to read
+      command->clear();
+      continue;
+    }
+    command->assign(line, line_length);
+    if (command->find('(') != std::string::npos) {
+      // comments are stripped in place, the line can be a comment only
+      command->resize(esp3d_gcode_job::stripParenComments(&(*command)[0],
+                                                          command->length()));
+      if (command->length() == 0) {
+        continue;
+      }
+    }
+    return ESP3DGcodeLineScan::command;
+  }
+  return ESP3DGcodeLineScan::need_chunk;
+}
@@ -0,0 +1,60 @@
+/*
+  esp3d_gcode_line_scanner
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+
+// Longest command sent to the controller, end of line excluded
+#define ESP3D_GCODE_MAX_LINE_LENGTH 255
+
+enum class ESP3DGcodeLineScan : uint8_t {
+  command,     // a stripped command is available
+  need_chunk,  // chunk is fully scanned, next one is needed
+  too_long,    // line exceeds ESP3D_GCODE_MAX_LINE_LENGTH
+};
+
+// Splits the chunks read ahead by the prefetcher into stripped commands
+// Lines are searched in place in the chunk, the command string is only filled
+// once with the stripped line, or used as carry when the line straddles two
+// chunks, so a stream does not allocate once the command string is reserved
+class ESP3DGcodeLineScanner final {
+ public:
+  void setChunk(const char *data, size_t length);
+  bool needChunk() { return _cursor >= _length; }
+  void reset();
+  ESP3DGcodeLineScan scan(std::string *command, uint64_t *position);
+  size_t getCursor() { return _cursor; }
+  size_t getLength() { return _length; }
+  uint64_t getScannedLines() { return _scanned_lines; }
+  uint64_t getStraddledLines() { return _straddled_lines; }
+  void resetStats();
+
+ private:
+  const char *_data = nullptr;  // current chunk, owned by the prefetcher
+  size_t _length = 0;
+  size_t _cursor = 0;
+  bool _after_cr = false;  // last line ended by '\r'
+  uint64_t _scanned_lines = 0;
+  // lines split by a chunk boundary, they are copied twice
+  uint64_t _straddled_lines = 0;
+};
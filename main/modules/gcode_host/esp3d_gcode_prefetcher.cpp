@@ -0,0 +1,234 @@
+/*
+  esp3d_gcode_prefetcher
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#include "esp3d_gcode_prefetcher.h"
+
+#include <stdlib.h>
+
+#include "esp3d_hal.h"
+#include "esp3d_log.h"
+
+// max time to wait for a chunk from the card before giving up
+#define ESP3D_PREFETCH_TIMEOUT 5000  // milliseconds
+
+static void esp3d_gcode_prefetch_task(void* pvParameter) {
+  ESP3DGcodePrefetcher* prefetcher = (ESP3DGcodePrefetcher*)pvParameter;
+  prefetcher->readerTask();
+  vTaskDelete(NULL);
+}
+
+ESP3DGcodePrefetcher::ESP3DGcodePrefetcher() {}
+
+ESP3DGcodePrefetcher::~ESP3DGcodePrefetcher() { end(); }
+
+bool ESP3DGcodePrefetcher::begin() {
+  end();
+  for (uint8_t i = 0; i < STREAM_CHUNK_COUNT; i++) {
+    _chunks[i].data = (char*)malloc(STREAM_CHUNK_SIZE);
+    _chunks[i].length = 0;
+    if (_chunks[i].data == nullptr) {
+      esp3d_log_e("Failed to allocate prefetch chunk %d", i);
+      end();
+      return false;
+    }
+  }
+  _free_queue = xQueueCreate(STREAM_CHUNK_COUNT, sizeof(uint8_t));
+  _filled_queue = xQueueCreate(STREAM_CHUNK_COUNT, sizeof(uint8_t));
+  _start_semaphore = xSemaphoreCreateBinary();
+  _idle_semaphore = xSemaphoreCreateBinary();
+  if (!_free_queue || !_filled_queue || !_start_semaphore ||
+      !_idle_semaphore) {
+    esp3d_log_e("Failed to create prefetch queues");
+    end();
+    return false;
+  }
+  for (uint8_t i = 0; i < STREAM_CHUNK_COUNT; i++) {
+    xQueueSend(_free_queue, &i, 0);
+  }
+  // reader is idle until first start
+  xSemaphoreGive(_idle_semaphore);
+  BaseType_t res = xTaskCreatePinnedToCore(
+      esp3d_gcode_prefetch_task, "esp3d_gcode_prefetch_task",
+      ESP3D_GCODE_PREFETCH_TASK_SIZE, this, ESP3D_GCODE_PREFETCH_TASK_PRIORITY,
+      &_xHandle, ESP3D_GCODE_PREFETCH_TASK_CORE);
+  if (res != pdPASS || !_xHandle) {
+    esp3d_log_e("Prefetch task creation failed");
+    _xHandle = NULL;
+    end();
+    return false;
+  }
+  esp3d_log("Prefetch started with %d chunks of %d bytes", STREAM_CHUNK_COUNT,
+            STREAM_CHUNK_SIZE);
+  return true;
+}
+
+void ESP3DGcodePrefetcher::end() {
+  if (_xHandle) {
+    stop();
+    vTaskDelete(_xHandle);
+    _xHandle = NULL;
+  }
+  if (_free_queue) {
+    vQueueDelete(_free_queue);
+    _free_queue = NULL;
+  }
+  if (_filled_queue) {
+    vQueueDelete(_filled_queue);
+    _filled_queue = NULL;
+  }
+  if (_start_semaphore) {
+    vSemaphoreDelete(_start_semaphore);
+    _start_semaphore = NULL;
+  }
+  if (_idle_semaphore) {
+    vSemaphoreDelete(_idle_semaphore);
+    _idle_semaphore = NULL;
+  }
+  for (uint8_t i = 0; i < STREAM_CHUNK_COUNT; i++) {
+    if (_chunks[i].data) {
+      free(_chunks[i].data);
+      _chunks[i].data = nullptr;
+    }
+    _chunks[i].length = 0;
+  }
+  _current_chunk = -1;
+  _eof = false;
+  _file = nullptr;
+}
+
+// Start to read ahead the file from its current position
+// size is the bytes to read, by default until end of file
+bool ESP3DGcodePrefetcher::start(FILE* file, uint64_t size) {
+  if (!_xHandle || file == nullptr) {
+    esp3d_log_e("Prefetch not ready");
+    return false;
+  }
+  stop();
+  // reader is now idle, the session starts
+  xSemaphoreTake(_idle_semaphore, portMAX_DELAY);
+  _file = file;
+  _remaining = size;
+  _running = true;
+  xSemaphoreGive(_start_semaphore);
+  return true;
+}
+
+// Stop reading, so the file can be closed or seeked safely
+void ESP3DGcodePrefetcher::stop() {
+  if (!_xHandle) {
+    return;
+  }
+  uint8_t index = 0;
+  _running = false;
+  // wake up the reader if it waits for a free chunk
+  xQueueSend(_free_queue, &index, 0);
+  // wait for the reader to be out of fread
+  xSemaphoreTake(_idle_semaphore, portMAX_DELAY);
+  xQueueReset(_free_queue);
+  xQueueReset(_filled_queue);
+  for (index = 0; index < STREAM_CHUNK_COUNT; index++) {
+    xQueueSend(_free_queue, &index, 0);
+  }
+  _current_chunk = -1;
+  _eof = false;
+  _file = nullptr;
+  xSemaphoreGive(_idle_semaphore);
+}
+
+void ESP3DGcodePrefetcher::resetStats() {
+  _reader_stalls = 0;
+  _consumer_stalls = 0;
+  _consumer_max_wait = 0;
+}
+
+void ESP3DGcodePrefetcher::_releaseCurrentChunk() {
+  if (_current_chunk >= 0) {
+    uint8_t index = (uint8_t)_current_chunk;
+    xQueueSend(_free_queue, &index, 0);
+    _current_chunk = -1;
+  }
+}
+
+// Give next chunk of file, previous one is released so it can be refilled
+// return the chunk size, 0 if end of file or error
+size_t ESP3DGcodePrefetcher::read(const char** data) {
+  uint8_t index = 0;
+  *data = nullptr;
+  if (!_xHandle) {
+    return 0;
+  }
+  _releaseCurrentChunk();
+  if (_eof) {
+    return 0;
+  }
+  if (xQueueReceive(_filled_queue, &index, 0) != pdTRUE) {
+    // the card is slower than the host
+    _consumer_stalls++;
+    uint64_t start_wait = esp3d_hal::millis();
+    if (xQueueReceive(_filled_queue, &index,
+                      pdMS_TO_TICKS(ESP3D_PREFETCH_TIMEOUT)) != pdTRUE) {
+      esp3d_log_e("Timeout waiting for file data");
+      return 0;
+    }
+    uint32_t wait_time = (uint32_t)(esp3d_hal::millis() - start_wait);
+    if (wait_time > _consumer_max_wait) {
+      _consumer_max_wait = wait_time;
+    }
+  }
+  _current_chunk = index;
+  if (_chunks[index].length == 0) {
+    esp3d_log("End of prefetched file");
+    _eof = true;
+    return 0;
+  }
+  *data = _chunks[index].data;
+  return _chunks[index].length;
+}
+
+// Fill free chunks while session is running
+void ESP3DGcodePrefetcher::readerTask() {
+  uint8_t index = 0;
+  while (1) {
+    xSemaphoreTake(_start_semaphore, portMAX_DELAY);
+    while (_running) {
+      if (xQueueReceive(_free_queue, &index, 0) != pdTRUE) {
+        // all chunks are filled, the host is slower than the card
+        _reader_stalls++;
+        xQueueReceive(_free_queue, &index, portMAX_DELAY);
+      }
+      if (!_running) {
+        break;
+      }
+      ESP3DGcodeChunk* chunk = &_chunks[index];
+      size_t size = STREAM_CHUNK_SIZE - 1;
+      if (_remaining < size) {
+        size = _remaining;
+      }
+      chunk->length = size ? fread(chunk->data, sizeof(char), size, _file) : 0;
+      chunk->data[chunk->length] = 0;
+      _remaining -= chunk->length;
+      xQueueSend(_filled_queue, &index, portMAX_DELAY);
+      if (chunk->length == 0) {
+        // end of file or read error, nothing more to read in this session
+        break;
+      }
+    }
+    xSemaphoreGive(_idle_semaphore);
+  }
+}
@@ -0,0 +1,82 @@
+/*
+  esp3d_gcode_prefetcher
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "tasks_def.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Read ahead of a streamed file, done by its own task so the gcode host
+// never waits for card I/O between lines
+// STREAM_CHUNK_COUNT chunks of STREAM_CHUNK_SIZE bytes are allocated once
+// in begin(), the free ones are filled by the task while the host consumes
+// the current one
+struct ESP3DGcodeChunk {
+  char *data = nullptr;  // STREAM_CHUNK_SIZE bytes, 0x0 terminated
+  size_t length = 0;     // 0 means end of file or read error
+};
+
+class ESP3DGcodePrefetcher final {
+ public:
+  ESP3DGcodePrefetcher();
+  ~ESP3DGcodePrefetcher();
+  bool begin();
+  void end();
+  bool start(FILE *file, uint64_t size = UINT64_MAX);
+  void stop();
+  size_t read(const char **data);
+  void readerTask();
+  uint32_t getReaderStalls() { return _reader_stalls; }
+  uint32_t getConsumerStalls() { return _consumer_stalls; }
+  uint32_t getConsumerMaxWait() { return _consumer_max_wait; }
+  void resetStats();
+
+ private:
+  void _releaseCurrentChunk();
+  ESP3DGcodeChunk _chunks[STREAM_CHUNK_COUNT];
+  QueueHandle_t _free_queue = NULL;    // index of chunks to be filled
+  QueueHandle_t _filled_queue = NULL;  // index of chunks to be consumed
+  SemaphoreHandle_t _start_semaphore = NULL;
+  SemaphoreHandle_t _idle_semaphore = NULL;
+  TaskHandle_t _xHandle = NULL;
+  FILE *_file = nullptr;
+  uint64_t _remaining = 0;  // bytes left to read in session
+  volatile bool _running = false;
+  int8_t _current_chunk = -1;  // chunk currently used by consumer
+  bool _eof = false;
+  // reader waited for a free chunk: host is the bottleneck
+  uint32_t _reader_stalls = 0;
+  // consumer waited for a filled chunk: card I/O is the bottleneck
+  uint32_t _consumer_stalls = 0;
+  uint32_t _consumer_max_wait = 0;  // milliseconds
+};
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
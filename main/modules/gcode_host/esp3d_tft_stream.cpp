@@ -46,6 +46,9 @@
 #define TASKPRIORITY STREAM_TASK_PRIORITY
 #define TASKCORE     STREAM_TASK_CORE
 
+// max sleep of stream task when no message is queued
+#define ESP3D_STREAM_HOUSEKEEPING_INTERVAL 1000  // milliseconds
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -77,7 +80,15 @@ static void streamTask(void *pvParameter)
             esp3dTftstream.handle();
             xSemaphoreGive(xStreamSemaphore);
         }
-        esp3d_hal::wait(10);
+        // Sleep until an output client queues a message
+        if (esp3dTftstream.hasPendingData())
+        {
+            taskYIELD();
+        }
+        else
+        {
+            ESP3DClient::waitForData(ESP3D_STREAM_HOUSEKEEPING_INTERVAL);
+        }
     }
 
     /* A task should NEVER return */
@@ -113,6 +124,15 @@ bool ESP3DTftStream::begin()
     if (res == pdPASS && xHandle)
     {
         esp3d_log("Created Stream Task");
+        // output clients wake up the task when they queue a message
+        serialClient.setNotifyTask(xHandle);
+#if ESP3D_USB_SERIAL_FEATURE
+        usbSerialClient.setNotifyTask(xHandle);
+#endif  // ESP3D_USB_SERIAL_FEATURE
+#if ESP3D_BT_FEATURE
+        btSerialClient.setNotifyTask(xHandle);
+        btBleClient.setNotifyTask(xHandle);
+#endif  // ESP3D_BT_FEATURE
         // to let buffer time to empty
 #if ESP3D_TFT_LOG
         esp3d_hal::wait(100);
@@ -195,6 +215,20 @@ bool ESP3DTftStream::begin()
     return false;
 }
 
+// Messages not yet processed by the output clients
+bool ESP3DTftStream::hasPendingData()
+{
+    size_t count = serialClient.getRxMsgsCount() + serialClient.getTxMsgsCount();
+#if ESP3D_USB_SERIAL_FEATURE
+    count += usbSerialClient.getRxMsgsCount() + usbSerialClient.getTxMsgsCount();
+#endif  // ESP3D_USB_SERIAL_FEATURE
+#if ESP3D_BT_FEATURE
+    count += btSerialClient.getRxMsgsCount() + btSerialClient.getTxMsgsCount();
+    count += btBleClient.getRxMsgsCount() + btBleClient.getTxMsgsCount();
+#endif  // ESP3D_BT_FEATURE
+    return count > 0;
+}
+
 void ESP3DTftStream::handle()
 {
     serialClient.handle();
@@ -25,6 +25,7 @@
 #include "esp3d_string.h"
 #include "esp_wifi.h"
 #include "filesystem/esp3d_sd.h"
+#include "gcode_host/esp3d_gcode_job.h"
 #include "http/esp3d_http_service.h"
 
 /* TODO: to change file time to match original one if needed
@@ -123,6 +124,19 @@ esp_err_t ESP3DHttpService::upload_to_sd_handler(
           return ESP_FAIL;
         }
       }
+      // compile gcode file now, so streaming it later is faster
+      if (esp3dTftsettings.readByte(ESP3DSettingIndex::esp3d_job_compile) ==
+              (uint8_t)ESP3DState::on &&
+          esp3d_gcode_job::isGcodeFile(filename)) {
+        std::string path = sd.mount_point();
+        if (filename[0] != '/') {
+          path += "/";
+        }
+        path += filename;
+        if (!esp3d_gcode_job::compile(path.c_str())) {
+          esp3d_log_w("Failed to compile %s", filename);
+        }
+      }
       isAccessed = false;
       sd.releaseFS();
       break;
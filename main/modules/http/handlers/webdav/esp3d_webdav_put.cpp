@@ -20,8 +20,10 @@
 #include <stdio.h>
 
 #include "esp3d_log.h"
+#include "esp3d_settings.h"
 #include "esp3d_string.h"
 #include "filesystem/esp3d_globalfs.h"
+#include "gcode_host/esp3d_gcode_job.h"
 #include "http/esp3d_http_service.h"
 #include "webdav/esp3d_webdav_service.h"
 #if ESP3D_TIMESTAMP_FEATURE
@@ -178,6 +180,15 @@ esp_err_t ESP3DHttpService::webdav_put_handler(httpd_req_t* req) {
                 response_msg =
                     "File receiving failed: size do not "
                     "match!";
+              } else if (!hasError &&
+                         esp3dTftsettings.readByte(
+                             ESP3DSettingIndex::esp3d_job_compile) ==
+                             (uint8_t)ESP3DState::on &&
+                         esp3d_gcode_job::isGcodeFile(uri.c_str())) {
+                // compile gcode file now, so streaming it later is faster
+                if (!esp3d_gcode_job::compile(uri.c_str())) {
+                  esp3d_log_w("Failed to compile %s", uri.c_str());
+                }
               }
             } else {
               esp3d_log_e("Failed to open file");
@@ -32,6 +32,7 @@
 #include "esp3d_log.h"
 #include "esp3d_settings.h"
 #include "esp3d_string.h"
+#include "esp3d_tft_network.h"
 #include "esp3d_values.h"
 #include "translations/esp3d_translation_service.h"
 
@@ -149,6 +150,7 @@ wifi_sta_event_handler(void *arg, esp_event_base_t event_base, int32_t event_id,
         esp3d_log_d("Client IP was lost");
         esp3dTftValues.set_string_value(ESP3DValuesIndex::status_bar_label, "0.0.0.0");
         xEventGroupSetBits(esp3dNetwork.getEventGroup(), WIFI_STA_LOST_IP);
+        esp3dTftnetwork.notify();
     }
 }
 
@@ -272,6 +274,7 @@ bool ESP3DNetwork::setModeAsync(ESP3DRadioMode mode)
 {
     _async_radio_mode = mode;
     esp3d_log_d("Enabling async mode to %d", (uint8_t)_async_radio_mode);
+    esp3dTftnetwork.notify();
     return true;
 }
 
@@ -36,6 +36,8 @@
 #define TASKPRIORITY NETWORK_TASK_PRIORITY
 #define TASKCORE NETWORK_TASK_CORE
 
+#define ESP3D_NETWORK_HOUSEKEEPING_INTERVAL 1000  // milliseconds
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -61,8 +63,9 @@ static void networkTask(void *pvParameter) {
   esp3dNetwork.begin();
   esp3d_hal::wait(100);
   while (1) {
-    /* Delay */
-    esp3d_hal::wait(10);
+    // Sleep until a network event, timeout is for services housekeeping
+    ulTaskNotifyTake(pdTRUE,
+                     pdMS_TO_TICKS(ESP3D_NETWORK_HOUSEKEEPING_INTERVAL));
 
     if (pdTRUE == xSemaphoreTake(xNetworkSemaphore, portMAX_DELAY)) {
       esp3dTftnetwork.handle();
@@ -81,11 +84,10 @@ ESP3DTftNetwork::~ESP3DTftNetwork() {}
 bool ESP3DTftNetwork::begin() {
   esp3d_log("Free mem %ld", esp_get_minimum_free_heap_size());
   // Ui creation
-  TaskHandle_t xHandle = NULL;
   BaseType_t res =
       xTaskCreatePinnedToCore(networkTask, "tftNetwork", STACKDEPTH, NULL,
-                              TASKPRIORITY, &xHandle, TASKCORE);
-  if (res == pdPASS && xHandle) {
+                              TASKPRIORITY, &_xHandle, TASKCORE);
+  if (res == pdPASS && _xHandle) {
     esp3d_log("Created Network Task");
     esp3d_log("Free mem %ld", esp_get_minimum_free_heap_size());
     return true;
@@ -98,4 +100,11 @@ bool ESP3DTftNetwork::begin() {
 
 void ESP3DTftNetwork::handle() { esp3dNetwork.handle(); }
 
+// Wake up network task to handle a new event
+void ESP3DTftNetwork::notify() {
+  if (_xHandle) {
+    xTaskNotifyGive(_xHandle);
+  }
+}
+
 bool ESP3DTftNetwork::end() { return true; }
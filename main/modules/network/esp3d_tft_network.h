@@ -20,6 +20,9 @@
 
 #pragma once
 #include <stdio.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -30,10 +33,12 @@ class ESP3DTftNetwork final {
   ~ESP3DTftNetwork();
   bool begin();
   void handle();
+  void notify();
   bool end();
 
  private:
   bool _started;
+  TaskHandle_t _xHandle = NULL;
 };
 
 extern ESP3DTftNetwork esp3dTftnetwork;
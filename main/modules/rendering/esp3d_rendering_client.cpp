@@ -27,24 +27,53 @@
 #include "esp3d_log.h"
 #include "esp3d_settings.h"
 #include "esp3d_string.h"
+#include "esp_timer.h"
 #include "freertos/task.h"
 #include "gcode_host/esp3d_gcode_host_service.h"
 #include "tasks_def.h"
 
+#if TARGET_IS_GRBLHAL
+#include "esp3d_jog_engine.h"
+#include "esp3d_override_engine.h"
+#else
+// only grblHAL status reports are polled, the task wakes up for messages
+#define ESP3D_POLLING_IDLE_INTERVAL 1000
+#endif  // TARGET_IS_GRBLHAL
+#if ESP3D_BRIGHTNESS_CONTROL_FEATURE
+#include "disp_backlight.h"
+#endif  // ESP3D_BRIGHTNESS_CONTROL_FEATURE
+#if TARGET_IS_GRBLHAL && \
+    (ESP3D_HARDWARE_ENCODER_FEATURE || ESP3D_HARDWARE_POTENTIOMETER_FEATURE)
+#include "control_input.h"
+#endif  // TARGET_IS_GRBLHAL && (ENCODER || POTENTIOMETER)
+
 ESP3DRenderingClient renderingClient;
 
 #define RX_FLUSH_TIME_OUT 1500  // milliseconds timeout
 
-#define ESP3D_POLLING_INTERVAL 3000  // milliseconds
+// a status request not answered after this delay is sent again
+#define ESP3D_POLLING_TIMEOUT 1000  // milliseconds
 
 // this task only collecting rendering RX data and push thenmm to Rx Queue
 static void esp3d_rendering_rx_task(void *pvParameter) {
   (void)pvParameter;
 
   while (1) {
-    /* Delay */
-    esp3d_hal::wait(10);
     renderingClient.handle();
+    // Sleep until a message is queued, next status request, next jog
+    // segment or next override burst is due
+    if (renderingClient.getRxMsgsCount() == 0) {
+      uint32_t delay = renderingClient.getPollingDelay();
+#if TARGET_IS_GRBLHAL
+      if (esp3dJogEngine.getDelay() < delay) {
+        delay = esp3dJogEngine.getDelay();
+      }
+      if (esp3dOverrideEngine.getDelay() < delay) {
+        delay = esp3dOverrideEngine.getDelay();
+      }
+#endif  // TARGET_IS_GRBLHAL
+      ESP3DClient::waitForData(delay);
+    }
   }
   /* A task should NEVER return */
   vTaskDelete(NULL);
@@ -55,6 +84,10 @@ bool ESP3DRenderingClient::sendGcode(const char *data) {
   if (data == nullptr || strlen(data) == 0) {
     return false;
   }
+  // realtime command is sent as is, without \n
+  if (strlen(data) == 1 && esp3dGcodeParser.isRealTimeCommand(data[0])) {
+    return sendRealTimeCommand(data[0]);
+  }
   // the command must end with \n, so we add it if not present
   std::string cmd = "";
   ESP3DRequest requestId = {.id = 0};
@@ -69,9 +102,27 @@ bool ESP3DRenderingClient::sendGcode(const char *data) {
       ESP3DClientType::rendering, ESP3DAuthenticationLevel::admin);
 }
 
+// Feed hold, resume, overrides... from UI are sent to output client ahead
+// of queued commands
+bool ESP3DRenderingClient::sendRealTimeCommand(uint8_t cmd) {
+  return esp3dCommands.dispatchRealTimeCommand(cmd);
+}
+
 ESP3DRenderingClient::ESP3DRenderingClient() {
   _started = false;
+  _polling_on = false;
   _xHandle = NULL;
+  _polling_delay = ESP3D_POLLING_IDLE_INTERVAL;
+  _last_poll_time = 0;
+  _last_report_time = 0;
+  _poll_sent_time = 0;
+  _poll_count = 0;
+  _poll_timeouts = 0;
+  _poll_rtt_avg = 0;
+  _poll_rtt_max = 0;
+  _poll_rate = 0;
+  _rate_window_count = 0;
+  _rate_window_start = 0;
 }
 ESP3DRenderingClient::~ESP3DRenderingClient() { end(); }
 
@@ -102,6 +153,15 @@ bool ESP3DRenderingClient::begin() {
 
   if (res == pdPASS && _xHandle) {
     esp3d_log("Created Rendering Task");
+    setNotifyTask(_xHandle);
+#if TARGET_IS_GRBLHAL
+    esp3dJogEngine.loadAcceleration();
+    esp3dJogEngine.setNotifyTask(_xHandle);
+#endif  // TARGET_IS_GRBLHAL
+#if TARGET_IS_GRBLHAL && \
+    (ESP3D_HARDWARE_ENCODER_FEATURE || ESP3D_HARDWARE_POTENTIOMETER_FEATURE)
+    control_input_set_consumer(_xHandle, ESP3D_CLIENT_NOTIFY_INDEX);
+#endif  // TARGET_IS_GRBLHAL && (ENCODER || POTENTIOMETER)
     esp3d_log("Rendering client started");
     flush();
     if (esp3dTftsettings.readByte(ESP3DSettingIndex::esp3d_polling_on) == 1) {
@@ -118,55 +178,172 @@ bool ESP3DRenderingClient::begin() {
 }
 
 void ESP3DRenderingClient::handle() {
-  static uint64_t now = esp3d_hal::millis();
-  static uint8_t polling_cmd_index = 0;
   if (_started) {
     if (getRxMsgsCount() > 0) {
       if (pdTRUE == xSemaphoreTake(_xGuiSemaphore, portMAX_DELAY)) {
         ESP3DMessage *msg = popRx();
         if (msg) {
           esp3d_log("Rendering client received message: %s", (char *)msg->data);
-          esp3dGcodeParser.processCommand((char *)msg->data);
+          if (esp3dGcodeParser.processCommand((char *)msg->data) &&
+              msg->data_type == ESP3DDataType::status) {
+            _onStatusReport();
+          }
           deleteMsg(msg);
         };
         xSemaphoreGive(_xGuiSemaphore);
       }
     }
-    // LUC: FIXME
-    if (_polling_on && 0) {
-      if (esp3d_hal::millis() - now >
-          ESP3D_POLLING_INTERVAL / ESP3D_POLLING_COMMANDS_COUNT) {
-        esp3d_log("Polling interval reached, list size is %d",
-                  gcodeHostService.getScriptsListSize());
-        const char **pollingCommands = esp3dGcodeParser.getPollingCommands();
-        if (pollingCommands == nullptr) {
-          return;
-        }
-        // reset index if needed
-        if (polling_cmd_index >= ESP3D_POLLING_COMMANDS_COUNT)
-          polling_cmd_index = 0;
-        // send command if not already in queue and last response is too old
-        bool is_in_queue = gcodeHostService.hasStreamListCommand(
-            pollingCommands[polling_cmd_index]);
-        bool is_recently_processed =
-            ((esp3d_hal::millis() -
-              esp3dGcodeParser.getPollingCommandsLastRun(polling_cmd_index)) <
-             ESP3D_POLLING_INTERVAL);
-        esp3d_log("Command %s in queue: %d, recently processed: %d",
-                  pollingCommands[polling_cmd_index], is_in_queue,
-                  is_recently_processed);
-        if (!is_in_queue && !is_recently_processed) {
-          esp3d_log("Sending command %s", pollingCommands[polling_cmd_index]);
-          sendGcode(pollingCommands[polling_cmd_index]);
-        } else {
-          esp3d_log_w("Command %s already in queue or recently processed",
-                      pollingCommands[polling_cmd_index]);
-        }
-        polling_cmd_index++;
-        now = esp3d_hal::millis();
+#if TARGET_IS_GRBLHAL
+    _readInput();
+    esp3dJogEngine.handle();
+    esp3dOverrideEngine.handle();
+#endif  // TARGET_IS_GRBLHAL
+    _pollStatus();
+  }
+}
+
+// Encoder and potentiometer come from the input task queue with the time of
+// their interrupt, not through the UI, so a redraw does not delay them
+void ESP3DRenderingClient::_readInput() {
+#if TARGET_IS_GRBLHAL && \
+    (ESP3D_HARDWARE_ENCODER_FEATURE || ESP3D_HARDWARE_POTENTIOMETER_FEATURE)
+  control_event_t event;
+  while (control_input_pop(&event)) {
+    switch (event.family_id) {
+      case CONTROL_FAMILY_ENCODER:
+        esp3dJogEngine.addClicks(event.steps, event.velocity,
+                                 event.timestamp_us);
+        break;
+      case CONTROL_FAMILY_POTENTIOMETER:
+        esp3dOverrideEngine.setPosition(event.steps);
+        break;
+      default:
+        break;
+    }
+  }
+#endif  // TARGET_IS_GRBLHAL && (ENCODER || POTENTIOMETER)
+}
+
+// Round trip time of the pending request, if any
+void ESP3DRenderingClient::_onStatusReport() {
+  _rate_window_count++;
+  _last_report_time = esp3d_hal::millis();
+  if (_poll_sent_time == 0) {
+    return;
+  }
+  uint32_t rtt = (uint32_t)(esp_timer_get_time() - _poll_sent_time);
+  _poll_sent_time = 0;
+  // smoothed over last 8 reports
+  _poll_rtt_avg = _poll_rtt_avg ? (_poll_rtt_avg * 7 + rtt) / 8 : rtt;
+  if (rtt > _poll_rtt_max) {
+    _poll_rtt_max = rtt;
+  }
+}
+
+bool ESP3DRenderingClient::isStatusPushed() {
+#if TARGET_IS_GRBLHAL
+  return esp3dGcodeParser.getStatusPushMode() == ESP3DStatusPushMode::active;
+#else
+  return false;
+#endif  // TARGET_IS_GRBLHAL
+}
+
+bool ESP3DRenderingClient::_isScreenOff() {
+#if ESP3D_BRIGHTNESS_CONTROL_FEATURE
+  return backlight_get_current() == 0;
+#else
+  return false;
+#endif  // ESP3D_BRIGHTNESS_CONTROL_FEATURE
+}
+
+// Status is asked with the realtime '?', so it is answered even when the
+// controller buffer is full, one request at a time, at the interval the
+// machine state needs
+// $G and $# go through the stream, only when their answer is outdated
+void ESP3DRenderingClient::_pollStatus() {
+#if TARGET_IS_GRBLHAL
+  uint64_t now = esp3d_hal::millis();
+  if (now - _rate_window_start >= 1000) {
+    _poll_rate = _rate_window_count * 1000 / (now - _rate_window_start);
+    _rate_window_count = 0;
+    _rate_window_start = now;
+  }
+  _polling_delay = ESP3D_POLLING_IDLE_INTERVAL;
+  // jogging and overrides need reports, whatever the polling setting
+  if ((!_polling_on || _isScreenOff()) && !esp3dJogEngine.isActive() &&
+      !esp3dOverrideEngine.isActive()) {
+    _poll_sent_time = 0;
+    return;
+  }
+  // push mode needs $ commands, so it is negotiated when idle, and as for
+  // $G and $# only when no job is streamed, as an idle report can come
+  // between two lines of a job when the planner drains
+  if (esp3dGcodeParser.getMachineState().status == ESP3DMachineStatus::idle &&
+      gcodeHostService.getState() == ESP3DGcodeHostState::idle &&
+      !esp3dJogEngine.isActive()) {
+    char cmd[32];
+    if (esp3dGcodeParser.getStatusPushCommand(cmd, sizeof(cmd))) {
+      esp3d_log("Sending command %s", cmd);
+      sendGcode(cmd);
+    }
+  }
+  uint32_t interval = esp3dGcodeParser.getStatusPollingInterval();
+  uint64_t last = _last_poll_time;
+  // pushed reports make requests useless, '?' is only sent if they stop
+  if (isStatusPushed()) {
+    interval = ESP3D_POLLING_IDLE_INTERVAL;
+    if (_last_report_time > last) {
+      last = _last_report_time;
+    }
+  }
+  // jog start and stop, and override changes, are seen within one motion
+  // interval
+  if (esp3dJogEngine.isActive() || esp3dOverrideEngine.isActive()) {
+    interval = ESP3D_POLLING_MOTION_INTERVAL;
+  }
+  if (_poll_sent_time != 0) {
+    uint32_t waiting = (uint32_t)((esp_timer_get_time() - _poll_sent_time) / 1000);
+    if (waiting < ESP3D_POLLING_TIMEOUT) {
+      // the report will wake up the task
+      _polling_delay = ESP3D_POLLING_TIMEOUT - waiting;
+      return;
+    }
+    esp3d_log_w("Status report not received, ask again");
+    _poll_timeouts++;
+    _poll_sent_time = 0;
+  }
+  uint64_t elapsed = now - last;
+  if (elapsed < interval) {
+    _polling_delay = interval - elapsed;
+    return;
+  }
+  if (sendRealTimeCommand('?')) {
+    _poll_sent_time = esp_timer_get_time();
+    _poll_count++;
+  }
+  _last_poll_time = now;
+  _polling_delay = interval;
+
+  // an idle report can come between two lines of a job when the planner
+  // drains, $G and $# would then be injected in the stream, so the flag
+  // stays set until the host has no job
+  if (esp3dGcodeParser.isModalStateRefreshNeeded() &&
+      gcodeHostService.getState() == ESP3DGcodeHostState::idle &&
+      !esp3dJogEngine.isActive()) {
+    const char **pollingCommands = esp3dGcodeParser.getPollingCommands();
+    static const uint8_t modalCommands[] = {
+        ESP3D_POLLING_COMMANDS_INDEX_GCODE_STATE,
+        ESP3D_POLLING_COMMANDS_INDEX_GCODE_PARAMETERS};
+    for (uint8_t index : modalCommands) {
+      if (!gcodeHostService.hasStreamListCommand(pollingCommands[index])) {
+        esp3d_log("Sending command %s", pollingCommands[index]);
+        sendGcode(pollingCommands[index]);
+        esp3dGcodeParser.setPollingCommandsLastRun(index, now);
       }
     }
+    esp3dGcodeParser.setModalStateStale(false);
   }
+#endif  // TARGET_IS_GRBLHAL
 }
 
 void ESP3DRenderingClient::flush() {
@@ -190,6 +367,14 @@ void ESP3DRenderingClient::end() {
     }
   }
   if (_xHandle) {
+    setNotifyTask(NULL);
+#if TARGET_IS_GRBLHAL
+    esp3dJogEngine.setNotifyTask(NULL);
+#endif  // TARGET_IS_GRBLHAL
+#if TARGET_IS_GRBLHAL && \
+    (ESP3D_HARDWARE_ENCODER_FEATURE || ESP3D_HARDWARE_POTENTIOMETER_FEATURE)
+    control_input_set_consumer(NULL, ESP3D_CLIENT_NOTIFY_INDEX);
+#endif  // TARGET_IS_GRBLHAL && (ENCODER || POTENTIOMETER)
     vTaskDelete(_xHandle);
     _xHandle = NULL;
   }
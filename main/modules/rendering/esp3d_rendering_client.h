@@ -23,10 +23,19 @@
 #include <stdio.h>
 
 #include "esp3d_client.h"
+#include "esp3d_data_type.h"
 #include "esp3d_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 
+// Broadcast messages parsed by rendering client, a target can override it in
+// its esp3d_data_type.h
+#ifndef ESP3D_RENDERING_MSG_CLASSES
+#define ESP3D_RENDERING_MSG_CLASSES                              \
+  (ESP3D_MSG_CLASS_MASK(ack) | ESP3D_MSG_CLASS_MASK(status) |    \
+   ESP3D_MSG_CLASS_MASK(error) | ESP3D_MSG_CLASS_MASK(console))
+#endif  // ESP3D_RENDERING_MSG_CLASSES
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -40,14 +49,41 @@ class ESP3DRenderingClient : public ESP3DClient {
   void end();
   void process(ESP3DMessage* msg);
   bool sendGcode(const char* data);
+  bool sendRealTimeCommand(uint8_t cmd);
   void flush();
   bool started() { return _started; }
   void setPolling(bool polling_on) { _polling_on = polling_on; }
+  // ms before next status request, or next check if polling is off
+  uint32_t getPollingDelay() { return _polling_delay; }
+  // status reports received per second, over last second
+  uint32_t getPollRate() { return _poll_rate; }
+  uint32_t getPollCount() { return _poll_count; }
+  uint32_t getPollTimeouts() { return _poll_timeouts; }
+  // round trip time of '?' in us
+  uint32_t getPollRttAvg() { return _poll_rtt_avg; }
+  uint32_t getPollRttMax() { return _poll_rtt_max; }
+  // controller sends status reports by itself
+  bool isStatusPushed();
 
  private:
   TaskHandle_t _xHandle;
   bool _started;
   bool _polling_on;
+  uint32_t _polling_delay;
+  uint64_t _last_poll_time;
+  uint64_t _last_report_time;
+  int64_t _poll_sent_time;  // 0 if no request pending
+  uint32_t _poll_count;
+  uint32_t _poll_timeouts;
+  uint32_t _poll_rtt_avg;
+  uint32_t _poll_rtt_max;
+  uint32_t _poll_rate;
+  uint32_t _rate_window_count;
+  uint64_t _rate_window_start;
+  void _pollStatus();
+  void _readInput();
+  void _onStatusReport();
+  bool _isScreenOff();
   SemaphoreHandle_t _xGuiSemaphore;
   pthread_mutex_t _rx_mutex;
 };
@@ -52,12 +52,15 @@ bool ESP3DSerialClient::configure(esp3d_serial_config_t *config)
 void ESP3DSerialClient::readSerial()
 {
     static uint64_t startTimeout = 0;  // milliseconds
-    // Use buffer size from configuration
-    int len = uart_read_bytes(_config->port,
-                              _data,
-                              (_config->rx_buffer_size / 2 - 1),
-                              10 / portTICK_PERIOD_MS);
-    if (len)
+    // only read what is already received, the task waits for UART events
+    size_t available = 0;
+    uart_get_buffered_data_len(_config->port, &available);
+    if (available > _config->rx_buffer_size / 2 - 1)
+    {
+        available = _config->rx_buffer_size / 2 - 1;
+    }
+    int len = available > 0 ? uart_read_bytes(_config->port, _data, available, 0) : 0;
+    if (len > 0)
     {
         // parse data
         startTimeout = esp3d_hal::millis();
@@ -100,8 +103,8 @@ static void esp3d_serial_rx_task(void *pvParameter)
     (void)pvParameter;
     while (1)
     {
-        /* Delay */
-        esp3d_hal::wait(1);
+        // Sleep until UART receives data, timeout flushes partial line
+        serialClient.waitForUartEvent();
         if (!serialClient.started())
         {
             break;
@@ -120,6 +123,7 @@ ESP3DSerialClient::ESP3DSerialClient()
     _buffer    = NULL;
     _bufferPos = 0;
     _config    = NULL;
+    _uart_queue = NULL;
 }
 
 ESP3DSerialClient::~ESP3DSerialClient()
@@ -202,6 +206,11 @@ bool ESP3DSerialClient::begin()
         return false;
     }
     setRxMutex(&_rx_mutex);
+    // rx has one producer: the rx task, and one consumer: the stream task
+    if (!setRxRing(ESP3D_CLIENT_RX_RING_SIZE))
+    {
+        esp3d_log_w("No rx ring, use rx queue");
+    }
 
     if (pthread_mutex_init(&_tx_mutex, NULL) != 0)
     {
@@ -237,8 +246,8 @@ bool ESP3DSerialClient::begin()
     ESP_ERROR_CHECK(uart_driver_install(_config->port,
                                         _config->rx_buffer_size * 2,
                                         _config->tx_buffer_size,
-                                        0,
-                                        NULL,
+                                        ESP3D_SERIAL_EVENT_QUEUE_SIZE,
+                                        &_uart_queue,
                                         intr_alloc_flags));
 
     // Configure UART parameters
@@ -291,6 +300,7 @@ bool ESP3DSerialClient::pushMsgToRxQueue(const uint8_t *msg, size_t size)
 #endif  // ESP3D_DISABLE_SERIAL_AUTHENTICATION
             newMsgPtr->origin = ESP3DClientType::serial;
             newMsgPtr->type   = ESP3DMessageType::unique;
+            ESP3DClient::classifyMsg(newMsgPtr);
             if (!addRxData(newMsgPtr))
             {
                 // delete message as cannot be added to the queue
@@ -302,7 +312,7 @@ bool ESP3DSerialClient::pushMsgToRxQueue(const uint8_t *msg, size_t size)
         else
         {
             // delete message as cannot be added partially filled to the queue
-            free(newMsgPtr);
+            ESP3DClient::deleteMsg(newMsgPtr);
             esp3d_log_e("Message creation failed");
             return false;
         }
@@ -315,52 +325,108 @@ bool ESP3DSerialClient::pushMsgToRxQueue(const uint8_t *msg, size_t size)
     return true;
 }
 
+// Only called by stream task, which is the single consumer of rx ring
 void ESP3DSerialClient::handle()
 {
     if (_started)
     {
-        if (getRxMsgsCount() > 0)
+        // process all messages already received
+        size_t count = getRxMsgsCount();
+        while (count > 0)
         {
+            count--;
             ESP3DMessage *msg = popRx();
             if (msg)
             {
                 esp3dCommands.process(msg);
             }
         }
-        if (getTxMsgsCount() > 0)
+        _sendTxMsg();
+    }
+}
+
+// Block until UART has data or an error, or until flush timeout of partial
+// line
+void ESP3DSerialClient::waitForUartEvent()
+{
+    uart_event_t event;
+    if (!_uart_queue
+        || xQueueReceive(_uart_queue, &event, pdMS_TO_TICKS(_config->rx_flush_timeout))
+               != pdTRUE)
+    {
+        return;
+    }
+    if (event.type == UART_FIFO_OVF || event.type == UART_BUFFER_FULL)
+    {
+        esp3d_log_e("UART rx overflow, data lost");
+        uart_flush_input(_config->port);
+        xQueueReset(_uart_queue);
+    }
+}
+
+void ESP3DSerialClient::_sendTxMsg()
+{
+    size_t count = getTxMsgsCount();
+    while (count > 0)
+    {
+        count--;
+        ESP3DMessage *msg = popTx();
+        if (msg)
         {
-            ESP3DMessage *msg = popTx();
-            if (msg)
+            size_t len = uart_write_bytes(_config->port, msg->data, msg->size);
+            if (len != msg->size)
             {
-                size_t len = uart_write_bytes(_config->port, msg->data, msg->size);
-                if (len != msg->size)
-                {
-                    esp3d_log_e("Error writing message %s", msg->data);
-                }
-                deleteMsg(msg);
+                esp3d_log_e("Error writing message %s", msg->data);
             }
+            deleteMsg(msg);
         }
     }
 }
 
+// Can be called by any task, so it only sends tx messages
 void ESP3DSerialClient::flush()
 {
     uint8_t loopCount = 10;
-    while (loopCount && getTxMsgsCount() > 0)
+    while (_started && loopCount && getTxMsgsCount() > 0)
     {
         // esp3d_log("flushing Tx messages");
         loopCount--;
-        handle();
+        _sendTxMsg();
         uart_wait_tx_done(_config->port, pdMS_TO_TICKS(500));
     }
 }
 
+// Realtime command is put directly in the UART hardware FIFO, so it is sent
+// before the data still waiting in tx queue and in driver ring buffer, once
+// the driver tx lock is released by the line being written, if any
+bool ESP3DSerialClient::sendRealTimeCommand(uint8_t cmd)
+{
+    if (!_started)
+    {
+        return false;
+    }
+    if (uart_tx_chars(_config->port, (const char *)&cmd, 1) == 1)
+    {
+        return true;
+    }
+    // FIFO is full, wait for room in ring buffer or in FIFO without one
+    esp3d_log_w("UART FIFO full, realtime command goes to ring buffer");
+    return uart_write_bytes(_config->port, &cmd, 1) == 1;
+}
+
 void ESP3DSerialClient::end()
 {
     if (_started)
     {
         flush();
         _started = false;
+        if (_uart_queue)
+        {
+            // wake up rx task so it sees the client is stopped
+            uart_event_t event = {};
+            event.type         = UART_EVENT_MAX;
+            xQueueSend(_uart_queue, &event, 0);
+        }
         esp3d_log("Clearing queue Rx messages");
         clearRxQueue();
         esp3d_log("Clearing queue Tx messages");
@@ -380,6 +446,7 @@ void ESP3DSerialClient::end()
         {
             esp3d_log_e("Error deleting serial driver");
         }
+        _uart_queue = NULL;
     }
     if (_xHandle)
     {
@@ -25,6 +25,10 @@
 #include "esp3d_client.h"
 #include "esp3d_log.h"
 #include "esp3d_serial_config.h"
+#include "freertos/queue.h"
+
+// UART driver events waited by rx task
+#define ESP3D_SERIAL_EVENT_QUEUE_SIZE 20
 
 #ifdef __cplusplus
 extern "C" {
@@ -42,12 +46,16 @@ class ESP3DSerialClient : public ESP3DClient {
   bool isEndChar(uint8_t ch);
   bool pushMsgToRxQueue(const uint8_t* msg, size_t size);
   void flush();
+  bool sendRealTimeCommand(uint8_t cmd);
   bool started() { return _started; }
   void readSerial();
+  void waitForUartEvent();
 
  private:
+  void _sendTxMsg();
   esp3d_serial_config_t * _config;
   TaskHandle_t _xHandle;
+  QueueHandle_t _uart_queue;
   bool _started;
   pthread_mutex_t _tx_mutex;
   pthread_mutex_t _rx_mutex;
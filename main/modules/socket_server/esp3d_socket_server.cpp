@@ -478,7 +478,7 @@ bool ESP3DSocketServer::pushMsgToRxQueue(uint index, const uint8_t *msg,
       }
     } else {
       // delete message as cannot be added partially filled to the queue
-      free(newMsgPtr);
+      ESP3DClient::deleteMsg(newMsgPtr);
       esp3d_log_e("Message creation failed");
       return false;
     }
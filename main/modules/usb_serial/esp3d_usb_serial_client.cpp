@@ -229,6 +229,10 @@ bool ESP3DUsbSerialClient::begin() {
     return false;
   }
   setRxMutex(&_rx_mutex);
+  // rx has one producer: the usb task, and one consumer: the stream task
+  if (!setRxRing(ESP3D_CLIENT_RX_RING_SIZE)) {
+    esp3d_log_w("No rx ring, use rx queue");
+  }
 
   if (pthread_mutex_init(&_tx_mutex, NULL) != 0) {
     esp3d_log_e("Mutex creation for tx failed");
@@ -273,6 +277,7 @@ bool ESP3DUsbSerialClient::pushMsgToRxQueue(const uint8_t *msg, size_t size) {
       newMsgPtr->authentication_level = ESP3DAuthenticationLevel::admin;
 #endif  // ESP3D_DISABLE_SERIAL_AUTHENTICATION
       newMsgPtr->origin = ESP3DClientType::usb_serial;
+      ESP3DClient::classifyMsg(newMsgPtr);
       if (!addRxData(newMsgPtr)) {
         // delete message as cannot be added to the queue
         ESP3DClient::deleteMsg(newMsgPtr);
@@ -281,7 +286,7 @@ bool ESP3DUsbSerialClient::pushMsgToRxQueue(const uint8_t *msg, size_t size) {
       }
     } else {
       // delete message as cannot be added partially filled to the queue
-      free(newMsgPtr);
+      ESP3DClient::deleteMsg(newMsgPtr);
       esp3d_log_e("Message creation failed");
       return false;
     }
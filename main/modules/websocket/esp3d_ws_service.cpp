@@ -362,7 +362,7 @@ bool ESP3DWsService::pushMsgToRxQueue(int socketId, const uint8_t *msg,
       esp3dCommands.process(newMsgPtr);
     } else {
       // delete message as cannot be added partially filled to the queue
-      free(newMsgPtr);
+      ESP3DClient::deleteMsg(newMsgPtr);
       esp3d_log_e("Message creation failed");
       return false;
     }
@@ -46,6 +46,7 @@ const char* no_ack_commands[] = {  // Commands that do not need an ack
     ""};
 
 const char* fwCommands[] = {"M110 N0",  // reset stream numbering
+                            "M115",     // firmware info
                             ""};
 uint64_t ESP3DGCodeParserService::getPollingCommandsLastRun(uint8_t index) {
   if (index < ESP3D_POLLING_COMMANDS_COUNT) {
@@ -387,19 +388,22 @@ bool ESP3DGCodeParserService::processCommand(const char* data) {
   return false;
 }
 
-ESP3DDataType ESP3DGCodeParserService::getType(const char* data) {
+// Prefix check against a literal, its size is known at compile time
+template <size_t N>
+static inline bool esp3d_has_prefix(const char* str, const char (&prefix)[N]) {
+  return strncmp(str, prefix, N - 1) == 0;
+}
+
+ESP3DDataType ESP3DGCodeParserService::getType(const char* data,
+                                              uint32_t* value) {
   if (data == nullptr) {
     return ESP3DDataType::empty_line;
   }
-  char* ptr = (char*)data;
+  const char* ptr = data;
 
   // remove leading spaces and tabs
-  for (uint8_t i = 0; i < strlen(data); i++) {
-    if (data[i] == ' ' || data[i] == '\t') {
-      ptr++;
-    } else {
-      break;
-    }
+  while (*ptr == ' ' || *ptr == '\t') {
+    ptr++;
   }
 
   // is empty line ?
@@ -407,110 +411,133 @@ ESP3DDataType ESP3DGCodeParserService::getType(const char* data) {
     return ESP3DDataType::empty_line;
   }
 
-  // is it ack ?
-  if (((ptr[0] == 'o' && ptr[1] == 'k') &&
-      (ptr[2] == '\n' || ptr[2] == '\r' || ptr[2] == ' ' || ptr[2] == 0x0)) || strstr(ptr, "ok") != nullptr  || strstr(ptr, "o`") != nullptr  || strstr(ptr, "`k") != nullptr) {
-    esp3d_log("Ack found in %s", ptr);
-    return ESP3DDataType::ack;
-  }
-
-  // is it comment ?
-  if (ptr[0] == ';' || ptr[0] == '#') {
-    return ESP3DDataType::comment;
+  // is it ack ? "ok" can be anywhere, even altered
+  for (const char* p = ptr; *p; p++) {
+    if ((p[0] == 'o' && (p[1] == 'k' || p[1] == '`')) ||
+        (p[0] == '`' && p[1] == 'k')) {
+      esp3d_log("Ack found in %s", ptr);
+      return ESP3DDataType::ack;
+    }
   }
 
-  // is gcode ?
-  if (ptr[0] == 'M' || ptr[0] == 'G' || ptr[0] == 'T') {
-    char* ptr2 = ptr;
-    int hasNumber = 0;
-    for (uint8_t i = 0; i < strlen(ptr2); i++) {
-      if (ptr2[i] >= '0' && ptr2[i] <= '9') {
-        hasNumber++;
-      } else if ((ptr2[i] == ' ' || ptr2[i] == '\t' || ptr2[i] == '\n' ||
-                  ptr2[i] == '\r') &&
-                 hasNumber > 0 && hasNumber < 5) {
-        for (uint8_t i = 0; i < sizeof(emmergencyGcodeCommand) / sizeof(char*);
+  // first char selects the only prefixes to check
+  switch (ptr[0]) {
+    case ';':
+    case '#':
+      return ESP3DDataType::comment;
+    // Resend: 2
+    case 'R':
+      if (esp3d_has_prefix(ptr, "Resend: ")) {
+        if (value) {
+          *value = atoi(ptr + 8);
+        }
+        return ESP3DDataType::resend;
+      }
+      break;
+    // Error:Line Number is not Last Line Number + 1 Last Line : 1
+    case 'E':
+      if (esp3d_has_prefix(ptr, "Error:")) {
+        if (value) {
+          *value = atoi(ptr + 6);
+        }
+        return ESP3DDataType::error;
+      }
+      break;
+    // status can be echoed, any other echo is a response
+    case 'e':
+      if (esp3d_has_prefix(ptr, "echo:")) {
+        if (esp3d_has_prefix(ptr + 5, "busy") ||
+            esp3d_has_prefix(ptr + 5, "processing") ||
+            esp3d_has_prefix(ptr + 5, "heating")) {
+          esp3d_log("Status: %s", ptr);
+          return ESP3DDataType::status;
+        }
+        return ESP3DDataType::response;
+      }
+      break;
+    case 'b':
+    case 'p':
+    case 'h':
+      if (esp3d_has_prefix(ptr, "busy") ||
+          esp3d_has_prefix(ptr, "processing") ||
+          esp3d_has_prefix(ptr, "heating")) {
+        esp3d_log("Status: %s", ptr);
+        return ESP3DDataType::status;
+      }
+      break;
+    /*
+      "Not SD printing"
+      "Done printing file"
+      "SD printing byte"
+      "echo: M73 Progress:"
+      "echo:Print time:"
+      "echo:E"
+      "Current file:"
+      "FR:xxx%"
+      "Cap:"
+      "FIRMWARE_NAME:"
+      "ok T:25.00 /120.00 B:25.00 /0.00 @:127 B@:0"
+      "T:25.00 /0.00 B:25.00 /50.00 T0:25.00 /0.00 T1:25.00 /0.00 @:0 B@:127
+      @0:0
+      @1:0"
+      "ok T0:23.00 /0.00 B:22.62 /0.00 T0:23.00 /0.00 T1:23.08 /0.00 @:0 B@:0
+      @0:0
+      @1:0"
+      "X:0.00 Y:0.00 Z:0.00 E:0.00 Count X:0 Y:0 Z:0"
+      */
+    case 'T':
+      if (esp3d_has_prefix(ptr, "T:") || esp3d_has_prefix(ptr, "T0:")) {
+        return ESP3DDataType::response;
+      }
+      break;
+    case 'X':
+      if (esp3d_has_prefix(ptr, "X:")) {
+        return ESP3DDataType::response;
+      }
+      break;
+    case 'N':
+      if (esp3d_has_prefix(ptr, "Not SD printing")) {
+        return ESP3DDataType::response;
+      }
+      break;
+    case 'D':
+      if (esp3d_has_prefix(ptr, "Done printing file")) {
+        return ESP3DDataType::response;
+      }
+      break;
+    case 'S':
+      if (esp3d_has_prefix(ptr, "SD printing byte")) {
+        return ESP3DDataType::response;
+      }
+      break;
+    case 'C':
+      if (esp3d_has_prefix(ptr, "Current file:") ||
+          esp3d_has_prefix(ptr, "Cap:")) {
+        return ESP3DDataType::response;
+      }
+      break;
+    case 'F':
+      if (esp3d_has_prefix(ptr, "FR:") ||
+          esp3d_has_prefix(ptr, "FIRMWARE_NAME:")) {
+        return ESP3DDataType::response;
+      }
+      break;
+    // is [ESPxxx] command ?
+    case '[':
+      if (esp3d_has_prefix(ptr, "[ESP") &&
+          (ptr[4] == ']' || (ptr[4] >= '0' && ptr[4] <= '9'))) {
+        for (uint8_t i = 0; i < sizeof(emmergencyESP3DCommand) / sizeof(char*);
              i++) {
-          if (strstr(ptr, emmergencyGcodeCommand[i]) == ptr) {
+          if (strncmp(ptr, emmergencyESP3DCommand[i],
+                      strlen(emmergencyESP3DCommand[i])) == 0) {
             return ESP3DDataType::emergency_command;
           }
         }
-        return ESP3DDataType::gcode;
-      } else {
-        // not a gcode
-        break;
+        return ESP3DDataType::esp_command;
       }
-    }
-  }
-
-  // is it resend ?
-  // Resend: 2
-  if (strstr(ptr, "Resend: ") == ptr) {
-    _lineResend = atoi(ptr + 8);
-    return ESP3DDataType::resend;
-  }
-
-  // is it error ?
-  // Error:Line Number is not Last Line Number + 1 Last Line : 1
-  if (strstr(ptr, "Error:") == ptr) {
-    _lastError = ptr + 6;
-    return ESP3DDataType::error;
-  }
-
-  // is it status ?
-  if (strstr(ptr, "busy") == ptr || strstr(ptr, "processing") == ptr ||
-      strstr(ptr, "heating") == ptr || strstr(ptr, "echo:busy") == ptr ||
-      strstr(ptr, "echo:processing") == ptr ||
-      strstr(ptr, "echo:heating") == ptr) {
-    esp3d_log("Status: %s", esp3d_string::str_trim(ptr));
-    return ESP3DDataType::status;
-  }
-  /*
-    "Not SD printing"
-    "Done printing file"
-    "SD printing byte"
-    "echo: M73 Progress:"
-    "echo:Print time:"
-    "echo:E"
-    "Current file:"
-    "FR:xxx%"
-    "Cap:"
-    "FIRMWARE_NAME:"
-    "ok T:25.00 /120.00 B:25.00 /0.00 @:127 B@:0"
-    "T:25.00 /0.00 B:25.00 /50.00 T0:25.00 /0.00 T1:25.00 /0.00 @:0 B@:127
-    @0:0
-    @1:0"
-    "ok T0:23.00 /0.00 B:22.62 /0.00 T0:23.00 /0.00 T1:23.08 /0.00 @:0 B@:0
-    @0:0
-    @1:0"
-    "X:0.00 Y:0.00 Z:0.00 E:0.00 Count X:0 Y:0 Z:0"
-    */
-
-  // is it response ?
-  if (strstr(ptr, "echo:") == ptr || strstr(ptr, "ok T:") == ptr ||
-      strstr(ptr, "T:") == ptr || strstr(ptr, "X:") == ptr ||
-      strstr(ptr, "Not SD printing") == ptr ||
-      strstr(ptr, "Done printing file") == ptr ||
-      strstr(ptr, "SD printing byte") == ptr ||
-      strstr(ptr, "Current file:") == ptr || strstr(ptr, "FR:") == ptr ||
-      strstr(ptr, "Cap:") == ptr || strstr(ptr, "FIRMWARE_NAME:") == ptr ||
-      strstr(ptr, "ok T0:") == ptr || strstr(ptr, "T0:") == ptr) {
-    return ESP3DDataType::response;
-  }
-
-  // is [ESPxxx] command ?
-  if (strstr(ptr, "[ESP") == ptr) {
-    if (strlen(ptr) >= 5 &&
-        (ptr[4] == ']' || (ptr[4] >= '0' && ptr[4] <= '9'))) {
-      for (uint8_t i = 0; i < sizeof(emmergencyESP3DCommand) / sizeof(char*);
-           i++) {
-        if (strstr(ptr, emmergencyESP3DCommand[i]) == ptr) {
-          return ESP3DDataType::emergency_command;
-        }
-      }
-      return ESP3DDataType::esp_command;
-    }
+      break;
+    default:
+      break;
   }
-
   return ESP3DDataType::unknown;
 }
@@ -30,6 +30,7 @@ extern "C" {
 
 enum class FW_GCodeCommand : uint8_t {
   reset_stream_numbering = 0,
+  build_info = 1,
 };
 
 #define ESP3D_POLLING_COMMANDS_INDEX_TEMPERATURE_TEMPERATURE 0
@@ -38,27 +39,36 @@ enum class FW_GCodeCommand : uint8_t {
 
 #define ESP3D_POLLING_COMMANDS_COUNT 3
 
+// Usable size of the firmware serial RX buffer, which is not reported
+#define ESP3D_RX_BUFFER_SIZE 127
+
 class ESP3DGCodeParserService final {
  public:
   ESP3DGCodeParserService();
   ~ESP3DGCodeParserService();
-  ESP3DDataType getType(const char *data);
+  ESP3DDataType getType(const char *data, uint32_t *value = nullptr);
   bool hasMultiLineReport(const char *data);
-  const char *getLastError() { return _lastError.c_str(); }
-  uint64_t getLineResend() { return _lineResend; }
   bool processCommand(const char *data);
   const char **getPollingCommands();
   const char *getFwCommandString(FW_GCodeCommand cmd);
   bool hasAck(const char *command);
+  // no single byte realtime command on this firmware
+  bool isRealTimeCommand(uint8_t command) { return false; }
   bool forwardToScreen(const char *command);
   bool isAckNeeded() { return true; }  // Depend on FW
+  size_t getRxBufferSize() { return ESP3D_RX_BUFFER_SIZE; }
+  // Bf: of status reports is not parsed for this firmware, so there is no
+  // buffer report and streaming only relies on its own accounting
+  uint8_t getPlannerBlocksFree() { return 0; }
+  uint16_t getRxBytesFree() { return 0; }
+  uint8_t getPlannerBlocksCount() { return 0; }
+  uint32_t getBufferReportCount() { return 0; }
+  uint32_t getBufferReportTime() { return 0; }
   uint64_t getPollingCommandsLastRun(uint8_t index);
   bool setPollingCommandsLastRun(uint8_t index, uint64_t value);
 
  private:
   bool _isMultiLineReportOnGoing;
-  std::string _lastError;
-  uint64_t _lineResend;
 };
 
 extern ESP3DGCodeParserService esp3dGcodeParser;
@@ -0,0 +1,27 @@
+/*
+  esp3d_cnc_data_type
+
+  Copyright (c) 2023 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+// Shared by grbl, grblHAL and FluidNC targets: their acks are a bare "ok"
+// without values, so rendering client does not subscribe to them
+#define ESP3D_RENDERING_MSG_CLASSES                               \
+  (ESP3D_MSG_CLASS_MASK(status) | ESP3D_MSG_CLASS_MASK(error) | \
+   ESP3D_MSG_CLASS_MASK(console))
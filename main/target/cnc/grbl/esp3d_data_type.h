@@ -21,6 +21,8 @@
 #pragma once
 #include <stdio.h>
 
+#include "target/cnc/esp3d_cnc_data_type.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
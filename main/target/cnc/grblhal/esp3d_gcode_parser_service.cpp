@@ -19,6 +19,9 @@
 
 #include "esp3d_gcode_parser_service.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "esp3d_hal.h"
 #include "esp3d_log.h"
 #include "esp3d_string.h"
@@ -48,7 +51,16 @@ const char *no_ack_commands[] = {  // Commands that do not need an ack
     ""};
 
 const char *fwCommands[] = {"M110 N0",  // reset stream numbering
+                            "$I",       // build info, report RX buffer size
                             ""};
+
+// Prefix check against a literal, its size is known at compile time
+template <size_t N>
+static inline bool esp3d_has_prefix(const char *str, const char (&prefix)[N])
+{
+    return strncmp(str, prefix, N - 1) == 0;
+}
+
 uint64_t ESP3DGCodeParserService::getPollingCommandsLastRun(uint8_t index)
 {
     if (index < ESP3D_POLLING_COMMANDS_COUNT)
@@ -106,6 +118,20 @@ bool ESP3DGCodeParserService::forwardToScreen(const char *command)
 ESP3DGCodeParserService::ESP3DGCodeParserService()
 {
     _isMultiLineReportOnGoing = false;
+    _rxBufferSize             = 0;
+    _rxBufferLearned          = 0;
+    _plannerBlocksCount       = 0;
+    _bufferReportCount        = 0;
+    _bufferReportTime         = 0;
+    memset(_axisMaxRate, 0, sizeof(_axisMaxRate));
+    _machineStatePublished    = false;
+    _modalStateStale          = true;
+    _pushMode                 = ESP3DStatusPushMode::unknown;
+    _pushWritten              = false;
+    _pushQuery                = false;
+    _pushModeTime             = 0;
+    esp3d_machine_state::init(&_machineState);
+    portMUX_INITIALIZE(&_machineStateLock);
 }
 
 ESP3DGCodeParserService::~ESP3DGCodeParserService()
@@ -127,6 +153,23 @@ bool ESP3DGCodeParserService::hasAck(const char *command)
     return true;
 }
 
+// check if byte is a realtime command: grbl executes it as soon as received,
+// it has no ack and must not be followed by a new line
+bool ESP3DGCodeParserService::isRealTimeCommand(uint8_t command)
+{
+    switch (command)
+    {
+        case 0x18:  // soft reset
+        case '?':   // status report
+        case '!':   // feed hold
+        case '~':   // cycle start / resume
+            return true;
+        default:
+            // extended set: safety door, jog cancel, overrides, coolant...
+            return command >= 0x80 && command <= 0xBF;
+    }
+}
+
 // TODO: implement multi line report detection
 bool ESP3DGCodeParserService::hasMultiLineReport(const char *data)
 {
@@ -136,421 +179,520 @@ bool ESP3DGCodeParserService::hasMultiLineReport(const char *data)
 bool ESP3DGCodeParserService::processCommand(const char *data)
 {
     esp3d_log("processing Command %s", data);
-    // if (data != nullptr && strlen(data) > 0) {
-    //   // is temperature
-    //   if (strstr(data, "T:") != nullptr) {
-    //     // ok T:25.00 /120.00 B:25.00 /0.00 @:127 B@:0
-    //     // T:25.00 /0.00 B:25.00 /50.00 T0:25.00 /0.00 T1:105.00 /0.00 @:0
-    //     B@:127 char* ptrt = strstr(data, "T:"); char* ptrt0 = strstr(data,
-    //     "T0:"); char* ptrt1 = strstr(data, "T1:"); char* ptrb = strstr(data,
-    //     "B:"); if (ptrt0 && ptrt1) {  // dual extruder
-    //       esp3d_log("Temperature dual extruders");
-    //       ptrt0 += 3;
-    //       ptrt1 += 3;
-    //       // Extruder 0 current temperature
-    //       char* ptre = strstr(ptrt0, " /");
-    //       if (!ptre) {
-    //         esp3d_log_e("Error parsing temperature T0 value");
-    //         return false;
-    //       }
-    //       ptre[0] = '\0';
-    //       // Extruder 0 target temperature
-    //       char* ptrtt = ptre + 2;
-    //       ptre = strstr(ptrtt, " ");
-    //       if (!ptre) {
-    //         esp3d_log_e("Error parsing temperature T0 target");
-    //         return false;
-    //       }
-    //       ptre[0] = '\0';
-    //       // Dispatch values
-    //       esp3dTftValues.set_string_value(ESP3DValuesIndex::ext_0_temperature,
-    //                                       ptrt0);
-    //       esp3dTftValues.set_string_value(
-    //           ESP3DValuesIndex::ext_0_target_temperature, ptrtt);
-    //       esp3d_log("T0: %s / %s", ptrt0, ptrtt);
-
-    // // Extruder 1 current temperature
-    // ptre = strstr(ptrt1, " /");
-    // if (!ptre) {
-    //   esp3d_log_e("Error parsing temperature T1 value");
-    //   esp3dTftValues.set_string_value(ESP3DValuesIndex::ext_1_temperature,
-    //                                   "#");
-    //   esp3dTftValues.set_string_value(
-    //       ESP3DValuesIndex::ext_1_target_temperature, "#");
-    //   return false;
-    // }
-    // ptre[0] = '\0';
-    // // Extruder 1 target temperature
-    // ptrtt = ptre + 2;
-    // ptre = strstr(ptrtt, " ");
-    // if (!ptre) {
-    //   esp3d_log_e("Error parsing temperature T1 target");
-    //   esp3dTftValues.set_string_value(ESP3DValuesIndex::ext_1_temperature,
-    //                                   "#");
-    //   esp3dTftValues.set_string_value(
-    //       ESP3DValuesIndex::ext_1_target_temperature, "#");
-    //   return false;
-    // }
-    // ptre[0] = '\0';
-    // // Dispatch values
-    // esp3dTftValues.set_string_value(ESP3DValuesIndex::ext_1_temperature,
-    //                                 ptrt1);
-    // esp3dTftValues.set_string_value(
-    //     ESP3DValuesIndex::ext_1_target_temperature, ptrtt);
-    // esp3d_log("T1: %s / %s", ptrt1, ptrtt);
-    // } else {  // single extruder
-    // esp3d_log("Temperature single extruder");
-    // esp3dTftValues.set_string_value(ESP3DValuesIndex::ext_1_temperature,
-    //                                 "#");
-    // esp3dTftValues.set_string_value(
-    //     ESP3DValuesIndex::ext_1_target_temperature, "#");
-    // ptrt += 2;
-    // // Extruder 0 current temperature
-    // char* ptre = strstr(ptrt, " /");
-    // if (!ptre) {
-    //   esp3d_log_e("Error parsing temperature T0 value");
-    //   return false;
-    // }
-    // ptre[0] = '\0';
-    // // Extruder 0 target temperature
-    // char* ptrtt = ptre + 2;
-    // ptre = strstr(ptrtt, " ");
-    // if (!ptre) {
-    //   esp3d_log_e("Error parsing temperature T0 target");
-    //   return false;
-    // }
-    // ptre[0] = '\0';
-    // // Dispatch values
-    // esp3dTftValues.set_string_value(ESP3DValuesIndex::ext_0_temperature,
-    //                                 ptrt);
-    // esp3dTftValues.set_string_value(
-    //     ESP3DValuesIndex::ext_0_target_temperature, ptrtt);
-
-    // esp3d_log("T: %s / %s", ptrt, ptrtt);
-    // }
-    // if (ptrb) {  // bed
-    // esp3d_log("Temperature bed");
-    // ptrb += 2;
-    // // Bed current temperature
-    // char* ptre = strstr(ptrb, " /");
-    // if (!ptre) {
-    //   esp3d_log_e("Error parsing temperature bed value");
-    //   return false;
-    // }
-    // ptre[0] = '\0';
-    // // Bed target temperature
-    // char* ptrtt = ptre + 2;
-    // ptre = strstr(ptrtt, " ");
-    // if (!ptre) {
-    //   esp3d_log_e("Error parsing temperature Bed target");
-    //   return false;
-    // }
-    // ptre[0] = '\0';
-    // // Dispatch values
-    // esp3dTftValues.set_string_value(ESP3DValuesIndex::bed_temperature,
-    //                                 ptrb);
-    // esp3dTftValues.set_string_value(
-    //     ESP3DValuesIndex::bed_target_temperature, ptrtt);
-    // esp3d_log("Bed: %s / %s", ptrb, ptrtt);
-    // } else {
-    // esp3d_log("No Temperature bed");
-    // esp3dTftValues.set_string_value(ESP3DValuesIndex::bed_temperature,
-    // "#"); esp3dTftValues.set_string_value(
-    //     ESP3DValuesIndex::bed_target_temperature, "#");
-    // }
-    // setPollingCommandsLastRun(
-    //   ESP3D_POLLING_COMMANDS_INDEX_TEMPERATURE_TEMPERATURE,
-    //   esp3d_hal::millis());
-    // return true;
-    // // is position but not bed leveling
-    // } else if (strstr(data, "X:") != nullptr &&
-    //        strstr(data, "Bed X:") == nullptr) {
-    // // X:0.00 Y:0.00 Z:0.00 E:0.00 Count X:0 Y:0 Z:0
-    // esp3d_log("Positions");
-    // char* ptrx = strstr(data, "X:");
-    // char* ptry = strstr(data, "Y:");
-    // char* ptrz = strstr(data, "Z:");
-    // char* ptre = strstr(data, "E:");
-
-    // if (ptrx && ptry && ptrz && ptre) {
-    //   ptrx += 2;
-    //   ptry[0] = '\0';
-    //   ptry += 2;
-    //   ptrz[0] = '\0';
-    //   ptrz += 2;
-    //   if (ptre) {
-    //     ptre[0] = '\0';
-    //   }
-    //   esp3dTftValues.set_string_value(ESP3DValuesIndex::position_x, ptrx);
-    //   esp3dTftValues.set_string_value(ESP3DValuesIndex::position_y, ptry);
-    //   esp3dTftValues.set_string_value(ESP3DValuesIndex::position_z, ptrz);
-    //   setPollingCommandsLastRun(
-    //       ESP3D_POLLING_COMMANDS_INDEX_TEMPERATURE_POSITION,
-    //       esp3d_hal::millis());
-    //   return true;
-    // } else {
-    //   esp3d_log_e("Error parsing positions");
-    // }
-    // } else if (strstr(data, "FR:") != nullptr) {
-    // char* ptrfr = strstr(data, "FR:");
-    // char* ptrpc = strstr(data, "%");
-    // if (ptrfr && ptrpc) {
-    //   ptrfr += 3;
-    //   ptrpc[0] = '\0';
-    //   esp3dTftValues.set_string_value(ESP3DValuesIndex::speed, ptrfr);
-    //   setPollingCommandsLastRun(
-    //       ESP3D_POLLING_COMMANDS_INDEX_TEMPERATURE_SPEED,
-    //       esp3d_hal::millis());
-    //   return true;
-    // } else {
-    //   esp3d_log_e("Error parsing progress");
-    // }
-    // // is fan speed ?
-    // } else if (strstr(data, "M106") != nullptr ||
-    //          strstr(data, "M107") != nullptr) {
-    // char* ptr106 = strstr(data, "M106");
-    // char* ptr107 = strstr(data, "M107");
-    // if (ptr106) {
-    //   ptr106 += 4;
-    //   char* ptrS = strstr(ptr106, "S");
-    //   if (!ptrS) {
-    //     esp3d_log_e("Error parsing fan speed");
-    //     return false;
-    //   }
-
-    // ptrS++;
-    // // get fan speed
-    // static std::string fanSpeed = "";
-    // fanSpeed = "";
-
-    // for (uint8_t i = 0; i < 3; i++) {
-    //   if (ptrS[i] >= '0' && ptrS[i] <= '9') {
-    //     fanSpeed += ptrS[i];
-    //   } else {
-    //     break;
-    //   }
-    // }
-    // // is there an index ?
-    // esp3d_log("Check index in %s", ptr106);
-    // uint8_t index = 0;
-    // char* ptrI = strstr(ptr106, "P");
-    // if (ptrI) {
-    //   esp3d_log("Index found %s", ptrI);
-    //   if (ptrI[1] == '1') {
-    //     index = 1;
-    //   }
-    // }
-    // // conversion 0~255 to 0~100
-    // double fspeed = (std::stod(fanSpeed.c_str()) * 100) / 255;
-    // // limit to 100%
-    // if (fspeed > 100) {
-    //   fspeed = 100;
-    // }
-
-    // fanSpeed = esp3d_string::set_precision(std::to_string(fspeed), 0);
-    // // set fan speed according index
-    // esp3d_log("Fan speed 106, index: %d, %s", index, fanSpeed.c_str());
-    // if (index == 0) {
-    //   esp3dTftValues.set_string_value(ESP3DValuesIndex::ext_0_fan,
-    //                                   fanSpeed.c_str());
-    // } else {
-    //   esp3dTftValues.set_string_value(ESP3DValuesIndex::ext_1_fan,
-    //                                   fanSpeed.c_str());
-    // }
-    // return true;
-    // } else if (ptr107) {
-    // ptr107 += 4;
-    // char* ptrI = strstr(ptr107, "P");
-    // uint8_t index = 0;
-    // // is there an index ?
-    // if (ptrI) {
-    //   if (ptrI[1] == '1') {
-    //     index = 1;
-    //   }
-    // }
-    // esp3d_log("Fan speed 107, index: %d", index);
-    // // set fan speed to 0 according index
-    // if (index == 0) {
-    //   esp3dTftValues.set_string_value(ESP3DValuesIndex::ext_0_fan, "0");
-    // } else {
-    //   esp3dTftValues.set_string_value(ESP3DValuesIndex::ext_1_fan, "0");
-    // }
-    // return true;
-    // } else {
-    // esp3d_log_e("Error parsing fan speed");
-    // }
-    // // G29 Auto Bed Leveling
-    // } else if (strstr(data, "G29 Auto Bed Leveling") != nullptr ||
-    //        strstr(data, "Bed X:") != nullptr ||
-    //        strstr(data, "Bilinear Leveling Grid:") != nullptr) {
-    // static bool isLeveling = false;
-    // if (strstr(data, "G29 Auto Bed Leveling") != nullptr) {
-    // isLeveling = true;
-    // // Send start of leveling
-    // esp3dTftValues.set_string_value(ESP3DValuesIndex::bed_leveling,
-    // "Start",
-    //                                 ESP3DValuesCbAction::Add);
-    // } else if (isLeveling) {
-    // if (strstr(data, "Bilinear Leveling Grid:") != nullptr) {
-    //   isLeveling = false;
-    //   // Send end of leveling
-    //   esp3dTftValues.set_string_value(ESP3DValuesIndex::bed_leveling,
-    //   "End",
-    //                                   ESP3DValuesCbAction::Delete);
-    // } else {
-    //   // Send leveling data
-    //   esp3dTftValues.set_string_value(ESP3DValuesIndex::bed_leveling,
-    //   data,
-    //                                   ESP3DValuesCbAction::Update);
-    // }
-    // }
-    // }
-    // }
-    return false;
-}
-
-ESP3DDataType ESP3DGCodeParserService::getType(const char *data)
-{
     if (data == nullptr)
     {
-        return ESP3DDataType::empty_line;
+        return false;
     }
-    char *ptr = (char *)data;
-
-    // remove leading spaces and tabs
-    for (uint8_t i = 0; i < strlen(data); i++)
+    // is real time status report ?
+    // <Idle|MPos:0.000,0.000,0.000|FS:0,0|WCO:0.000,0.000,0.000>
+    const char *ptr = data;
+    while (*ptr == ' ' || *ptr == '\t')
+    {
+        ptr++;
+    }
+    if (ptr[0] == '<')
     {
-        if (data[i] == ' ' || data[i] == '\t')
+        ESP3DMachineState previous = _machineState;
+        ESP3DMachineState state    = previous;
+        if (!esp3d_machine_state::parseReport(ptr, &state))
         {
-            ptr++;
+            esp3d_log_e("Error parsing status report");
+            return false;
         }
-        else
+        // other tasks never see a half parsed report
+        portENTER_CRITICAL(&_machineStateLock);
+        _machineState = state;
+        if (state.fields & ESP3D_MACHINE_FIELD_BF)
         {
-            break;
+            _bufferReportTime = (uint32_t)esp3d_hal::millis();
+            _bufferReportCount++;
         }
+        portEXIT_CRITICAL(&_machineStateLock);
+        setPollingCommandsLastRun(ESP3D_POLLING_COMMANDS_INDEX_STATUS, esp3d_hal::millis());
+        // G10, G92, G54..G59 or tool length change offsets, so WCO
+        if ((_machineState.fields & ESP3D_MACHINE_FIELD_WCO)
+            && memcmp(previous.wco, _machineState.wco, sizeof(previous.wco)) != 0)
+        {
+            _modalStateStale = true;
+        }
+        // end of job
+        if (_machineState.status == ESP3DMachineStatus::idle
+            && previous.status != ESP3DMachineStatus::idle)
+        {
+            _modalStateStale = true;
+        }
+        if (_machineState.fields & ESP3D_MACHINE_FIELD_BF)
+        {
+            _processBufferReport();
+        }
+        _publishMachineState(previous);
+        return true;
     }
+    _processMaxRate(ptr);
+    _processPushAnswer(ptr);
+    return false;
+}
 
-    // is empty line ?
-    if (ptr[0] == '\n' || ptr[0] == '\r')
-    {
-        return ESP3DDataType::empty_line;
-    }
-
-    // is it ack ?
-    if ((ptr[0] == 'o' && ptr[1] == 'k')
-        && (ptr[2] == '\n' || ptr[2] == '\r' || ptr[2] == ' ' || ptr[2] == 0x0))
-    {
-        return ESP3DDataType::ack;
-    }
-
-    // is it comment ?
-    if (ptr[0] == ';' || ptr[0] == '#')
+// $110=5000.000 from $$ output, max rate is the real top speed of a jog
+void ESP3DGCodeParserService::_processMaxRate(const char *data)
+{
+    if (!esp3d_has_prefix(data, "$11") || data[3] < '0'
+        || data[3] >= '0' + ESP3D_MAX_RATE_AXIS_COUNT || data[4] != '=')
     {
-        return ESP3DDataType::comment;
+        return;
     }
+    double rate = atof(data + 5);
+    _axisMaxRate[data[3] - '0'] = rate > 0 ? (uint32_t)rate : 0;
+}
 
-    // is gcode ?
-    if (ptr[0] == 'M' || ptr[0] == 'G' || ptr[0] == 'T')
+// Firmware identification, $481 value and restart of controller
+// Errors are not used: grbl answers carry no reference to their command, so
+// an error cannot be told from one of another line, the setting is checked
+// by reading it back instead
+void ESP3DGCodeParserService::_processPushAnswer(const char *data)
+{
+    switch (data[0])
     {
-        char *ptr2    = ptr;
-        int hasNumber = 0;
-        for (uint8_t i = 0; i < strlen(ptr2); i++)
-        {
-            if (ptr2[i] >= '0' && ptr2[i] <= '9')
+        case '[':
+            // [FIRMWARE:grblHAL]
+            if (_pushMode == ESP3DStatusPushMode::identifying
+                && esp3d_has_prefix(data, "[FIRMWARE:grblHAL"))
             {
-                hasNumber++;
+                esp3d_log("Firmware supports status report push");
+                _pushMode = ESP3DStatusPushMode::setting;
+                // current interval is read first to not write setting each time
+                _pushQuery = true;
             }
-            else if ((ptr2[i] == ' ' || ptr2[i] == '\t' || ptr2[i] == '\n' || ptr2[i] == '\r')
-                     && hasNumber > 0 && hasNumber < 5)
+            break;
+        case '$':
+            // $481=100
+            if (_pushMode == ESP3DStatusPushMode::probing && _pushQuery
+                && esp3d_has_prefix(data, "$481="))
             {
-                for (uint8_t i = 0; i < sizeof(emmergencyGcodeCommand) / sizeof(char *); i++)
+                if (atoi(data + 5) == ESP3D_STATUS_PUSH_INTERVAL)
                 {
-                    if (strstr(ptr, emmergencyGcodeCommand[i]) == ptr)
-                    {
-                        return ESP3DDataType::emergency_command;
-                    }
+                    esp3d_log("Status report push enabled");
+                    _pushMode = ESP3DStatusPushMode::active;
+                }
+                else if (!_pushWritten)
+                {
+                    _pushMode  = ESP3DStatusPushMode::setting;
+                    _pushQuery = false;
                 }
-                return ESP3DDataType::gcode;
+                else
+                {
+                    esp3d_log_w("Status report push refused, keep polling");
+                    _pushMode = ESP3DStatusPushMode::unsupported;
+                }
+            }
+            break;
+        case 'G':
+            // Welcome message after a reset: runtime settings are lost
+            // Grbl 1.1f ['$' for help] or GrblHAL 1.1f ['$' or '$HELP' for help]
+            if (esp3d_has_prefix(data, "Grbl"))
+            {
+                _pushMode    = ESP3DStatusPushMode::unknown;
+                _pushWritten = false;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+// Controller is asked to send status reports by itself, so '?' is only sent
+// when nothing was pushed for a while
+bool ESP3DGCodeParserService::getStatusPushCommand(char *buffer, size_t size)
+{
+    uint64_t now = esp3d_hal::millis();
+    switch (_pushMode)
+    {
+        case ESP3DStatusPushMode::unknown:
+            snprintf(buffer, size, "%s", getFwCommandString(FW_GCodeCommand::build_info));
+            break;
+        case ESP3DStatusPushMode::setting:
+            if (_pushQuery)
+            {
+                snprintf(buffer, size, "$481");
             }
             else
             {
-                // not a gcode
-                break;
+                snprintf(buffer, size, "$481=%d", ESP3D_STATUS_PUSH_INTERVAL);
+                // written value is read back by next command, queued after it
+                _pushWritten = true;
+                _pushQuery   = true;
+                return true;
             }
+            break;
+        case ESP3DStatusPushMode::identifying:
+        case ESP3DStatusPushMode::probing:
+            // no answer to $I or to the query means it is not supported
+            if (now - _pushModeTime > ESP3D_STATUS_PUSH_TIMEOUT)
+            {
+                esp3d_log("No status report push, keep polling");
+                _pushMode = ESP3DStatusPushMode::unsupported;
+            }
+            return false;
+        default:
+            return false;
+    }
+    _pushMode     = _pushMode == ESP3DStatusPushMode::unknown ? ESP3DStatusPushMode::identifying
+                                                              : ESP3DStatusPushMode::probing;
+    _pushModeTime = now;
+    return true;
+}
+
+// Status is polled faster when machine moves, a report answers in ms
+uint32_t ESP3DGCodeParserService::getStatusPollingInterval()
+{
+    switch (_machineState.status)
+    {
+        case ESP3DMachineStatus::run:
+        case ESP3DMachineStatus::jog:
+        case ESP3DMachineStatus::home:
+            return ESP3D_POLLING_MOTION_INTERVAL;
+        case ESP3DMachineStatus::hold:
+        case ESP3DMachineStatus::door:
+        case ESP3DMachineStatus::tool:
+            return ESP3D_POLLING_HOLD_INTERVAL;
+        default:
+            return ESP3D_POLLING_IDLE_INTERVAL;
+    }
+}
+
+// $# is refused by controller during a cycle
+bool ESP3DGCodeParserService::isModalStateRefreshNeeded()
+{
+    return _modalStateStale && _machineState.status == ESP3DMachineStatus::idle;
+}
+
+// Bf: gives free planner blocks and RX bytes, when idle they are the usable
+// sizes, so max values seen are used if $I did not report them
+void ESP3DGCodeParserService::_processBufferReport()
+{
+    if (_machineState.status == ESP3DMachineStatus::idle)
+    {
+        if (_rxBufferSize == 0 && _machineState.bf_bytes > _rxBufferLearned)
+        {
+            _rxBufferLearned = _machineState.bf_bytes;
+            esp3d_log("RX buffer size from Bf: %d", _rxBufferLearned);
+        }
+        if (_machineState.bf_blocks > _plannerBlocksCount)
+        {
+            _plannerBlocksCount = _machineState.bf_blocks;
+            esp3d_log("Planner size from Bf: %d", _plannerBlocksCount);
         }
     }
+}
 
-    // is it resend ?
-    // Resend: 2
-    if (strstr(ptr, "Resend: ") == ptr)
+void ESP3DGCodeParserService::getMachineStateSnapshot(ESP3DMachineState *state)
+{
+    portENTER_CRITICAL(&_machineStateLock);
+    *state = _machineState;
+    portEXIT_CRITICAL(&_machineStateLock);
+}
+
+uint8_t ESP3DGCodeParserService::getPlannerBlocksQueued()
+{
+    uint8_t free = _machineState.bf_blocks;
+    if (_plannerBlocksCount == 0 || free >= _plannerBlocksCount)
     {
-        _lineResend = atoi(ptr + 8);
-        return ESP3DDataType::resend;
+        return 0;
     }
+    return _plannerBlocksCount - free;
+}
 
-    // is it error ?
-    // Error:Line Number is not Last Line Number + 1 Last Line : 1
-    if (strstr(ptr, "Error:") == ptr)
+// Only values which changed since previous report are sent to the display,
+// each one being a string copy and a list lookup
+void ESP3DGCodeParserService::_publishMachineState(const ESP3DMachineState &previous)
+{
+    static const ESP3DValuesIndex mposIndex[ESP3D_MACHINE_AXES_COUNT] = {
+        ESP3DValuesIndex::m_position_x,
+        ESP3DValuesIndex::m_position_y,
+        ESP3DValuesIndex::m_position_z,
+        ESP3DValuesIndex::m_position_a,
+        ESP3DValuesIndex::m_position_b,
+        ESP3DValuesIndex::m_position_c};
+    static const ESP3DValuesIndex wposIndex[ESP3D_MACHINE_AXES_COUNT] = {
+        ESP3DValuesIndex::w_position_x,
+        ESP3DValuesIndex::w_position_y,
+        ESP3DValuesIndex::w_position_z,
+        ESP3DValuesIndex::w_position_a,
+        ESP3DValuesIndex::w_position_b,
+        ESP3DValuesIndex::w_position_c};
+    const ESP3DMachineState &state = _machineState;
+    char buffer[24];
+    // first report, or formatting changed: send all
+    bool force = !_machineStatePublished || previous.decimals != state.decimals
+                 || previous.axes != state.axes;
+    _machineStatePublished = true;
+
+    if (force || previous.status != state.status || previous.sub_state != state.sub_state)
+    {
+        const char *status = esp3d_machine_state::getStatusString(state.status);
+        if (state.status == ESP3DMachineStatus::hold || state.status == ESP3DMachineStatus::door)
+        {
+            snprintf(buffer, sizeof(buffer), "%s:%u", status, state.sub_state);
+            status = buffer;
+        }
+        esp3dTftValues.set_string_value(ESP3DValuesIndex::state, status);
+    }
+    for (uint8_t i = 0; i < state.axes; i++)
+    {
+        if (force || previous.mpos[i] != state.mpos[i])
+        {
+            esp3dTftValues.set_string_value(
+                mposIndex[i],
+                esp3d_machine_state::formatValue(state.mpos[i], state.decimals, buffer,
+                                                 sizeof(buffer)));
+        }
+        int32_t wpos = esp3d_machine_state::getWorkPosition(&state, i);
+        if (force || esp3d_machine_state::getWorkPosition(&previous, i) != wpos)
+        {
+            esp3dTftValues.set_string_value(
+                wposIndex[i],
+                esp3d_machine_state::formatValue(wpos, state.decimals, buffer, sizeof(buffer)));
+        }
+    }
+    // grbl reports feed with 1 decimal in inches, none in mm
+    if (force || previous.feed != state.feed)
+    {
+        esp3dTftValues.set_string_value(
+            ESP3DValuesIndex::feed_rate,
+            esp3d_machine_state::formatValue(state.feed, state.decimals > 3 ? 1 : 0, buffer,
+                                             sizeof(buffer)));
+    }
+    if (force || previous.speed != state.speed)
+    {
+        esp3dTftValues.set_string_value(
+            ESP3DValuesIndex::spindle_speed,
+            esp3d_machine_state::formatValue(state.speed, 0, buffer, sizeof(buffer)));
+    }
+    if (force || previous.ov_feed != state.ov_feed || previous.ov_rapid != state.ov_rapid
+        || previous.ov_spindle != state.ov_spindle)
+    {
+        snprintf(buffer, sizeof(buffer), "%u", state.ov_feed);
+        esp3dTftValues.set_string_value(ESP3DValuesIndex::feed_override, buffer);
+        snprintf(buffer, sizeof(buffer), "%u", state.ov_rapid);
+        esp3dTftValues.set_string_value(ESP3DValuesIndex::rapid_override, buffer);
+        snprintf(buffer, sizeof(buffer), "%u", state.ov_spindle);
+        esp3dTftValues.set_string_value(ESP3DValuesIndex::spindle_override, buffer);
+    }
+    // pins and accessories are sent back as letters, like in report
+    if (force || previous.pins != state.pins)
+    {
+        uint8_t pos = 0;
+        for (uint8_t i = 0; ESP3D_MACHINE_PINS_LETTERS[i] && pos < sizeof(buffer) - 1; i++)
+        {
+            if (state.pins & (1 << i))
+            {
+                buffer[pos++] = ESP3D_MACHINE_PINS_LETTERS[i];
+            }
+        }
+        buffer[pos] = 0x0;
+        esp3dTftValues.set_string_value(ESP3DValuesIndex::pins_state, buffer);
+    }
+    if (force || previous.accessories != state.accessories)
     {
-        _lastError = ptr + 6;
-        return ESP3DDataType::error;
+        uint8_t pos = 0;
+        for (uint8_t i = 0; ESP3D_MACHINE_ACCESSORIES_LETTERS[i]; i++)
+        {
+            if (state.accessories & (1 << i))
+            {
+                buffer[pos++] = ESP3D_MACHINE_ACCESSORIES_LETTERS[i];
+            }
+        }
+        buffer[pos] = 0x0;
+        esp3dTftValues.set_string_value(ESP3DValuesIndex::accessories_state, buffer);
     }
+}
 
-    // is it status ?
-    if (strstr(ptr, "busy") == ptr || strstr(ptr, "processing") == ptr
-        || strstr(ptr, "heating") == ptr || strstr(ptr, "echo:busy") == ptr
-        || strstr(ptr, "echo:processing") == ptr || strstr(ptr, "echo:heating") == ptr)
+ESP3DDataType ESP3DGCodeParserService::getType(const char *data, uint32_t *value)
+{
+    if (data == nullptr)
     {
-        esp3d_log("Status: %s", esp3d_string::str_trim(ptr));
-        return ESP3DDataType::status;
+        return ESP3DDataType::empty_line;
     }
-    /*
-      "Not SD printing"
-      "Done printing file"
-      "SD printing byte"
-      "echo: M73 Progress:"
-      "echo:Print time:"
-      "echo:E"
-      "Current file:"
-      "FR:xxx%"
-      "Cap:"
-      "FIRMWARE_NAME:"
-      "ok T:25.00 /120.00 B:25.00 /0.00 @:127 B@:0"
-      "T:25.00 /0.00 B:25.00 /50.00 T0:25.00 /0.00 T1:25.00 /0.00 @:0 B@:127
-      @0:0
-      @1:0"
-      "ok T0:23.00 /0.00 B:22.62 /0.00 T0:23.00 /0.00 T1:23.08 /0.00 @:0 B@:0
-      @0:0
-      @1:0"
-      "X:0.00 Y:0.00 Z:0.00 E:0.00 Count X:0 Y:0 Z:0"
-      */
-
-    // is it response ?
-    if (strstr(ptr, "echo:") == ptr || strstr(ptr, "ok T:") == ptr || strstr(ptr, "T:") == ptr
-        || strstr(ptr, "X:") == ptr || strstr(ptr, "Not SD printing") == ptr
-        || strstr(ptr, "Done printing file") == ptr || strstr(ptr, "SD printing byte") == ptr
-        || strstr(ptr, "Current file:") == ptr || strstr(ptr, "FR:") == ptr
-        || strstr(ptr, "Cap:") == ptr || strstr(ptr, "FIRMWARE_NAME:") == ptr
-        || strstr(ptr, "ok T0:") == ptr || strstr(ptr, "T0:") == ptr)
+    const char *ptr = data;
+
+    // remove leading spaces and tabs
+    while (*ptr == ' ' || *ptr == '\t')
     {
-        return ESP3DDataType::response;
+        ptr++;
     }
 
-    // is [ESPxxx] command ?
-    if (strstr(ptr, "[ESP") == ptr)
+    // first char selects the only prefixes to check
+    switch (ptr[0])
     {
-        if (strlen(ptr) >= 5 && (ptr[4] == ']' || (ptr[4] >= '0' && ptr[4] <= '9')))
-        {
-            for (uint8_t i = 0; i < sizeof(emmergencyESP3DCommand) / sizeof(char *); i++)
+        // is empty line ?
+        case '\n':
+        case '\r':
+            return ESP3DDataType::empty_line;
+        case ';':
+        case '#':
+            return ESP3DDataType::comment;
+        // real time status report
+        case '<':
+            return ESP3DDataType::status;
+        // is it ack ? "ok T:" and "ok T0:" reports are acks too
+        case 'o':
+            if (ptr[1] == 'k' && (ptr[2] == '\n' || ptr[2] == '\r' || ptr[2] == ' ' || ptr[2] == 0x0))
             {
-                if (strstr(ptr, emmergencyESP3DCommand[i]) == ptr)
+                return ESP3DDataType::ack;
+            }
+            break;
+        // Resend: 2
+        case 'R':
+            if (esp3d_has_prefix(ptr, "Resend: "))
+            {
+                if (value)
                 {
-                    return ESP3DDataType::emergency_command;
+                    *value = atoi(ptr + 8);
                 }
+                return ESP3DDataType::resend;
             }
-            return ESP3DDataType::esp_command;
-        }
+            break;
+        // Error:Line Number is not Last Line Number + 1 Last Line : 1
+        // error:20
+        // status can be echoed, any other echo is a response
+        case 'E':
+        case 'e':
+            if (esp3d_has_prefix(ptr + 1, "rror:"))
+            {
+                if (value)
+                {
+                    *value = atoi(ptr + 6);
+                }
+                return ESP3DDataType::error;
+            }
+            if (esp3d_has_prefix(ptr, "echo:"))
+            {
+                if (esp3d_has_prefix(ptr + 5, "busy") || esp3d_has_prefix(ptr + 5, "processing")
+                    || esp3d_has_prefix(ptr + 5, "heating"))
+                {
+                    esp3d_log("Status: %s", ptr);
+                    return ESP3DDataType::status;
+                }
+                return ESP3DDataType::response;
+            }
+            break;
+        case 'b':
+        case 'p':
+        case 'h':
+            if (esp3d_has_prefix(ptr, "busy") || esp3d_has_prefix(ptr, "processing")
+                || esp3d_has_prefix(ptr, "heating"))
+            {
+                esp3d_log("Status: %s", ptr);
+                return ESP3DDataType::status;
+            }
+            break;
+        /*
+          "Not SD printing"
+          "Done printing file"
+          "SD printing byte"
+          "echo: M73 Progress:"
+          "echo:Print time:"
+          "echo:E"
+          "Current file:"
+          "FR:xxx%"
+          "Cap:"
+          "FIRMWARE_NAME:"
+          "ok T:25.00 /120.00 B:25.00 /0.00 @:127 B@:0"
+          "T:25.00 /0.00 B:25.00 /50.00 T0:25.00 /0.00 T1:25.00 /0.00 @:0 B@:127
+          @0:0
+          @1:0"
+          "ok T0:23.00 /0.00 B:22.62 /0.00 T0:23.00 /0.00 T1:23.08 /0.00 @:0 B@:0
+          @0:0
+          @1:0"
+          "X:0.00 Y:0.00 Z:0.00 E:0.00 Count X:0 Y:0 Z:0"
+          */
+        case 'T':
+            if (esp3d_has_prefix(ptr, "T:") || esp3d_has_prefix(ptr, "T0:"))
+            {
+                return ESP3DDataType::response;
+            }
+            break;
+        case 'X':
+            if (esp3d_has_prefix(ptr, "X:"))
+            {
+                return ESP3DDataType::response;
+            }
+            break;
+        case 'N':
+            if (esp3d_has_prefix(ptr, "Not SD printing"))
+            {
+                return ESP3DDataType::response;
+            }
+            break;
+        case 'D':
+            if (esp3d_has_prefix(ptr, "Done printing file"))
+            {
+                return ESP3DDataType::response;
+            }
+            break;
+        case 'S':
+            if (esp3d_has_prefix(ptr, "SD printing byte"))
+            {
+                return ESP3DDataType::response;
+            }
+            break;
+        case 'C':
+            if (esp3d_has_prefix(ptr, "Current file:") || esp3d_has_prefix(ptr, "Cap:"))
+            {
+                return ESP3DDataType::response;
+            }
+            break;
+        case 'F':
+            if (esp3d_has_prefix(ptr, "FR:") || esp3d_has_prefix(ptr, "FIRMWARE_NAME:"))
+            {
+                return ESP3DDataType::response;
+            }
+            break;
+        case '[':
+            // is it build options report ?
+            // [OPT:VNMZL,35,1024] planner size then RX buffer size
+            // extended report of grblHAL adds more values after them
+            if (esp3d_has_prefix(ptr, "[OPT:"))
+            {
+                const char *ptr_blocks = strchr(ptr, ',');
+                const char *ptr_size   = ptr_blocks ? strchr(ptr_blocks + 1, ',') : nullptr;
+                if (ptr_blocks)
+                {
+                    int blocks = atoi(ptr_blocks + 1);
+                    if (blocks > 0 && blocks <= UINT8_MAX)
+                    {
+                        _plannerBlocksCount = blocks;
+                        esp3d_log("Planner size: %d", _plannerBlocksCount);
+                    }
+                }
+                if (ptr_size)
+                {
+                    int size = atoi(ptr_size + 1);
+                    // one byte is kept free by the firmware
+                    if (size > 1)
+                    {
+                        _rxBufferSize = size - 1;
+                        esp3d_log("RX buffer size: %d", _rxBufferSize);
+                    }
+                }
+                return ESP3DDataType::response;
+            }
+            // is [ESPxxx] command ?
+            if (esp3d_has_prefix(ptr, "[ESP") && (ptr[4] == ']' || (ptr[4] >= '0' && ptr[4] <= '9')))
+            {
+                for (uint8_t i = 0; i < sizeof(emmergencyESP3DCommand) / sizeof(char *); i++)
+                {
+                    if (strncmp(ptr, emmergencyESP3DCommand[i], strlen(emmergencyESP3DCommand[i]))
+                        == 0)
+                    {
+                        return ESP3DDataType::emergency_command;
+                    }
+                }
+                return ESP3DDataType::esp_command;
+            }
+            break;
+        default:
+            break;
     }
-
     return ESP3DDataType::unknown;
 }
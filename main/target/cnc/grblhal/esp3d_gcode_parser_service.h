@@ -22,7 +22,9 @@
 #include <stdio.h>
 
 #include "esp3d_data_type.h"
+#include "esp3d_machine_state.h"
 #include "esp3d_string.h"
+#include "freertos/FreeRTOS.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -30,35 +32,113 @@ extern "C" {
 
 enum class FW_GCodeCommand : uint8_t {
   reset_stream_numbering = 0,
+  build_info = 1,
 };
 
-#define ESP3D_POLLING_COMMANDS_INDEX_TEMPERATURE_TEMPERATURE 0
-#define ESP3D_POLLING_COMMANDS_INDEX_TEMPERATURE_POSITION 1
-#define ESP3D_POLLING_COMMANDS_INDEX_TEMPERATURE_SPEED 2
+#define ESP3D_POLLING_COMMANDS_INDEX_STATUS 0
+#define ESP3D_POLLING_COMMANDS_INDEX_GCODE_STATE 1
+#define ESP3D_POLLING_COMMANDS_INDEX_GCODE_PARAMETERS 2
 
 #define ESP3D_POLLING_COMMANDS_COUNT 3
 
+// X, Y and Z max rates are $110, $111 and $112
+#define ESP3D_MAX_RATE_AXIS_COUNT 3
+
+// Status report polling interval according machine state, in ms
+#define ESP3D_POLLING_MOTION_INTERVAL 50
+#define ESP3D_POLLING_HOLD_INTERVAL 250
+#define ESP3D_POLLING_IDLE_INTERVAL 1000
+
+// Status reports pushed by grblHAL $481 (min 100 ms), 10 reports/s are
+// enough for the DRO refresh
+#define ESP3D_STATUS_PUSH_INTERVAL 100
+// time to wait for firmware answer during push mode negotiation, in ms
+#define ESP3D_STATUS_PUSH_TIMEOUT 2000
+
+enum class ESP3DStatusPushMode : uint8_t {
+  unknown = 0,  // firmware not yet identified
+  identifying,  // $I sent
+  setting,  // firmware supports push, interval to be set
+  probing,  // $481 query sent, waiting for its value
+  active,
+  unsupported,
+};
+
+// Usable size of the controller serial RX buffer when not reported by $I
+#define ESP3D_RX_BUFFER_SIZE 127
+
 class ESP3DGCodeParserService final {
  public:
   ESP3DGCodeParserService();
   ~ESP3DGCodeParserService();
-  ESP3DDataType getType(const char *data);
+  // value gets error code or line to resend, if any
+  ESP3DDataType getType(const char *data, uint32_t *value = nullptr);
   bool hasMultiLineReport(const char *data);
-  const char *getLastError() { return _lastError.c_str(); }
-  uint64_t getLineResend() { return _lineResend; }
   bool processCommand(const char *data);
   const char **getPollingCommands();
   const char *getFwCommandString(FW_GCodeCommand cmd);
   bool hasAck(const char *command);
+  bool isRealTimeCommand(uint8_t command);
   bool forwardToScreen(const char *command);
   bool isAckNeeded() { return true; }  // Depend on FW
+  // usable RX buffer size reported by [OPT:] of $I, or learned from Bf:
+  // when idle, 0 if not yet known
+  size_t getRxBufferSize() {
+    return _rxBufferSize != 0 ? _rxBufferSize : _rxBufferLearned;
+  }
+  // Bf: of last status report, read by streaming and jogging tasks
+  uint8_t getPlannerBlocksFree() { return _machineState.bf_blocks; }
+  uint16_t getRxBytesFree() { return _machineState.bf_bytes; }
+  // usable planner size reported by [OPT:] of $I, or learned from Bf:
+  // when idle, 0 if not yet known
+  uint8_t getPlannerBlocksCount() { return _plannerBlocksCount; }
+  // blocks waiting in planner, 0 if unknown
+  uint8_t getPlannerBlocksQueued();
+  // changes for each report with Bf:, so credits can be refreshed
+  uint32_t getBufferReportCount() { return _bufferReportCount; }
+  // in ms, 32 bits so it can be read from other tasks
+  uint32_t getBufferReportTime() { return _bufferReportTime; }
   uint64_t getPollingCommandsLastRun(uint8_t index);
   bool setPollingCommandsLastRun(uint8_t index, uint64_t value);
+  // $110..$112 max rate of axis in mm/min, seen in a settings report,
+  // 0 if not yet known
+  uint32_t getAxisMaxRate(uint8_t axis) {
+    return axis < ESP3D_MAX_RATE_AXIS_COUNT ? _axisMaxRate[axis] : 0;
+  }
+  // last real time status report, only for the task parsing the reports
+  const ESP3DMachineState &getMachineState() { return _machineState; }
+  // copy of last report, can be called from any task
+  void getMachineStateSnapshot(ESP3DMachineState *state);
+  uint32_t getStatusPollingInterval();
+  // $G and $# answers are outdated (offsets changed or job ended) and
+  // machine is idle, so they can be asked again
+  bool isModalStateRefreshNeeded();
+  void setModalStateStale(bool stale) { _modalStateStale = stale; }
+  ESP3DStatusPushMode getStatusPushMode() { return _pushMode; }
+  // next command of push mode negotiation, if any to send now
+  bool getStatusPushCommand(char *buffer, size_t size);
 
  private:
   bool _isMultiLineReportOnGoing;
-  std::string _lastError;
-  uint64_t _lineResend;
+  size_t _rxBufferSize;
+  size_t _rxBufferLearned;
+  uint8_t _plannerBlocksCount;
+  uint32_t _bufferReportCount;
+  uint32_t _bufferReportTime;
+  uint32_t _axisMaxRate[ESP3D_MAX_RATE_AXIS_COUNT];
+  // written by the task parsing reports, under lock for other tasks
+  ESP3DMachineState _machineState;
+  portMUX_TYPE _machineStateLock;
+  bool _machineStatePublished;
+  bool _modalStateStale;
+  ESP3DStatusPushMode _pushMode;
+  bool _pushQuery;    // probing is a query of current interval
+  bool _pushWritten;  // interval was written, query checks it
+  uint64_t _pushModeTime;
+  void _processPushAnswer(const char *data);
+  void _processBufferReport();
+  void _processMaxRate(const char *data);
+  void _publishMachineState(const ESP3DMachineState &previous);
 };
 
 extern ESP3DGCodeParserService esp3dGcodeParser;
@@ -0,0 +1,501 @@
+/*
+  esp3d_jog_engine
+  Copyright (c) 2023 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "esp3d_jog_engine.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp3d_client.h"
+#include "esp3d_gcode_parser_service.h"
+#include "esp3d_hal.h"
+#include "esp3d_log.h"
+#include "esp3d_settings.h"
+#include "esp3d_target_settings.h"
+#include "esp_timer.h"
+#include "gcode_host/esp3d_gcode_host_service.h"
+#include "rendering/esp3d_rendering_client.h"
+
+ESP3DJogEngine esp3dJogEngine;
+
+static const char jogAxisLetters[] = "XYZABC";
+// in ESP3D_MACHINE_STATE_SCALE units of mm
+static const int32_t jogSteps[ESP3D_JOG_STEPS_COUNT] = {10, 100, 1000, 10000};
+
+// latency in us, smoothed over last 8 jogs, in ms
+static void esp3d_jog_latency(int64_t latency, uint32_t *avg, uint32_t *max)
+{
+    uint32_t value = latency > 0 ? (uint32_t)(latency / 1000) : 0;
+    *avg           = *avg ? (*avg * 7 + value) / 8 : value;
+    if (value > *max)
+    {
+        *max = value;
+    }
+}
+
+ESP3DJogEngine::ESP3DJogEngine()
+{
+    portMUX_INITIALIZE(&_lock);
+    _notify_task         = NULL;
+    _enabled             = false;
+    _pending_clicks      = 0;
+    parseAcceleration(JOG_ACCELERATION_TARGET, _accel_factors, &_accel_count);
+    _first_click_time    = 0;
+    _last_click_time     = 0;
+    _stop_requested      = false;
+    _state               = ESP3DJogState::idle;
+    _axis                = 0;
+    _step_index          = ESP3D_JOG_DEFAULT_STEP_INDEX;
+    _started             = false;
+    _recancel            = false;
+    _segment_line        = 0;
+    _jog_start_time      = 0;
+    _jog_last_click_time = 0;
+    _last_segment_time   = 0;
+    _motion_end_time     = 0;
+    _stop_delay          = 0;
+    _cancel_time         = 0;
+    _bf_report_count     = 0;
+    _bf_segments         = 0;
+    _segment[0]          = 0;
+    _jog_count           = 0;
+    _start_latency_avg   = 0;
+    _start_latency_max   = 0;
+    _stop_latency_avg    = 0;
+    _stop_latency_max    = 0;
+}
+
+void ESP3DJogEngine::_notify()
+{
+    if (_notify_task)
+    {
+        xTaskNotifyGiveIndexed(_notify_task, ESP3D_CLIENT_NOTIFY_INDEX);
+    }
+}
+
+void ESP3DJogEngine::setEnabled(bool enabled)
+{
+    bool was_enabled = _enabled;
+    _enabled         = enabled;
+    if (was_enabled && !enabled)
+    {
+        stop();
+    }
+}
+
+void ESP3DJogEngine::addClicks(int32_t clicks, uint32_t velocity, int64_t time_us)
+{
+    if (!_enabled || clicks == 0)
+    {
+        return;
+    }
+    int32_t scaled = clicks * getAccelerationFactor(velocity);
+    portENTER_CRITICAL(&_lock);
+    if (_pending_clicks == 0)
+    {
+        _first_click_time = time_us;
+    }
+    _pending_clicks += scaled;
+    _last_click_time = time_us;
+    portEXIT_CRITICAL(&_lock);
+    _notify();
+}
+
+bool ESP3DJogEngine::parseAcceleration(const char *curve, uint16_t *factors, uint8_t *count)
+{
+    uint8_t index = 0;
+    const char *p = curve;
+    while (*p)
+    {
+        char *end;
+        long factor = strtol(p, &end, 10);
+        if (end == p || factor < 1 || factor > ESP3D_JOG_ACCEL_MAX_FACTOR
+            || index >= ESP3D_JOG_ACCEL_MAX_ENTRIES || (*end != ',' && *end != 0))
+        {
+            return false;
+        }
+        if (factors)
+        {
+            factors[index] = (uint16_t)factor;
+        }
+        index++;
+        p = *end == ',' ? end + 1 : end;
+    }
+    if (index == 0)
+    {
+        return false;
+    }
+    if (count)
+    {
+        *count = index;
+    }
+    return true;
+}
+
+void ESP3DJogEngine::loadAcceleration()
+{
+    char curve[SIZE_OF_JOG_ACCELERATION + 1];
+    uint16_t factors[ESP3D_JOG_ACCEL_MAX_ENTRIES];
+    uint8_t count;
+    bool error = true;
+    esp3dTftsettings.readString(ESP3DSettingIndex::esp3d_jog_acceleration,
+                                curve,
+                                sizeof(curve),
+                                &error);
+    if (error || !parseAcceleration(curve, factors, &count))
+    {
+        esp3d_log_w("Invalid jog acceleration, using default");
+        parseAcceleration(JOG_ACCELERATION_TARGET, factors, &count);
+    }
+    portENTER_CRITICAL(&_lock);
+    memcpy(_accel_factors, factors, sizeof(factors));
+    _accel_count = count;
+    portEXIT_CRITICAL(&_lock);
+}
+
+// Linear between entries, so speed changes do not jump distance per detent
+int32_t ESP3DJogEngine::getAccelerationFactor(uint32_t velocity)
+{
+    uint32_t position = velocity * ESP3D_JOG_ACCEL_SCALE / ESP3D_JOG_ACCEL_BUCKET;
+    uint32_t index    = position / ESP3D_JOG_ACCEL_SCALE;
+    int32_t factor;
+    portENTER_CRITICAL(&_lock);
+    if (index + 1 >= _accel_count)
+    {
+        factor = _accel_factors[_accel_count - 1] * ESP3D_JOG_ACCEL_SCALE;
+    }
+    else
+    {
+        int32_t from = _accel_factors[index];
+        int32_t to   = _accel_factors[index + 1];
+        factor       = from * ESP3D_JOG_ACCEL_SCALE
+                 + (to - from) * (int32_t)(position % ESP3D_JOG_ACCEL_SCALE);
+    }
+    portEXIT_CRITICAL(&_lock);
+    return factor;
+}
+
+void ESP3DJogEngine::stop()
+{
+    portENTER_CRITICAL(&_lock);
+    _pending_clicks = 0;
+    _stop_requested = true;
+    portEXIT_CRITICAL(&_lock);
+    _notify();
+}
+
+// clicks sent are removed from pending ones, new ones may have come since
+int32_t ESP3DJogEngine::_takeClicks(int32_t clicks)
+{
+    portENTER_CRITICAL(&_lock);
+    _pending_clicks -= clicks;
+    int32_t left = _pending_clicks;
+    portEXIT_CRITICAL(&_lock);
+    return left;
+}
+
+void ESP3DJogEngine::setAxis(uint8_t axis)
+{
+    if (axis < sizeof(jogAxisLetters) - 1)
+    {
+        _axis = axis;
+    }
+}
+
+char ESP3DJogEngine::getAxisLetter()
+{
+    return jogAxisLetters[_axis];
+}
+
+void ESP3DJogEngine::setStepIndex(uint8_t index)
+{
+    if (index < ESP3D_JOG_STEPS_COUNT)
+    {
+        _step_index = index;
+    }
+}
+
+int32_t ESP3DJogEngine::getStep()
+{
+    return jogSteps[_step_index];
+}
+
+uint32_t ESP3DJogEngine::getDelay()
+{
+    return _state == ESP3DJogState::idle ? UINT32_MAX : ESP3D_JOG_TICK;
+}
+
+// mm/min
+int64_t ESP3DJogEngine::_getMaxFeed()
+{
+    uint32_t rate = esp3dGcodeParser.getAxisMaxRate(_axis);
+    if (rate == 0)
+    {
+        return ESP3D_JOG_DEFAULT_MAX_FEED;
+    }
+    return rate < ESP3D_JOG_MAX_FEED ? rate : ESP3D_JOG_MAX_FEED;
+}
+
+// A segment is queued only when the previous one left the host, and when
+// the motion already queued is short, so a cancel has little to discard
+bool ESP3DJogEngine::_canQueueSegment(int64_t now)
+{
+    if (now - _last_segment_time < ESP3D_JOG_TICK * 1000)
+    {
+        return false;
+    }
+    if (_segment[0] != 0 && gcodeHostService.hasStreamListCommand(_segment))
+    {
+        return false;
+    }
+    if (_motion_end_time - now > ESP3D_JOG_LOOKAHEAD * 1000)
+    {
+        return false;
+    }
+    // planner blocks of last Bf:, plus segments sent since
+    uint32_t count = esp3dGcodeParser.getBufferReportCount();
+    if (count != _bf_report_count)
+    {
+        _bf_report_count = count;
+        _bf_segments     = 0;
+    }
+    uint32_t age = (uint32_t)esp3d_hal::millis() - esp3dGcodeParser.getBufferReportTime();
+    if (count != 0 && age <= ESP3D_JOG_BF_MAX_AGE && esp3dGcodeParser.getPlannerBlocksCount() != 0
+        && esp3dGcodeParser.getPlannerBlocksQueued() + _bf_segments >= ESP3D_JOG_MAX_QUEUED_BLOCKS)
+    {
+        return false;
+    }
+    return true;
+}
+
+// Segment moves the detents turned since previous segment, in the time they
+// took to be turned, so the feed follows the wheel speed
+void ESP3DJogEngine::_sendSegment(int32_t clicks, int64_t now)
+{
+    int64_t period = now - _last_segment_time;
+    if (period > ESP3D_JOG_STOP_MAX_DELAY * 1000)
+    {
+        period = ESP3D_JOG_START_INTERVAL * 1000;
+    }
+    // pending detents are scaled by acceleration
+    int64_t distance = (int64_t)clicks * getStep() / ESP3D_JOG_ACCEL_SCALE;
+    // no more than max feed can move until next segment, detents turned
+    // faster are dropped instead of piling up
+    int64_t maxFeed     = _getMaxFeed();
+    int64_t maxDistance = maxFeed * (period + ESP3D_JOG_LOOKAHEAD * 1000) / 6000;
+    if (maxDistance > ESP3D_MACHINE_STATE_MAX)
+    {
+        maxDistance = ESP3D_MACHINE_STATE_MAX;
+    }
+    if (distance > maxDistance || distance < -maxDistance)
+    {
+        distance = distance > 0 ? maxDistance : -maxDistance;
+    }
+    // segment is sent with 3 decimals
+    distance -= distance % (ESP3D_MACHINE_STATE_SCALE / 1000);
+    if (distance == 0)
+    {
+        _takeClicks(clicks);
+        return;
+    }
+    int64_t absDistance = distance < 0 ? -distance : distance;
+    // mm/min from fixed point mm and us
+    int64_t feed = absDistance * 6000 / period;
+    if (feed < ESP3D_JOG_MIN_FEED)
+    {
+        feed = ESP3D_JOG_MIN_FEED;
+    }
+    else if (feed > maxFeed)
+    {
+        feed = maxFeed;
+    }
+    char value[16];
+    snprintf(_segment,
+             sizeof(_segment),
+             "$J=G91G21%c%sF%d",
+             getAxisLetter(),
+             esp3d_machine_state::formatValue((int32_t)distance, 3, value, sizeof(value)),
+             (int)feed);
+    esp3d_log("Jog segment: %s", _segment);
+    if (!renderingClient.sendGcode(_segment))
+    {
+        esp3d_log_e("Failed to send jog segment");
+        _segment[0] = 0;
+        return;
+    }
+    _takeClicks(clicks);
+    _bf_segments++;
+    if (_motion_end_time < now)
+    {
+        _motion_end_time = now;
+    }
+    _motion_end_time += absDistance * 6000 / feed;
+    _stop_delay = period * 3 / 2;
+    if (_stop_delay < ESP3D_JOG_STOP_MIN_DELAY * 1000)
+    {
+        _stop_delay = ESP3D_JOG_STOP_MIN_DELAY * 1000;
+    }
+    else if (_stop_delay > ESP3D_JOG_STOP_MAX_DELAY * 1000)
+    {
+        _stop_delay = ESP3D_JOG_STOP_MAX_DELAY * 1000;
+    }
+    _last_segment_time = now;
+}
+
+// A segment is executed once the controller acked it, until then it may be in
+// host queue, in serial client queue or in UART FIFO, where realtime 0x85
+// overtakes it
+bool ESP3DJogEngine::_isSegmentAcked()
+{
+    if (_segment_line == 0)
+    {
+        if (gcodeHostService.hasStreamListCommand(_segment))
+        {
+            return false;
+        }
+        // lines written up to now include the segment
+        _segment_line = gcodeHostService.getWrittenLineCount();
+    }
+    return (int32_t)(gcodeHostService.getAckedLineCount() - _segment_line) >= 0;
+}
+
+// 0x85 flushes jog motion from planner, a segment not yet acked would run
+// after it, so it needs its own cancel once acked
+void ESP3DJogEngine::_cancel(int64_t now)
+{
+    esp3d_log("Jog cancel");
+    portENTER_CRITICAL(&_lock);
+    _pending_clicks = 0;
+    portEXIT_CRITICAL(&_lock);
+    if (!renderingClient.sendRealTimeCommand(ESP3D_JOG_CANCEL))
+    {
+        esp3d_log_e("Failed to send jog cancel");
+    }
+    _segment_line    = 0;
+    _recancel        = _segment[0] != 0 && !_isSegmentAcked();
+    _cancel_time     = now;
+    _motion_end_time = 0;
+    _state           = ESP3DJogState::stopping;
+}
+
+// motion is started when a report after first detent is in jog state
+void ESP3DJogEngine::_checkStart(uint64_t report_time)
+{
+    if (_started || (int64_t)report_time * 1000 < _jog_start_time
+        || esp3dGcodeParser.getMachineState().status != ESP3DMachineStatus::jog)
+    {
+        return;
+    }
+    _started = true;
+    esp3d_jog_latency((int64_t)report_time * 1000 - _jog_start_time,
+                      &_start_latency_avg,
+                      &_start_latency_max);
+}
+
+void ESP3DJogEngine::handle()
+{
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&_lock);
+    int32_t clicks      = _pending_clicks;
+    int64_t first_click = _first_click_time;
+    int64_t last_click  = _last_click_time;
+    bool stop_requested = _stop_requested;
+    _stop_requested     = false;
+    portEXIT_CRITICAL(&_lock);
+    const ESP3DMachineState &machine = esp3dGcodeParser.getMachineState();
+    uint64_t report_time =
+        esp3dGcodeParser.getPollingCommandsLastRun(ESP3D_POLLING_COMMANDS_INDEX_STATUS);
+    switch (_state)
+    {
+        case ESP3DJogState::idle:
+            if (clicks == 0)
+            {
+                return;
+            }
+            // $J= is refused during a job, an alarm or a hold
+            if (machine.status != ESP3DMachineStatus::idle
+                && machine.status != ESP3DMachineStatus::jog
+                && machine.status != ESP3DMachineStatus::unknown)
+            {
+                esp3d_log_w("Jog refused in state %s",
+                            esp3d_machine_state::getStatusString(machine.status));
+                _takeClicks(clicks);
+                return;
+            }
+            _jog_count++;
+            _state          = ESP3DJogState::jogging;
+            _started        = false;
+            _jog_start_time = first_click;
+            // first segment uses the default period
+            _last_segment_time = now - ESP3D_JOG_START_INTERVAL * 1000;
+            _stop_delay        = ESP3D_JOG_START_INTERVAL * 1000 * 3 / 2;
+            _motion_end_time   = now;
+            _segment[0]        = 0;
+            _bf_report_count   = esp3dGcodeParser.getBufferReportCount();
+            _bf_segments       = 0;
+            [[fallthrough]];
+        case ESP3DJogState::jogging:
+            _checkStart(report_time);
+            _jog_last_click_time = last_click;
+            if (stop_requested || now - last_click > _stop_delay)
+            {
+                _cancel(now);
+                return;
+            }
+            if (clicks != 0 && _canQueueSegment(now))
+            {
+                _sendSegment(clicks, now);
+            }
+            break;
+        case ESP3DJogState::stopping:
+            _checkStart(report_time);
+            if (_recancel && _isSegmentAcked())
+            {
+                renderingClient.sendRealTimeCommand(ESP3D_JOG_CANCEL);
+                _recancel    = false;
+                _cancel_time = now;
+            }
+            if (!_recancel && (int64_t)report_time * 1000 > _cancel_time
+                && machine.status != ESP3DMachineStatus::jog)
+            {
+                esp3d_jog_latency((int64_t)report_time * 1000 - _jog_last_click_time,
+                                  &_stop_latency_avg,
+                                  &_stop_latency_max);
+                _state = ESP3DJogState::idle;
+            }
+            else if (now - _cancel_time > ESP3D_JOG_STOP_TIMEOUT * 1000)
+            {
+                esp3d_log_w("Jog cancel not confirmed by controller");
+                _recancel = false;
+                _state    = ESP3DJogState::idle;
+            }
+            if (_state == ESP3DJogState::idle)
+            {
+                _segment[0] = 0;
+                // detents turned during cancel start a new jog
+                if (clicks != 0)
+                {
+                    _notify();
+                }
+            }
+            break;
+        default:
+            break;
+    }
+}
@@ -0,0 +1,166 @@
+/*
+  esp3d_jog_engine
+
+  Copyright (c) 2023 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+
+#include "esp3d_machine_state.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Realtime jog cancel of grbl 1.1 protocol
+#define ESP3D_JOG_CANCEL 0x85
+// handle() interval while jogging, and min time between segments, in ms
+#define ESP3D_JOG_TICK 10
+// detents period assumed for the first segment of a jog, in ms
+#define ESP3D_JOG_START_INTERVAL 100
+// encoder is stopped when no detent came for 1.5 segment period, within
+// these limits, in ms
+#define ESP3D_JOG_STOP_MIN_DELAY 50
+#define ESP3D_JOG_STOP_MAX_DELAY 300
+// max wait for controller to leave jog state after a cancel, in ms
+#define ESP3D_JOG_STOP_TIMEOUT 2000
+// motion queued ahead, in ms and in planner blocks
+#define ESP3D_JOG_LOOKAHEAD 150
+#define ESP3D_JOG_MAX_QUEUED_BLOCKS 2
+// Bf: of an older report is not used, in ms
+#define ESP3D_JOG_BF_MAX_AGE 200
+// mm/min, top feed is axis max rate ($110..$112) once seen in a settings
+// report, else a conservative default, so a segment queued at top speed
+// is short and the controller does not clamp its feed and stretch it
+#define ESP3D_JOG_MIN_FEED 10
+#define ESP3D_JOG_DEFAULT_MAX_FEED 3000
+#define ESP3D_JOG_MAX_FEED 20000
+// distance per detent choices: 0.001, 0.01, 0.1 and 1 mm
+#define ESP3D_JOG_STEPS_COUNT 4
+#define ESP3D_JOG_DEFAULT_STEP_INDEX 2
+// acceleration curve: distance multiplier per encoder speed, one entry every
+// ESP3D_JOG_ACCEL_BUCKET detents/s, interpolated between entries
+#define ESP3D_JOG_ACCEL_MAX_ENTRIES 10
+#define ESP3D_JOG_ACCEL_BUCKET 5
+#define ESP3D_JOG_ACCEL_MAX_FACTOR 1000
+// fixed point scale of multipliers and of pending detents
+#define ESP3D_JOG_ACCEL_SCALE 256
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum class ESP3DJogState : uint8_t {
+  idle = 0,
+  jogging,  // segments sent while encoder turns
+  stopping,  // cancel sent, waiting for controller to leave jog state
+};
+
+// Encoder detents are turned into short $J=G91 segments, each one moves the
+// distance of the detents turned since previous one, at the feed they were
+// turned, so motion follows the wheel
+// Only a short look-ahead is queued and 0x85 cancels the jog as soon as the
+// encoder stops, so the machine does not coast
+class ESP3DJogEngine final {
+ public:
+  ESP3DJogEngine();
+  // detents turned at time_us, scaled by acceleration at velocity
+  // detents/s, ignored when disabled, can be called from any task
+  void addClicks(int32_t clicks, uint32_t velocity, int64_t time_us);
+  // disabling stops the jog
+  void setEnabled(bool enabled);
+  bool isEnabled() { return _enabled; }
+  // cancel jog and drop detents not yet sent, can be called from any task
+  void stop();
+  // read acceleration curve setting, can be called from any task
+  void loadAcceleration();
+  // check and convert a curve like "1,2,4,8", factors can be NULL
+  static bool parseAcceleration(const char *curve, uint16_t *factors,
+                                uint8_t *count);
+  // distance multiplier at velocity detents/s, ESP3D_JOG_ACCEL_SCALE is x1
+  int32_t getAccelerationFactor(uint32_t velocity);
+  // called by the task which parses status reports
+  void handle();
+  // ms before handle() must be called again
+  uint32_t getDelay();
+  // task calling handle()
+  void setNotifyTask(TaskHandle_t task) { _notify_task = task; }
+  bool isActive() { return _state != ESP3DJogState::idle; }
+  ESP3DJogState getState() { return _state; }
+  void setAxis(uint8_t axis);
+  uint8_t getAxis() { return _axis; }
+  char getAxisLetter();
+  void setStepIndex(uint8_t index);
+  uint8_t getStepIndex() { return _step_index; }
+  // distance per detent in ESP3D_MACHINE_STATE_SCALE units of mm
+  int32_t getStep();
+  uint32_t getJogCount() { return _jog_count; }
+  // first detent to first report in jog state, in ms
+  uint32_t getStartLatencyAvg() { return _start_latency_avg; }
+  uint32_t getStartLatencyMax() { return _start_latency_max; }
+  // last detent to first report out of jog state, in ms
+  uint32_t getStopLatencyAvg() { return _stop_latency_avg; }
+  uint32_t getStopLatencyMax() { return _stop_latency_max; }
+
+ private:
+  portMUX_TYPE _lock;
+  TaskHandle_t _notify_task;
+  volatile bool _enabled;
+  // shared with input task, under _lock
+  int32_t _pending_clicks;  // in 1/ESP3D_JOG_ACCEL_SCALE of detent
+  uint16_t _accel_factors[ESP3D_JOG_ACCEL_MAX_ENTRIES];
+  uint8_t _accel_count;
+  int64_t _first_click_time;
+  int64_t _last_click_time;
+  bool _stop_requested;
+  // jog task only
+  ESP3DJogState _state;
+  uint8_t _axis;
+  uint8_t _step_index;
+  bool _started;
+  bool _recancel;  // last segment was not yet acked at cancel
+  // host written line count once last segment left its queue, 0 before
+  uint32_t _segment_line;
+  int64_t _jog_start_time;
+  int64_t _jog_last_click_time;
+  int64_t _last_segment_time;
+  int64_t _motion_end_time;
+  int64_t _stop_delay;
+  int64_t _cancel_time;
+  uint32_t _bf_report_count;
+  uint8_t _bf_segments;  // segments sent since last Bf:
+  char _segment[48];
+  uint32_t _jog_count;
+  uint32_t _start_latency_avg;
+  uint32_t _start_latency_max;
+  uint32_t _stop_latency_avg;
+  uint32_t _stop_latency_max;
+  int32_t _takeClicks(int32_t clicks);
+  int64_t _getMaxFeed();
+  bool _canQueueSegment(int64_t now);
+  void _sendSegment(int32_t clicks, int64_t now);
+  void _cancel(int64_t now);
+  bool _isSegmentAcked();
+  void _checkStart(uint64_t report_time);
+  void _notify();
+};
+
+extern ESP3DJogEngine esp3dJogEngine;
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
@@ -0,0 +1,407 @@
+/*
+  esp3d_machine_state
+  Copyright (c) 2023 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "esp3d_machine_state.h"
+
+#include <string.h>
+
+#include "esp3d_log.h"
+
+// same order as ESP3DMachineStatus, starting at idle
+static const char *machineStatusNames[] = {
+    "Idle", "Run", "Hold", "Jog", "Alarm", "Door", "Check", "Home", "Sleep", "Tool"};
+
+static bool esp3d_is_field_end(char c)
+{
+    return c == '|' || c == '>' || c == 0x0;
+}
+
+// Parse a decimal number as fixed point, extra decimals are truncated
+// decimals gets count of decimals written by controller
+static const char *esp3d_parse_fixed(const char *ptr, int32_t *value, uint8_t *decimals)
+{
+    bool negative = false;
+    int64_t result = 0;
+    uint8_t digits = 0;
+    if (*ptr == '-')
+    {
+        negative = true;
+        ptr++;
+    }
+    else if (*ptr == '+')
+    {
+        ptr++;
+    }
+    while (*ptr >= '0' && *ptr <= '9')
+    {
+        // saturate instead of overflow
+        if (result <= ESP3D_MACHINE_STATE_MAX)
+        {
+            result = result * 10 + (*ptr - '0');
+        }
+        ptr++;
+    }
+    result *= ESP3D_MACHINE_STATE_SCALE;
+    if (*ptr == '.')
+    {
+        ptr++;
+        int32_t unit = ESP3D_MACHINE_STATE_SCALE / 10;
+        while (*ptr >= '0' && *ptr <= '9')
+        {
+            if (digits < ESP3D_MACHINE_STATE_DECIMALS)
+            {
+                result += (*ptr - '0') * unit;
+                unit /= 10;
+                digits++;
+            }
+            ptr++;
+        }
+    }
+    // half range, so work and machine positions can be converted safely
+    if (result > ESP3D_MACHINE_STATE_MAX)
+    {
+        result = ESP3D_MACHINE_STATE_MAX;
+    }
+    *value = negative ? -(int32_t)result : (int32_t)result;
+    if (decimals)
+    {
+        *decimals = digits;
+    }
+    return ptr;
+}
+
+// Parse comma separated fixed point values, returns count of values read
+static uint8_t esp3d_parse_fixed_list(const char **ptr, int32_t *values, uint8_t max,
+                                      uint8_t *decimals)
+{
+    uint8_t count = 0;
+    while (true)
+    {
+        int32_t value;
+        uint8_t digits = 0;
+        *ptr = esp3d_parse_fixed(*ptr, &value, &digits);
+        if (count < max)
+        {
+            values[count] = value;
+            count++;
+        }
+        if (decimals && digits > *decimals)
+        {
+            *decimals = digits;
+        }
+        if (**ptr != ',')
+        {
+            break;
+        }
+        (*ptr)++;
+    }
+    return count;
+}
+
+// Parse comma separated unsigned integers, returns count of values read
+static uint8_t esp3d_parse_uint_list(const char **ptr, uint32_t *values, uint8_t max)
+{
+    uint8_t count = 0;
+    while (true)
+    {
+        uint32_t value = 0;
+        while (**ptr >= '0' && **ptr <= '9')
+        {
+            value = value * 10 + (**ptr - '0');
+            (*ptr)++;
+        }
+        if (count < max)
+        {
+            values[count] = value;
+            count++;
+        }
+        if (**ptr != ',')
+        {
+            break;
+        }
+        (*ptr)++;
+    }
+    return count;
+}
+
+// Each letter of the field sets the bit of its position in letters
+static uint32_t esp3d_parse_letters(const char **ptr, const char *letters)
+{
+    uint32_t bits = 0;
+    while (!esp3d_is_field_end(**ptr))
+    {
+        const char *letter = strchr(letters, **ptr);
+        if (letter)
+        {
+            bits |= 1 << (letter - letters);
+        }
+        (*ptr)++;
+    }
+    return bits;
+}
+
+static ESP3DMachineStatus esp3d_status_from_name(const char *name, size_t len)
+{
+    for (uint8_t i = 0; i < sizeof(machineStatusNames) / sizeof(char *); i++)
+    {
+        if (strlen(machineStatusNames[i]) == len && strncmp(name, machineStatusNames[i], len) == 0)
+        {
+            return static_cast<ESP3DMachineStatus>(i + 1);
+        }
+    }
+    return ESP3DMachineStatus::unknown;
+}
+
+static bool esp3d_is_field(const char *field, size_t len, const char *name, size_t name_len)
+{
+    return len == name_len && strncmp(field, name, len) == 0;
+}
+
+namespace esp3d_machine_state
+{
+void init(ESP3DMachineState *state)
+{
+    memset(state, 0, sizeof(ESP3DMachineState));
+    state->status     = ESP3DMachineStatus::unknown;
+    state->ov_feed    = 100;
+    state->ov_rapid   = 100;
+    state->ov_spindle = 100;
+    state->decimals   = 3;
+}
+
+bool parseReport(const char *data, ESP3DMachineState *state)
+{
+    if (data == nullptr || state == nullptr)
+    {
+        return false;
+    }
+    const char *ptr = data;
+    while (*ptr == ' ' || *ptr == '\t')
+    {
+        ptr++;
+    }
+    if (*ptr != '<')
+    {
+        return false;
+    }
+    ptr++;
+    // work on a copy so an incomplete report changes nothing
+    ESP3DMachineState parsed = *state;
+    int32_t positions[ESP3D_MACHINE_AXES_COUNT];
+    uint8_t positionsCount = 0;
+    uint8_t decimals       = 0;
+    parsed.fields          = 0;
+
+    // state and sub state: Hold:0
+    const char *name = ptr;
+    while (*ptr != ':' && !esp3d_is_field_end(*ptr))
+    {
+        ptr++;
+    }
+    parsed.status    = esp3d_status_from_name(name, ptr - name);
+    parsed.sub_state = 0;
+    if (*ptr == ':')
+    {
+        ptr++;
+        uint32_t subState = 0;
+        esp3d_parse_uint_list(&ptr, &subState, 1);
+        parsed.sub_state = subState;
+    }
+
+    while (*ptr == '|')
+    {
+        ptr++;
+        const char *field = ptr;
+        while (*ptr != ':' && !esp3d_is_field_end(*ptr))
+        {
+            ptr++;
+        }
+        size_t len = ptr - field;
+        if (*ptr != ':')
+        {
+            // field without value
+            continue;
+        }
+        ptr++;
+        uint32_t values[3];
+        uint8_t count;
+        switch (field[0])
+        {
+            case 'M':
+            case 'W':
+                if (esp3d_is_field(field, len, "MPos", 4) || esp3d_is_field(field, len, "WPos", 4))
+                {
+                    positionsCount = esp3d_parse_fixed_list(&ptr, positions,
+                                                            ESP3D_MACHINE_AXES_COUNT, &decimals);
+                    parsed.fields |= field[0] == 'M' ? ESP3D_MACHINE_FIELD_MPOS
+                                                     : ESP3D_MACHINE_FIELD_WPOS;
+                }
+                else if (esp3d_is_field(field, len, "WCO", 3))
+                {
+                    int32_t wco[ESP3D_MACHINE_AXES_COUNT];
+                    count = esp3d_parse_fixed_list(&ptr, wco, ESP3D_MACHINE_AXES_COUNT, nullptr);
+                    memcpy(parsed.wco, wco, count * sizeof(int32_t));
+                    parsed.fields |= ESP3D_MACHINE_FIELD_WCO;
+                }
+                break;
+            case 'F':
+                // FS:feed,speed or F:feed if no spindle
+                if (esp3d_is_field(field, len, "FS", 2) || esp3d_is_field(field, len, "F", 1))
+                {
+                    int32_t rates[2];
+                    count = esp3d_parse_fixed_list(&ptr, rates, 2, nullptr);
+                    parsed.feed = rates[0];
+                    parsed.fields |= ESP3D_MACHINE_FIELD_FEED;
+                    if (count > 1)
+                    {
+                        parsed.speed = rates[1];
+                        parsed.fields |= ESP3D_MACHINE_FIELD_SPEED;
+                    }
+                }
+                break;
+            case 'O':
+                if (esp3d_is_field(field, len, "Ov", 2)
+                    && esp3d_parse_uint_list(&ptr, values, 3) == 3)
+                {
+                    parsed.ov_feed    = values[0];
+                    parsed.ov_rapid   = values[1];
+                    parsed.ov_spindle = values[2];
+                    parsed.fields |= ESP3D_MACHINE_FIELD_OV;
+                }
+                break;
+            case 'P':
+                if (esp3d_is_field(field, len, "Pn", 2))
+                {
+                    parsed.pins = esp3d_parse_letters(&ptr, ESP3D_MACHINE_PINS_LETTERS);
+                    parsed.fields |= ESP3D_MACHINE_FIELD_PINS;
+                }
+                break;
+            case 'B':
+                if (esp3d_is_field(field, len, "Bf", 2)
+                    && esp3d_parse_uint_list(&ptr, values, 2) == 2)
+                {
+                    parsed.bf_blocks = values[0];
+                    parsed.bf_bytes  = values[1];
+                    parsed.fields |= ESP3D_MACHINE_FIELD_BF;
+                }
+                break;
+            case 'A':
+                if (len == 1)
+                {
+                    parsed.accessories =
+                        esp3d_parse_letters(&ptr, ESP3D_MACHINE_ACCESSORIES_LETTERS);
+                    parsed.fields |= ESP3D_MACHINE_FIELD_ACCESSORIES;
+                }
+                break;
+            case 'L':
+                if (esp3d_is_field(field, len, "Ln", 2))
+                {
+                    esp3d_parse_uint_list(&ptr, values, 1);
+                    parsed.line = values[0];
+                    parsed.fields |= ESP3D_MACHINE_FIELD_LINE;
+                }
+                break;
+            default:
+                // WCS:, MPG:, H:, Sc:... are not used
+                break;
+        }
+        // skip what is left of the field
+        while (!esp3d_is_field_end(*ptr))
+        {
+            ptr++;
+        }
+    }
+    if (*ptr != '>')
+    {
+        esp3d_log_e("Incomplete status report");
+        return false;
+    }
+
+    // no Pn: means no pin triggered
+    if (!(parsed.fields & ESP3D_MACHINE_FIELD_PINS))
+    {
+        parsed.pins = 0;
+    }
+    // A: is reported with Ov:, and omitted when all accessories are off
+    if ((parsed.fields & ESP3D_MACHINE_FIELD_OV)
+        && !(parsed.fields & ESP3D_MACHINE_FIELD_ACCESSORIES))
+    {
+        parsed.accessories = 0;
+    }
+    // work positions are converted back using WCO of this report if any
+    if (positionsCount > 0)
+    {
+        parsed.axes     = positionsCount;
+        parsed.decimals = decimals;
+        for (uint8_t i = 0; i < positionsCount; i++)
+        {
+            parsed.mpos[i] = (parsed.fields & ESP3D_MACHINE_FIELD_MPOS)
+                                 ? positions[i]
+                                 : positions[i] + parsed.wco[i];
+        }
+    }
+    *state = parsed;
+    return true;
+}
+
+int32_t getWorkPosition(const ESP3DMachineState *state, uint8_t axis)
+{
+    if (axis >= ESP3D_MACHINE_AXES_COUNT)
+    {
+        return 0;
+    }
+    return state->mpos[axis] - state->wco[axis];
+}
+
+const char *getStatusString(ESP3DMachineStatus status)
+{
+    uint8_t index = static_cast<uint8_t>(status);
+    if (index == 0 || index > sizeof(machineStatusNames) / sizeof(char *))
+    {
+        return "?";
+    }
+    return machineStatusNames[index - 1];
+}
+
+char *formatValue(int32_t value, uint8_t decimals, char *buffer, size_t size)
+{
+    if (decimals > ESP3D_MACHINE_STATE_DECIMALS)
+    {
+        decimals = ESP3D_MACHINE_STATE_DECIMALS;
+    }
+    uint32_t absValue     = value < 0 ? -(int64_t)value : value;
+    unsigned int integer  = absValue / ESP3D_MACHINE_STATE_SCALE;
+    unsigned int fraction = absValue % ESP3D_MACHINE_STATE_SCALE;
+    for (uint8_t i = decimals; i < ESP3D_MACHINE_STATE_DECIMALS; i++)
+    {
+        fraction /= 10;
+    }
+    // no -0.000
+    const char *sign = (value < 0 && (integer || fraction)) ? "-" : "";
+    if (decimals == 0)
+    {
+        snprintf(buffer, size, "%s%u", sign, integer);
+    }
+    else
+    {
+        snprintf(buffer, size, "%s%u.%0*u", sign, integer, (int)decimals, fraction);
+    }
+    return buffer;
+}
+}  // namespace esp3d_machine_state
@@ -0,0 +1,108 @@
+/*
+  esp3d_machine_state
+
+  Copyright (c) 2023 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+
+// X Y Z A B C
+#define ESP3D_MACHINE_AXES_COUNT 6
+// positions and rates are fixed point numbers, enough for mm (3 decimals)
+// and inches (4 decimals) reports
+#define ESP3D_MACHINE_STATE_DECIMALS 4
+#define ESP3D_MACHINE_STATE_SCALE 10000
+#define ESP3D_MACHINE_STATE_MAX (INT32_MAX / 2)
+
+// fields present in last report
+#define ESP3D_MACHINE_FIELD_MPOS (1 << 0)
+#define ESP3D_MACHINE_FIELD_WPOS (1 << 1)
+#define ESP3D_MACHINE_FIELD_WCO (1 << 2)
+#define ESP3D_MACHINE_FIELD_FEED (1 << 3)
+#define ESP3D_MACHINE_FIELD_SPEED (1 << 4)
+#define ESP3D_MACHINE_FIELD_OV (1 << 5)
+#define ESP3D_MACHINE_FIELD_PINS (1 << 6)
+#define ESP3D_MACHINE_FIELD_BF (1 << 7)
+#define ESP3D_MACHINE_FIELD_ACCESSORIES (1 << 8)
+#define ESP3D_MACHINE_FIELD_LINE (1 << 9)
+
+// Pn: letters, bit index is position in this string
+#define ESP3D_MACHINE_PINS_LETTERS "XYZABCPDHRSELTMFO"
+// A: letters, bit index is position in this string
+#define ESP3D_MACHINE_ACCESSORIES_LETTERS "SCFMT"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum class ESP3DMachineStatus : uint8_t {
+  unknown = 0,
+  idle,
+  run,
+  hold,
+  jog,
+  alarm,
+  door,
+  check,
+  home,
+  sleep,
+  tool,
+};
+
+// Content of a real time status report
+// <Idle|MPos:0.000,0.000,0.000|Bf:15,128|FS:0,0|Ov:100,100,100|A:S>
+// Work positions are not stored, they are machine positions minus WCO, which
+// is only reported every few reports and so is cached
+// Members are ordered by size so there is no padding
+struct ESP3DMachineState {
+  int32_t mpos[ESP3D_MACHINE_AXES_COUNT];
+  int32_t wco[ESP3D_MACHINE_AXES_COUNT];
+  int32_t feed;
+  int32_t speed;
+  uint32_t line;
+  uint32_t pins;  // bits of ESP3D_MACHINE_PINS_LETTERS
+  uint16_t fields;  // ESP3D_MACHINE_FIELD_* of last report
+  uint16_t bf_bytes;  // free bytes in RX buffer
+  ESP3DMachineStatus status;
+  uint8_t sub_state;
+  uint8_t axes;  // axes count reported
+  uint8_t decimals;  // decimals used by controller, 3 for mm, 4 for inches
+  uint8_t ov_feed;
+  uint8_t ov_rapid;
+  uint8_t ov_spindle;
+  uint8_t bf_blocks;  // free blocks in planner buffer
+  uint8_t accessories;  // bits of ESP3D_MACHINE_ACCESSORIES_LETTERS
+};
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+namespace esp3d_machine_state {
+void init(ESP3DMachineState *state);
+// Parse a report in one pass into state, without modifying or copying data
+// Fields not in report keep their previous value, except the ones the
+// controller omits when empty (Pn:, and A: when Ov: is reported)
+bool parseReport(const char *data, ESP3DMachineState *state);
+int32_t getWorkPosition(const ESP3DMachineState *state, uint8_t axis);
+const char *getStatusString(ESP3DMachineStatus status);
+// format fixed point value with the decimals used by controller
+char *formatValue(int32_t value, uint8_t decimals, char *buffer,
+                  size_t size);
+}  // namespace esp3d_machine_state
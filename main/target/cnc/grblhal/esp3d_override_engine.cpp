@@ -0,0 +1,357 @@
+/*
+  esp3d_override_engine
+  Copyright (c) 2023 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "esp3d_override_engine.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp3d_gcode_parser_service.h"
+#include "esp3d_log.h"
+#include "esp_timer.h"
+#include "rendering/esp3d_rendering_client.h"
+
+ESP3DOverrideEngine esp3dOverrideEngine;
+
+struct ESP3DOverrideCommands
+{
+    uint8_t reset;
+    uint8_t plus10;
+    uint8_t minus10;
+    uint8_t plus1;
+    uint8_t minus1;
+};
+
+// indexed by ESP3DOverrideTarget
+static const ESP3DOverrideCommands overrideCommands[] = {
+    {ESP3D_OVERRIDE_FEED_RESET,
+     ESP3D_OVERRIDE_FEED_PLUS_10,
+     ESP3D_OVERRIDE_FEED_MINUS_10,
+     ESP3D_OVERRIDE_FEED_PLUS_1,
+     ESP3D_OVERRIDE_FEED_MINUS_1},
+    {ESP3D_OVERRIDE_SPINDLE_RESET,
+     ESP3D_OVERRIDE_SPINDLE_PLUS_10,
+     ESP3D_OVERRIDE_SPINDLE_MINUS_10,
+     ESP3D_OVERRIDE_SPINDLE_PLUS_1,
+     ESP3D_OVERRIDE_SPINDLE_MINUS_1},
+};
+
+// override after a command, controller clamps it to its limits
+static int32_t esp3d_override_apply(const ESP3DOverrideCommands &cmds, int32_t value, uint8_t cmd)
+{
+    if (cmd == cmds.reset)
+    {
+        return ESP3D_OVERRIDE_DEFAULT;
+    }
+    if (cmd == cmds.plus10)
+    {
+        value += 10;
+    }
+    else if (cmd == cmds.minus10)
+    {
+        value -= 10;
+    }
+    else if (cmd == cmds.plus1)
+    {
+        value += 1;
+    }
+    else if (cmd == cmds.minus1)
+    {
+        value -= 1;
+    }
+    if (value < ESP3D_OVERRIDE_MIN)
+    {
+        return ESP3D_OVERRIDE_MIN;
+    }
+    if (value > ESP3D_OVERRIDE_MAX)
+    {
+        return ESP3D_OVERRIDE_MAX;
+    }
+    return value;
+}
+
+// append tens then ones commands, value follows them
+static bool esp3d_override_append(const ESP3DOverrideCommands &cmds,
+                                  int32_t tens,
+                                  int32_t ones,
+                                  int32_t *value,
+                                  uint8_t *commands,
+                                  uint8_t *count,
+                                  uint8_t size)
+{
+    if (*count + abs(tens) + abs(ones) > size)
+    {
+        return false;
+    }
+    for (int32_t i = 0; i < abs(tens); i++)
+    {
+        commands[*count] = tens > 0 ? cmds.plus10 : cmds.minus10;
+        *value           = esp3d_override_apply(cmds, *value, commands[*count]);
+        (*count)++;
+    }
+    for (int32_t i = 0; i < abs(ones); i++)
+    {
+        commands[*count] = ones > 0 ? cmds.plus1 : cmds.minus1;
+        *value           = esp3d_override_apply(cmds, *value, commands[*count]);
+        (*count)++;
+    }
+    return true;
+}
+
+ESP3DOverrideEngine::ESP3DOverrideEngine()
+{
+    portMUX_INITIALIZE(&_lock);
+    _enabled         = false;
+    _target          = ESP3DOverrideTarget::feed;
+    _wanted          = 0;
+    _burst_target    = ESP3DOverrideTarget::feed;
+    _expected        = ESP3D_OVERRIDE_DEFAULT;
+    _burst_time      = 0;
+    _last_burst_time = 0;
+    _commands_count  = 0;
+    _bursts_count    = 0;
+    _timeouts_count  = 0;
+}
+
+// Lower half of the course goes from min to 100 %, upper half from 100 %
+// to max, so the middle is no override
+uint8_t ESP3DOverrideEngine::positionToPercent(int32_t position)
+{
+    const int32_t half = ESP3D_OVERRIDE_POSITION_MAX / 2;
+    if (position < 0)
+    {
+        position = 0;
+    }
+    else if (position > ESP3D_OVERRIDE_POSITION_MAX)
+    {
+        position = ESP3D_OVERRIDE_POSITION_MAX;
+    }
+    if (position <= half)
+    {
+        return ESP3D_OVERRIDE_MIN + (ESP3D_OVERRIDE_DEFAULT - ESP3D_OVERRIDE_MIN) * position / half;
+    }
+    return ESP3D_OVERRIDE_DEFAULT
+           + (ESP3D_OVERRIDE_MAX - ESP3D_OVERRIDE_DEFAULT) * (position - half)
+                 / (ESP3D_OVERRIDE_POSITION_MAX - half);
+}
+
+// Candidates start from current value, from a reset, or from a limit
+// reached with tens clamped by controller; then use tens and ones, or one
+// more ten and ones back, or only tens when the limit clamps the last one;
+// the shortest which ends on wanted value is kept
+uint8_t ESP3DOverrideEngine::buildSequence(ESP3DOverrideTarget target,
+                                           uint8_t current,
+                                           uint8_t wanted,
+                                           uint8_t *commands,
+                                           uint8_t size)
+{
+    const ESP3DOverrideCommands &cmds = overrideCommands[(uint8_t)target];
+    uint8_t candidate[ESP3D_OVERRIDE_MAX_SEQUENCE];
+    uint8_t best = 0;
+    bool found   = false;
+    for (uint8_t start = 0; start < 4; start++)
+    {
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            uint8_t count = 0;
+            int32_t value = current;
+            bool valid    = true;
+            switch (start)
+            {
+                case 1:
+                    candidate[count++] = cmds.reset;
+                    value              = ESP3D_OVERRIDE_DEFAULT;
+                    break;
+                case 2:
+                    valid = esp3d_override_append(cmds,
+                                                  -(value - ESP3D_OVERRIDE_MIN + 9) / 10,
+                                                  0,
+                                                  &value,
+                                                  candidate,
+                                                  &count,
+                                                  sizeof(candidate));
+                    break;
+                case 3:
+                    valid = esp3d_override_append(cmds,
+                                                  (ESP3D_OVERRIDE_MAX - value + 9) / 10,
+                                                  0,
+                                                  &value,
+                                                  candidate,
+                                                  &count,
+                                                  sizeof(candidate));
+                    break;
+                default:
+                    break;
+            }
+            int32_t delta = (int32_t)wanted - value;
+            int32_t tens  = delta / 10;
+            int32_t ones  = delta % 10;
+            int32_t sign  = ones > 0 ? 1 : -1;
+            if (i > 0 && ones == 0)
+            {
+                break;
+            }
+            const int32_t options[3][2] = {
+                {tens, ones}, {tens + sign, ones - 10 * sign}, {tens + sign, 0}};
+            if (!valid
+                || !esp3d_override_append(cmds,
+                                          options[i][0],
+                                          options[i][1],
+                                          &value,
+                                          candidate,
+                                          &count,
+                                          sizeof(candidate))
+                || value != wanted || count > size || (found && count >= best))
+            {
+                continue;
+            }
+            memcpy(commands, candidate, count);
+            best  = count;
+            found = true;
+        }
+    }
+    return best;
+}
+
+void ESP3DOverrideEngine::setPosition(int32_t position)
+{
+    if (!_enabled)
+    {
+        return;
+    }
+    uint8_t percent = positionToPercent(position);
+    portENTER_CRITICAL(&_lock);
+    _wanted = percent;
+    portEXIT_CRITICAL(&_lock);
+}
+
+void ESP3DOverrideEngine::setEnabled(bool enabled)
+{
+    _enabled = enabled;
+    if (!enabled)
+    {
+        portENTER_CRITICAL(&_lock);
+        _wanted = 0;
+        portEXIT_CRITICAL(&_lock);
+    }
+}
+
+void ESP3DOverrideEngine::setTarget(ESP3DOverrideTarget target)
+{
+    portENTER_CRITICAL(&_lock);
+    if (_target != target)
+    {
+        _target = target;
+        _wanted = 0;
+    }
+    portEXIT_CRITICAL(&_lock);
+}
+
+uint32_t ESP3DOverrideEngine::getDelay()
+{
+    return _wanted == 0 ? UINT32_MAX : ESP3D_OVERRIDE_INTERVAL;
+}
+
+void ESP3DOverrideEngine::handle()
+{
+    portENTER_CRITICAL(&_lock);
+    uint8_t wanted             = _wanted;
+    ESP3DOverrideTarget target = _target;
+    portEXIT_CRITICAL(&_lock);
+    if (wanted == 0)
+    {
+        return;
+    }
+    int64_t now = esp_timer_get_time();
+    if (now - _last_burst_time < ESP3D_OVERRIDE_INTERVAL * 1000)
+    {
+        return;
+    }
+    const ESP3DMachineState &machine = esp3dGcodeParser.getMachineState();
+    // current override is not known before controller answers
+    if (machine.status == ESP3DMachineStatus::unknown)
+    {
+        return;
+    }
+    uint8_t current = target == ESP3DOverrideTarget::feed ? machine.ov_feed : machine.ov_spindle;
+    if (target != _burst_target)
+    {
+        _burst_time = 0;
+    }
+    // controller reports Ov: right after a change, an older report does
+    // not have it
+    if (_burst_time != 0)
+    {
+        uint64_t report_time =
+            esp3dGcodeParser.getPollingCommandsLastRun(ESP3D_POLLING_COMMANDS_INDEX_STATUS);
+        if ((int64_t)report_time * 1000 <= _burst_time + ESP3D_OVERRIDE_SETTLE_DELAY * 1000
+            || !(machine.fields & ESP3D_MACHINE_FIELD_OV))
+        {
+            if (now - _burst_time < ESP3D_OVERRIDE_CONFIRM_TIMEOUT * 1000)
+            {
+                return;
+            }
+            esp3d_log_w("Override not confirmed by controller");
+            _timeouts_count++;
+            current = _expected;
+        }
+        _burst_time = 0;
+    }
+    if (current == wanted)
+    {
+        portENTER_CRITICAL(&_lock);
+        if (_wanted == wanted && _target == target)
+        {
+            _wanted = 0;
+        }
+        portEXIT_CRITICAL(&_lock);
+        return;
+    }
+    uint8_t commands[ESP3D_OVERRIDE_MAX_SEQUENCE];
+    uint8_t count = buildSequence(target, current, wanted, commands, sizeof(commands));
+    // long sequences are sent over several bursts, each one from the
+    // reported value
+    if (count > ESP3D_OVERRIDE_MAX_BURST)
+    {
+        count = ESP3D_OVERRIDE_MAX_BURST;
+    }
+    const ESP3DOverrideCommands &cmds = overrideCommands[(uint8_t)target];
+    int32_t value                     = current;
+    uint8_t sent                      = 0;
+    for (; sent < count; sent++)
+    {
+        if (!renderingClient.sendRealTimeCommand(commands[sent]))
+        {
+            esp3d_log_e("Failed to send override command");
+            break;
+        }
+        value = esp3d_override_apply(cmds, value, commands[sent]);
+    }
+    esp3d_log("Override %u%% to %u%%, %u commands sent", current, wanted, sent);
+    _last_burst_time = now;
+    if (sent == 0)
+    {
+        return;
+    }
+    _commands_count += sent;
+    _bursts_count++;
+    _expected     = (uint8_t)value;
+    _burst_target = target;
+    _burst_time   = now;
+}
@@ -0,0 +1,116 @@
+/*
+  esp3d_override_engine
+
+  Copyright (c) 2023 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+
+#include "freertos/FreeRTOS.h"
+
+// Realtime override commands of grbl 1.1 protocol
+#define ESP3D_OVERRIDE_FEED_RESET 0x90
+#define ESP3D_OVERRIDE_FEED_PLUS_10 0x91
+#define ESP3D_OVERRIDE_FEED_MINUS_10 0x92
+#define ESP3D_OVERRIDE_FEED_PLUS_1 0x93
+#define ESP3D_OVERRIDE_FEED_MINUS_1 0x94
+#define ESP3D_OVERRIDE_SPINDLE_RESET 0x99
+#define ESP3D_OVERRIDE_SPINDLE_PLUS_10 0x9A
+#define ESP3D_OVERRIDE_SPINDLE_MINUS_10 0x9B
+#define ESP3D_OVERRIDE_SPINDLE_PLUS_1 0x9C
+#define ESP3D_OVERRIDE_SPINDLE_MINUS_1 0x9D
+// controller clamps overrides to these limits, in %
+#define ESP3D_OVERRIDE_MIN 10
+#define ESP3D_OVERRIDE_MAX 200
+#define ESP3D_OVERRIDE_DEFAULT 100
+// potentiometer position range, middle position is 100 %
+#define ESP3D_OVERRIDE_POSITION_MAX 100
+// shortest sequences are at most 15 commands
+#define ESP3D_OVERRIDE_MAX_SEQUENCE 24
+// commands sent at once, and min time between two bursts, in ms
+#define ESP3D_OVERRIDE_MAX_BURST 8
+#define ESP3D_OVERRIDE_INTERVAL 50
+// a burst is confirmed by a report with Ov: received this long after it,
+// or assumed applied after the timeout, in ms
+#define ESP3D_OVERRIDE_SETTLE_DELAY 20
+#define ESP3D_OVERRIDE_CONFIRM_TIMEOUT 500
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum class ESP3DOverrideTarget : uint8_t {
+  feed = 0,
+  spindle,
+};
+
+// Potentiometer position sets the feed or spindle override, the engine
+// sends the shortest sequence of realtime commands from the Ov: value of
+// status reports, a few at a time, and checks the next report before
+// sending more, so the override converges without oscillating
+class ESP3DOverrideEngine final {
+ public:
+  ESP3DOverrideEngine();
+  // potentiometer moved, position is 0 to ESP3D_OVERRIDE_POSITION_MAX
+  void setPosition(int32_t position);
+  // potentiometer is only used when enabled, override is changed on its
+  // next move, not when enabling or changing target
+  void setEnabled(bool enabled);
+  bool isEnabled() { return _enabled; }
+  void setTarget(ESP3DOverrideTarget target);
+  ESP3DOverrideTarget getTarget() { return _target; }
+  // override for a potentiometer position, in %
+  static uint8_t positionToPercent(int32_t position);
+  // shortest commands to go from current to wanted override, returns count
+  static uint8_t buildSequence(ESP3DOverrideTarget target, uint8_t current,
+                               uint8_t wanted, uint8_t *commands,
+                               uint8_t size);
+  // called by the task which parses status reports
+  void handle();
+  // ms before handle() must be called again
+  uint32_t getDelay();
+  // an override is being reached, status reports are needed
+  bool isActive() { return _wanted != 0; }
+  // override being reached in %, 0 if none
+  uint8_t getWanted() { return _wanted; }
+  uint32_t getCommandsCount() { return _commands_count; }
+  uint32_t getBurstsCount() { return _bursts_count; }
+  uint32_t getTimeoutsCount() { return _timeouts_count; }
+
+ private:
+  portMUX_TYPE _lock;
+  volatile bool _enabled;
+  // shared with UI task, under _lock
+  ESP3DOverrideTarget _target;
+  uint8_t _wanted;
+  // status report task only
+  ESP3DOverrideTarget _burst_target;
+  uint8_t _expected;  // override once last burst is applied
+  int64_t _burst_time;  // 0 if last burst is confirmed
+  int64_t _last_burst_time;
+  uint32_t _commands_count;
+  uint32_t _bursts_count;
+  uint32_t _timeouts_count;
+};
+
+extern ESP3DOverrideEngine esp3dOverrideEngine;
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
@@ -39,12 +39,15 @@
 
 #include "authentication/esp3d_authentication.h"
 #include "board_init.h"
+#include "esp3d_jog_engine.h"
 
 
 // Is Valid String Setting ?
 bool ESP3DSettings::isValidStringTargetSetting(const char* value,
                                          ESP3DSettingIndex settingElement) {
   switch (settingElement) {
+    case ESP3DSettingIndex::esp3d_jog_acceleration:
+      return ESP3DJogEngine::parseAcceleration(value, nullptr, nullptr);
     default:
       return false;
   }
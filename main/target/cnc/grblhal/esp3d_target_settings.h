@@ -27,6 +27,9 @@ extern "C" {
 #define BT_ADDRESS_TARGET "00:00:00:00:00:00"
 #define BTSERIAL_PIN_TARGET "1234"
 #define BTBLE_PIN_TARGET "123456"
+// encoder jog distance multipliers, from slow to fast wheel
+#define SIZE_OF_JOG_ACCELERATION 48
+#define JOG_ACCELERATION_TARGET "1,1,2,3,4,6,8,10,12,16"
 
 #ifdef __cplusplus
 }  // extern "C"
@@ -0,0 +1,56 @@
+/*
+  bench_line_classifier
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Host benchmark of grblHAL controller lines classification, over a mix of
+// acks, status reports, errors and messages
+// Host figures are only relative, they are not the ESP32 timings
+
+#include <chrono>
+
+#include "esp3d_gcode_parser_service.h"
+
+#define BENCH_ROUNDS 2000000
+
+static const char *lines[] = {
+    "ok\n",
+    "<Run|MPos:12.000,3.500,-1.000|Bf:15,128|FS:1200,0>\n",
+    "ok\n",
+    "error:20\n",
+    "[MSG:Pgm End]\n",
+    "ok\n",
+    "[GC:G0 G54 G17 G21 G90 G94 M5 M9 T0 F0 S0]\n",
+    "ALARM:1\n",
+};
+
+int main() {
+  ESP3DGCodeParserService parser;
+  const size_t count = sizeof(lines) / sizeof(lines[0]);
+  uint32_t checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < BENCH_ROUNDS; i++) {
+    uint32_t value = 0;
+    checksum += (uint32_t)parser.getType(lines[i % count], &value) + value;
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  printf("%.1f M lines/s (%u)\n", BENCH_ROUNDS / elapsed.count() / 1e6,
+         (unsigned)checksum);
+  return 0;
+}
@@ -0,0 +1,128 @@
+/*
+  bench_line_scanner
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Host benchmark of the line scanner of streamed files: a CAM file is split
+// in STREAM_CHUNK_SIZE chunks as read ahead by the prefetcher, then scanned
+// as the gcode host does. Heap allocations are counted by replacing the
+// global operator new, a stream must not allocate once started
+// Host figures only compare changes, they are not the ESP32 timings
+// Usage: bench_line_scanner [gcode file]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "gcode_host/esp3d_gcode_line_scanner.h"
+#include "tasks_def.h"
+
+#ifndef ESP3D_TEST_DATA
+#define ESP3D_TEST_DATA "data"
+#endif
+
+#define BENCH_PASSES 200
+
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+  allocations++;
+  void *ptr = malloc(size ? size : 1);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete[](void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { free(ptr); }
+
+static std::vector<std::string> readChunks(const char *path) {
+  std::vector<std::string> chunks;
+  FILE *fd = fopen(path, "rb");
+  if (fd == nullptr) {
+    return chunks;
+  }
+  char buffer[STREAM_CHUNK_SIZE];
+  size_t read = 0;
+  while ((read = fread(buffer, 1, sizeof(buffer), fd)) > 0) {
+    chunks.emplace_back(buffer, read);
+  }
+  fclose(fd);
+  return chunks;
+}
+
+int main(int argc, char **argv) {
+  const char *path =
+      argc > 1 ? argv[1] : ESP3D_TEST_DATA "/adaptive_clearing.nc";
+  std::vector<std::string> chunks = readChunks(path);
+  if (chunks.empty()) {
+    printf("Cannot read %s\n", path);
+    return 1;
+  }
+  ESP3DGcodeLineScanner scanner;
+  std::string command;
+  // as done once in gcode host begin()
+  command.reserve(ESP3D_GCODE_MAX_LINE_LENGTH + 2);
+  uint64_t commands = 0;
+  uint64_t position = 0;
+  size_t bytes = 0;
+  size_t start_allocations = allocations;
+  auto start = std::chrono::steady_clock::now();
+  for (int pass = 0; pass < BENCH_PASSES; pass++) {
+    scanner.reset();
+    command.clear();
+    for (const std::string &chunk : chunks) {
+      scanner.setChunk(chunk.c_str(), chunk.length());
+      bytes += chunk.length();
+      while (!scanner.needChunk()) {
+        ESP3DGcodeLineScan result = scanner.scan(&command, &position);
+        if (result == ESP3DGcodeLineScan::too_long) {
+          printf("Line too long at %llu\n", (unsigned long long)position);
+          return 1;
+        }
+        if (result == ESP3DGcodeLineScan::command) {
+          commands++;
+          command.clear();
+        }
+      }
+    }
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  size_t pass_allocations = allocations - start_allocations;
+  uint64_t lines = scanner.getScannedLines();
+  printf("%s: %llu lines, %llu commands, %u chunks of %d bytes\n", path,
+         (unsigned long long)(lines / BENCH_PASSES),
+         (unsigned long long)(commands / BENCH_PASSES),
+         (unsigned int)chunks.size(), STREAM_CHUNK_SIZE);
+  printf("straddled lines: %llu per pass\n",
+         (unsigned long long)(scanner.getStraddledLines() / BENCH_PASSES));
+  printf("scan: %.0f lines/s, %.1f MB/s\n", lines / elapsed.count(),
+         bytes / elapsed.count() / 1e6);
+  printf("heap allocations: %zu, %.4f per line\n", pass_allocations,
+         lines ? (double)pass_allocations / lines : 0.0);
+  return pass_allocations == 0 ? 0 : 1;
+}
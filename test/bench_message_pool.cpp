@@ -0,0 +1,58 @@
+/*
+  bench_message_pool
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Host benchmark of message allocation: create, copy for a second client
+// and delete, for an inline ack and for a slab payload
+// Host figures only compare both paths, they are not the ESP32 timings
+
+#include <string.h>
+
+#include <chrono>
+
+#include "esp3d_client.h"
+#include "esp3d_stubs.h"
+
+#define BENCH_MESSAGES 1000000
+
+static double bench_payload(const char *text) {
+  size_t length = strlen(text);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < BENCH_MESSAGES; i++) {
+    ESP3DMessage *msg = ESP3DClient::newMsg(ESP3DClientType::serial,
+                                            ESP3DClientType::all_clients,
+                                            (const uint8_t *)text, length);
+    ESP3DMessage *copy = ESP3DClient::copyMsg(*msg);
+    ESP3DClient::deleteMsg(msg);
+    ESP3DClient::deleteMsg(copy);
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / BENCH_MESSAGES;
+}
+
+int main() {
+  static char line[100];
+  memset(line, 'g', sizeof(line) - 1);
+  line[sizeof(line) - 1] = '\0';
+  esp3d_stub_reset();
+  printf("inline ack: %.1f ns/message\n", bench_payload("ok\n"));
+  printf("slab payload: %.1f ns/message\n", bench_payload(line));
+  return 0;
+}
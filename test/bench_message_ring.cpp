@@ -0,0 +1,106 @@
+/*
+  bench_message_ring
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Host benchmark of client queues: lock free ring against the mutex and
+// deque it replaces, one producer thread and one consumer thread
+// Host figures only compare both queues, they are not the ESP32 timings
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include <chrono>
+#include <deque>
+#include <thread>
+
+#include "esp3d_message_ring.h"
+
+#define BENCH_MESSAGES 2000000
+#define BENCH_CAPACITY 128
+
+#define fakeMsg(value) ((ESP3DMessage *)(uintptr_t)(value))
+
+static double bench_ring() {
+  ESP3DMessageRing ring;
+  ring.begin(BENCH_CAPACITY);
+  auto start = std::chrono::steady_clock::now();
+  std::thread producer([&ring]() {
+    for (uintptr_t i = 1; i <= BENCH_MESSAGES; i++) {
+      while (!ring.push(fakeMsg(i))) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  for (uintptr_t received = 0; received < BENCH_MESSAGES;) {
+    if (ring.pop()) {
+      received++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / BENCH_MESSAGES;
+}
+
+static double bench_mutex_deque() {
+  std::deque<ESP3DMessage *> queue;
+  pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+  auto start = std::chrono::steady_clock::now();
+  std::thread producer([&queue, &mutex]() {
+    for (uintptr_t i = 1; i <= BENCH_MESSAGES;) {
+      pthread_mutex_lock(&mutex);
+      bool pushed = queue.size() < BENCH_CAPACITY;
+      if (pushed) {
+        queue.push_back(fakeMsg(i));
+      }
+      pthread_mutex_unlock(&mutex);
+      if (pushed) {
+        i++;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+  for (uintptr_t received = 0; received < BENCH_MESSAGES;) {
+    ESP3DMessage *msg = nullptr;
+    pthread_mutex_lock(&mutex);
+    if (!queue.empty()) {
+      msg = queue.front();
+      queue.pop_front();
+    }
+    pthread_mutex_unlock(&mutex);
+    if (msg) {
+      received++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / BENCH_MESSAGES;
+}
+
+int main() {
+  printf("ring: %.1f ns/message\n", bench_ring());
+  printf("mutex and deque: %.1f ns/message\n", bench_mutex_deque());
+  return 0;
+}
@@ -0,0 +1,99 @@
+/*
+  bench_potentiometer
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Host benchmark of the potentiometer acquisition, per ADC sample: frame
+// averaging and filters of continuous mode, and one-shot reads
+// Host figures are only relative, they are not the ESP32 timings, one-shot
+// reads on ESP32 also wait for each conversion, the stub does not
+
+#include <stdio.h>
+#include <time.h>
+
+#include "phy_potentiometer.c"
+
+#define BENCH_FRAMES 200000
+#define BENCH_READS 200000
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void bench_continuous(uint32_t oversampling) {
+  phy_potentiometer_config_t config = {
+      .pin = GPIO_NUM_34,
+      .channel = 6,
+      .continuous = true,
+      .oversampling = oversampling,
+      .median_size = 5,
+      .iir_shift = 2,
+      .raw_min = 100,
+      .raw_max = 3900,
+  };
+  phy_potentiometer_configure(&config);
+  adc_digi_output_data_t frame[64];
+  for (uint32_t i = 0; i < oversampling; i++) {
+    frame[i].type1.data = 2000 + (i & 7);
+    frame[i].type1.channel = 6;
+  }
+  adc_continuous_evt_data_t edata = {
+      .conv_frame_buffer = (uint8_t *)frame,
+      .size = oversampling * SOC_ADC_DIGI_RESULT_BYTES};
+  double start = now_ns();
+  for (int i = 0; i < BENCH_FRAMES; i++) {
+    frame[0].type1.data = 2000 + (i & 15);
+    on_conversion_done(adc_continuous_handle, &edata, NULL);
+  }
+  double elapsed = now_ns() - start;
+  printf("continuous, %u samples/frame: %.1f ns/sample\n", oversampling,
+         elapsed / ((double)BENCH_FRAMES * oversampling));
+}
+
+static void bench_oneshot(uint32_t samples) {
+  phy_potentiometer_config_t config = {
+      .pin = GPIO_NUM_34,
+      .channel = 6,
+      .filter_enabled = true,
+      .filter_samples = samples,
+      .median_size = 1,
+      .raw_min = 100,
+      .raw_max = 3900,
+  };
+  phy_potentiometer_configure(&config);
+  uint32_t value;
+  double start = now_ns();
+  for (int i = 0; i < BENCH_READS; i++) {
+    esp3d_stub_adc_raw = 2000 + (i & 15);
+    phy_potentiometer_read(&value);
+  }
+  double elapsed = now_ns() - start;
+  printf("one-shot, %u samples/read: %.1f ns/sample\n", samples,
+         elapsed / ((double)BENCH_READS * samples));
+}
+
+int main(void) {
+  esp3d_stub_reset();
+  bench_continuous(16);
+  bench_continuous(64);
+  bench_oneshot(1);
+  bench_oneshot(4);
+  return 0;
+}
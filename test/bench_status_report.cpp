@@ -0,0 +1,57 @@
+/*
+  bench_status_report
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Host benchmark of grblHAL status reports: one pass parsing alone, and
+// parsing with the display values update of changed fields
+// Host figures are only relative, they are not the ESP32 timings
+
+#include <chrono>
+
+#include "esp3d_gcode_parser_service.h"
+#include "esp3d_machine_state.h"
+
+#define BENCH_REPORTS 500000
+
+static const char *reports[] = {
+    "<Run|MPos:12.000,3.500,-1.000|Bf:15,120|FS:1200,12000|Ov:100,100,100>",
+    "<Run|MPos:12.100,3.500,-1.000|Bf:14,96|FS:1200,12000|WCO:0,0,0>",
+};
+
+int main() {
+  ESP3DMachineState state;
+  esp3d_machine_state::init(&state);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < BENCH_REPORTS; i++) {
+    esp3d_machine_state::parseReport(reports[i % 2], &state);
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  printf("parse: %.1f ns/report\n", elapsed.count() / BENCH_REPORTS);
+
+  ESP3DGCodeParserService parser;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < BENCH_REPORTS; i++) {
+    parser.processCommand(reports[i % 2]);
+  }
+  elapsed = std::chrono::steady_clock::now() - start;
+  printf("parse and publish: %.1f ns/report\n",
+         elapsed.count() / BENCH_REPORTS);
+  return 0;
+}
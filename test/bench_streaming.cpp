@@ -0,0 +1,215 @@
+/*
+  bench_streaming
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Host benchmark of streaming protocols against a simulated grbl controller:
+// send-response waits for the ok of each line, character counting keeps the
+// controller RX buffer full, with the same rules as the gcode host service.
+// Commands are stripped and timed with the compiled job code, the machine
+// runs each move at its feed rate, acceleration is not simulated.
+// Figures are simulated time, not host time, so they do not depend on the
+// host. Usage: bench_streaming [gcode file]
+
+#include <stdio.h>
+#include <string.h>
+
+#include <cmath>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "gcode_host/esp3d_gcode_job.h"
+
+#ifndef ESP3D_TEST_DATA
+#define ESP3D_TEST_DATA "data"
+#endif
+
+// 115200 bauds, 10 bits per byte
+#define BYTE_US 87
+// controller parses and plans a line before sending its ok
+#define PARSE_US 200
+// gcode host task wake up and write after an ok is read
+#define HOST_LATENCY_US 1000
+// G0 has no feed rate, a common rapid rate
+#define RAPID_FEED 5000.0f
+#define OK_LENGTH 4  // "ok\r\n"
+
+struct Line {
+  size_t length;  // bytes sent, '\n' included
+  int64_t duration_us;  // time the machine needs to run it
+};
+
+struct Controller {
+  const char *name;
+  size_t rx_buffer_size;  // as reported by [OPT:], one byte kept free
+  size_t planner_blocks;
+};
+
+struct Result {
+  double job_s;
+  double lines_per_s;
+  double starved_percent;  // machine idle while lines were left
+};
+
+// Stripped commands of the file, with the time each move takes
+static bool loadLines(const char *path, float feed_scale,
+                      std::vector<Line> *lines) {
+  FILE *fd = fopen(path, "r");
+  if (!fd) {
+    return false;
+  }
+  ESP3DGcodeModalState state;
+  char buffer[256];
+  while (fgets(buffer, sizeof(buffer), fd)) {
+    const char *command = buffer;
+    size_t length = strlen(buffer);
+    esp3d_gcode_job::trimLine(&command, &length);
+    std::string stripped(command, length);
+    stripped.resize(
+        esp3d_gcode_job::stripParenComments(&stripped[0], length));
+    if (stripped.empty()) {
+      continue;
+    }
+    float x = state.x;
+    float y = state.y;
+    float z = state.z;
+    esp3d_gcode_job::updateModalState(&state, stripped.c_str(),
+                                      stripped.length());
+    float distance = sqrtf((state.x - x) * (state.x - x) +
+                           (state.y - y) * (state.y - y) +
+                           (state.z - z) * (state.z - z));
+    float feed = state.motion == 0 || state.feedrate <= 0
+                     ? RAPID_FEED
+                     : state.feedrate * feed_scale;
+    lines->push_back(
+        {stripped.length() + 1, (int64_t)(distance / feed * 60e6f)});
+  }
+  fclose(fd);
+  return true;
+}
+
+// Time stepped by one microsecond: serial link both ways, controller RX
+// buffer, parser, planner and machine, host sending lines as its mode allows
+static Result stream(const std::vector<Line> &lines,
+                     const Controller &controller, bool character_counting) {
+  int64_t now = 0;
+  size_t next = 0;
+  // host
+  std::deque<size_t> in_flight;
+  size_t bytes_in_flight = 0;
+  int64_t host_ready = 0;
+  int64_t tx_free = 0;
+  // serial link, arrival time of each line and ok
+  std::deque<std::pair<int64_t, size_t>> to_controller;
+  std::deque<int64_t> to_host;
+  int64_t rx_free = 0;
+  // controller
+  std::deque<size_t> rx_buffer;
+  int64_t parse_end = -1;
+  std::deque<int64_t> planner;
+  int64_t block_end = -1;
+  size_t acked = 0;
+  int64_t starved = 0;
+  while (acked < lines.size() || !planner.empty()) {
+    // host writes a line when its mode allows it
+    if (next < lines.size() && now >= host_ready && now >= tx_free) {
+      size_t length = lines[next].length;
+      bool can_send =
+          character_counting
+              ? in_flight.empty() ||
+                    bytes_in_flight + length <= controller.rx_buffer_size
+              : in_flight.empty();
+      if (can_send) {
+        tx_free = now + length * BYTE_US;
+        to_controller.push_back({tx_free, next});
+        in_flight.push_back(length);
+        bytes_in_flight += length;
+        next++;
+      }
+    }
+    if (!to_controller.empty() && to_controller.front().first <= now) {
+      rx_buffer.push_back(to_controller.front().second);
+      to_controller.pop_front();
+    }
+    // controller plans a line when planner has room, then acks it
+    if (parse_end < 0 && !rx_buffer.empty() &&
+        planner.size() < controller.planner_blocks) {
+      parse_end = now + PARSE_US;
+    }
+    if (parse_end >= 0 && now >= parse_end) {
+      const Line &line = lines[rx_buffer.front()];
+      rx_buffer.pop_front();
+      if (line.duration_us > 0) {
+        planner.push_back(line.duration_us);
+      }
+      rx_free = (rx_free > now ? rx_free : now) + OK_LENGTH * BYTE_US;
+      to_host.push_back(rx_free);
+      parse_end = -1;
+    }
+    // machine runs planned moves
+    if (!planner.empty()) {
+      if (block_end < 0) {
+        block_end = now + planner.front();
+      }
+      if (now >= block_end) {
+        planner.pop_front();
+        block_end = -1;
+      }
+    } else if (acked > 0 && acked < lines.size()) {
+      starved++;
+    }
+    // host reads an ok, the oldest line is released
+    if (!to_host.empty() && to_host.front() <= now) {
+      to_host.pop_front();
+      bytes_in_flight -= in_flight.front();
+      in_flight.pop_front();
+      acked++;
+      host_ready = now + HOST_LATENCY_US;
+    }
+    now++;
+  }
+  return {now / 1e6, lines.size() * 1e6 / now, 100.0 * starved / now};
+}
+
+int main(int argc, char **argv) {
+  const char *path =
+      argc > 1 ? argv[1] : ESP3D_TEST_DATA "/adaptive_clearing.nc";
+  const Controller controllers[] = {{"grbl", 127, 15}, {"grblHAL", 1023, 35}};
+  printf("%s\n", path);
+  printf("%-8s %5s | %-22s | %-22s\n", "", "feed", "send-response",
+         "character counting");
+  printf("%-8s %5s | %7s %6s %7s | %7s %6s %7s\n", "", "", "lines/s", "job s",
+         "starved", "lines/s", "job s", "starved");
+  for (const Controller &controller : controllers) {
+    for (float feed_scale : {1.0f, 2.0f, 4.0f, 8.0f}) {
+      std::vector<Line> lines;
+      if (!loadLines(path, feed_scale, &lines) || lines.empty()) {
+        printf("Cannot read %s\n", path);
+        return 1;
+      }
+      Result send_response = stream(lines, controller, false);
+      Result counting = stream(lines, controller, true);
+      printf("%-8s %4.0f%% | %7.0f %6.1f %6.1f%% | %7.0f %6.1f %6.1f%%\n",
+             controller.name, feed_scale * 100, send_response.lines_per_s,
+             send_response.job_s, send_response.starved_percent,
+             counting.lines_per_s, counting.job_s, counting.starved_percent);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,3365 @@
+%
+(adaptive clearing toolpath, generated for host benchmarks)
+(T1  D=6. CR=0. - ZMIN=-6. - flat end mill)
+G90 G94
+G17
+G21
+
+(Adaptive1)
+T1 M6
+S18000 M3
+G54
+M8
+G0 X10. Y10.
+G43 Z15. H1
+G0 Z5.
+G1 Z-1.5 F500.
+Z-2.
+G1 X43.302 Y30. F2000.
+X43.297 Y30.071
+X43.294 Y30.14
+X43.291 Y30.208
+X43.279 Y30.278
+X43.269 Y30.348
+X43.255 Y30.416
+X43.242 Y30.484
+X43.223 Y30.55
+X43.202 Y30.616
+X43.178 Y30.684
+X43.153 Y30.749
+X43.127 Y30.814
+X43.098 Y30.877
+X43.064 Y30.939
+X43.031 Y30.998
+X42.997 Y31.06
+X42.959 Y31.118
+X42.918 Y31.177
+X42.876 Y31.233
+X42.832 Y31.285
+X42.785 Y31.339
+X42.737 Y31.389
+X42.689 Y31.438
+X42.638 Y31.487
+X42.584 Y31.532
+X42.53 Y31.575
+X42.477 Y31.618
+X42.42 Y31.656
+X42.36 Y31.697
+X42.301 Y31.731
+X42.238 Y31.766
+X42.178 Y31.796
+X42.112 Y31.826
+X42.05 Y31.853
+X41.985 Y31.879
+X41.918 Y31.903
+X41.851 Y31.923
+X41.785 Y31.94
+X41.718 Y31.956
+X41.648 Y31.97
+X41.577 Y31.98
+X41.51 Y31.989
+X41.441 Y31.995
+X41.368 Y31.998
+X41.299
+X41.23
+X41.161 Y31.997
+X41.092 Y31.989
+X41.021 Y31.979
+X40.951 Y31.97
+X40.882 Y31.958
+X40.815 Y31.94
+X40.747 Y31.923
+X40.682 Y31.901
+X40.614 Y31.881
+X40.553 Y31.855
+X40.487 Y31.827
+X40.425 Y31.799
+X40.362 Y31.766
+X40.3 Y31.732
+X40.24 Y31.696
+X40.18 Y31.66
+X40.124 Y31.616
+X40.069 Y31.574
+X40.015 Y31.532
+X39.964 Y31.487
+X39.909 Y31.438
+X39.861 Y31.39
+X39.816 Y31.339
+X39.768 Y31.284
+X39.724 Y31.233
+X39.682 Y31.175
+X39.641 Y31.119
+X39.605 Y31.06
+X39.569 Y31.
+X39.533 Y30.941
+X39.502 Y30.878
+X39.475 Y30.815
+X39.445 Y30.75
+X39.419 Y30.685
+X39.398 Y30.62
+X39.377 Y30.55
+X39.36 Y30.484
+X39.344 Y30.416
+X39.332 Y30.348
+X39.318 Y30.277
+X39.311 Y30.21
+X39.304 Y30.139
+X39.302 Y30.072
+X39.301 Y30.
+X39.3 Y29.931
+X39.304 Y29.862
+X39.312 Y29.79
+X39.321 Y29.72
+X39.329 Y29.653
+X39.343 Y29.584
+X39.361 Y29.517
+X39.375 Y29.45
+X39.397 Y29.383
+X39.422 Y29.314
+X39.445 Y29.252
+X39.472 Y29.188
+X39.502 Y29.124
+X39.532 Y29.063
+X39.569 Y29.
+X39.605 Y28.939
+X39.641 Y28.884
+X39.68 Y28.825
+X39.724 Y28.769
+X39.768 Y28.715
+X39.814 Y28.663
+X39.86 Y28.611
+X39.909 Y28.563
+X39.963 Y28.512
+X40.015 Y28.466
+X40.071 Y28.423
+X40.126 Y28.38
+X40.18 Y28.342
+X40.241 Y28.303
+X40.3 Y28.269
+X40.359 Y28.235
+X40.425 Y28.203
+X40.488 Y28.173
+X40.552 Y28.147
+X40.614 Y28.119
+X40.682 Y28.099
+X40.75 Y28.078
+X40.817 Y28.058
+X40.883 Y28.044
+X40.951 Y28.029
+X41.022 Y28.02
+X41.091 Y28.012
+X41.162 Y28.003
+X41.229 Y27.999
+X41.298
+X41.368 Y28.003
+X41.438 Y28.004
+X41.511 Y28.011
+X41.577 Y28.019
+X41.647 Y28.032
+X41.716 Y28.043
+X41.784 Y28.061
+X41.853 Y28.079
+X41.92 Y28.097
+X41.984 Y28.12
+X42.049 Y28.145
+X42.114 Y28.173
+X42.176 Y28.202
+X42.237 Y28.235
+X42.302 Y28.269
+X42.359 Y28.303
+X42.417 Y28.342
+X42.477 Y28.38
+X42.533 Y28.423
+X42.586 Y28.467
+X42.639 Y28.516
+X42.689 Y28.561
+X42.738 Y28.609
+X42.786 Y28.661
+X42.832 Y28.715
+X42.876 Y28.769
+X42.917 Y28.826
+X42.957 Y28.883
+X42.995 Y28.942
+X43.03 Y28.999
+X43.068 Y29.06
+X43.099 Y29.125
+X43.128 Y29.187
+X43.156 Y29.25
+X43.18 Y29.316
+X43.202 Y29.381
+X43.222 Y29.45
+X43.239 Y29.518
+X43.255 Y29.582
+X43.268 Y29.652
+X43.281 Y29.721
+X43.288 Y29.789
+X43.293 Y29.862
+X43.298 Y29.932
+G1 X45.499 Y30. F2000.
+X45.498 Y30.09
+X45.493 Y30.181
+X45.486 Y30.274
+X45.476 Y30.366
+X45.463 Y30.456
+X45.447 Y30.545
+X45.428 Y30.635
+X45.406 Y30.726
+X45.384 Y30.812
+X45.357 Y30.902
+X45.325 Y30.988
+X45.294 Y31.073
+X45.26 Y31.157
+X45.221 Y31.241
+X45.183 Y31.322
+X45.139 Y31.404
+X45.093 Y31.483
+X45.044 Y31.559
+X44.992 Y31.636
+X44.942 Y31.711
+X44.884 Y31.783
+X44.829 Y31.858
+X44.769 Y31.925
+X44.705 Y31.992
+X44.642 Y32.057
+X44.576 Y32.121
+X44.51 Y32.185
+X44.439 Y32.242
+X44.369 Y32.299
+X44.293 Y32.352
+X44.218 Y32.406
+X44.142 Y32.455
+X44.063 Y32.502
+X43.982 Y32.547
+X43.902 Y32.589
+X43.818 Y32.63
+X43.735 Y32.669
+X43.651 Y32.704
+X43.566 Y32.735
+X43.48 Y32.763
+X43.39 Y32.792
+X43.301 Y32.815
+X43.214 Y32.833
+X43.125 Y32.854
+X43.034 Y32.868
+X42.944 Y32.878
+X42.852 Y32.889
+X42.761 Y32.897
+X42.67 Y32.9
+X42.579 Y32.901
+X42.486 Y32.897
+X42.392 Y32.891
+X42.302 Y32.883
+X42.213 Y32.874
+X42.122 Y32.861
+X42.032 Y32.844
+X41.94 Y32.826
+X41.854 Y32.802
+X41.765 Y32.778
+X41.676 Y32.75
+X41.59 Y32.717
+X41.505 Y32.687
+X41.421 Y32.651
+X41.341 Y32.611
+X41.257 Y32.57
+X41.177 Y32.528
+X41.098 Y32.481
+X41.018 Y32.43
+X40.943 Y32.382
+X40.869 Y32.327
+X40.795 Y32.27
+X40.725 Y32.214
+X40.658 Y32.154
+X40.589 Y32.091
+X40.525 Y32.026
+X40.461 Y31.961
+X40.4 Y31.893
+X40.345 Y31.819
+X40.286 Y31.75
+X40.234 Y31.675
+X40.18 Y31.598
+X40.133 Y31.521
+X40.085 Y31.442
+X40.041 Y31.365
+X39.997 Y31.283
+X39.96 Y31.201
+X39.924 Y31.114
+X39.891 Y31.03
+X39.856 Y30.942
+X39.829 Y30.857
+X39.803 Y30.768
+X39.78 Y30.68
+X39.762 Y30.589
+X39.745 Y30.502
+X39.728 Y30.412
+X39.719 Y30.321
+X39.708 Y30.228
+X39.703 Y30.139
+X39.701 Y30.045
+X39.7 Y29.953
+X39.701 Y29.861
+X39.71 Y29.77
+X39.719 Y29.679
+X39.728 Y29.589
+X39.742 Y29.498
+X39.763 Y29.411
+X39.782 Y29.32
+X39.805 Y29.233
+X39.83 Y29.144
+X39.856 Y29.057
+X39.889 Y28.971
+X39.924 Y28.884
+X39.958 Y28.803
+X39.997 Y28.718
+X40.04 Y28.636
+X40.086 Y28.559
+X40.131 Y28.479
+X40.18 Y28.401
+X40.232 Y28.324
+X40.285 Y28.25
+X40.345 Y28.179
+X40.4 Y28.11
+X40.464 Y28.04
+X40.524 Y27.973
+X40.589 Y27.909
+X40.656 Y27.846
+X40.725 Y27.787
+X40.799 Y27.73
+X40.869 Y27.672
+X40.944 Y27.619
+X41.019 Y27.567
+X41.097 Y27.521
+X41.175 Y27.473
+X41.258 Y27.431
+X41.338 Y27.388
+X41.421 Y27.35
+X41.506 Y27.316
+X41.593 Y27.283
+X41.676 Y27.249
+X41.766 Y27.224
+X41.853 Y27.198
+X41.94 Y27.175
+X42.033 Y27.158
+X42.123 Y27.142
+X42.211 Y27.125
+X42.302 Y27.115
+X42.395 Y27.109
+X42.486 Y27.103
+X42.578 Y27.1
+X42.669 Y27.099
+X42.761 Y27.103
+X42.853 Y27.112
+X42.942 Y27.119
+X43.032 Y27.133
+X43.124 Y27.146
+X43.212 Y27.166
+X43.303 Y27.186
+X43.39 Y27.21
+X43.477 Y27.236
+X43.565 Y27.267
+X43.652 Y27.299
+X43.736 Y27.331
+X43.819 Y27.371
+X43.903 Y27.408
+X43.982 Y27.451
+X44.064 Y27.496
+X44.141 Y27.544
+X44.22 Y27.592
+X44.292 Y27.645
+X44.367 Y27.701
+X44.437 Y27.759
+X44.509 Y27.817
+X44.575 Y27.88
+X44.642 Y27.943
+X44.705 Y28.006
+X44.769 Y28.073
+X44.83 Y28.144
+X44.884 Y28.214
+X44.94 Y28.289
+X44.995 Y28.361
+X45.044 Y28.438
+X45.094 Y28.516
+X45.136 Y28.595
+X45.18 Y28.679
+X45.223 Y28.76
+X45.261 Y28.845
+X45.294 Y28.926
+X45.329 Y29.014
+X45.355 Y29.1
+X45.383 Y29.186
+X45.407 Y29.274
+X45.427 Y29.363
+X45.448 Y29.456
+X45.462 Y29.546
+X45.476 Y29.634
+X45.488 Y29.727
+X45.494 Y29.815
+X45.498 Y29.908
+G1 X47.699 Y29.999 F2000.
+X47.699 Y30.125
+X47.691 Y30.255
+X47.682 Y30.379
+X47.664 Y30.505
+X47.649 Y30.631
+X47.625 Y30.759
+X47.596 Y30.88
+X47.567 Y31.004
+X47.528 Y31.127
+X47.489 Y31.246
+X47.444 Y31.367
+X47.4 Y31.484
+X47.349 Y31.598
+X47.291 Y31.714
+X47.234 Y31.828
+X47.169 Y31.936
+X47.103 Y32.045
+X47.035 Y32.149
+X46.96 Y32.255
+X46.884 Y32.356
+X46.802 Y32.453
+X46.718 Y32.548
+X46.633 Y32.64
+X46.541 Y32.733
+X46.448 Y32.817
+X46.352 Y32.902
+X46.254 Y32.984
+X46.156 Y33.061
+X46.05 Y33.131
+X45.943 Y33.203
+X45.837 Y33.269
+X45.725 Y33.332
+X45.614 Y33.392
+X45.501 Y33.448
+X45.384 Y33.497
+X45.267 Y33.545
+X45.147 Y33.589
+X45.027 Y33.628
+X44.903 Y33.664
+X44.78 Y33.698
+X44.657 Y33.723
+X44.532 Y33.749
+X44.407 Y33.765
+X44.282 Y33.782
+X44.156 Y33.79
+X44.027 Y33.799
+X43.901 Y33.802
+X43.771 Y33.797
+X43.645 Y33.79
+X43.522 Y33.781
+X43.395 Y33.766
+X43.269 Y33.747
+X43.142 Y33.725
+X43.021 Y33.695
+X42.896 Y33.665
+X42.773 Y33.629
+X42.652 Y33.589
+X42.533 Y33.546
+X42.417 Y33.497
+X42.298 Y33.446
+X42.187 Y33.39
+X42.073 Y33.331
+X41.965 Y33.27
+X41.854 Y33.201
+X41.749 Y33.133
+X41.646 Y33.058
+X41.544 Y32.983
+X41.446 Y32.901
+X41.35 Y32.82
+X41.258 Y32.732
+X41.168 Y32.641
+X41.083 Y32.551
+X40.998 Y32.452
+X40.919 Y32.354
+X40.839 Y32.256
+X40.767 Y32.152
+X40.697 Y32.046
+X40.63 Y31.935
+X40.566 Y31.826
+X40.509 Y31.715
+X40.451 Y31.6
+X40.401 Y31.483
+X40.352 Y31.365
+X40.31 Y31.248
+X40.269 Y31.126
+X40.236 Y31.006
+X40.202 Y30.879
+X40.178 Y30.759
+X40.153 Y30.63
+X40.136 Y30.506
+X40.121 Y30.381
+X40.11 Y30.252
+X40.103 Y30.126
+X40.1 Y30.001
+X40.103 Y29.872
+X40.107 Y29.746
+X40.119 Y29.619
+X40.132 Y29.492
+X40.154 Y29.37
+X40.174 Y29.243
+X40.205 Y29.117
+X40.236 Y28.995
+X40.271 Y28.874
+X40.311 Y28.753
+X40.354 Y28.635
+X40.401 Y28.517
+X40.453 Y28.4
+X40.507 Y28.287
+X40.568 Y28.173
+X40.632 Y28.065
+X40.697 Y27.954
+X40.767 Y27.848
+X40.839 Y27.746
+X40.916 Y27.645
+X40.998 Y27.545
+X41.082 Y27.449
+X41.169 Y27.359
+X41.258 Y27.267
+X41.351 Y27.181
+X41.448 Y27.097
+X41.546 Y27.02
+X41.647 Y26.942
+X41.748 Y26.869
+X41.855 Y26.799
+X41.965 Y26.729
+X42.075 Y26.669
+X42.184 Y26.608
+X42.301 Y26.552
+X42.418 Y26.501
+X42.536 Y26.452
+X42.654 Y26.412
+X42.773 Y26.37
+X42.896 Y26.334
+X43.017 Y26.302
+X43.142 Y26.278
+X43.269 Y26.255
+X43.392 Y26.235
+X43.518 Y26.219
+X43.647 Y26.208
+X43.775 Y26.202
+X43.9 Y26.202
+X44.025 Y26.204
+X44.154 Y26.208
+X44.282 Y26.218
+X44.408 Y26.234
+X44.531 Y26.254
+X44.657 Y26.275
+X44.782 Y26.302
+X44.905 Y26.334
+X45.026 Y26.373
+X45.147 Y26.411
+X45.265 Y26.452
+X45.382 Y26.5
+X45.5 Y26.553
+X45.614 Y26.61
+X45.725 Y26.666
+X45.837 Y26.729
+X45.943 Y26.796
+X46.049 Y26.867
+X46.153 Y26.941
+X46.255 Y27.017
+X46.354 Y27.098
+X46.448 Y27.183
+X46.541 Y27.267
+X46.63 Y27.359
+X46.72 Y27.452
+X46.801 Y27.546
+X46.88 Y27.646
+X46.96 Y27.745
+X47.033 Y27.849
+X47.105 Y27.956
+X47.169 Y28.065
+X47.231 Y28.174
+X47.291 Y28.285
+X47.345 Y28.402
+X47.397 Y28.517
+X47.448 Y28.633
+X47.489 Y28.754
+X47.529 Y28.875
+X47.566 Y28.995
+X47.596 Y29.118
+X47.622 Y29.245
+X47.648 Y29.369
+X47.664 Y29.495
+X47.682 Y29.619
+X47.692 Y29.746
+X47.697 Y29.871
+G1 X49.901 Y29.998 F2000.
+X49.899 Y30.171
+X49.89 Y30.338
+X49.871 Y30.509
+X49.852 Y30.677
+X49.825 Y30.846
+X49.789 Y31.012
+X49.752 Y31.174
+X49.705 Y31.338
+X49.656 Y31.502
+X49.596 Y31.659
+X49.536 Y31.817
+X49.465 Y31.974
+X49.391 Y32.128
+X49.314 Y32.278
+X49.229 Y32.423
+X49.137 Y32.567
+X49.04 Y32.705
+X48.943 Y32.843
+X48.838 Y32.979
+X48.726 Y33.107
+X48.612 Y33.231
+X48.491 Y33.352
+X48.371 Y33.469
+X48.245 Y33.583
+X48.11 Y33.688
+X47.977 Y33.791
+X47.836 Y33.888
+X47.697 Y33.984
+X47.549 Y34.072
+X47.402 Y34.153
+X47.252 Y34.23
+X47.097 Y34.3
+X46.939 Y34.365
+X46.779 Y34.428
+X46.622 Y34.481
+X46.456 Y34.53
+X46.294 Y34.571
+X46.126 Y34.609
+X45.961 Y34.637
+X45.792 Y34.662
+X45.623 Y34.683
+X45.453 Y34.694
+X45.286 Y34.7
+X45.116 Y34.699
+X44.945 Y34.694
+X44.777 Y34.679
+X44.608 Y34.661
+X44.44 Y34.636
+X44.273 Y34.608
+X44.108 Y34.571
+X43.942 Y34.528
+X43.78 Y34.479
+X43.62 Y34.424
+X43.46 Y34.365
+X43.305 Y34.302
+X43.152 Y34.23
+X43. Y34.153
+X42.85 Y34.069
+X42.706 Y33.985
+X42.561 Y33.889
+X42.425 Y33.793
+X42.289 Y33.692
+X42.158 Y33.581
+X42.029 Y33.468
+X41.908 Y33.355
+X41.789 Y33.232
+X41.674 Y33.106
+X41.563 Y32.977
+X41.459 Y32.843
+X41.36 Y32.708
+X41.265 Y32.565
+X41.173 Y32.424
+X41.088 Y32.274
+X41.009 Y32.126
+X40.936 Y31.973
+X40.866 Y31.817
+X40.803 Y31.661
+X40.745 Y31.5
+X40.694 Y31.34
+X40.65 Y31.175
+X40.609 Y31.011
+X40.578 Y30.844
+X40.55 Y30.678
+X40.528 Y30.509
+X40.512 Y30.338
+X40.505 Y30.169
+X40.502 Y30.002
+Y29.831
+X40.511 Y29.659
+X40.526 Y29.491
+X40.548 Y29.323
+X40.575 Y29.158
+X40.609 Y28.991
+X40.649 Y28.823
+X40.696 Y28.661
+X40.745 Y28.501
+X40.802 Y28.338
+X40.865 Y28.183
+X40.932 Y28.025
+X41.01 Y27.875
+X41.088 Y27.724
+X41.174 Y27.578
+X41.263 Y27.435
+X41.359 Y27.293
+X41.457 Y27.154
+X41.562 Y27.022
+X41.672 Y26.894
+X41.789 Y26.767
+X41.906 Y26.648
+X42.029 Y26.531
+X42.157 Y26.416
+X42.29 Y26.31
+X42.424 Y26.209
+X42.564 Y26.109
+X42.703 Y26.019
+X42.852 Y25.928
+X42.997 Y25.846
+X43.151 Y25.773
+X43.303 Y25.699
+X43.462 Y25.634
+X43.618 Y25.574
+X43.778 Y25.521
+X43.942 Y25.471
+X44.108 Y25.429
+X44.275 Y25.391
+X44.44 Y25.364
+X44.608 Y25.338
+X44.777 Y25.318
+X44.945 Y25.305
+X45.113 Y25.302
+X45.285 Y25.301
+X45.455 Y25.305
+X45.623 Y25.319
+X45.794 Y25.339
+X45.962 Y25.364
+X46.127 Y25.391
+X46.295 Y25.427
+X46.459 Y25.47
+X46.621 Y25.521
+X46.782 Y25.572
+X46.94 Y25.635
+X47.097 Y25.699
+X47.252 Y25.772
+X47.402 Y25.849
+X47.55 Y25.931
+X47.694 Y26.018
+X47.838 Y26.112
+X47.977 Y26.208
+X48.113 Y26.312
+X48.242 Y26.418
+X48.369 Y26.53
+X48.494 Y26.645
+X48.614 Y26.766
+X48.726 Y26.893
+X48.835 Y27.023
+X48.941 Y27.157
+X49.042 Y27.292
+X49.137 Y27.434
+X49.226 Y27.575
+X49.311 Y27.724
+X49.392 Y27.875
+X49.464 Y28.026
+X49.535 Y28.181
+X49.596 Y28.34
+X49.654 Y28.5
+X49.707 Y28.659
+X49.752 Y28.825
+X49.791 Y28.989
+X49.824 Y29.155
+X49.849 Y29.325
+X49.873 Y29.49
+X49.886 Y29.661
+X49.898 Y29.83
+G1 X52.098 Y30. F2000.
+X52.096 Y30.18
+X52.088 Y30.361
+X52.075 Y30.539
+X52.055 Y30.72
+X52.028 Y30.899
+X51.997 Y31.075
+X51.958 Y31.254
+X51.913 Y31.428
+X51.867 Y31.599
+X51.812 Y31.774
+X51.754 Y31.943
+X51.689 Y32.112
+X51.616 Y32.279
+X51.538 Y32.442
+X51.459 Y32.602
+X51.374 Y32.76
+X51.281 Y32.916
+X51.185 Y33.068
+X51.083 Y33.218
+X50.977 Y33.365
+X50.865 Y33.508
+X50.751 Y33.645
+X50.63 Y33.781
+X50.509 Y33.912
+X50.38 Y34.038
+X50.246 Y34.161
+X50.111 Y34.281
+X49.972 Y34.392
+X49.829 Y34.505
+X49.681 Y34.607
+X49.53 Y34.707
+X49.377 Y34.806
+X49.222 Y34.895
+X49.064 Y34.981
+X48.901 Y35.06
+X48.737 Y35.135
+X48.57 Y35.204
+X48.4 Y35.268
+X48.23 Y35.327
+X48.056 Y35.378
+X47.882 Y35.427
+X47.71 Y35.469
+X47.531 Y35.505
+X47.355 Y35.535
+X47.174 Y35.558
+X46.995 Y35.577
+X46.815 Y35.592
+X46.637 Y35.597
+X46.455 Y35.598
+X46.273 Y35.597
+X46.095 Y35.587
+X45.914 Y35.567
+X45.735 Y35.548
+X45.559 Y35.522
+X45.38 Y35.486
+X45.202 Y35.448
+X45.028 Y35.402
+X44.854 Y35.351
+X44.685 Y35.296
+X44.516 Y35.234
+X44.348 Y35.168
+X44.179 Y35.098
+X44.017 Y35.021
+X43.856 Y34.936
+X43.701 Y34.851
+X43.547 Y34.758
+X43.392 Y34.66
+X43.246 Y34.557
+X43.102 Y34.449
+X42.96 Y34.339
+X42.818 Y34.219
+X42.687 Y34.102
+X42.555 Y33.975
+X42.431 Y33.845
+X42.31 Y33.713
+X42.189 Y33.576
+X42.078 Y33.436
+X41.97 Y33.29
+X41.867 Y33.143
+X41.768 Y32.994
+X41.673 Y32.839
+X41.585 Y32.684
+X41.501 Y32.522
+X41.421 Y32.358
+X41.35 Y32.196
+X41.281 Y32.027
+X41.218 Y31.861
+X41.162 Y31.688
+X41.108 Y31.514
+X41.064 Y31.34
+X41.023 Y31.165
+X40.989 Y30.988
+X40.958 Y30.807
+X40.935 Y30.63
+X40.919 Y30.452
+X40.908 Y30.269
+X40.902 Y30.091
+Y29.91
+X40.906 Y29.731
+X40.919 Y29.55
+X40.937 Y29.369
+X40.957 Y29.191
+X40.989 Y29.012
+X41.023 Y28.837
+X41.062 Y28.66
+X41.109 Y28.485
+X41.159 Y28.311
+X41.218 Y28.142
+X41.28 Y27.97
+X41.349 Y27.806
+X41.42 Y27.64
+X41.502 Y27.479
+X41.584 Y27.318
+X41.673 Y27.16
+X41.766 Y27.006
+X41.867 Y26.856
+X41.97 Y26.708
+X42.078 Y26.563
+X42.189 Y26.425
+X42.308 Y26.285
+X42.431 Y26.155
+X42.555 Y26.025
+X42.686 Y25.899
+X42.818 Y25.777
+X42.96 Y25.664
+X43.1 Y25.551
+X43.244 Y25.444
+X43.393 Y25.342
+X43.546 Y25.244
+X43.702 Y25.149
+X43.856 Y25.061
+X44.017 Y24.978
+X44.179 Y24.903
+X44.348 Y24.83
+X44.516 Y24.766
+X44.682 Y24.703
+X44.855 Y24.645
+X45.031 Y24.596
+X45.204 Y24.553
+X45.382 Y24.514
+X45.557 Y24.48
+X45.734 Y24.454
+X45.917 Y24.43
+X46.093 Y24.414
+X46.274 Y24.406
+X46.457 Y24.402
+X46.634 Y24.403
+X46.816 Y24.409
+X46.998 Y24.42
+X47.174 Y24.442
+X47.356 Y24.466
+X47.531 Y24.496
+X47.709 Y24.53
+X47.883 Y24.573
+X48.057 Y24.621
+X48.229 Y24.673
+X48.4 Y24.733
+X48.568 Y24.797
+X48.735 Y24.864
+X48.902 Y24.94
+X49.064 Y25.022
+X49.223 Y25.104
+X49.378 Y25.194
+X49.533 Y25.293
+X49.682 Y25.391
+X49.827 Y25.497
+X49.971 Y25.606
+X50.11 Y25.719
+X50.245 Y25.839
+X50.379 Y25.96
+X50.509 Y26.087
+X50.631 Y26.218
+X50.75 Y26.356
+X50.866 Y26.492
+X50.977 Y26.635
+X51.085 Y26.78
+X51.186 Y26.929
+X51.282 Y27.084
+X51.371 Y27.239
+X51.458 Y27.397
+X51.539 Y27.558
+X51.618 Y27.724
+X51.688 Y27.887
+X51.751 Y28.058
+X51.81 Y28.228
+X51.865 Y28.401
+X51.913 Y28.574
+X51.958 Y28.746
+X51.994 Y28.925
+X52.028 Y29.1
+X52.053 Y29.282
+X52.073 Y29.46
+X52.087 Y29.638
+X52.098 Y29.82
+G1 X54.3 Y30.001 F2000.
+X54.297 Y30.238
+X54.284 Y30.473
+X54.26 Y30.712
+X54.231 Y30.945
+X54.191 Y31.179
+X54.145 Y31.413
+X54.09 Y31.646
+X54.024 Y31.872
+X53.951 Y32.099
+X53.873 Y32.32
+X53.782 Y32.543
+X53.684 Y32.76
+X53.58 Y32.972
+X53.47 Y33.179
+X53.349 Y33.386
+X53.222 Y33.586
+X53.088 Y33.784
+X52.943 Y33.972
+X52.795 Y34.159
+X52.643 Y34.339
+X52.481 Y34.512
+X52.313 Y34.679
+X52.136 Y34.842
+X51.958 Y34.994
+X51.774 Y35.143
+X51.581 Y35.285
+X51.387 Y35.42
+X51.185 Y35.549
+X50.983 Y35.666
+X50.774 Y35.782
+X50.558 Y35.887
+X50.343 Y35.982
+X50.121 Y36.071
+X49.898 Y36.15
+X49.671 Y36.223
+X49.444 Y36.289
+X49.214 Y36.343
+X48.979 Y36.393
+X48.747 Y36.43
+X48.51 Y36.462
+X48.274 Y36.482
+X48.039 Y36.494
+X47.801 Y36.501
+X47.563 Y36.496
+X47.324 Y36.485
+X47.087 Y36.46
+X46.853 Y36.432
+X46.62 Y36.393
+X46.387 Y36.346
+X46.155 Y36.288
+X45.928 Y36.224
+X45.7 Y36.153
+X45.477 Y36.073
+X45.258 Y35.98
+X45.039 Y35.884
+X44.827 Y35.78
+X44.619 Y35.667
+X44.414 Y35.548
+X44.215 Y35.421
+X44.016 Y35.288
+X43.829 Y35.143
+X43.644 Y34.997
+X43.464 Y34.842
+X43.289 Y34.681
+X43.119 Y34.51
+X42.957 Y34.336
+X42.803 Y34.156
+X42.654 Y33.972
+X42.512 Y33.78
+X42.381 Y33.588
+X42.253 Y33.384
+X42.132 Y33.183
+X42.019 Y32.972
+X41.916 Y32.761
+X41.818 Y32.541
+X41.73 Y32.323
+X41.647 Y32.099
+X41.576 Y31.872
+X41.511 Y31.644
+X41.455 Y31.415
+X41.407 Y31.181
+X41.371 Y30.945
+X41.338 Y30.71
+X41.318 Y30.476
+X41.304 Y30.239
+X41.299 Y30.002
+X41.304 Y29.762
+X41.316 Y29.527
+X41.338 Y29.287
+X41.367 Y29.054
+X41.409 Y28.819
+X41.456 Y28.587
+X41.513 Y28.355
+X41.577 Y28.127
+X41.65 Y27.902
+X41.731 Y27.678
+X41.818 Y27.456
+X41.913 Y27.241
+X42.018 Y27.029
+X42.13 Y26.82
+X42.253 Y26.616
+X42.378 Y26.414
+X42.514 Y26.219
+X42.655 Y26.026
+X42.803 Y25.842
+X42.957 Y25.662
+X43.123 Y25.487
+X43.29 Y25.32
+X43.463 Y25.157
+X43.644 Y25.005
+X43.827 Y24.855
+X44.017 Y24.714
+X44.214 Y24.58
+X44.412 Y24.453
+X44.621 Y24.331
+X44.827 Y24.219
+X45.042 Y24.114
+X45.257 Y24.017
+X45.479 Y23.928
+X45.703 Y23.849
+X45.926 Y23.775
+X46.158 Y23.713
+X46.389 Y23.654
+X46.618 Y23.61
+X46.853 Y23.569
+X47.088 Y23.539
+X47.325 Y23.519
+X47.564 Y23.504
+X47.8 Y23.498
+X48.038 Y23.504
+X48.273 Y23.516
+X48.51 Y23.539
+X48.746 Y23.57
+X48.982 Y23.607
+X49.212 Y23.655
+X49.444 Y23.712
+X49.674 Y23.776
+X49.899 Y23.849
+X50.12 Y23.928
+X50.342 Y24.016
+X50.558 Y24.113
+X50.773 Y24.218
+X50.981 Y24.333
+X51.186 Y24.454
+X51.387 Y24.579
+X51.583 Y24.712
+X51.774 Y24.855
+X51.956 Y25.004
+X52.136 Y25.159
+X52.312 Y25.322
+X52.48 Y25.487
+X52.639 Y25.663
+X52.796 Y25.844
+X52.944 Y26.026
+X53.084 Y26.216
+X53.22 Y26.415
+X53.349 Y26.615
+X53.47 Y26.819
+X53.579 Y27.027
+X53.686 Y27.24
+X53.782 Y27.458
+X53.869 Y27.676
+X53.954 Y27.901
+X54.024 Y28.127
+X54.09 Y28.357
+X54.145 Y28.587
+X54.19 Y28.818
+X54.23 Y29.052
+X54.262 Y29.291
+X54.284 Y29.524
+X54.294 Y29.763
+G0 Z5.
+X47.8 Y30.
+G1 Z-2. F500.
+G0 Z15.
+G1 Z-3.5 F500.
+Z-4.
+G1 X43.298 Y30.002 F2000.
+X43.299 Y30.08
+X43.294 Y30.156
+X43.285 Y30.232
+X43.277 Y30.312
+X43.261 Y30.389
+X43.247 Y30.463
+X43.226 Y30.541
+X43.203 Y30.616
+X43.177 Y30.688
+X43.15 Y30.76
+X43.118 Y30.834
+X43.085 Y30.904
+X43.047 Y30.97
+X43.008 Y31.038
+X42.969 Y31.104
+X42.923 Y31.168
+X42.876 Y31.231
+X42.826 Y31.29
+X42.773 Y31.352
+X42.721 Y31.406
+X42.664 Y31.461
+X42.606 Y31.512
+X42.548 Y31.563
+X42.484 Y31.612
+X42.42 Y31.655
+X42.357 Y31.697
+X42.288 Y31.74
+X42.221 Y31.774
+X42.15 Y31.811
+X42.078 Y31.844
+X42.005 Y31.873
+X41.933 Y31.896
+X41.858 Y31.919
+X41.784 Y31.94
+X41.709 Y31.959
+X41.63 Y31.972
+X41.553 Y31.983
+X41.477 Y31.991
+X41.398 Y31.998
+X41.319 Y32.001
+X41.241 Y32.
+X41.164 Y31.995
+X41.085 Y31.987
+X41.007 Y31.98
+X40.931 Y31.966
+X40.853 Y31.95
+X40.779 Y31.931
+X40.703 Y31.907
+X40.629 Y31.883
+X40.556 Y31.858
+X40.484 Y31.826
+X40.416 Y31.794
+X40.347 Y31.759
+X40.276 Y31.718
+X40.209 Y31.678
+X40.147 Y31.633
+X40.083 Y31.588
+X40.024 Y31.538
+X39.965 Y31.487
+X39.907 Y31.433
+X39.85 Y31.381
+X39.8 Y31.323
+X39.747 Y31.26
+X39.699 Y31.199
+X39.654 Y31.137
+X39.61 Y31.072
+X39.572 Y31.004
+X39.535 Y30.938
+X39.499 Y30.867
+X39.465 Y30.798
+X39.435 Y30.723
+X39.41 Y30.652
+X39.384 Y30.575
+X39.365 Y30.502
+X39.344 Y30.425
+X39.329 Y30.351
+X39.317 Y30.274
+X39.311 Y30.193
+X39.304 Y30.117
+X39.301 Y30.04
+X39.3 Y29.959
+X39.305 Y29.883
+X39.311 Y29.806
+X39.32 Y29.729
+X39.331 Y29.65
+X39.344 Y29.575
+X39.364 Y29.498
+X39.387 Y29.421
+X39.41 Y29.347
+X39.437 Y29.277
+X39.465 Y29.203
+X39.5 Y29.133
+X39.533 Y29.062
+X39.569 Y28.994
+X39.611 Y28.926
+X39.654 Y28.861
+X39.701 Y28.8
+X39.748 Y28.737
+X39.799 Y28.678
+X39.853 Y28.62
+X39.906 Y28.567
+X39.962 Y28.512
+X40.022 Y28.462
+X40.084 Y28.413
+X40.145 Y28.367
+X40.212 Y28.322
+X40.279 Y28.282
+X40.344 Y28.242
+X40.414 Y28.205
+X40.484 Y28.173
+X40.556 Y28.144
+X40.63 Y28.114
+X40.704 Y28.091
+X40.779 Y28.068
+X40.853 Y28.048
+X40.933 Y28.035
+X41.007 Y28.022
+X41.088 Y28.012
+X41.162 Y28.005
+X41.241 Y28.
+X41.32 Y27.998
+X41.399 Y28.003
+X41.476 Y28.009
+X41.554 Y28.015
+X41.629 Y28.026
+X41.705 Y28.043
+X41.784 Y28.058
+X41.857 Y28.08
+X41.934 Y28.104
+X42.005 Y28.13
+X42.08 Y28.159
+X42.149 Y28.188
+X42.221 Y28.224
+X42.288 Y28.262
+X42.355 Y28.303
+X42.42 Y28.342
+X42.485 Y28.389
+X42.548 Y28.437
+X42.609 Y28.488
+X42.665 Y28.538
+X42.72 Y28.592
+X42.775 Y28.648
+X42.827 Y28.706
+X42.876 Y28.77
+X42.921 Y28.829
+X42.967 Y28.894
+X43.01 Y28.959
+X43.049 Y29.03
+X43.086 Y29.097
+X43.118 Y29.168
+X43.15 Y29.239
+X43.177 Y29.312
+X43.204 Y29.387
+X43.227 Y29.459
+X43.245 Y29.536
+X43.262 Y29.612
+X43.274 Y29.687
+X43.286 Y29.766
+X43.296 Y29.846
+X43.3 Y29.924
+G1 X45.5 Y30.001 F2000.
+X45.497 Y30.093
+X45.495 Y30.183
+X45.487 Y30.277
+X45.477 Y30.368
+X45.463 Y30.458
+X45.449 Y30.547
+X45.428 Y30.64
+X45.407 Y30.727
+X45.383 Y30.817
+X45.356 Y30.905
+X45.325 Y30.992
+X45.292 Y31.076
+X45.255 Y31.164
+X45.219 Y31.245
+X45.179 Y31.328
+X45.133 Y31.41
+X45.087 Y31.49
+X45.04 Y31.567
+X44.989 Y31.643
+X44.935 Y31.72
+X44.878 Y31.792
+X44.82 Y31.864
+X44.763 Y31.934
+X44.7 Y32.002
+X44.633 Y32.069
+X44.569 Y32.129
+X44.5 Y32.191
+X44.427 Y32.253
+X44.357 Y32.309
+X44.281 Y32.363
+X44.205 Y32.413
+X44.128 Y32.462
+X44.05 Y32.51
+X43.969 Y32.557
+X43.887 Y32.6
+X43.805 Y32.639
+X43.721 Y32.676
+X43.636 Y32.708
+X43.549 Y32.74
+X43.462 Y32.77
+X43.374 Y32.794
+X43.283 Y32.819
+X43.196 Y32.839
+X43.102 Y32.856
+X43.011 Y32.871
+X42.923 Y32.881
+X42.832 Y32.892
+X42.737 Y32.895
+X42.646 Y32.901
+X42.554 Y32.898
+X42.46 Y32.895
+X42.371 Y32.89
+X42.279 Y32.881
+X42.188 Y32.87
+X42.095 Y32.857
+X42.006 Y32.839
+X41.918 Y32.82
+X41.825 Y32.795
+X41.738 Y32.769
+X41.653 Y32.742
+X41.563 Y32.708
+X41.481 Y32.676
+X41.395 Y32.638
+X41.311 Y32.6
+X41.23 Y32.558
+X41.15 Y32.51
+X41.07 Y32.463
+X40.995 Y32.415
+X40.916 Y32.361
+X40.843 Y32.308
+X40.772 Y32.25
+X40.7 Y32.19
+X40.633 Y32.13
+X40.564 Y32.067
+X40.503 Y31.999
+X40.437 Y31.934
+X40.378 Y31.863
+X40.32 Y31.792
+X40.265 Y31.72
+X40.213 Y31.646
+X40.159 Y31.568
+X40.113 Y31.491
+X40.067 Y31.411
+X40.023 Y31.328
+X39.981 Y31.248
+X39.945 Y31.164
+X39.908 Y31.077
+X39.876 Y30.993
+X39.845 Y30.905
+X39.817 Y30.817
+X39.793 Y30.727
+X39.771 Y30.638
+X39.754 Y30.549
+X39.736 Y30.457
+X39.722 Y30.367
+X39.712 Y30.274
+X39.707 Y30.184
+X39.701 Y30.092
+X39.699 Y29.999
+X39.7 Y29.907
+X39.705 Y29.817
+X39.713 Y29.726
+X39.723 Y29.635
+X39.737 Y29.54
+X39.751 Y29.451
+X39.773 Y29.361
+X39.794 Y29.271
+X39.819 Y29.181
+X39.845 Y29.097
+X39.874 Y29.007
+X39.906 Y28.921
+X39.942 Y28.838
+X39.98 Y28.753
+X40.021 Y28.672
+X40.067 Y28.591
+X40.111 Y28.511
+X40.162 Y28.433
+X40.21 Y28.357
+X40.266 Y28.28
+X40.319 Y28.206
+X40.379 Y28.137
+X40.439 Y28.068
+X40.5 Y27.998
+X40.567 Y27.934
+X40.632 Y27.87
+X40.7 Y27.807
+X40.771 Y27.747
+X40.844 Y27.692
+X40.918 Y27.638
+X40.993 Y27.585
+X41.069 Y27.537
+X41.15 Y27.49
+X41.229 Y27.444
+X41.313 Y27.401
+X41.394 Y27.361
+X41.478 Y27.326
+X41.563 Y27.292
+X41.651 Y27.26
+X41.739 Y27.231
+X41.828 Y27.205
+X41.916 Y27.183
+X42.005 Y27.162
+X42.097 Y27.145
+X42.187 Y27.131
+X42.28 Y27.118
+X42.369 Y27.109
+X42.464 Y27.102
+X42.552 Y27.1
+X42.647 Y27.101
+X42.737 Y27.105
+X42.829 Y27.11
+X42.92 Y27.116
+X43.011 Y27.128
+X43.104 Y27.144
+X43.193 Y27.163
+X43.283 Y27.18
+X43.371 Y27.206
+X43.463 Y27.229
+X43.547 Y27.261
+X43.634 Y27.293
+X43.72 Y27.326
+X43.804 Y27.363
+X43.888 Y27.401
+X43.971 Y27.442
+X44.051 Y27.487
+X44.13 Y27.535
+X44.208 Y27.584
+X44.282 Y27.637
+X44.358 Y27.694
+X44.429 Y27.748
+X44.498 Y27.807
+X44.567 Y27.869
+X44.633 Y27.934
+X44.699 Y27.998
+X44.763 Y28.065
+X44.822 Y28.135
+X44.881 Y28.209
+X44.934 Y28.282
+X44.99 Y28.355
+X45.039 Y28.432
+X45.09 Y28.509
+X45.135 Y28.59
+X45.177 Y28.671
+X45.22 Y28.752
+X45.258 Y28.837
+X45.293 Y28.924
+X45.324 Y29.01
+X45.357 Y29.094
+X45.381 Y29.181
+X45.409 Y29.27
+X45.43 Y29.36
+X45.449 Y29.45
+X45.462 Y29.543
+X45.475 Y29.632
+X45.489 Y29.725
+X45.496 Y29.818
+X45.497 Y29.907
+G1 X47.701 Y29.998 F2000.
+X47.698 Y30.118
+X47.692 Y30.237
+X47.681 Y30.36
+X47.669 Y30.478
+X47.652 Y30.594
+X47.631 Y30.712
+X47.607 Y30.83
+X47.579 Y30.946
+X47.549 Y31.059
+X47.513 Y31.174
+X47.477 Y31.287
+X47.432 Y31.401
+X47.389 Y31.51
+X47.337 Y31.617
+X47.285 Y31.723
+X47.228 Y31.831
+X47.17 Y31.935
+X47.108 Y32.034
+X47.044 Y32.137
+X46.974 Y32.234
+X46.903 Y32.331
+X46.829 Y32.423
+X46.75 Y32.512
+X46.67 Y32.603
+X46.587 Y32.687
+X46.501 Y32.769
+X46.415 Y32.848
+X46.323 Y32.93
+X46.228 Y33.003
+X46.133 Y33.073
+X46.035 Y33.141
+X45.938 Y33.21
+X45.836 Y33.269
+X45.731 Y33.329
+X45.626 Y33.386
+X45.517 Y33.44
+X45.407 Y33.488
+X45.3 Y33.533
+X45.188 Y33.577
+X45.073 Y33.615
+X44.961 Y33.649
+X44.846 Y33.68
+X44.729 Y33.709
+X44.613 Y33.732
+X44.495 Y33.753
+X44.375 Y33.77
+X44.257 Y33.785
+X44.138 Y33.793
+X44.019 Y33.798
+X43.899 Y33.799
+X43.782
+X43.661 Y33.793
+X43.544 Y33.782
+X43.422 Y33.771
+X43.305 Y33.754
+X43.189 Y33.734
+X43.073 Y33.707
+X42.955 Y33.682
+X42.841 Y33.648
+X42.724 Y33.613
+X42.611 Y33.575
+X42.502 Y33.533
+X42.391 Y33.486
+X42.282 Y33.44
+X42.176 Y33.386
+X42.069 Y33.331
+X41.967 Y33.269
+X41.865 Y33.208
+X41.764 Y33.142
+X41.666 Y33.074
+X41.57 Y33.001
+X41.477 Y32.928
+X41.385 Y32.849
+X41.3 Y32.769
+X41.212 Y32.686
+X41.131 Y32.6
+X41.05 Y32.514
+X40.971 Y32.422
+X40.899 Y32.33
+X40.825 Y32.232
+X40.757 Y32.135
+X40.692 Y32.035
+X40.629 Y31.935
+X40.571 Y31.83
+X40.514 Y31.725
+X40.463 Y31.617
+X40.414 Y31.51
+X40.366 Y31.4
+X40.324 Y31.285
+X40.287 Y31.174
+X40.251 Y31.06
+X40.221 Y30.946
+X40.19 Y30.829
+X40.167 Y30.712
+X40.148 Y30.594
+X40.13 Y30.478
+X40.117 Y30.358
+X40.108 Y30.24
+X40.103 Y30.12
+X40.1 Y29.998
+X40.103 Y29.881
+X40.109 Y29.762
+X40.115 Y29.641
+X40.128 Y29.525
+X40.145 Y29.404
+X40.168 Y29.288
+X40.19 Y29.172
+X40.22 Y29.055
+X40.249 Y28.941
+X40.286 Y28.826
+X40.327 Y28.714
+X40.368 Y28.6
+X40.412 Y28.491
+X40.46 Y28.384
+X40.513 Y28.274
+X40.569 Y28.168
+X40.631 Y28.066
+X40.692 Y27.964
+X40.755 Y27.863
+X40.827 Y27.768
+X40.899 Y27.67
+X40.971 Y27.576
+X41.05 Y27.487
+X41.13 Y27.399
+X41.213 Y27.312
+X41.3 Y27.229
+X41.389 Y27.15
+X41.476 Y27.071
+X41.571 Y26.997
+X41.667 Y26.925
+X41.763 Y26.858
+X41.863 Y26.792
+X41.967 Y26.73
+X42.069 Y26.672
+X42.175 Y26.616
+X42.28 Y26.561
+X42.391 Y26.511
+X42.503 Y26.465
+X42.613 Y26.423
+X42.727 Y26.386
+X42.841 Y26.351
+X42.956 Y26.32
+X43.07 Y26.29
+X43.189 Y26.266
+X43.307 Y26.246
+X43.422 Y26.228
+X43.544 Y26.219
+X43.661 Y26.208
+X43.78 Y26.203
+X43.901 Y26.199
+X44.018 Y26.203
+X44.137 Y26.209
+X44.257 Y26.216
+X44.377 Y26.229
+X44.495 Y26.245
+X44.614 Y26.267
+X44.73 Y26.29
+X44.846 Y26.321
+X44.96 Y26.349
+X45.074 Y26.387
+X45.186 Y26.425
+X45.297 Y26.467
+X45.41 Y26.512
+X45.519 Y26.56
+X45.626 Y26.613
+X45.732 Y26.672
+X45.836 Y26.729
+X45.935 Y26.791
+X46.037 Y26.857
+X46.135 Y26.924
+X46.229 Y26.999
+X46.323 Y27.072
+X46.411 Y27.148
+X46.5 Y27.231
+X46.588 Y27.312
+X46.672 Y27.397
+X46.751 Y27.489
+X46.827 Y27.58
+X46.903 Y27.669
+X46.974 Y27.766
+X47.042 Y27.865
+X47.107 Y27.965
+X47.17 Y28.064
+X47.23 Y28.168
+X47.286 Y28.276
+X47.339 Y28.382
+X47.386 Y28.491
+X47.432 Y28.602
+X47.474 Y28.713
+X47.513 Y28.825
+X47.55 Y28.938
+X47.579 Y29.057
+X47.608 Y29.172
+X47.634 Y29.288
+X47.652 Y29.404
+X47.672 Y29.522
+X47.683 Y29.643
+X47.691 Y29.761
+X47.697 Y29.881
+G1 X49.899 Y30.002 F2000.
+X49.897 Y30.154
+X49.892 Y30.309
+X49.878 Y30.461
+X49.859 Y30.612
+X49.836 Y30.764
+X49.811 Y30.918
+X49.776 Y31.068
+X49.738 Y31.215
+X49.699 Y31.366
+X49.65 Y31.511
+X49.597 Y31.656
+X49.541 Y31.799
+X49.48 Y31.939
+X49.416 Y32.079
+X49.346 Y32.217
+X49.269 Y32.349
+X49.19 Y32.481
+X49.109 Y32.61
+X49.02 Y32.736
+X48.93 Y32.862
+X48.832 Y32.981
+X48.735 Y33.1
+X48.628 Y33.214
+X48.522 Y33.323
+X48.412 Y33.432
+X48.3 Y33.532
+X48.183 Y33.634
+X48.062 Y33.727
+X47.936 Y33.822
+X47.809 Y33.908
+X47.681 Y33.99
+X47.55 Y34.069
+X47.417 Y34.143
+X47.278 Y34.215
+X47.14 Y34.283
+X46.999 Y34.343
+X46.856 Y34.4
+X46.711 Y34.45
+X46.565 Y34.497
+X46.415 Y34.54
+X46.268 Y34.578
+X46.116 Y34.609
+X45.966 Y34.639
+X45.814 Y34.661
+X45.661 Y34.678
+X45.508 Y34.688
+X45.355 Y34.699
+X45.201 Y34.701
+X45.045 Y34.698
+X44.893 Y34.691
+X44.74 Y34.679
+X44.588 Y34.658
+X44.435 Y34.637
+X44.284 Y34.611
+X44.132 Y34.577
+X43.985 Y34.539
+X43.836 Y34.499
+X43.69 Y34.452
+X43.544 Y34.398
+X43.401 Y34.343
+X43.262 Y34.283
+X43.121 Y34.215
+X42.984 Y34.144
+X42.85 Y34.069
+X42.718 Y33.991
+X42.587 Y33.907
+X42.464 Y33.819
+X42.34 Y33.728
+X42.219 Y33.632
+X42.1 Y33.534
+X41.987 Y33.432
+X41.876 Y33.323
+X41.768 Y33.212
+X41.666 Y33.1
+X41.568 Y32.983
+X41.47 Y32.86
+X41.381 Y32.739
+X41.293 Y32.613
+X41.211 Y32.481
+X41.128 Y32.351
+X41.053 Y32.215
+X40.985 Y32.079
+X40.92 Y31.94
+X40.86 Y31.8
+X40.802 Y31.656
+X40.748 Y31.512
+X40.701 Y31.364
+X40.66 Y31.216
+X40.622 Y31.066
+X40.59 Y30.918
+X40.564 Y30.767
+X40.541 Y30.612
+X40.523 Y30.461
+X40.511 Y30.305
+X40.504 Y30.155
+X40.498 Y30.
+X40.502 Y29.846
+X40.509 Y29.693
+X40.522 Y29.541
+X40.54 Y29.385
+X40.565 Y29.233
+X40.589 Y29.085
+X40.623 Y28.935
+X40.659 Y28.784
+X40.704 Y28.636
+X40.748 Y28.49
+X40.799 Y28.345
+X40.857 Y28.2
+X40.921 Y28.061
+X40.985 Y27.923
+X41.054 Y27.786
+X41.129 Y27.651
+X41.209 Y27.516
+X41.292 Y27.39
+X41.378 Y27.264
+X41.469 Y27.138
+X41.567 Y27.019
+X41.668 Y26.901
+X41.772 Y26.788
+X41.876 Y26.677
+X41.986 Y26.571
+X42.101 Y26.467
+X42.22 Y26.366
+X42.34 Y26.271
+X42.462 Y26.181
+X42.589 Y26.091
+X42.72 Y26.009
+X42.85 Y25.929
+X42.983 Y25.857
+X43.119 Y25.784
+X43.26 Y25.72
+X43.403 Y25.657
+X43.543 Y25.601
+X43.69 Y25.549
+X43.837 Y25.504
+X43.982 Y25.46
+X44.131 Y25.423
+X44.284 Y25.39
+X44.435 Y25.362
+X44.588 Y25.342
+X44.741 Y25.321
+X44.893 Y25.311
+X45.048 Y25.303
+X45.202 Y25.299
+X45.352 Y25.303
+X45.508 Y25.309
+X45.66 Y25.324
+X45.815 Y25.342
+X45.965 Y25.363
+X46.116 Y25.392
+X46.268 Y25.421
+X46.417 Y25.46
+X46.566 Y25.502
+X46.71 Y25.55
+X46.857 Y25.6
+X46.997 Y25.658
+X47.139 Y25.719
+X47.278 Y25.786
+X47.417 Y25.856
+X47.551 Y25.928
+X47.681 Y26.01
+X47.81 Y26.091
+X47.937 Y26.178
+X48.063 Y26.273
+X48.181 Y26.366
+X48.3 Y26.468
+X48.412 Y26.571
+X48.524 Y26.678
+X48.631 Y26.787
+X48.734 Y26.903
+X48.832 Y27.018
+X48.929 Y27.14
+X49.019 Y27.26
+X49.108 Y27.387
+X49.193 Y27.517
+X49.27 Y27.651
+X49.345 Y27.784
+X49.417 Y27.922
+X49.481 Y28.058
+X49.542 Y28.201
+X49.599 Y28.344
+X49.652 Y28.491
+X49.698 Y28.635
+X49.74 Y28.785
+X49.776 Y28.935
+X49.81 Y29.084
+X49.836 Y29.233
+X49.861 Y29.386
+X49.877 Y29.541
+X49.889 Y29.691
+X49.896 Y29.846
+G1 X52.1 Y30.001 F2000.
+X52.099 Y30.177
+X52.088 Y30.357
+X52.075 Y30.534
+X52.055 Y30.713
+X52.029 Y30.891
+X51.999 Y31.066
+X51.96 Y31.24
+X51.917 Y31.412
+X51.872 Y31.584
+X51.819 Y31.754
+X51.76 Y31.926
+X51.696 Y32.092
+X51.624 Y32.257
+X51.552 Y32.417
+X51.472 Y32.576
+X51.387 Y32.736
+X51.295 Y32.889
+X51.202 Y33.043
+X51.103 Y33.191
+X50.999 Y33.335
+X50.891 Y33.477
+X50.776 Y33.614
+X50.658 Y33.75
+X50.539 Y33.88
+X50.41 Y34.008
+X50.283 Y34.129
+X50.15 Y34.248
+X50.013 Y34.362
+X49.869 Y34.471
+X49.726 Y34.579
+X49.581 Y34.679
+X49.428 Y34.773
+X49.274 Y34.864
+X49.118 Y34.952
+X48.957 Y35.031
+X48.798 Y35.107
+X48.634 Y35.179
+X48.465 Y35.245
+X48.298 Y35.302
+X48.127 Y35.359
+X47.957 Y35.405
+X47.785 Y35.453
+X47.607 Y35.49
+X47.432 Y35.522
+X47.258 Y35.55
+X47.079 Y35.57
+X46.901 Y35.587
+X46.725 Y35.594
+X46.543 Y35.599
+X46.368 Y35.597
+X46.189 Y35.593
+X46.009 Y35.579
+X45.833 Y35.561
+X45.657 Y35.537
+X45.479 Y35.507
+X45.305 Y35.469
+X45.13 Y35.431
+X44.959 Y35.384
+X44.786 Y35.333
+X44.618 Y35.273
+X44.45 Y35.211
+X44.286 Y35.145
+X44.124 Y35.068
+X43.962 Y34.993
+X43.803 Y34.909
+X43.649 Y34.819
+X43.498 Y34.725
+X43.345 Y34.628
+X43.201 Y34.527
+X43.06 Y34.419
+X42.918 Y34.306
+X42.784 Y34.189
+X42.65 Y34.069
+X42.524 Y33.946
+X42.402 Y33.817
+X42.28 Y33.681
+X42.166 Y33.547
+X42.054 Y33.406
+X41.95 Y33.262
+X41.848 Y33.114
+X41.748 Y32.966
+X41.656 Y32.813
+X41.571 Y32.658
+X41.488 Y32.499
+X41.412 Y32.338
+X41.339 Y32.175
+X41.273 Y32.007
+X41.21 Y31.841
+X41.156 Y31.67
+X41.105 Y31.501
+X41.06 Y31.329
+X41.02 Y31.151
+X40.986 Y30.978
+X40.956 Y30.8
+X40.936 Y30.626
+X40.916 Y30.445
+X40.906 Y30.267
+X40.901 Y30.09
+X40.9 Y29.909
+X40.905 Y29.73
+X40.919 Y29.555
+X40.934 Y29.376
+X40.96 Y29.201
+X40.986 Y29.022
+X41.021 Y28.848
+X41.058 Y28.671
+X41.103 Y28.501
+X41.156 Y28.328
+X41.213 Y28.161
+X41.271 Y27.992
+X41.338 Y27.825
+X41.41 Y27.664
+X41.49 Y27.5
+X41.57 Y27.342
+X41.656 Y27.189
+X41.751 Y27.034
+X41.847 Y26.885
+X41.95 Y26.737
+X42.056 Y26.592
+X42.166 Y26.453
+X42.281 Y26.317
+X42.402 Y26.183
+X42.526 Y26.055
+X42.652 Y25.93
+X42.783 Y25.809
+X42.921 Y25.694
+X43.058 Y25.581
+X43.2 Y25.475
+X43.346 Y25.37
+X43.497 Y25.273
+X43.65 Y25.182
+X43.804 Y25.093
+X43.962 Y25.009
+X44.121 Y24.931
+X44.287 Y24.858
+X44.45 Y24.787
+X44.619 Y24.726
+X44.787 Y24.667
+X44.959 Y24.616
+X45.129 Y24.57
+X45.306 Y24.528
+X45.48 Y24.494
+X45.655 Y24.465
+X45.833 Y24.439
+X46.008 Y24.42
+X46.187 Y24.407
+X46.367 Y24.402
+X46.543 Y24.398
+X46.723 Y24.405
+X46.902 Y24.414
+X47.081 Y24.432
+X47.257 Y24.453
+X47.432 Y24.478
+X47.61 Y24.51
+X47.785 Y24.551
+X47.958 Y24.593
+X48.128 Y24.641
+X48.298 Y24.698
+X48.465 Y24.755
+X48.632 Y24.821
+X48.797 Y24.894
+X48.957 Y24.967
+X49.119 Y25.05
+X49.273 Y25.134
+X49.426 Y25.226
+X49.58 Y25.32
+X49.725 Y25.421
+X49.871 Y25.526
+X50.011 Y25.637
+X50.151 Y25.754
+X50.282 Y25.871
+X50.411 Y25.993
+X50.539 Y26.119
+X50.658 Y26.251
+X50.779 Y26.387
+X50.889 Y26.524
+X51.001 Y26.663
+X51.103 Y26.812
+X51.203 Y26.96
+X51.296 Y27.112
+X51.386 Y27.263
+X51.47 Y27.421
+X51.55 Y27.581
+X51.625 Y27.744
+X51.693 Y27.909
+X51.759 Y28.075
+X51.818 Y28.246
+X51.873 Y28.414
+X51.917 Y28.585
+X51.96 Y28.76
+X51.997 Y28.934
+X52.027 Y29.111
+X52.054 Y29.286
+X52.075 Y29.467
+X52.09 Y29.643
+X52.095 Y29.821
+G1 X54.299 Y29.999 F2000.
+X54.297 Y30.249
+X54.279 Y30.5
+X54.258 Y30.75
+X54.224 Y30.997
+X54.179 Y31.244
+X54.126 Y31.491
+X54.064 Y31.731
+X53.995 Y31.973
+X53.911 Y32.208
+X53.824 Y32.444
+X53.722 Y32.674
+X53.618 Y32.901
+X53.5 Y33.123
+X53.377 Y33.341
+X53.242 Y33.554
+X53.104 Y33.761
+X52.955 Y33.961
+X52.799 Y34.155
+X52.632 Y34.347
+X52.464 Y34.528
+X52.283 Y34.704
+X52.099 Y34.873
+X51.907 Y35.038
+X51.712 Y35.193
+X51.508 Y35.339
+X51.298 Y35.479
+X51.085 Y35.608
+X50.868 Y35.732
+X50.644 Y35.847
+X50.418 Y35.949
+X50.187 Y36.045
+X49.953 Y36.134
+X49.712 Y36.214
+X49.472 Y36.281
+X49.228 Y36.342
+X48.982 Y36.391
+X48.735 Y36.434
+X48.486 Y36.464
+X48.237 Y36.485
+X47.988 Y36.498
+X47.736 Y36.499
+X47.485 Y36.494
+X47.236 Y36.474
+X46.988 Y36.449
+X46.741 Y36.411
+X46.492 Y36.366
+X46.249 Y36.312
+X46.007 Y36.249
+X45.768 Y36.176
+X45.533 Y36.09
+X45.3 Y35.999
+X45.067 Y35.9
+X44.842 Y35.787
+X44.622 Y35.67
+X44.408 Y35.545
+X44.195 Y35.409
+X43.991 Y35.267
+X43.79 Y35.115
+X43.594 Y34.956
+X43.408 Y34.791
+X43.227 Y34.62
+X43.053 Y34.437
+X42.882 Y34.254
+X42.724 Y34.058
+X42.572 Y33.86
+X42.425 Y33.656
+X42.289 Y33.448
+X42.159 Y33.233
+X42.041 Y33.012
+X41.929 Y32.789
+X41.823 Y32.56
+X41.732 Y32.328
+X41.646 Y32.091
+X41.572 Y31.854
+X41.502 Y31.611
+X41.447 Y31.367
+X41.397 Y31.124
+X41.361 Y30.873
+X41.331 Y30.625
+X41.312 Y30.377
+X41.3 Y30.124
+Y29.874
+X41.309 Y29.623
+X41.33 Y29.374
+X41.357 Y29.126
+X41.399 Y28.878
+X41.445 Y28.633
+X41.503 Y28.387
+X41.57 Y28.145
+X41.646 Y27.907
+X41.73 Y27.674
+X41.826 Y27.442
+X41.929 Y27.213
+X42.041 Y26.99
+X42.159 Y26.769
+X42.288 Y26.552
+X42.427 Y26.344
+X42.572 Y26.14
+X42.724 Y25.939
+X42.882 Y25.748
+X43.052 Y25.561
+X43.224 Y25.38
+X43.406 Y25.21
+X43.593 Y25.042
+X43.788 Y24.886
+X43.991 Y24.732
+X44.194 Y24.593
+X44.408 Y24.455
+X44.622 Y24.33
+X44.843 Y24.211
+X45.069 Y24.101
+X45.296 Y23.999
+X45.53 Y23.907
+X45.768 Y23.827
+X46.006 Y23.753
+X46.25 Y23.687
+X46.494 Y23.631
+X46.742 Y23.587
+X46.986 Y23.55
+X47.238 Y23.524
+X47.488 Y23.506
+X47.739 Y23.502
+X47.986 Y23.503
+X48.237 Y23.516
+X48.489 Y23.538
+X48.735 Y23.566
+X48.984 Y23.609
+X49.227 Y23.658
+X49.473 Y23.717
+X49.714 Y23.787
+X49.95 Y23.866
+X50.186 Y23.955
+X50.415 Y24.051
+X50.643 Y24.155
+X50.868 Y24.27
+X51.087 Y24.393
+X51.299 Y24.522
+X51.509 Y24.661
+X51.71 Y24.807
+X51.909 Y24.964
+X52.1 Y25.127
+X52.285 Y25.294
+X52.461 Y25.472
+X52.631 Y25.654
+X52.795 Y25.841
+X52.954 Y26.038
+X53.104 Y26.242
+X53.243 Y26.446
+X53.375 Y26.66
+X53.501 Y26.877
+X53.618 Y27.1
+X53.725 Y27.324
+X53.821 Y27.556
+X53.913 Y27.789
+X53.994 Y28.026
+X54.064 Y28.267
+X54.128 Y28.511
+X54.179 Y28.755
+X54.225 Y29.003
+X54.257 Y29.248
+X54.281 Y29.5
+X54.294 Y29.748
+G0 Z5.
+X47.8 Y30.
+G1 Z-4. F500.
+G0 Z15.
+G1 Z-5.5 F500.
+Z-6.
+G1 X43.299 Y30. F2000.
+X43.299 Y30.064
+X43.294 Y30.13
+X43.292 Y30.193
+X43.282 Y30.257
+X43.272 Y30.323
+X43.261 Y30.383
+X43.25 Y30.446
+X43.232 Y30.508
+X43.215 Y30.572
+X43.198 Y30.632
+X43.174 Y30.695
+X43.152 Y30.754
+X43.126 Y30.812
+X43.102 Y30.87
+X43.07 Y30.93
+X43.042 Y30.988
+X43.007 Y31.043
+X42.973 Y31.095
+X42.937 Y31.15
+X42.9 Y31.2
+X42.858 Y31.254
+X42.817 Y31.303
+X42.775 Y31.349
+X42.73 Y31.397
+X42.687 Y31.441
+X42.64 Y31.486
+X42.588 Y31.53
+X42.539 Y31.568
+X42.488 Y31.61
+X42.438 Y31.646
+X42.381 Y31.683
+X42.328 Y31.717
+X42.274 Y31.747
+X42.217 Y31.78
+X42.156 Y31.806
+X42.098 Y31.833
+X42.039 Y31.857
+X41.978 Y31.883
+X41.918 Y31.903
+X41.858 Y31.922
+X41.793 Y31.94
+X41.733 Y31.955
+X41.669 Y31.967
+X41.606 Y31.976
+X41.542 Y31.985
+X41.478 Y31.991
+X41.413 Y31.996
+X41.35 Y31.999
+X41.285 Y32.001
+X41.221 Y31.997
+X41.157 Y31.996
+X41.092 Y31.99
+X41.025 Y31.983
+X40.963 Y31.971
+X40.899 Y31.961
+X40.838 Y31.947
+X40.773 Y31.929
+X40.712 Y31.91
+X40.651 Y31.89
+X40.592 Y31.869
+X40.529 Y31.844
+X40.473 Y31.819
+X40.413 Y31.792
+X40.358 Y31.765
+X40.299 Y31.733
+X40.246 Y31.699
+X40.192 Y31.665
+X40.137 Y31.629
+X40.086 Y31.588
+X40.035 Y31.551
+X39.986 Y31.508
+X39.938 Y31.466
+X39.892 Y31.419
+X39.846 Y31.373
+X39.805 Y31.327
+X39.76 Y31.279
+X39.719 Y31.227
+X39.682 Y31.176
+X39.645 Y31.121
+X39.61 Y31.07
+X39.577 Y31.013
+X39.543 Y30.959
+X39.516 Y30.9
+X39.488 Y30.845
+X39.46 Y30.783
+X39.437 Y30.726
+X39.412 Y30.663
+X39.392 Y30.604
+X39.373 Y30.541
+X39.358 Y30.479
+X39.342 Y30.418
+X39.333 Y30.353
+X39.322 Y30.288
+X39.314 Y30.225
+X39.308 Y30.162
+X39.302 Y30.098
+X39.299 Y30.03
+X39.3 Y29.969
+X39.304 Y29.905
+X39.307 Y29.841
+X39.313 Y29.774
+X39.322 Y29.712
+X39.331 Y29.648
+X39.343 Y29.583
+X39.358 Y29.521
+X39.374 Y29.457
+X39.391 Y29.397
+X39.414 Y29.337
+X39.435 Y29.275
+X39.46 Y29.215
+X39.487 Y29.159
+X39.513 Y29.1
+X39.545 Y29.043
+X39.577 Y28.987
+X39.609 Y28.932
+X39.647 Y28.875
+X39.684 Y28.824
+X39.719 Y28.771
+X39.762 Y28.723
+X39.802 Y28.674
+X39.847 Y28.628
+X39.891 Y28.581
+X39.937 Y28.534
+X39.985 Y28.492
+X40.036 Y28.45
+X40.084 Y28.41
+X40.136 Y28.371
+X40.19 Y28.336
+X40.243 Y28.301
+X40.3 Y28.27
+X40.356 Y28.238
+X40.414 Y28.206
+X40.472 Y28.178
+X40.53 Y28.152
+X40.592 Y28.132
+X40.651 Y28.108
+X40.712 Y28.088
+X40.775 Y28.07
+X40.836 Y28.056
+X40.9 Y28.038
+X40.965 Y28.029
+X41.026 Y28.019
+X41.093 Y28.011
+X41.155 Y28.004
+X41.22 Y28.002
+X41.285
+X41.347 Y28.
+X41.414 Y28.004
+X41.477 Y28.009
+X41.54 Y28.016
+X41.605 Y28.023
+X41.667 Y28.033
+X41.733 Y28.048
+X41.792 Y28.061
+X41.856 Y28.079
+X41.917 Y28.099
+X41.978 Y28.119
+X42.041 Y28.142
+X42.099 Y28.166
+X42.157 Y28.194
+X42.216 Y28.221
+X42.271 Y28.252
+X42.327 Y28.286
+X42.383 Y28.317
+X42.435 Y28.355
+X42.487 Y28.392
+X42.538 Y28.429
+X42.588 Y28.473
+X42.637 Y28.513
+X42.684 Y28.557
+X42.732 Y28.604
+X42.777 Y28.652
+X42.818 Y28.7
+X42.858 Y28.749
+X42.899 Y28.797
+X42.938 Y28.852
+X42.972 Y28.902
+X43.009 Y28.959
+X43.04 Y29.016
+X43.069 Y29.069
+X43.098 Y29.126
+X43.128 Y29.187
+X43.151 Y29.244
+X43.174 Y29.306
+X43.198 Y29.369
+X43.216 Y29.43
+X43.234 Y29.49
+X43.248 Y29.552
+X43.265 Y29.618
+X43.275 Y29.678
+X43.282 Y29.742
+X43.29 Y29.808
+X43.294 Y29.871
+X43.3 Y29.934
+G1 X45.5 Y30.002 F2000.
+X45.496 Y30.097
+X45.492 Y30.194
+X45.486 Y30.29
+X45.473 Y30.385
+X45.461 Y30.482
+X45.442 Y30.578
+X45.42 Y30.673
+X45.397 Y30.768
+X45.371 Y30.861
+X45.341 Y30.951
+X45.307 Y31.041
+X45.269 Y31.133
+X45.23 Y31.221
+X45.189 Y31.31
+X45.142 Y31.395
+X45.094 Y31.48
+X45.043 Y31.561
+X44.991 Y31.639
+X44.935 Y31.72
+X44.876 Y31.798
+X44.816 Y31.872
+X44.751 Y31.945
+X44.686 Y32.017
+X44.618 Y32.085
+X44.547 Y32.149
+X44.472 Y32.213
+X44.397 Y32.275
+X44.32 Y32.336
+X44.239 Y32.391
+X44.159 Y32.444
+X44.079 Y32.496
+X43.993 Y32.545
+X43.909 Y32.587
+X43.821 Y32.63
+X43.73 Y32.671
+X43.641 Y32.704
+X43.55 Y32.741
+X43.458 Y32.77
+X43.366 Y32.797
+X43.273 Y32.822
+X43.178 Y32.841
+X43.083 Y32.859
+X42.987 Y32.875
+X42.892 Y32.884
+X42.795 Y32.895
+X42.696 Y32.899
+X42.601 Y32.901
+X42.505 Y32.898
+X42.408 Y32.895
+X42.309 Y32.885
+X42.213 Y32.872
+X42.116 Y32.861
+X42.024 Y32.841
+X41.928 Y32.823
+X41.832 Y32.796
+X41.742 Y32.77
+X41.651 Y32.74
+X41.559 Y32.707
+X41.469 Y32.669
+X41.378 Y32.632
+X41.291 Y32.59
+X41.205 Y32.542
+X41.12 Y32.494
+X41.042 Y32.444
+X40.961 Y32.389
+X40.879 Y32.335
+X40.805 Y32.275
+X40.727 Y32.214
+X40.654 Y32.149
+X40.583 Y32.085
+X40.515 Y32.016
+X40.448 Y31.944
+X40.385 Y31.871
+X40.323 Y31.799
+X40.267 Y31.722
+X40.209 Y31.643
+X40.156 Y31.559
+X40.105 Y31.48
+X40.056 Y31.393
+X40.01 Y31.307
+X39.968 Y31.223
+X39.93 Y31.131
+X39.893 Y31.043
+X39.859 Y30.952
+X39.829 Y30.859
+X39.805 Y30.766
+X39.778 Y30.673
+X39.76 Y30.578
+X39.74 Y30.484
+X39.725 Y30.388
+X39.715 Y30.289
+X39.705 Y30.192
+X39.701 Y30.098
+Y30.
+Y29.902
+X39.705 Y29.806
+X39.715 Y29.711
+X39.725 Y29.612
+X39.74 Y29.516
+X39.757 Y29.423
+X39.78 Y29.327
+X39.805 Y29.232
+X39.829 Y29.142
+X39.861 Y29.049
+X39.893 Y28.959
+X39.93 Y28.867
+X39.97 Y28.781
+X40.013 Y28.691
+X40.056 Y28.605
+X40.105 Y28.523
+X40.157 Y28.44
+X40.209 Y28.361
+X40.263 Y28.28
+X40.325 Y28.202
+X40.387 Y28.129
+X40.449 Y28.054
+X40.517 Y27.982
+X40.582 Y27.914
+X40.654 Y27.849
+X40.727 Y27.785
+X40.802 Y27.723
+X40.881 Y27.665
+X40.959 Y27.608
+X41.038 Y27.554
+X41.123 Y27.503
+X41.206 Y27.457
+X41.29 Y27.412
+X41.379 Y27.37
+X41.469 Y27.329
+X41.556 Y27.295
+X41.647 Y27.262
+X41.74 Y27.231
+X41.835 Y27.203
+X41.927 Y27.179
+X42.021 Y27.16
+X42.12 Y27.139
+X42.215 Y27.125
+X42.308 Y27.116
+X42.405 Y27.106
+X42.504 Y27.103
+X42.599 Y27.098
+X42.698 Y27.1
+X42.795 Y27.106
+X42.891 Y27.113
+X42.986 Y27.128
+X43.081 Y27.14
+X43.179 Y27.158
+X43.272 Y27.181
+X43.367 Y27.204
+X43.46 Y27.231
+X43.55 Y27.259
+X43.64 Y27.294
+X43.733 Y27.329
+X43.82 Y27.368
+X43.907 Y27.411
+X43.994 Y27.456
+X44.078 Y27.506
+X44.161 Y27.554
+X44.241 Y27.609
+X44.319 Y27.665
+X44.396 Y27.725
+X44.472 Y27.784
+X44.545 Y27.851
+X44.614 Y27.914
+X44.683 Y27.983
+X44.75 Y28.055
+X44.814 Y28.128
+X44.875 Y28.201
+X44.936 Y28.28
+X44.991 Y28.357
+X45.045 Y28.441
+X45.094 Y28.52
+X45.143 Y28.607
+X45.186 Y28.691
+X45.233 Y28.78
+X45.271 Y28.869
+X45.305 Y28.959
+X45.339 Y29.048
+X45.372 Y29.14
+X45.396 Y29.235
+X45.421 Y29.329
+X45.441 Y29.422
+X45.458 Y29.516
+X45.474 Y29.613
+X45.484 Y29.711
+X45.494 Y29.805
+X45.497 Y29.904
+G1 X47.701 Y29.998 F2000.
+X47.695 Y30.144
+X47.69 Y30.291
+X47.675 Y30.435
+X47.657 Y30.578
+X47.632 Y30.721
+X47.602 Y30.862
+X47.566 Y31.
+X47.525 Y31.14
+X47.478 Y31.276
+X47.428 Y31.413
+X47.37 Y31.545
+X47.31 Y31.677
+X47.243 Y31.806
+X47.171 Y31.931
+X47.096 Y32.056
+X47.017 Y32.176
+X46.931 Y32.291
+X46.843 Y32.405
+X46.748 Y32.515
+X46.65 Y32.623
+X46.55 Y32.725
+X46.444 Y32.823
+X46.333 Y32.918
+X46.22 Y33.009
+X46.105 Y33.096
+X45.984 Y33.176
+X45.863 Y33.255
+X45.738 Y33.327
+X45.61 Y33.393
+X45.477 Y33.456
+X45.344 Y33.516
+X45.211 Y33.567
+X45.076 Y33.615
+X44.935 Y33.655
+X44.794 Y33.694
+X44.656 Y33.724
+X44.512 Y33.749
+X44.369 Y33.772
+X44.227 Y33.787
+X44.082 Y33.795
+X43.936 Y33.799
+X43.793 Y33.797
+X43.646 Y33.791
+X43.504 Y33.781
+X43.359 Y33.763
+X43.218 Y33.738
+X43.073 Y33.71
+X42.933 Y33.674
+X42.796 Y33.635
+X42.657 Y33.591
+X42.52 Y33.539
+X42.387 Y33.486
+X42.254 Y33.425
+X42.128 Y33.36
+X42.001 Y33.291
+X41.875 Y33.214
+X41.756 Y33.137
+X41.636 Y33.052
+X41.524 Y32.966
+X41.41 Y32.872
+X41.304 Y32.774
+X41.198 Y32.673
+X41.101 Y32.57
+X41.005 Y32.46
+X40.912 Y32.348
+X40.825 Y32.233
+X40.745 Y32.113
+X40.667 Y31.992
+X40.593 Y31.868
+X40.523 Y31.741
+X40.457 Y31.613
+X40.401 Y31.478
+X40.347 Y31.345
+X40.299 Y31.207
+X40.253 Y31.069
+X40.216 Y30.932
+X40.184 Y30.79
+X40.155 Y30.649
+X40.132 Y30.504
+X40.118 Y30.361
+X40.108 Y30.215
+X40.101 Y30.071
+X40.099 Y29.926
+X40.105 Y29.783
+X40.117 Y29.639
+X40.133 Y29.496
+X40.156 Y29.354
+X40.182 Y29.21
+X40.216 Y29.068
+X40.255 Y28.928
+X40.299 Y28.791
+X40.345 Y28.656
+X40.4 Y28.52
+X40.457 Y28.39
+X40.522 Y28.257
+X40.592 Y28.132
+X40.664 Y28.006
+X40.744 Y27.884
+X40.825 Y27.768
+X40.912 Y27.651
+X41.003 Y27.54
+X41.101 Y27.43
+X41.2 Y27.325
+X41.305 Y27.225
+X41.413 Y27.128
+X41.524 Y27.034
+X41.636 Y26.949
+X41.756 Y26.864
+X41.876 Y26.784
+X41.999 Y26.708
+X42.127 Y26.64
+X42.255 Y26.575
+X42.386 Y26.514
+X42.52 Y26.459
+X42.656 Y26.409
+X42.793 Y26.364
+X42.934 Y26.323
+X43.074 Y26.291
+X43.217 Y26.262
+X43.36 Y26.239
+X43.502 Y26.221
+X43.648 Y26.209
+X43.792 Y26.201
+X43.936 Y26.202
+X44.082 Y26.205
+X44.224 Y26.214
+X44.367 Y26.231
+X44.514 Y26.251
+X44.654 Y26.277
+X44.795 Y26.308
+X44.936 Y26.342
+X45.076 Y26.386
+X45.212 Y26.434
+X45.346 Y26.487
+X45.477 Y26.545
+X45.608 Y26.604
+X45.736 Y26.672
+X45.861 Y26.746
+X45.983 Y26.822
+X46.103 Y26.904
+X46.222 Y26.992
+X46.335 Y27.083
+X46.442 Y27.177
+X46.547 Y27.277
+X46.651 Y27.379
+X46.747 Y27.483
+X46.843 Y27.595
+X46.932 Y27.71
+X47.015 Y27.826
+X47.097 Y27.947
+X47.172 Y28.068
+X47.246 Y28.194
+X47.311 Y28.325
+X47.37 Y28.455
+X47.427 Y28.587
+X47.478 Y28.725
+X47.525 Y28.86
+X47.566 Y28.997
+X47.602 Y29.14
+X47.633 Y29.28
+X47.655 Y29.423
+X47.676 Y29.567
+X47.689 Y29.711
+X47.696 Y29.857
+G1 X49.902 Y29.999 F2000.
+X49.899 Y30.156
+X49.889 Y30.311
+X49.878 Y30.465
+X49.858 Y30.618
+X49.835 Y30.774
+X49.809 Y30.926
+X49.776 Y31.08
+X49.736 Y31.23
+X49.692 Y31.378
+X49.646 Y31.528
+X49.593 Y31.671
+X49.535 Y31.815
+X49.474 Y31.959
+X49.405 Y32.1
+X49.334 Y32.237
+X49.259 Y32.371
+X49.175 Y32.507
+X49.091 Y32.636
+X49.002 Y32.762
+X48.907 Y32.888
+X48.813 Y33.006
+X48.71 Y33.124
+X48.605 Y33.24
+X48.494 Y33.353
+X48.385 Y33.458
+X48.269 Y33.562
+X48.146 Y33.66
+X48.026 Y33.758
+X47.9 Y33.848
+X47.772 Y33.933
+X47.639 Y34.016
+X47.506 Y34.098
+X47.367 Y34.169
+X47.228 Y34.241
+X47.089 Y34.302
+X46.945 Y34.366
+X46.798 Y34.418
+X46.651 Y34.471
+X46.503 Y34.514
+X46.352 Y34.558
+X46.201 Y34.591
+X46.052 Y34.622
+X45.898 Y34.65
+X45.741 Y34.67
+X45.588 Y34.684
+X45.431 Y34.693
+X45.277 Y34.699
+X45.122 Y34.7
+X44.967 Y34.693
+X44.812 Y34.684
+X44.658 Y34.67
+X44.504 Y34.648
+X44.35 Y34.624
+X44.197 Y34.593
+X44.048 Y34.557
+X43.895 Y34.514
+X43.746 Y34.472
+X43.602 Y34.421
+X43.455 Y34.363
+X43.313 Y34.306
+X43.17 Y34.237
+X43.031 Y34.17
+X42.894 Y34.095
+X42.762 Y34.019
+X42.629 Y33.935
+X42.502 Y33.846
+X42.374 Y33.754
+X42.251 Y33.66
+X42.134 Y33.561
+X42.016 Y33.456
+X41.902 Y33.349
+X41.793 Y33.239
+X41.691 Y33.126
+X41.587 Y33.006
+X41.492 Y32.889
+X41.397 Y32.764
+X41.31 Y32.636
+X41.224 Y32.506
+X41.144 Y32.374
+X41.065 Y32.237
+X40.995 Y32.099
+X40.926 Y31.961
+X40.865 Y31.815
+X40.807 Y31.673
+X40.754 Y31.526
+X40.707 Y31.38
+X40.664 Y31.23
+X40.624 Y31.08
+X40.591 Y30.926
+X40.565 Y30.773
+X40.541 Y30.619
+X40.522 Y30.465
+X40.512 Y30.309
+X40.501 Y30.154
+Y30.001
+X40.504 Y29.846
+X40.51 Y29.69
+X40.522 Y29.536
+X40.541 Y29.38
+X40.565 Y29.228
+X40.592 Y29.075
+X40.624 Y28.92
+X40.664 Y28.772
+X40.708 Y28.622
+X40.755 Y28.472
+X40.807 Y28.33
+X40.865 Y28.184
+X40.927 Y28.043
+X40.995 Y27.903
+X41.067 Y27.764
+X41.142 Y27.626
+X41.222 Y27.494
+X41.309 Y27.363
+X41.399 Y27.239
+X41.492 Y27.112
+X41.589 Y26.99
+X41.69 Y26.874
+X41.795 Y26.761
+X41.904 Y26.648
+X42.017 Y26.541
+X42.132 Y26.438
+X42.254 Y26.338
+X42.374 Y26.243
+X42.502 Y26.153
+X42.63 Y26.066
+X42.76 Y25.982
+X42.895 Y25.906
+X43.033 Y25.831
+X43.169 Y25.761
+X43.311 Y25.697
+X43.453 Y25.635
+X43.601 Y25.58
+X43.748 Y25.532
+X43.896 Y25.483
+X44.047 Y25.443
+X44.199 Y25.407
+X44.35 Y25.378
+X44.503 Y25.354
+X44.659 Y25.331
+X44.813 Y25.315
+X44.968 Y25.306
+X45.124 Y25.3
+X45.278
+X45.433 Y25.305
+X45.587 Y25.316
+X45.742 Y25.332
+X45.895 Y25.35
+X46.051 Y25.376
+X46.203 Y25.407
+X46.353 Y25.445
+X46.505 Y25.484
+X46.652 Y25.53
+X46.801 Y25.582
+X46.943 Y25.636
+X47.087 Y25.694
+X47.231 Y25.761
+X47.368 Y25.832
+X47.505 Y25.903
+X47.639 Y25.984
+X47.772 Y26.067
+X47.898 Y26.151
+X48.024 Y26.245
+X48.15 Y26.338
+X48.267 Y26.439
+X48.384 Y26.543
+X48.494 Y26.651
+X48.604 Y26.759
+X48.71 Y26.874
+X48.811 Y26.993
+X48.907 Y27.113
+X49.001 Y27.236
+X49.092 Y27.363
+X49.178 Y27.496
+X49.258 Y27.628
+X49.334 Y27.765
+X49.405 Y27.9
+X49.472 Y28.043
+X49.535 Y28.183
+X49.591 Y28.326
+X49.647 Y28.475
+X49.694 Y28.621
+X49.736 Y28.77
+X49.774 Y28.922
+X49.806 Y29.074
+X49.836 Y29.225
+X49.858 Y29.381
+X49.879 Y29.534
+X49.889 Y29.689
+X49.898 Y29.844
+G1 X52.101 Y29.999 F2000.
+X52.095 Y30.187
+X52.089 Y30.371
+X52.073 Y30.559
+X52.049 Y30.741
+X52.023 Y30.926
+X51.991 Y31.112
+X51.949 Y31.293
+X51.904 Y31.471
+X51.853 Y31.649
+X51.792 Y31.827
+X51.728 Y32.002
+X51.66 Y32.177
+X51.585 Y32.347
+X51.505 Y32.514
+X51.417 Y32.677
+X51.326 Y32.84
+X51.23 Y32.999
+X51.126 Y33.155
+X51.022 Y33.305
+X50.906 Y33.453
+X50.788 Y33.598
+X50.668 Y33.742
+X50.542 Y33.879
+X50.411 Y34.009
+X50.275 Y34.135
+X50.135 Y34.259
+X49.992 Y34.377
+X49.844 Y34.491
+X49.693 Y34.6
+X49.537 Y34.705
+X49.381 Y34.803
+X49.217 Y34.896
+X49.056 Y34.985
+X48.889 Y35.064
+X48.72 Y35.143
+X48.545 Y35.215
+X48.373 Y35.28
+X48.194 Y35.338
+X48.016 Y35.39
+X47.838 Y35.439
+X47.655 Y35.48
+X47.474 Y35.515
+X47.29 Y35.544
+X47.106 Y35.565
+X46.918 Y35.585
+X46.734 Y35.597
+X46.547 Y35.6
+X46.361 Y35.598
+X46.175 Y35.592
+X45.987 Y35.576
+X45.805 Y35.555
+X45.621 Y35.528
+X45.437 Y35.499
+X45.253 Y35.459
+X45.072 Y35.416
+X44.894 Y35.365
+X44.716 Y35.309
+X44.543 Y35.247
+X44.37 Y35.177
+X44.197 Y35.104
+X44.028 Y35.026
+X43.861 Y34.94
+X43.701 Y34.851
+X43.538 Y34.753
+X43.384 Y34.655
+X43.23 Y34.548
+X43.081 Y34.436
+X42.938 Y34.318
+X42.794 Y34.197
+X42.656 Y34.073
+X42.525 Y33.944
+X42.393 Y33.81
+X42.271 Y33.669
+X42.152 Y33.529
+X42.035 Y33.383
+X41.927 Y33.23
+X41.819 Y33.079
+X41.723 Y32.918
+X41.628 Y32.761
+X41.539 Y32.597
+X41.457 Y32.429
+X41.378 Y32.262
+X41.304 Y32.09
+X41.238 Y31.917
+X41.177 Y31.738
+X41.121 Y31.562
+X41.072 Y31.383
+X41.032 Y31.2
+X40.994 Y31.019
+X40.961 Y30.836
+X40.939 Y30.649
+X40.918 Y30.464
+X40.908 Y30.279
+X40.902 Y30.092
+X40.899 Y29.906
+X40.908 Y29.72
+X40.918 Y29.536
+X40.936 Y29.351
+X40.961 Y29.164
+X40.994 Y28.983
+X41.03 Y28.799
+X41.071 Y28.618
+X41.121 Y28.44
+X41.178 Y28.262
+X41.238 Y28.085
+X41.303 Y27.91
+X41.376 Y27.738
+X41.456 Y27.569
+X41.537 Y27.403
+X41.629 Y27.241
+X41.721 Y27.079
+X41.823 Y26.925
+X41.926 Y26.769
+X42.038 Y26.618
+X42.15 Y26.471
+X42.271 Y26.331
+X42.394 Y26.191
+X42.526 Y26.057
+X42.657 Y25.928
+X42.796 Y25.801
+X42.935 Y25.681
+X43.083 Y25.566
+X43.232 Y25.452
+X43.384 Y25.346
+X43.54 Y25.246
+X43.702 Y25.152
+X43.864 Y25.06
+X44.03 Y24.973
+X44.198 Y24.896
+X44.369 Y24.821
+X44.543 Y24.752
+X44.718 Y24.693
+X44.893 Y24.637
+X45.072 Y24.586
+X45.254 Y24.54
+X45.435 Y24.503
+X45.62 Y24.468
+X45.806 Y24.442
+X45.988 Y24.423
+X46.175 Y24.411
+X46.362 Y24.402
+X46.546 Y24.399
+X46.731 Y24.405
+X46.919 Y24.415
+X47.106 Y24.432
+X47.288 Y24.455
+X47.471 Y24.487
+X47.656 Y24.521
+X47.836 Y24.561
+X48.016 Y24.609
+X48.195 Y24.665
+X48.372 Y24.721
+X48.544 Y24.786
+X48.717 Y24.859
+X48.889 Y24.934
+X49.056 Y25.016
+X49.219 Y25.105
+X49.378 Y25.196
+X49.539 Y25.297
+X49.692 Y25.401
+X49.845 Y25.507
+X49.99 Y25.622
+X50.136 Y25.739
+X50.273 Y25.863
+X50.408 Y25.992
+X50.542 Y26.122
+X50.668 Y26.259
+X50.789 Y26.399
+X50.908 Y26.545
+X51.02 Y26.693
+X51.128 Y26.846
+X51.23 Y27.001
+X51.327 Y27.159
+X51.42 Y27.322
+X51.504 Y27.487
+X51.584 Y27.654
+X51.659 Y27.826
+X51.728 Y27.997
+X51.795 Y28.174
+X51.852 Y28.349
+X51.902 Y28.529
+X51.948 Y28.709
+X51.988 Y28.891
+X52.023 Y29.075
+X52.053 Y29.257
+X52.074 Y29.44
+X52.089 Y29.626
+X52.097 Y29.813
+G1 X54.3 Y30. F2000.
+X54.297 Y30.227
+X54.283 Y30.455
+X54.264 Y30.681
+X54.236 Y30.906
+X54.202 Y31.128
+X54.159 Y31.35
+X54.108 Y31.574
+X54.049 Y31.793
+X53.981 Y32.009
+X53.907 Y32.225
+X53.829 Y32.435
+X53.736 Y32.643
+X53.644 Y32.848
+X53.538 Y33.051
+X53.428 Y33.249
+X53.313 Y33.446
+X53.188 Y33.636
+X53.058 Y33.821
+X52.922 Y34.003
+X52.78 Y34.179
+X52.632 Y34.349
+X52.476 Y34.517
+X52.316 Y34.675
+X52.148 Y34.832
+X51.979 Y34.978
+X51.801 Y35.123
+X51.621 Y35.258
+X51.435 Y35.391
+X51.243 Y35.512
+X51.051 Y35.629
+X50.852 Y35.739
+X50.648 Y35.844
+X50.444 Y35.938
+X50.235 Y36.028
+X50.021 Y36.108
+X49.809 Y36.181
+X49.59 Y36.248
+X49.374 Y36.306
+X49.15 Y36.359
+X48.928 Y36.4
+X48.704 Y36.436
+X48.48 Y36.463
+X48.254 Y36.484
+X48.028 Y36.496
+X47.798 Y36.501
+X47.572 Y36.496
+X47.346 Y36.482
+X47.12 Y36.463
+X46.895 Y36.437
+X46.671 Y36.403
+X46.45 Y36.358
+X46.228 Y36.306
+X46.008 Y36.247
+X45.792 Y36.181
+X45.575 Y36.108
+X45.366 Y36.026
+X45.157 Y35.936
+X44.951 Y35.842
+X44.747 Y35.739
+X44.552 Y35.63
+X44.355 Y35.514
+X44.164 Y35.39
+X43.979 Y35.257
+X43.797 Y35.122
+X43.622 Y34.979
+X43.449 Y34.829
+X43.285 Y34.675
+X43.125 Y34.517
+X42.969 Y34.348
+X42.82 Y34.179
+X42.679 Y34.001
+X42.54 Y33.819
+X42.411 Y33.635
+X42.286 Y33.445
+X42.169 Y33.251
+X42.061 Y33.053
+X41.956 Y32.848
+X41.862 Y32.644
+X41.775 Y32.436
+X41.691 Y32.225
+X41.618 Y32.009
+X41.552 Y31.791
+X41.493 Y31.571
+X41.443 Y31.35
+X41.397 Y31.129
+X41.364 Y30.904
+X41.336 Y30.679
+X41.317 Y30.453
+X41.305 Y30.227
+X41.302 Y30.
+X41.304 Y29.775
+X41.317 Y29.546
+X41.334 Y29.322
+X41.362 Y29.096
+X41.398 Y28.873
+X41.442 Y28.65
+X41.492 Y28.426
+X41.55 Y28.21
+X41.618 Y27.99
+X41.693 Y27.777
+X41.772 Y27.565
+X41.861 Y27.355
+X41.957 Y27.15
+X42.059 Y26.947
+X42.169 Y26.75
+X42.289 Y26.556
+X42.413 Y26.364
+X42.541 Y26.18
+X42.678 Y25.997
+X42.821 Y25.822
+X42.969 Y25.649
+X43.125 Y25.484
+X43.284 Y25.326
+X43.452 Y25.169
+X43.62 Y25.022
+X43.798 Y24.878
+X43.981 Y24.742
+X44.164 Y24.612
+X44.354 Y24.487
+X44.548 Y24.371
+X44.748 Y24.259
+X44.95 Y24.158
+X45.154 Y24.061
+X45.365 Y23.973
+X45.575 Y23.891
+X45.791 Y23.819
+X46.008 Y23.751
+X46.226 Y23.693
+X46.447 Y23.641
+X46.669 Y23.599
+X46.894 Y23.561
+X47.121 Y23.537
+X47.347 Y23.517
+X47.575 Y23.503
+X47.801 Y23.5
+X48.028 Y23.505
+X48.255 Y23.516
+X48.478 Y23.534
+X48.706 Y23.564
+X48.928 Y23.598
+X49.153 Y23.643
+X49.374 Y23.695
+X49.594 Y23.751
+X49.807 Y23.819
+X50.023 Y23.892
+X50.236 Y23.975
+X50.445 Y24.06
+X50.65 Y24.156
+X50.851 Y24.261
+X51.051 Y24.373
+X51.245 Y24.487
+X51.434 Y24.613
+X51.619 Y24.742
+X51.803 Y24.879
+X51.978 Y25.023
+X52.15 Y25.168
+X52.317 Y25.322
+X52.475 Y25.486
+X52.629 Y25.651
+X52.781 Y25.822
+X52.921 Y25.997
+X53.06 Y26.18
+X53.187 Y26.367
+X53.311 Y26.557
+X53.43 Y26.75
+X53.54 Y26.948
+X53.643 Y27.149
+X53.738 Y27.357
+X53.826 Y27.567
+X53.909 Y27.776
+X53.983 Y27.991
+X54.05 Y28.21
+X54.106 Y28.427
+X54.156 Y28.65
+X54.202 Y28.87
+X54.238 Y29.095
+X54.263 Y29.322
+X54.285 Y29.545
+X54.298 Y29.775
+G0 Z5.
+X47.8 Y30.
+G1 Z-6. F500.
+G0 Z15.
+M9
+M5
+G28 G91 Z0.
+G90
+M30
+%
@@ -0,0 +1,67 @@
+/*
+  esp3d_test
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include <stdio.h>
+#include <string.h>
+
+// Minimal checks for host tests, a failed check is reported and counted but
+// the test goes on, main returns the failures count so ctest sees it
+static int esp3d_test_failures = 0;
+
+#define ESP3D_CHECK(condition)                                             \
+  do {                                                                     \
+    if (!(condition)) {                                                    \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+      esp3d_test_failures++;                                               \
+    }                                                                      \
+  } while (0)
+
+#define ESP3D_CHECK_EQ(actual, expected)                               \
+  do {                                                                 \
+    long long _actual = (long long)(actual);                           \
+    long long _expected = (long long)(expected);                       \
+    if (_actual != _expected) {                                        \
+      printf("%s:%d: %s is %lld, expected %lld\n", __FILE__, __LINE__, \
+             #actual, _actual, _expected);                             \
+      esp3d_test_failures++;                                           \
+    }                                                                  \
+  } while (0)
+
+#define ESP3D_CHECK_STR(actual, expected)                                  \
+  do {                                                                     \
+    const char *_actual = (actual);                                        \
+    const char *_expected = (expected);                                    \
+    if (_actual == NULL || strcmp(_actual, _expected) != 0) {              \
+      printf("%s:%d: %s is \"%s\", expected \"%s\"\n", __FILE__, __LINE__, \
+             #actual, _actual ? _actual : "(null)", _expected);            \
+      esp3d_test_failures++;                                               \
+    }                                                                      \
+  } while (0)
+
+#define ESP3D_RUN(test)    \
+  do {                     \
+    printf("%s\n", #test); \
+    test();                \
+  } while (0)
+
+#define ESP3D_TEST_RESULT()                                   \
+  (printf("%s\n", esp3d_test_failures ? "FAILED" : "PASSED"), \
+   esp3d_test_failures)
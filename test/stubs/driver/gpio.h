@@ -0,0 +1,105 @@
+/*
+  gpio
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include <stdint.h>
+
+#include "esp3d_stubs.h"
+#include "esp_err.h"
+
+// Levels are read from esp3d_stub_gpio_level, configuration is accepted and
+// interrupts are never raised, tests call the handlers
+
+typedef enum {
+  GPIO_NUM_NC = -1,
+  GPIO_NUM_0 = 0,
+  GPIO_NUM_2 = 2,
+  GPIO_NUM_12 = 12,
+  GPIO_NUM_13 = 13,
+  GPIO_NUM_14 = 14,
+  GPIO_NUM_15 = 15,
+  GPIO_NUM_25 = 25,
+  GPIO_NUM_32 = 32,
+  GPIO_NUM_34 = 34,
+  GPIO_NUM_35 = 35,
+  GPIO_NUM_36 = 36,
+  GPIO_NUM_39 = 39,
+  GPIO_NUM_MAX = 40,
+} gpio_num_t;
+
+typedef enum {
+  GPIO_MODE_DISABLE,
+  GPIO_MODE_INPUT,
+  GPIO_MODE_OUTPUT,
+} gpio_mode_t;
+
+typedef enum { GPIO_PULLUP_DISABLE, GPIO_PULLUP_ENABLE } gpio_pullup_t;
+typedef enum { GPIO_PULLDOWN_DISABLE, GPIO_PULLDOWN_ENABLE } gpio_pulldown_t;
+
+typedef enum {
+  GPIO_INTR_DISABLE,
+  GPIO_INTR_POSEDGE,
+  GPIO_INTR_NEGEDGE,
+  GPIO_INTR_ANYEDGE,
+} gpio_int_type_t;
+
+typedef struct {
+  uint64_t pin_bit_mask;
+  gpio_mode_t mode;
+  gpio_pullup_t pull_up_en;
+  gpio_pulldown_t pull_down_en;
+  gpio_int_type_t intr_type;
+} gpio_config_t;
+
+typedef void (*gpio_isr_t)(void *arg);
+
+#define GPIO_IS_VALID_GPIO(pin) ((pin) >= 0 && (pin) < GPIO_NUM_MAX)
+
+static inline esp_err_t gpio_config(const gpio_config_t *config) {
+  (void)config;
+  return ESP_OK;
+}
+
+static inline int gpio_get_level(gpio_num_t pin) {
+  return esp3d_stub_gpio_level[pin];
+}
+
+static inline esp_err_t gpio_set_level(gpio_num_t pin, uint32_t level) {
+  esp3d_stub_gpio_level[pin] = (int)level;
+  return ESP_OK;
+}
+
+static inline esp_err_t gpio_install_isr_service(int flags) {
+  (void)flags;
+  return ESP_OK;
+}
+
+static inline esp_err_t gpio_isr_handler_add(gpio_num_t pin, gpio_isr_t isr,
+                                             void *arg) {
+  (void)pin;
+  (void)isr;
+  (void)arg;
+  return ESP_OK;
+}
+
+static inline esp_err_t gpio_isr_handler_remove(gpio_num_t pin) {
+  (void)pin;
+  return ESP_OK;
+}
@@ -0,0 +1,140 @@
+/*
+  i2c
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "driver/gpio.h"
+#include "esp3d_stubs.h"
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+// Legacy master driver: reads are served from esp3d_stub_i2c_data, indexed
+// by the register written last, and each command with reads is counted
+
+typedef int i2c_port_t;
+
+#define I2C_NUM_0 0
+#define I2C_NUM_1 1
+
+typedef enum { I2C_MODE_SLAVE, I2C_MODE_MASTER } i2c_mode_t;
+typedef enum { I2C_MASTER_WRITE, I2C_MASTER_READ } i2c_rw_t;
+typedef enum { I2C_MASTER_ACK, I2C_MASTER_NACK } i2c_ack_type_t;
+
+typedef struct {
+  i2c_mode_t mode;
+  int sda_io_num;
+  int scl_io_num;
+  gpio_pullup_t sda_pullup_en;
+  gpio_pullup_t scl_pullup_en;
+  struct {
+    uint32_t clk_speed;
+  } master;
+} i2c_config_t;
+
+typedef struct {
+  int bytes;  // bytes written since start, first is the address
+  bool read;  // some bytes were read
+} esp3d_stub_i2c_cmd_t;
+
+typedef esp3d_stub_i2c_cmd_t *i2c_cmd_handle_t;
+
+static int esp3d_stub_i2c_register;
+
+static inline esp_err_t i2c_param_config(i2c_port_t port,
+                                         const i2c_config_t *config) {
+  (void)port;
+  (void)config;
+  return ESP_OK;
+}
+
+static inline esp_err_t i2c_driver_install(i2c_port_t port, i2c_mode_t mode,
+                                           size_t rx_size, size_t tx_size,
+                                           int flags) {
+  (void)port;
+  (void)mode;
+  (void)rx_size;
+  (void)tx_size;
+  (void)flags;
+  return ESP_OK;
+}
+
+static inline esp_err_t i2c_driver_delete(i2c_port_t port) {
+  (void)port;
+  return ESP_OK;
+}
+
+static inline i2c_cmd_handle_t i2c_cmd_link_create(void) {
+  return (i2c_cmd_handle_t)calloc(1, sizeof(esp3d_stub_i2c_cmd_t));
+}
+
+static inline void i2c_cmd_link_delete(i2c_cmd_handle_t cmd) { free(cmd); }
+
+static inline esp_err_t i2c_master_start(i2c_cmd_handle_t cmd) {
+  cmd->bytes = 0;
+  return ESP_OK;
+}
+
+static inline esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd) {
+  (void)cmd;
+  return ESP_OK;
+}
+
+static inline esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd,
+                                              uint8_t data, bool ack) {
+  (void)ack;
+  if (cmd->bytes == 1) {
+    esp3d_stub_i2c_register = data;
+  }
+  cmd->bytes++;
+  return ESP_OK;
+}
+
+static inline esp_err_t i2c_master_read(i2c_cmd_handle_t cmd, uint8_t *data,
+                                        size_t size, i2c_ack_type_t ack) {
+  (void)ack;
+  for (size_t i = 0; i < size; i++) {
+    data[i] = esp3d_stub_i2c_data[(esp3d_stub_i2c_register + i) % 16];
+  }
+  esp3d_stub_i2c_register += (int)size;
+  cmd->read = true;
+  return ESP_OK;
+}
+
+static inline esp_err_t i2c_master_read_byte(i2c_cmd_handle_t cmd,
+                                             uint8_t *data,
+                                             i2c_ack_type_t ack) {
+  return i2c_master_read(cmd, data, 1, ack);
+}
+
+static inline esp_err_t i2c_master_cmd_begin(i2c_port_t port,
+                                             i2c_cmd_handle_t cmd,
+                                             TickType_t wait) {
+  (void)port;
+  (void)wait;
+  if (cmd->read) {
+    esp3d_stub_i2c_reads++;
+  }
+  return ESP_OK;
+}
@@ -0,0 +1,40 @@
+/*
+  esp3d_host_stubs
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "esp3d_hal.h"
+#include "esp3d_settings.h"
+#include "esp3d_stubs.h"
+#include "esp3d_values.h"
+#include "filesystem/esp3d_globalfs.h"
+#include "gcode_host/esp3d_gcode_host_service.h"
+#include "rendering/esp3d_rendering_client.h"
+
+ESP3DValues esp3dTftValues;
+ESP3DSettings esp3dTftsettings;
+ESP3DGCodeHostService gcodeHostService;
+ESP3DRenderingClient renderingClient;
+ESP3DGlobalFileSystem globalFs;
+
+namespace esp3d_hal {
+int64_t millis() { return esp3d_stub_time_us / 1000; }
+int64_t micros() { return esp3d_stub_time_us; }
+int64_t seconds() { return esp3d_stub_time_us / 1000000; }
+void wait(int64_t milliseconds) { esp3d_stub_time_us += milliseconds * 1000; }
+}  // namespace esp3d_hal
@@ -0,0 +1,57 @@
+/*
+  esp3d_settings
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+
+#include <map>
+#include <string>
+
+// Settings without NVS: only the string settings read by host built code,
+// unset ones are read as an error
+
+enum class ESP3DSettingIndex : uint16_t {
+  esp3d_jog_acceleration,
+};
+
+class ESP3DSettings final {
+ public:
+  const char *readString(ESP3DSettingIndex index, char *out_str, size_t len,
+                         bool *haserror = NULL) {
+    auto it = _strings.find(index);
+    if (haserror) {
+      *haserror = it == _strings.end();
+    }
+    snprintf(out_str, len, "%s",
+             it == _strings.end() ? "" : it->second.c_str());
+    return out_str;
+  }
+  bool writeString(ESP3DSettingIndex index, const char *byte_buffer) {
+    _strings[index] = byte_buffer;
+    return true;
+  }
+  void clear() { _strings.clear(); }
+
+ private:
+  std::map<ESP3DSettingIndex, std::string> _strings;
+};
+
+extern ESP3DSettings esp3dTftsettings;
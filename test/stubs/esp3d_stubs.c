@@ -0,0 +1,44 @@
+/*
+  esp3d_stubs
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "esp3d_stubs.h"
+
+#include <string.h>
+
+int64_t esp3d_stub_time_us = 0;
+uint32_t esp3d_stub_notified = 0;
+uint32_t esp3d_stub_notify_bits = 0;
+int esp3d_stub_gpio_level[64];
+uint32_t esp3d_stub_i2c_reads = 0;
+uint8_t esp3d_stub_i2c_data[16];
+int esp3d_stub_adc_raw = 0;
+
+void esp3d_stub_reset(void) {
+  esp3d_stub_time_us = 0;
+  esp3d_stub_notified = 0;
+  esp3d_stub_notify_bits = 0;
+  // inputs idle high, as with pull-ups
+  for (int i = 0; i < 64; i++) {
+    esp3d_stub_gpio_level[i] = 1;
+  }
+  esp3d_stub_i2c_reads = 0;
+  memset(esp3d_stub_i2c_data, 0, sizeof(esp3d_stub_i2c_data));
+  esp3d_stub_adc_raw = 0;
+}
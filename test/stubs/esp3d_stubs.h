@@ -0,0 +1,44 @@
+/*
+  esp3d_stubs
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+// Host stand-ins of ESP-IDF and FreeRTOS services, state is global so tests
+// can set the time, the GPIO levels, and check what was called
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern int64_t esp3d_stub_time_us;     // esp_timer_get_time()
+extern uint32_t esp3d_stub_notified;   // task notifications sent
+extern uint32_t esp3d_stub_notify_bits;  // bits of eSetBits notifications
+extern int esp3d_stub_gpio_level[64];  // gpio_get_level() by pin
+extern uint32_t esp3d_stub_i2c_reads;  // I2C read transactions
+extern uint8_t esp3d_stub_i2c_data[16];  // bytes returned by I2C reads
+extern int esp3d_stub_adc_raw;           // adc_oneshot_read() value
+
+void esp3d_stub_reset(void);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
@@ -0,0 +1,59 @@
+/*
+  esp3d_values
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include <stdio.h>
+
+#include <map>
+#include <string>
+
+#include "esp3d_values_list.h"
+
+// Display values without LVGL: last value of each index is kept so tests can
+// check what the parsers published
+
+enum class ESP3DValuesCbAction : uint8_t { Add = 0, Delete, Clear, Update };
+
+class ESP3DValues final {
+ public:
+  const char *get_string_value(ESP3DValuesIndex index) {
+    auto it = _values.find(index);
+    return it == _values.end() ? nullptr : it->second.c_str();
+  }
+  bool set_string_value(
+      ESP3DValuesIndex index, const char *value,
+      ESP3DValuesCbAction action = ESP3DValuesCbAction::Update) {
+    (void)action;
+    _values[index] = value;
+    _updates++;
+    return true;
+  }
+  uint32_t updates() { return _updates; }
+  void clear() {
+    _values.clear();
+    _updates = 0;
+  }
+
+ private:
+  std::map<ESP3DValuesIndex, std::string> _values;
+  uint32_t _updates = 0;
+};
+
+extern ESP3DValues esp3dTftValues;
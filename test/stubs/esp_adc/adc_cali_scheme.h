@@ -0,0 +1,40 @@
+/*
+  adc_cali_scheme
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include <stdint.h>
+
+#include "esp_adc/adc_cali.h"
+#include "esp_adc/adc_oneshot.h"
+
+typedef struct {
+  adc_unit_t unit_id;
+  adc_atten_t atten;
+  adc_bitwidth_t bitwidth;
+  uint32_t default_vref;
+} adc_cali_line_fitting_config_t;
+
+static inline esp_err_t adc_cali_create_scheme_line_fitting(
+    const adc_cali_line_fitting_config_t *config, adc_cali_handle_t *handle) {
+  static int scheme;
+  (void)config;
+  *handle = (adc_cali_handle_t)&scheme;
+  return ESP_OK;
+}
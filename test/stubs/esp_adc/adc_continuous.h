@@ -0,0 +1,120 @@
+/*
+  adc_continuous
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include <stdint.h>
+
+#include "esp_adc/adc_oneshot.h"
+
+// Conversions never run, tests call the conversion done callback with their
+// own frames, in the ESP32 output format
+
+#define SOC_ADC_DIGI_RESULT_BYTES 2
+#define SOC_ADC_DIGI_DATA_BYTES_PER_CONV 4
+#define SOC_ADC_DIGI_MAX_BITWIDTH 12
+
+typedef enum { ADC_CONV_SINGLE_UNIT_1 } adc_digi_convert_mode_t;
+typedef enum {
+  ADC_DIGI_OUTPUT_FORMAT_TYPE1,
+  ADC_DIGI_OUTPUT_FORMAT_TYPE2,
+} adc_digi_output_format_t;
+
+typedef struct {
+  union {
+    struct {
+      uint16_t data : 12;
+      uint16_t channel : 4;
+    } type1;
+    uint16_t val;
+  };
+} adc_digi_output_data_t;
+
+typedef struct {
+  uint8_t atten;
+  uint8_t channel;
+  uint8_t unit;
+  uint8_t bit_width;
+} adc_digi_pattern_config_t;
+
+typedef struct {
+  uint32_t max_store_buf_size;
+  uint32_t conv_frame_size;
+  struct {
+    uint32_t flush_pool : 1;
+  } flags;
+} adc_continuous_handle_cfg_t;
+
+typedef struct {
+  uint32_t pattern_num;
+  adc_digi_pattern_config_t *adc_pattern;
+  uint32_t sample_freq_hz;
+  adc_digi_convert_mode_t conv_mode;
+  adc_digi_output_format_t format;
+} adc_continuous_config_t;
+
+typedef struct {
+  uint8_t *conv_frame_buffer;
+  uint32_t size;
+} adc_continuous_evt_data_t;
+
+typedef struct adc_continuous_ctx_t *adc_continuous_handle_t;
+typedef bool (*adc_continuous_callback_t)(
+    adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata,
+    void *user_data);
+
+typedef struct {
+  adc_continuous_callback_t on_conv_done;
+  adc_continuous_callback_t on_pool_ovf;
+} adc_continuous_evt_cbs_t;
+
+static inline esp_err_t adc_continuous_new_handle(
+    const adc_continuous_handle_cfg_t *config,
+    adc_continuous_handle_t *handle) {
+  static int unit;
+  (void)config;
+  *handle = (adc_continuous_handle_t)&unit;
+  return ESP_OK;
+}
+
+static inline esp_err_t adc_continuous_config(
+    adc_continuous_handle_t handle, const adc_continuous_config_t *config) {
+  (void)handle;
+  (void)config;
+  return ESP_OK;
+}
+
+static inline esp_err_t adc_continuous_register_event_callbacks(
+    adc_continuous_handle_t handle, const adc_continuous_evt_cbs_t *cbs,
+    void *user_data) {
+  (void)handle;
+  (void)cbs;
+  (void)user_data;
+  return ESP_OK;
+}
+
+static inline esp_err_t adc_continuous_start(adc_continuous_handle_t handle) {
+  (void)handle;
+  return ESP_OK;
+}
+
+static inline esp_err_t adc_continuous_deinit(adc_continuous_handle_t handle) {
+  (void)handle;
+  return ESP_OK;
+}
@@ -0,0 +1,78 @@
+/*
+  adc_oneshot
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include <stdint.h>
+
+#include "esp3d_stubs.h"
+#include "esp_err.h"
+
+// One-shot reads return esp3d_stub_adc_raw
+
+typedef int adc_channel_t;
+typedef int adc_bitwidth_t;
+typedef int adc_atten_t;
+
+typedef enum { ADC_UNIT_1, ADC_UNIT_2 } adc_unit_t;
+typedef enum { ADC_ULP_MODE_DISABLE } adc_ulp_mode_t;
+
+typedef struct {
+  adc_unit_t unit_id;
+  adc_ulp_mode_t ulp_mode;
+} adc_oneshot_unit_init_cfg_t;
+
+typedef struct {
+  adc_atten_t atten;
+  adc_bitwidth_t bitwidth;
+} adc_oneshot_chan_cfg_t;
+
+typedef struct adc_oneshot_unit_ctx_t *adc_oneshot_unit_handle_t;
+
+static inline esp_err_t adc_oneshot_new_unit(
+    const adc_oneshot_unit_init_cfg_t *config,
+    adc_oneshot_unit_handle_t *handle) {
+  static int unit;
+  (void)config;
+  *handle = (adc_oneshot_unit_handle_t)&unit;
+  return ESP_OK;
+}
+
+static inline esp_err_t adc_oneshot_config_channel(
+    adc_oneshot_unit_handle_t handle, adc_channel_t channel,
+    const adc_oneshot_chan_cfg_t *config) {
+  (void)handle;
+  (void)channel;
+  (void)config;
+  return ESP_OK;
+}
+
+static inline esp_err_t adc_oneshot_read(adc_oneshot_unit_handle_t handle,
+                                         adc_channel_t channel, int *raw) {
+  (void)handle;
+  (void)channel;
+  *raw = esp3d_stub_adc_raw;
+  return ESP_OK;
+}
+
+static inline esp_err_t adc_oneshot_del_unit(
+    adc_oneshot_unit_handle_t handle) {
+  (void)handle;
+  return ESP_OK;
+}
@@ -0,0 +1,48 @@
+/*
+  esp3d_globalfs
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include <stdio.h>
+#include <sys/stat.h>
+
+// File systems of the target replaced by the host one, paths are host paths
+
+class ESP3DGlobalFileSystem final {
+ public:
+  bool accessFS(const char *path) { return true; }
+  void releaseFS(const char *path) {}
+  int stat(const char *filepath, struct stat *entry_stat) {
+    return ::stat(filepath, entry_stat);
+  }
+  bool exists(const char *path) {
+    struct stat entry_stat;
+    return ::stat(path, &entry_stat) == 0;
+  }
+  bool remove(const char *path) { return ::remove(path) == 0; }
+  bool rename(const char *oldpath, const char *newpath) {
+    return ::rename(oldpath, newpath) == 0;
+  }
+  FILE *open(const char *filename, const char *mode) {
+    return fopen(filename, mode);
+  }
+  void close(FILE *fd, const char *filename) { fclose(fd); }
+};
+
+extern ESP3DGlobalFileSystem globalFs;
@@ -0,0 +1,96 @@
+/*
+  task
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include "freertos/FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+typedef enum { eNoAction, eSetBits, eIncrement } eNotifyAction;
+
+// Task is not run, tests call its steps
+static inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function,
+                                                 const char *name,
+                                                 uint32_t stack,
+                                                 void *arg,
+                                                 UBaseType_t priority,
+                                                 TaskHandle_t *task,
+                                                 BaseType_t core) {
+  static int handle;
+  (void)function;
+  (void)name;
+  (void)stack;
+  (void)arg;
+  (void)priority;
+  (void)core;
+  *task = &handle;
+  return pdPASS;
+}
+
+static inline void xTaskNotifyGiveIndexed(TaskHandle_t task,
+                                          UBaseType_t index) {
+  (void)task;
+  (void)index;
+  esp3d_stub_notified++;
+}
+
+static inline uint32_t ulTaskNotifyTakeIndexed(UBaseType_t index,
+                                               BaseType_t clear,
+                                               TickType_t wait) {
+  (void)index;
+  (void)clear;
+  (void)wait;
+  return 0;
+}
+
+static inline BaseType_t xTaskNotify(TaskHandle_t task, uint32_t bits,
+                                     eNotifyAction action) {
+  (void)task;
+  (void)action;
+  esp3d_stub_notified++;
+  esp3d_stub_notify_bits |= bits;
+  return pdPASS;
+}
+
+static inline BaseType_t xTaskNotifyFromISR(TaskHandle_t task, uint32_t bits,
+                                            eNotifyAction action,
+                                            BaseType_t *woken) {
+  *woken = pdFALSE;
+  return xTaskNotify(task, bits, action);
+}
+
+static inline BaseType_t xTaskNotifyWait(uint32_t clear_on_entry,
+                                         uint32_t clear_on_exit,
+                                         uint32_t *bits, TickType_t wait) {
+  (void)clear_on_entry;
+  (void)clear_on_exit;
+  (void)wait;
+  *bits = esp3d_stub_notify_bits;
+  esp3d_stub_notify_bits = 0;
+  return pdPASS;
+}
+
+static inline TickType_t xTaskGetTickCount(void) {
+  return (TickType_t)(esp3d_stub_time_us / (1000000 / configTICK_RATE_HZ));
+}
+
+static inline void vTaskDelay(TickType_t ticks) {
+  esp3d_stub_time_us += (int64_t)ticks * (1000000 / configTICK_RATE_HZ);
+}
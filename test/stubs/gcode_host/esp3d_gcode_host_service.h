@@ -0,0 +1,53 @@
+/*
+  esp3d_gcode_host_service
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+// Streaming host without serial: tests set the commands still queued and
+// the line counts written to and acked by the controller
+
+class ESP3DGCodeHostService final {
+ public:
+  bool hasStreamListCommand(const char *command) {
+    for (const std::string &queued : streamList) {
+      if (queued == command) {
+        return true;
+      }
+    }
+    return false;
+  }
+  uint32_t getWrittenLineCount() { return writtenLines; }
+  uint32_t getAckedLineCount() { return ackedLines; }
+  void clear() {
+    streamList.clear();
+    writtenLines = 0;
+    ackedLines = 0;
+  }
+
+  std::vector<std::string> streamList;
+  uint32_t writtenLines = 0;
+  uint32_t ackedLines = 0;
+};
+
+extern ESP3DGCodeHostService gcodeHostService;
@@ -0,0 +1,38 @@
+/*
+  lvgl
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+// Only the input device types used by control events
+
+typedef struct _lv_indev_t lv_indev_t;
+
+typedef enum {
+  LV_INDEV_TYPE_NONE,
+  LV_INDEV_TYPE_POINTER,
+  LV_INDEV_TYPE_KEYPAD,
+  LV_INDEV_TYPE_BUTTON,
+  LV_INDEV_TYPE_ENCODER,
+} lv_indev_type_t;
+
+typedef enum {
+  LV_INDEV_STATE_RELEASED = 0,
+  LV_INDEV_STATE_PRESSED,
+} lv_indev_state_t;
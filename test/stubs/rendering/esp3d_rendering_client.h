@@ -0,0 +1,48 @@
+/*
+  esp3d_rendering_client
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+// Rendering client without a target: what is sent is kept for the tests
+
+class ESP3DRenderingClient final {
+ public:
+  bool sendGcode(const char *data) {
+    gcodes.push_back(data);
+    return true;
+  }
+  bool sendRealTimeCommand(uint8_t cmd) {
+    realTimeCommands.push_back(cmd);
+    return true;
+  }
+  void clear() {
+    gcodes.clear();
+    realTimeCommands.clear();
+  }
+
+  std::vector<std::string> gcodes;
+  std::vector<uint8_t> realTimeCommands;
+};
+
+extern ESP3DRenderingClient renderingClient;
@@ -0,0 +1,89 @@
+/*
+  test_buffer_report
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Host test of Bf: buffer reports of the grblHAL parser: free planner blocks
+// and RX bytes, report counter and time used by the streaming credits, and
+// sizes learned when $I did not report them
+
+#include "esp3d_gcode_parser_service.h"
+#include "esp3d_test.h"
+
+static void test_buffer_fields() {
+  ESP3DGCodeParserService parser;
+  ESP3D_CHECK_EQ(parser.getBufferReportCount(), 0);
+  esp3d_stub_time_us = 5000000;
+  ESP3D_CHECK(parser.processCommand("<Run|MPos:0,0,0|Bf:12,96>\n"));
+  ESP3D_CHECK_EQ(parser.getPlannerBlocksFree(), 12);
+  ESP3D_CHECK_EQ(parser.getRxBytesFree(), 96);
+  ESP3D_CHECK_EQ(parser.getBufferReportCount(), 1);
+  ESP3D_CHECK_EQ(parser.getBufferReportTime(), 5000);
+  // sizes are only learned when idle
+  ESP3D_CHECK_EQ(parser.getRxBufferSize(), 0);
+  ESP3D_CHECK_EQ(parser.getPlannerBlocksCount(), 0);
+  ESP3D_CHECK_EQ(parser.getPlannerBlocksQueued(), 0);
+}
+
+// Report without Bf: does not refresh credits
+static void test_report_without_buffer() {
+  ESP3DGCodeParserService parser;
+  esp3d_stub_time_us = 1000000;
+  ESP3D_CHECK(parser.processCommand("<Idle|MPos:0,0,0|Bf:15,127>\n"));
+  esp3d_stub_time_us = 2000000;
+  ESP3D_CHECK(parser.processCommand("<Idle|MPos:0,0,0>\n"));
+  ESP3D_CHECK_EQ(parser.getBufferReportCount(), 1);
+  ESP3D_CHECK_EQ(parser.getBufferReportTime(), 1000);
+  ESP3D_CHECK_EQ(parser.getRxBytesFree(), 127);
+  // malformed Bf: is ignored
+  ESP3D_CHECK(parser.processCommand("<Idle|MPos:0,0,0|Bf:3>\n"));
+  ESP3D_CHECK_EQ(parser.getBufferReportCount(), 1);
+}
+
+// Idle Bf: gives usable sizes, largest values seen are kept
+static void test_learned_sizes() {
+  ESP3DGCodeParserService parser;
+  ESP3D_CHECK(parser.processCommand("<Idle|MPos:0,0,0|Bf:34,1020>\n"));
+  ESP3D_CHECK_EQ(parser.getRxBufferSize(), 1020);
+  ESP3D_CHECK_EQ(parser.getPlannerBlocksCount(), 34);
+  ESP3D_CHECK(parser.processCommand("<Idle|MPos:0,0,0|Bf:35,1023>\n"));
+  ESP3D_CHECK(parser.processCommand("<Idle|MPos:0,0,0|Bf:30,900>\n"));
+  ESP3D_CHECK_EQ(parser.getRxBufferSize(), 1023);
+  ESP3D_CHECK_EQ(parser.getPlannerBlocksCount(), 35);
+  // blocks queued are planner size minus free ones
+  ESP3D_CHECK(parser.processCommand("<Run|MPos:0,0,0|Bf:20,512>\n"));
+  ESP3D_CHECK_EQ(parser.getPlannerBlocksQueued(), 15);
+  ESP3D_CHECK_EQ(parser.getRxBufferSize(), 1023);
+}
+
+// RX size reported by $I wins over learned one
+static void test_reported_size_wins() {
+  ESP3DGCodeParserService parser;
+  parser.getType("[OPT:VNMZL,35,1024]\n");
+  ESP3D_CHECK(parser.processCommand("<Idle|MPos:0,0,0|Bf:35,1500>\n"));
+  ESP3D_CHECK_EQ(parser.getRxBufferSize(), 1023);
+}
+
+int main() {
+  esp3d_stub_reset();
+  ESP3D_RUN(test_buffer_fields);
+  ESP3D_RUN(test_report_without_buffer);
+  ESP3D_RUN(test_learned_sizes);
+  ESP3D_RUN(test_reported_size_wins);
+  return ESP3D_TEST_RESULT();
+}
@@ -0,0 +1,162 @@
+/*
+  test_control_input
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Host test of the input task queues and of their drop counting,
+// no control is enabled so only the queues are built
+
+#include "esp3d_test.h"
+
+// Statics of the input task are reached by building it here
+#include "control_input.c"
+
+static int consumer;
+
+static void reset_queues(void) {
+  control_event_t event;
+  control_input_set_consumer(NULL, 0);
+  while (control_input_pop(&event)) {
+  }
+  for (int family = 0; family < CONTROL_INPUT_FAMILY_COUNT; family++) {
+    while (control_input_pop_ui((control_family_t)family, &event)) {
+    }
+  }
+  memset(&input_stats, 0, sizeof(input_stats));
+}
+
+static control_event_t make_event(control_family_t family, int32_t steps) {
+  control_event_t event = {
+      .type = LV_INDEV_TYPE_ENCODER,
+      .family_id = family,
+      .steps = steps,
+      .state = LV_INDEV_STATE_PRESSED,
+      .timestamp_us = steps,
+  };
+  return event;
+}
+
+static void test_no_consumer(void) {
+  reset_queues();
+  control_event_t event;
+  for (int32_t i = 0; i < CONTROL_INPUT_QUEUE_SIZE + 8; i++) {
+    event = make_event(CONTROL_FAMILY_ENCODER, i);
+    ESP3D_CHECK(!control_input_push(&event));
+  }
+  control_input_stats_t stats;
+  control_input_get_stats(&stats);
+  ESP3D_CHECK_EQ(stats.events, CONTROL_INPUT_QUEUE_SIZE + 8);
+  // Nobody reads events, a full UI queue is not a loss
+  ESP3D_CHECK_EQ(stats.dropped, 0);
+  ESP3D_CHECK(!control_input_pop(&event));
+  // UI keeps the oldest events
+  for (int32_t i = 0; i < CONTROL_INPUT_QUEUE_SIZE; i++) {
+    ESP3D_CHECK(control_input_pop_ui(CONTROL_FAMILY_ENCODER, &event));
+    ESP3D_CHECK_EQ(event.steps, i);
+  }
+  ESP3D_CHECK(!control_input_pop_ui(CONTROL_FAMILY_ENCODER, &event));
+}
+
+static void test_consumer_full(void) {
+  reset_queues();
+  control_input_set_consumer(&consumer, 1);
+  control_event_t event;
+  for (int32_t i = 0; i < CONTROL_INPUT_QUEUE_SIZE + 5; i++) {
+    event = make_event(CONTROL_FAMILY_BUTTONS, i);
+    ESP3D_CHECK_EQ(control_input_push(&event), i < CONTROL_INPUT_QUEUE_SIZE);
+  }
+  control_input_stats_t stats;
+  control_input_get_stats(&stats);
+  ESP3D_CHECK_EQ(stats.events, CONTROL_INPUT_QUEUE_SIZE + 5);
+  ESP3D_CHECK_EQ(stats.dropped, 5);
+  for (int32_t i = 0; i < CONTROL_INPUT_QUEUE_SIZE; i++) {
+    ESP3D_CHECK(control_input_pop(&event));
+    ESP3D_CHECK_EQ(event.steps, i);
+    ESP3D_CHECK_EQ(event.family_id, CONTROL_FAMILY_BUTTONS);
+  }
+  ESP3D_CHECK(!control_input_pop(&event));
+  // Room again, UI queue still full is not counted
+  event = make_event(CONTROL_FAMILY_BUTTONS, 100);
+  ESP3D_CHECK(control_input_push(&event));
+  control_input_get_stats(&stats);
+  ESP3D_CHECK_EQ(stats.dropped, 5);
+}
+
+static void test_families(void) {
+  reset_queues();
+  control_input_set_consumer(&consumer, 1);
+  control_event_t event = make_event(CONTROL_FAMILY_SWITCH, 1);
+  ESP3D_CHECK(control_input_push(&event));
+  event = make_event(CONTROL_FAMILY_POTENTIOMETER, 2);
+  ESP3D_CHECK(control_input_push(&event));
+  // Consumer gets all families in order, UI one queue per family
+  ESP3D_CHECK(control_input_pop(&event));
+  ESP3D_CHECK_EQ(event.family_id, CONTROL_FAMILY_SWITCH);
+  ESP3D_CHECK(control_input_pop(&event));
+  ESP3D_CHECK_EQ(event.family_id, CONTROL_FAMILY_POTENTIOMETER);
+  ESP3D_CHECK(!control_input_pop_ui(CONTROL_FAMILY_BUTTONS, &event));
+  ESP3D_CHECK(control_input_pop_ui(CONTROL_FAMILY_POTENTIOMETER, &event));
+  ESP3D_CHECK_EQ(event.steps, 2);
+  ESP3D_CHECK(control_input_pop_ui(CONTROL_FAMILY_SWITCH, &event));
+  ESP3D_CHECK_EQ(event.steps, 1);
+  ESP3D_CHECK(!control_input_pop_ui(
+      (control_family_t)CONTROL_INPUT_FAMILY_COUNT, &event));
+}
+
+static void test_wrap_around(void) {
+  reset_queues();
+  control_input_set_consumer(&consumer, 1);
+  control_event_t event;
+  // Indexes go several times around the queue
+  for (int32_t i = 0; i < CONTROL_INPUT_QUEUE_SIZE * 5; i++) {
+    event = make_event(CONTROL_FAMILY_ENCODER, i);
+    ESP3D_CHECK(control_input_push(&event));
+    event = make_event(CONTROL_FAMILY_ENCODER, i + 1);
+    ESP3D_CHECK(control_input_push(&event));
+    ESP3D_CHECK(control_input_pop(&event));
+    ESP3D_CHECK_EQ(event.steps, i);
+    ESP3D_CHECK(control_input_pop(&event));
+    ESP3D_CHECK_EQ(event.steps, i + 1);
+    ESP3D_CHECK(control_input_pop_ui(CONTROL_FAMILY_ENCODER, &event));
+    ESP3D_CHECK(control_input_pop_ui(CONTROL_FAMILY_ENCODER, &event));
+    ESP3D_CHECK_EQ(event.steps, i + 1);
+  }
+  control_input_stats_t stats;
+  control_input_get_stats(&stats);
+  ESP3D_CHECK_EQ(stats.dropped, 0);
+}
+
+static void test_start(void) {
+  // Initial states are read at start, before any interrupt
+  ESP3D_CHECK_EQ(control_input_start(), ESP_OK);
+  ESP3D_CHECK(input_task != NULL);
+  ESP3D_CHECK_EQ(esp3d_stub_notify_bits & CONTROL_INPUT_NOTIFY_GPIO,
+                 CONTROL_INPUT_NOTIFY_GPIO);
+  ESP3D_CHECK_EQ(control_input_start(), ESP_OK);
+  ESP3D_CHECK_EQ(esp3d_stub_notified, 1);
+}
+
+int main(void) {
+  esp3d_stub_reset();
+  ESP3D_RUN(test_no_consumer);
+  ESP3D_RUN(test_consumer_full);
+  ESP3D_RUN(test_families);
+  ESP3D_RUN(test_wrap_around);
+  ESP3D_RUN(test_start);
+  return ESP3D_TEST_RESULT();
+}
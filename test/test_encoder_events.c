@@ -0,0 +1,123 @@
+/*
+  test_encoder_events
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Host test of encoder sampling in the input task: detents turned in a period
+// make one event, with a smoothed wheel speed
+
+#include "esp3d_test.h"
+
+#define ESP3D_HARDWARE_ENCODER_FEATURE 1
+#include "control_input.c"
+
+// Detents counted since last read, as the PCNT driver does
+static int32_t turned;
+
+esp_err_t phy_encoder_read(int32_t *steps) {
+  *steps = turned;
+  turned = 0;
+  return ESP_OK;
+}
+
+esp_err_t phy_encoder_set_notify(phy_encoder_notify_cb_t callback, void *arg) {
+  (void)callback;
+  (void)arg;
+  return ESP_OK;
+}
+
+static int64_t now_us = 1000000;
+
+static bool sample(int32_t clicks, int64_t elapsed_ms) {
+  now_us += elapsed_ms * 1000;
+  turned += clicks;
+  return sample_encoder(now_us);
+}
+
+static bool pop_event(control_event_t *event) {
+  return control_input_pop_ui(CONTROL_FAMILY_ENCODER, event);
+}
+
+static void test_coalesced(void) {
+  control_event_t event;
+  // First event after a pause has no speed
+  sample(5, 0);
+  ESP3D_CHECK(pop_event(&event));
+  ESP3D_CHECK_EQ(event.steps, 5);
+  ESP3D_CHECK_EQ(event.velocity, 0);
+  ESP3D_CHECK_EQ(event.timestamp_us, now_us);
+  // Detents within the period wait for it, and make one event
+  sample(2, 5);
+  ESP3D_CHECK(!pop_event(&event));
+  sample(3, 5);
+  ESP3D_CHECK(pop_event(&event));
+  ESP3D_CHECK_EQ(event.steps, 5);
+  ESP3D_CHECK(!pop_event(&event));
+  // No detent, no event
+  sample(0, ENCODER_EVENT_PERIOD_MS);
+  ESP3D_CHECK(!pop_event(&event));
+}
+
+static void test_velocity(void) {
+  control_event_t event;
+  sample(1, ENCODER_VELOCITY_RESET_MS + 1);
+  ESP3D_CHECK(pop_event(&event));
+  ESP3D_CHECK_EQ(event.velocity, 0);
+  // 10 detents in 10 ms is 1000 detents/s, reached by steps of 1/4
+  sample(10, 10);
+  ESP3D_CHECK(pop_event(&event));
+  ESP3D_CHECK_EQ(event.velocity, 250);
+  sample(10, 10);
+  ESP3D_CHECK(pop_event(&event));
+  ESP3D_CHECK_EQ(event.velocity, 437);
+  // Reverse turn keeps the speed, steps carry the direction
+  sample(-10, 10);
+  ESP3D_CHECK(pop_event(&event));
+  ESP3D_CHECK_EQ(event.steps, -10);
+  ESP3D_CHECK_EQ(event.velocity, 578);
+  // Speed restarts after a pause
+  sample(1, ENCODER_VELOCITY_RESET_MS + 1);
+  ESP3D_CHECK(pop_event(&event));
+  ESP3D_CHECK_EQ(event.velocity, 0);
+}
+
+static void test_fast_spin(void) {
+  control_event_t event;
+  control_input_stats_t before;
+  control_input_get_stats(&before);
+  // 200 detents in 100 ms sampled each ms give one event per period
+  int32_t steps = 0;
+  for (int i = 0; i < 100; i++) {
+    sample(2, 1);
+    while (pop_event(&event)) {
+      steps += event.steps;
+    }
+  }
+  control_input_stats_t after;
+  control_input_get_stats(&after);
+  ESP3D_CHECK_EQ(after.events - before.events, 100 / ENCODER_EVENT_PERIOD_MS);
+  ESP3D_CHECK_EQ(steps + turned, 200);
+}
+
+int main(void) {
+  esp3d_stub_reset();
+  ESP3D_RUN(test_coalesced);
+  ESP3D_RUN(test_velocity);
+  ESP3D_RUN(test_fast_spin);
+  return ESP3D_TEST_RESULT();
+}
@@ -0,0 +1,447 @@
+/*
+  test_gcode_job
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Host test of compiled jobs: stripped commands, line index and source CRC
+// of the compilation, start line found with the index and the modal state
+// checkpoints, modal state of commands and the commands sent to restore it
+
+#include "gcode_host/esp3d_gcode_job.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include <string>
+#include <vector>
+
+#include "esp3d_stubs.h"
+#include "esp3d_test.h"
+#include "filesystem/esp3d_globalfs.h"
+#include "tasks_def.h"
+
+#define JOB_LINES 1000
+
+static std::string dir;
+
+static void writeFile(const std::string &path, const std::string &content) {
+  FILE *fd = fopen(path.c_str(), "w");
+  fwrite(content.c_str(), 1, content.length(), fd);
+  fclose(fd);
+}
+
+static std::string readFile(const std::string &path) {
+  std::string content;
+  FILE *fd = fopen(path.c_str(), "r");
+  if (fd) {
+    char buffer[512];
+    size_t read = 0;
+    while ((read = fread(buffer, 1, sizeof(buffer), fd)) > 0) {
+      content.append(buffer, read);
+    }
+    fclose(fd);
+  }
+  return content;
+}
+
+// Line as sent, valid until next call
+static const char *trim(const char *line) {
+  static std::string trimmed;
+  size_t length = strlen(line);
+  esp3d_gcode_job::trimLine(&line, &length);
+  trimmed.assign(line, length);
+  trimmed.resize(esp3d_gcode_job::stripParenComments(&trimmed[0], length));
+  return trimmed.c_str();
+}
+
+static void test_trim_line() {
+  ESP3D_CHECK_STR(trim("  G1 X1 ; move \r"), "G1 X1");
+  ESP3D_CHECK_STR(trim("; only comment"), "");
+  ESP3D_CHECK_STR(trim("\t \r"), "");
+  // ';' is allowed in ESP commands parameters, and so is '('
+  ESP3D_CHECK_STR(trim(" [ESP800]time=1;2 (x) "), "[ESP800]time=1;2 (x)");
+  ESP3D_CHECK_STR(trim("G1 X1 (move) Y2"), "G1 X1  Y2");
+  ESP3D_CHECK_STR(trim("(tool 1) G0 Z5 (up)"), "G0 Z5");
+  ESP3D_CHECK_STR(trim("(only comment)"), "");
+  // ';' inside (...) does not start a comment
+  ESP3D_CHECK_STR(trim("G0 (a;b) X1 ; end"), "G0  X1");
+  // unclosed comment ends the line
+  ESP3D_CHECK_STR(trim("G0 X1 (oops Y2"), "G0 X1");
+  // messages are displayed by the controller
+  ESP3D_CHECK_STR(trim("(MSG,Change tool) (T2)"), "(MSG,Change tool)");
+  ESP3D_CHECK_STR(trim("M0 (msg, pause)"), "M0 (msg, pause)");
+  ESP3D_CHECK_STR(trim("(MSG"), "");
+}
+
+// Commands are stripped, one per line, '\r' also separates commands
+static void test_compile() {
+  std::string path = dir + "/compile.gcode";
+  writeFile(path,
+            "; header\r\n"
+            "G21 (mm) G90\r\n"
+            "\n"
+            "  (MSG,Start)\n"
+            "G0 X1\rG0 Y2\n"
+            "(only comment)\n"
+            "[ESP800]a;b\n"
+            "M5");
+  ESP3D_CHECK(esp3d_gcode_job::compile(path.c_str()));
+  ESP3DGcodeJobHeader header;
+  ESP3D_CHECK(esp3d_gcode_job::getJob(path.c_str(), &header));
+  std::string commands =
+      "G21  G90\n(MSG,Start)\nG0 X1\nG0 Y2\n[ESP800]a;b\nM5\n";
+  ESP3D_CHECK_EQ(header.source_lines, 8);
+  ESP3D_CHECK_EQ(header.commands_count, 6);
+  ESP3D_CHECK_EQ(header.commands_size, commands.length());
+  ESP3D_CHECK_EQ(header.index_offset, sizeof(header) + commands.length());
+  ESP3D_CHECK_EQ(header.modal_offset,
+                 header.index_offset + 9 * sizeof(uint32_t));
+  std::string job = readFile(esp3d_gcode_job::jobPath(path.c_str()));
+  ESP3D_CHECK_EQ(job.length(),
+                 header.modal_offset + sizeof(ESP3DGcodeModalState));
+  std::string compiled = job.substr(sizeof(header), header.commands_size);
+  ESP3D_CHECK_STR(compiled.c_str(), commands.c_str());
+  // offset of first command at or after each line, then end of commands
+  const uint32_t index[] = {0, 0, 9, 9, 21, 33, 33, 45, 48};
+  for (uint32_t i = 0; i < 9; i++) {
+    uint32_t offset = 0;
+    memcpy(&offset, job.c_str() + header.index_offset + i * sizeof(uint32_t),
+           sizeof(offset));
+    ESP3D_CHECK_EQ(offset, index[i]);
+  }
+  // temporary files are removed
+  ESP3D_CHECK(!globalFs.exists((esp3d_gcode_job::jobPath(path.c_str()) +
+                                ".tmp").c_str()));
+  ESP3D_CHECK(!globalFs.exists((esp3d_gcode_job::jobPath(path.c_str()) +
+                                ".idx").c_str()));
+}
+
+// Too long line fails and leaves no job
+static void test_compile_error() {
+  std::string path = dir + "/long.gcode";
+  writeFile(path, "G0 X1\nG1 X" + std::string(300, '1') + "\n");
+  ESP3D_CHECK(!esp3d_gcode_job::compile(path.c_str()));
+  std::string job_path = esp3d_gcode_job::jobPath(path.c_str());
+  ESP3D_CHECK(!globalFs.exists(job_path.c_str()));
+  ESP3D_CHECK(!globalFs.exists((job_path + ".tmp").c_str()));
+  ESP3DGcodeJobHeader header;
+  ESP3D_CHECK(!esp3d_gcode_job::getJob(path.c_str(), &header));
+}
+
+// Source edited without changing its size is found by the CRC, job is made
+// newer than source so the date does not tell it
+static void touchJob(const std::string &path) {
+  struct utimbuf times = {time(nullptr) + 10, time(nullptr) + 10};
+  utime(esp3d_gcode_job::jobPath(path.c_str()).c_str(), &times);
+}
+
+static void test_source_crc() {
+  std::string path = dir + "/crc.gcode";
+  writeFile(path, "123456789");
+  ESP3DGcodeJobHeader header;
+  ESP3D_CHECK(esp3d_gcode_job::compile(path.c_str()));
+  ESP3D_CHECK(esp3d_gcode_job::getJob(path.c_str(), &header));
+  // CRC32 of the whole small file
+  ESP3D_CHECK_EQ(header.source_crc, 0xCBF43926);
+  writeFile(path, "123456788");
+  touchJob(path);
+  ESP3D_CHECK(!esp3d_gcode_job::getJob(path.c_str(), &header));
+
+  // big file: only ESP3D_JOB_CRC_BLOCKS evenly spaced blocks are in the CRC,
+  // first, one in between and last
+  std::string source;
+  for (int line = 0; (int)source.length() < 64 * 1024; line++) {
+    source += "G1 X" + std::to_string(line % 1000) + " Y1.500\n";
+  }
+  size_t between = (source.length() - STREAM_CHUNK_SIZE) * 3 /
+                       (ESP3D_JOB_CRC_BLOCKS - 1) +
+                   5;
+  for (size_t edit : {(size_t)10, between, source.length() - 5}) {
+    writeFile(path, source);
+    ESP3D_CHECK(esp3d_gcode_job::compile(path.c_str()));
+    ESP3D_CHECK(esp3d_gcode_job::getJob(path.c_str(), &header));
+    std::string edited = source;
+    edited[edit] = edited[edit] == '7' ? '8' : '7';
+    writeFile(path, edited);
+    touchJob(path);
+    ESP3D_CHECK(!esp3d_gcode_job::getJob(path.c_str(), &header));
+  }
+  // job older than source is not used
+  writeFile(path, source);
+  ESP3D_CHECK(esp3d_gcode_job::compile(path.c_str()));
+  struct utimbuf times = {time(nullptr) - 10, time(nullptr) - 10};
+  utime(esp3d_gcode_job::jobPath(path.c_str()).c_str(), &times);
+  ESP3D_CHECK(!esp3d_gcode_job::getJob(path.c_str(), &header));
+}
+
+// Source of JOB_LINES lines: setup, then a move with its own X and feed rate
+// on each line but every 100th, which is a comment
+struct Program {
+  std::string path;
+  std::vector<uint32_t> offsets;  // expected offset of each line, 1 based
+  std::vector<std::string> commands;  // command of each line, may be empty
+};
+
+static Program makeProgram() {
+  Program program;
+  program.path = dir + "/part.nc";
+  std::string source;
+  std::string commands;
+  program.offsets.push_back(0);
+  program.commands.push_back("");
+  for (uint32_t line = 1; line <= JOB_LINES; line++) {
+    std::string command;
+    if (line == 1) {
+      source += "G21 G90 G54 ; setup\n";
+      command = "G21 G90 G54";
+    } else if (line % 100 == 0) {
+      source += "; layer\n";
+    } else {
+      command = "G1 X" + std::to_string(line) + " F" +
+                std::to_string(line * 10);
+      source += "  " + command + "\r\n";
+    }
+    program.offsets.push_back(commands.length());
+    program.commands.push_back(command);
+    if (!command.empty()) {
+      commands += command + "\n";
+    }
+  }
+  writeFile(program.path, source);
+  return program;
+}
+
+// Last X and feed rate set before a line
+static uint32_t lastMoveBefore(uint32_t line) {
+  for (uint32_t previous = line - 1; previous > 1; previous--) {
+    if (previous % 100 != 0) {
+      return previous;
+    }
+  }
+  return 0;
+}
+
+static void test_seek_line() {
+  Program program = makeProgram();
+  ESP3DGcodeJobHeader header;
+  ESP3D_CHECK(esp3d_gcode_job::compile(program.path.c_str()));
+  ESP3D_CHECK(esp3d_gcode_job::getJob(program.path.c_str(), &header));
+  ESP3D_CHECK_EQ(header.source_lines, JOB_LINES);
+  std::string job = readFile(esp3d_gcode_job::jobPath(program.path.c_str()));
+  for (uint32_t line : {1, 2, 99, 100, 101, 500, 999, JOB_LINES}) {
+    uint32_t offset = UINT32_MAX;
+    ESP3DGcodeModalState state;
+    ESP3D_CHECK(esp3d_gcode_job::seek(program.path.c_str(), &header, line,
+                                      &offset, &state));
+    ESP3D_CHECK_EQ(offset, program.offsets[line]);
+    // comment line starts from the command of next line, last one from the
+    // end of commands
+    uint32_t next = line;
+    while (next <= JOB_LINES && program.commands[next].empty()) {
+      next++;
+    }
+    std::string command =
+        next <= JOB_LINES ? program.commands[next] + "\n" : "";
+    std::string sent =
+        job.substr(header.header_size + offset, command.length());
+    ESP3D_CHECK_STR(sent.c_str(), command.c_str());
+  }
+  uint32_t offset = 0;
+  ESP3DGcodeModalState state;
+  ESP3D_CHECK(!esp3d_gcode_job::seek(program.path.c_str(), &header, 0, &offset,
+                                     &state));
+  ESP3D_CHECK(!esp3d_gcode_job::seek(program.path.c_str(), &header,
+                                     JOB_LINES + 1, &offset, &state));
+}
+
+// Percent start is a line of the index, first and last included
+static void test_seek_percent() {
+  ESP3DGcodeJobHeader header;
+  header.source_lines = 101;
+  ESP3D_CHECK_EQ(esp3d_gcode_job::getPercentLine(&header, 0), 1);
+  ESP3D_CHECK_EQ(esp3d_gcode_job::getPercentLine(&header, 1), 2);
+  ESP3D_CHECK_EQ(esp3d_gcode_job::getPercentLine(&header, 50), 51);
+  ESP3D_CHECK_EQ(esp3d_gcode_job::getPercentLine(&header, 100), 101);
+  ESP3D_CHECK_EQ(esp3d_gcode_job::getPercentLine(&header, 200), 101);
+  header.source_lines = 1;
+  ESP3D_CHECK_EQ(esp3d_gcode_job::getPercentLine(&header, 100), 1);
+  header.source_lines = 0;
+  ESP3D_CHECK_EQ(esp3d_gcode_job::getPercentLine(&header, 50), 0);
+
+  Program program = makeProgram();
+  ESP3D_CHECK(esp3d_gcode_job::compile(program.path.c_str()));
+  ESP3D_CHECK(esp3d_gcode_job::getJob(program.path.c_str(), &header));
+  uint32_t line = esp3d_gcode_job::getPercentLine(&header, 50);
+  ESP3D_CHECK_EQ(line, 500);
+  uint32_t offset = 0;
+  ESP3DGcodeModalState state;
+  ESP3D_CHECK(esp3d_gcode_job::seek(program.path.c_str(), &header, line,
+                                    &offset, &state));
+  ESP3D_CHECK_EQ(offset, program.offsets[500]);
+}
+
+// State at a checkpoint is read as is, between two it is rebuilt from the
+// commands after the previous one
+static void test_checkpoints() {
+  Program program = makeProgram();
+  ESP3DGcodeJobHeader header;
+  ESP3D_CHECK(esp3d_gcode_job::compile(program.path.c_str()));
+  ESP3D_CHECK(esp3d_gcode_job::getJob(program.path.c_str(), &header));
+  ESP3D_CHECK_EQ(header.modal_interval, ESP3D_JOB_MODAL_INTERVAL);
+  ESP3D_CHECK_EQ(header.modal_offset - header.index_offset,
+                 (JOB_LINES + 1) * sizeof(uint32_t));
+  for (uint32_t line : {1, 2, 3, 255, 256, 257, 258, 300, 512, 513, 514, 769,
+                        JOB_LINES}) {
+    uint32_t offset = 0;
+    ESP3DGcodeModalState state;
+    ESP3D_CHECK(esp3d_gcode_job::seek(program.path.c_str(), &header, line,
+                                      &offset, &state));
+    uint32_t move = lastMoveBefore(line);
+    if (line == 1) {
+      ESP3D_CHECK_EQ(state.axes, 0);
+      ESP3D_CHECK_EQ(state.units, 21);
+    } else if (move == 0) {
+      ESP3D_CHECK_EQ(state.axes, 0);
+      ESP3D_CHECK_EQ(state.wcs, 540);
+    } else {
+      ESP3D_CHECK_EQ(state.axes, ESP3D_JOB_AXIS_X);
+      ESP3D_CHECK_EQ(state.x, move);
+      ESP3D_CHECK_EQ(state.feedrate, move * 10);
+      ESP3D_CHECK_EQ(state.motion, 1);
+    }
+  }
+}
+
+static ESP3DGcodeModalState stateOf(std::initializer_list<const char *> lines) {
+  ESP3DGcodeModalState state;
+  for (const char *line : lines) {
+    esp3d_gcode_job::updateModalState(&state, line, strlen(line));
+  }
+  return state;
+}
+
+static void test_modal_state() {
+  ESP3DGcodeModalState state = stateOf({"G20", "G55"});
+  ESP3D_CHECK_EQ(state.units, 20);
+  ESP3D_CHECK_EQ(state.wcs, 550);
+  state = stateOf({"G20", "G21 G59.1"});
+  ESP3D_CHECK_EQ(state.units, 21);
+  ESP3D_CHECK_EQ(state.wcs, 591);
+  // G59.4 is not a work coordinate system
+  state = stateOf({"G59.4"});
+  ESP3D_CHECK_EQ(state.wcs, 540);
+
+  state = stateOf({"G43 H2"});
+  ESP3D_CHECK_EQ(state.tool_length, 430);
+  ESP3D_CHECK_EQ(state.tool_length_value, 2);
+  // Z of G43.1 is the offset, not a move
+  state = stateOf({"G43.1 Z0.5"});
+  ESP3D_CHECK_EQ(state.tool_length, 431);
+  ESP3D_CHECK(state.tool_length_value == 0.5f);
+  ESP3D_CHECK_EQ(state.axes, 0);
+  state = stateOf({"G43 H2", "G49"});
+  ESP3D_CHECK_EQ(state.tool_length, 490);
+  ESP3D_CHECK_EQ(state.tool_length_value, 0);
+
+  // offsets and machine moves do not give a position
+  state = stateOf({"G92 X0 Y0", "G10 L20 P1 Z0", "G53 G0 Z-1", "G28"});
+  ESP3D_CHECK_EQ(state.axes, 0);
+  // relative moves only follow a known position
+  state = stateOf({"G91 G0 X5", "G90 G0 Y1", "G91 G1 Y2 Z1", "(comment Y9)"});
+  ESP3D_CHECK_EQ(state.axes, ESP3D_JOB_AXIS_Y);
+  ESP3D_CHECK_EQ(state.y, 3);
+  ESP3D_CHECK_EQ(state.distance, 91);
+  // system and ESP commands are ignored
+  state = stateOf({"$H", "[ESP700]X1"});
+  ESP3D_CHECK_EQ(state.axes, 0);
+
+  // an arc needs its words, its mode cannot be restored
+  ESP3D_CHECK(esp3d_gcode_job::canRestoreModalState(&state));
+  state = stateOf({"G1 X1 F100"});
+  ESP3D_CHECK(esp3d_gcode_job::canRestoreModalState(&state));
+  state = stateOf({"G1 X1 F100", "G2 X2 Y0 I1 J0"});
+  ESP3D_CHECK(!esp3d_gcode_job::canRestoreModalState(&state));
+  state = stateOf({"G3 X2 Y0 I1 J0", "G0 Z5"});
+  ESP3D_CHECK(esp3d_gcode_job::canRestoreModalState(&state));
+}
+
+// Start line after an arc is rejected through the job too
+static void test_arc_start() {
+  std::string path = dir + "/arc.nc";
+  writeFile(path,
+            "G21 G90\nG0 X0 Y0\nG2 X2 Y0 I1 J0 F100\nX4 Y0 I1 J0\nG1 X0\n");
+  ESP3DGcodeJobHeader header;
+  ESP3D_CHECK(esp3d_gcode_job::compile(path.c_str()));
+  ESP3D_CHECK(esp3d_gcode_job::getJob(path.c_str(), &header));
+  uint32_t offset = 0;
+  ESP3DGcodeModalState state;
+  ESP3D_CHECK(esp3d_gcode_job::seek(path.c_str(), &header, 3, &offset, &state));
+  ESP3D_CHECK(esp3d_gcode_job::canRestoreModalState(&state));
+  ESP3D_CHECK(esp3d_gcode_job::seek(path.c_str(), &header, 4, &offset, &state));
+  ESP3D_CHECK(!esp3d_gcode_job::canRestoreModalState(&state));
+  ESP3D_CHECK(esp3d_gcode_job::seek(path.c_str(), &header, 5, &offset, &state));
+  ESP3D_CHECK(!esp3d_gcode_job::canRestoreModalState(&state));
+}
+
+static void test_restore_command() {
+  ESP3DGcodeModalState state;
+  std::string command = esp3d_gcode_job::getModalStateCommand(&state);
+  ESP3D_CHECK_STR(command.c_str(),
+                  "G21 G90 G17 G54 G49\nM5 M9\nG0 G90");
+  state = stateOf({"G20 G55 G43 H2", "G0 Z0.5", "G0 X1 Y2.125",
+                   "S12000 M3 M8", "G1 Z-0.25 F30", "G91"});
+  command = esp3d_gcode_job::getModalStateCommand(&state);
+  ESP3D_CHECK_STR(command.c_str(),
+                  "G20 G90 G17 G55 G43 H2\n"
+                  "G0 Z0.5\n"
+                  "G0 X1 Y2.125\n"
+                  "S12000 M3 M8\n"
+                  "G4 P2\n"
+                  "G1 Z-0.25 F30\n"
+                  "G1 G91 F30");
+  state = stateOf({"G18 G59.1 G43.1 Z0.1", "M4 M7", "G0 Z3", "G0 Z1"});
+  command = esp3d_gcode_job::getModalStateCommand(&state);
+  ESP3D_CHECK_STR(command.c_str(),
+                  "G21 G90 G18 G59.1 G43.1 Z0.1\n"
+                  "G0 Z3\n"
+                  "M4 M7\n"
+                  "G4 P2\n"
+                  "G0 Z1\n"
+                  "G0 G90");
+}
+
+int main() {
+  char dir_template[] = "/tmp/esp3d_job_XXXXXX";
+  dir = mkdtemp(dir_template);
+  esp3d_stub_reset();
+  ESP3D_RUN(test_trim_line);
+  ESP3D_RUN(test_compile);
+  ESP3D_RUN(test_compile_error);
+  ESP3D_RUN(test_source_crc);
+  ESP3D_RUN(test_seek_line);
+  ESP3D_RUN(test_seek_percent);
+  ESP3D_RUN(test_checkpoints);
+  ESP3D_RUN(test_modal_state);
+  ESP3D_RUN(test_arc_start);
+  ESP3D_RUN(test_restore_command);
+  system(("rm -rf " + dir).c_str());
+  return ESP3D_TEST_RESULT();
+}
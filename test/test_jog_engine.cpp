@@ -0,0 +1,220 @@
+/*
+  test_jog_engine
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Host test of the encoder jog: acceleration curve setting and lookup,
+// detents coalesced in one segment per period, feed capped by axis max rate,
+// and cancel once the wheel stops
+
+#include "esp3d_jog_engine.h"
+
+#include "esp3d_gcode_parser_service.h"
+#include "esp3d_settings.h"
+#include "esp3d_target_settings.h"
+#include "esp3d_test.h"
+#include "gcode_host/esp3d_gcode_host_service.h"
+#include "rendering/esp3d_rendering_client.h"
+
+#define START_US 10000000
+
+// Controller idle with unknown max rates, nothing sent yet
+static void reset() {
+  esp3d_stub_reset();
+  esp3d_stub_time_us = START_US;
+  esp3dTftsettings.clear();
+  gcodeHostService.clear();
+  renderingClient.clear();
+  esp3dGcodeParser.processCommand("$110=0\n");
+  esp3dGcodeParser.processCommand("<Idle|MPos:0,0,0>\n");
+}
+
+static void test_parse_acceleration() {
+  uint16_t factors[ESP3D_JOG_ACCEL_MAX_ENTRIES];
+  uint8_t count = 0;
+  ESP3D_CHECK(ESP3DJogEngine::parseAcceleration("1,2,4,8", factors, &count));
+  ESP3D_CHECK_EQ(count, 4);
+  ESP3D_CHECK_EQ(factors[0], 1);
+  ESP3D_CHECK_EQ(factors[3], 8);
+  ESP3D_CHECK(ESP3DJogEngine::parseAcceleration(JOG_ACCELERATION_TARGET,
+                                                nullptr, nullptr));
+  ESP3D_CHECK(ESP3DJogEngine::parseAcceleration("1000", nullptr, &count));
+  ESP3D_CHECK_EQ(count, 1);
+  ESP3D_CHECK(!ESP3DJogEngine::parseAcceleration("", nullptr, nullptr));
+  ESP3D_CHECK(!ESP3DJogEngine::parseAcceleration("0,1", nullptr, nullptr));
+  ESP3D_CHECK(!ESP3DJogEngine::parseAcceleration("1001", nullptr, nullptr));
+  ESP3D_CHECK(!ESP3DJogEngine::parseAcceleration("1,,2", nullptr, nullptr));
+  ESP3D_CHECK(!ESP3DJogEngine::parseAcceleration("1;2", nullptr, nullptr));
+  ESP3D_CHECK(!ESP3DJogEngine::parseAcceleration("x", nullptr, nullptr));
+  ESP3D_CHECK(!ESP3DJogEngine::parseAcceleration("1,2,3,4,5,6,7,8,9,10,11",
+                                                 nullptr, nullptr));
+}
+
+static void test_acceleration_factor() {
+  reset();
+  ESP3DJogEngine engine;
+  // Default curve, one entry every ESP3D_JOG_ACCEL_BUCKET detents/s
+  ESP3D_CHECK_EQ(engine.getAccelerationFactor(0), ESP3D_JOG_ACCEL_SCALE);
+  ESP3D_CHECK_EQ(engine.getAccelerationFactor(4), ESP3D_JOG_ACCEL_SCALE);
+  ESP3D_CHECK_EQ(engine.getAccelerationFactor(10), 2 * ESP3D_JOG_ACCEL_SCALE);
+  // Linear between entries
+  ESP3D_CHECK_EQ(engine.getAccelerationFactor(7),
+                 ESP3D_JOG_ACCEL_SCALE + 2 * ESP3D_JOG_ACCEL_SCALE / 5);
+  // Last entry beyond the curve
+  ESP3D_CHECK_EQ(engine.getAccelerationFactor(45), 16 * ESP3D_JOG_ACCEL_SCALE);
+  ESP3D_CHECK_EQ(engine.getAccelerationFactor(100000),
+                 16 * ESP3D_JOG_ACCEL_SCALE);
+  int32_t previous = 0;
+  for (uint32_t velocity = 0; velocity < 60; velocity++) {
+    int32_t factor = engine.getAccelerationFactor(velocity);
+    ESP3D_CHECK(factor >= previous);
+    previous = factor;
+  }
+}
+
+static void test_load_acceleration() {
+  reset();
+  ESP3DJogEngine engine;
+  esp3dTftsettings.writeString(ESP3DSettingIndex::esp3d_jog_acceleration,
+                               "1,4");
+  engine.loadAcceleration();
+  ESP3D_CHECK_EQ(engine.getAccelerationFactor(5), 4 * ESP3D_JOG_ACCEL_SCALE);
+  // Invalid setting falls back to the default curve
+  esp3dTftsettings.writeString(ESP3DSettingIndex::esp3d_jog_acceleration,
+                               "1,x");
+  engine.loadAcceleration();
+  ESP3D_CHECK_EQ(engine.getAccelerationFactor(100), 16 * ESP3D_JOG_ACCEL_SCALE);
+}
+
+static void test_disabled() {
+  reset();
+  ESP3DJogEngine engine;
+  engine.addClicks(3, 0, esp3d_stub_time_us);
+  engine.handle();
+  ESP3D_CHECK(!engine.isActive());
+  ESP3D_CHECK_EQ(renderingClient.gcodes.size(), 0);
+}
+
+static void test_coalesced_segment() {
+  reset();
+  ESP3DJogEngine engine;
+  engine.setEnabled(true);
+  // Detents of a period go in one segment, 0.1 mm each, at the feed they
+  // were turned at over the first period
+  for (int i = 0; i < 3; i++) {
+    engine.addClicks(1, 0, esp3d_stub_time_us);
+  }
+  engine.handle();
+  ESP3D_CHECK(engine.getState() == ESP3DJogState::jogging);
+  ESP3D_CHECK_EQ(renderingClient.gcodes.size(), 1);
+  ESP3D_CHECK_STR(renderingClient.gcodes[0].c_str(), "$J=G91G21X0.300F180");
+  // Detents within the tick after a segment wait for it
+  esp3d_stub_time_us += 5000;
+  engine.addClicks(-2, 0, esp3d_stub_time_us);
+  engine.handle();
+  ESP3D_CHECK_EQ(renderingClient.gcodes.size(), 1);
+  esp3d_stub_time_us += 5000;
+  engine.handle();
+  ESP3D_CHECK_EQ(renderingClient.gcodes.size(), 2);
+  ESP3D_CHECK_STR(renderingClient.gcodes[1].c_str(), "$J=G91G21X-0.200F1200");
+  // Nothing pending, nothing sent
+  esp3d_stub_time_us += ESP3D_JOG_TICK * 1000;
+  engine.handle();
+  ESP3D_CHECK_EQ(renderingClient.gcodes.size(), 2);
+}
+
+static void test_max_feed() {
+  reset();
+  ESP3DJogEngine engine;
+  engine.setEnabled(true);
+  engine.setStepIndex(3);
+  // Fast spin at top acceleration is capped to what default feed moves in
+  // period and look-ahead, extra detents are dropped
+  engine.addClicks(100, 1000, esp3d_stub_time_us);
+  engine.handle();
+  ESP3D_CHECK_EQ(renderingClient.gcodes.size(), 1);
+  ESP3D_CHECK_STR(renderingClient.gcodes[0].c_str(), "$J=G91G21X12.500F3000");
+  esp3d_stub_time_us += ESP3D_JOG_TICK * 1000;
+  engine.handle();
+  ESP3D_CHECK_EQ(renderingClient.gcodes.size(), 1);
+
+  // Axis max rate from $$ output caps feed and distance
+  reset();
+  ESP3DJogEngine limited;
+  limited.setEnabled(true);
+  limited.setStepIndex(3);
+  esp3dGcodeParser.processCommand("$110=1000.000\n");
+  ESP3D_CHECK_EQ(esp3dGcodeParser.getAxisMaxRate(0), 1000);
+  limited.addClicks(100, 1000, esp3d_stub_time_us);
+  limited.handle();
+  ESP3D_CHECK_EQ(renderingClient.gcodes.size(), 1);
+  ESP3D_CHECK_STR(renderingClient.gcodes[0].c_str(), "$J=G91G21X4.166F1000");
+}
+
+static void test_refused() {
+  reset();
+  ESP3DJogEngine engine;
+  engine.setEnabled(true);
+  // $J= is refused during a job, detents are dropped
+  esp3dGcodeParser.processCommand("<Run|MPos:0,0,0>\n");
+  engine.addClicks(5, 0, esp3d_stub_time_us);
+  engine.handle();
+  ESP3D_CHECK(!engine.isActive());
+  esp3dGcodeParser.processCommand("<Idle|MPos:0,0,0>\n");
+  engine.handle();
+  ESP3D_CHECK(!engine.isActive());
+  ESP3D_CHECK_EQ(renderingClient.gcodes.size(), 0);
+}
+
+static void test_stop() {
+  reset();
+  ESP3DJogEngine engine;
+  engine.setEnabled(true);
+  engine.addClicks(1, 0, esp3d_stub_time_us);
+  engine.handle();
+  ESP3D_CHECK_EQ(renderingClient.gcodes.size(), 1);
+  // Wheel stopped for 1.5 segment period, jog is cancelled
+  esp3d_stub_time_us += 140000;
+  engine.handle();
+  ESP3D_CHECK(engine.getState() == ESP3DJogState::jogging);
+  esp3d_stub_time_us += 20000;
+  engine.handle();
+  ESP3D_CHECK(engine.getState() == ESP3DJogState::stopping);
+  ESP3D_CHECK_EQ(renderingClient.realTimeCommands.size(), 1);
+  ESP3D_CHECK_EQ(renderingClient.realTimeCommands[0], ESP3D_JOG_CANCEL);
+  // Idle once a later report is out of jog state
+  esp3d_stub_time_us += 50000;
+  esp3dGcodeParser.setPollingCommandsLastRun(
+      ESP3D_POLLING_COMMANDS_INDEX_STATUS, esp3d_stub_time_us / 1000);
+  engine.handle();
+  ESP3D_CHECK(!engine.isActive());
+  ESP3D_CHECK_EQ(engine.getJogCount(), 1);
+  ESP3D_CHECK_EQ(engine.getStopLatencyMax(), 210);
+}
+
+int main() {
+  ESP3D_RUN(test_parse_acceleration);
+  ESP3D_RUN(test_acceleration_factor);
+  ESP3D_RUN(test_load_acceleration);
+  ESP3D_RUN(test_disabled);
+  ESP3D_RUN(test_coalesced_segment);
+  ESP3D_RUN(test_max_feed);
+  ESP3D_RUN(test_refused);
+  ESP3D_RUN(test_stop);
+  return ESP3D_TEST_RESULT();
+}
@@ -0,0 +1,256 @@
+/*
+  test_line_classifier
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Host test of controller lines classification, built once per target
+// parser: every target runs the same corpus against its own column of
+// expected types. A fuzz pass run under the sanitizers catches reads past
+// the end of a line
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <random>
+#include <string>
+
+#include "esp3d_gcode_parser_service.h"
+#include "esp3d_test.h"
+
+// Column of the expected types, set by the build of each target
+enum class Target : uint8_t {
+  grblhal = 0,
+  grbl,
+  fluidnc,
+  marlin,
+  repetier,
+  smoothieware,
+  count
+};
+
+#if defined(ESP3D_TEST_TARGET_GRBLHAL)
+static const Target target = Target::grblhal;
+#elif defined(ESP3D_TEST_TARGET_GRBL)
+static const Target target = Target::grbl;
+#elif defined(ESP3D_TEST_TARGET_FLUIDNC)
+static const Target target = Target::fluidnc;
+#elif defined(ESP3D_TEST_TARGET_MARLIN)
+static const Target target = Target::marlin;
+#elif defined(ESP3D_TEST_TARGET_REPETIER)
+static const Target target = Target::repetier;
+#elif defined(ESP3D_TEST_TARGET_SMOOTHIEWARE)
+static const Target target = Target::smoothieware;
+#else
+#error "ESP3D_TEST_TARGET_<target> is not defined"
+#endif
+
+using T = ESP3DDataType;
+static const T esp = T::esp_command, ack = T::ack, rsp = T::response,
+               err = T::error, rsd = T::resend, sts = T::status,
+               cmt = T::comment, nl = T::empty_line,
+               emg = T::emergency_command, unk = T::unknown;
+
+// value is what error and resend lines carry, other types leave it untouched
+struct ClassifiedLine {
+  const char *line;
+  uint32_t value;
+  // grblhal, grbl, fluidnc, marlin, repetier, smoothieware
+  ESP3DDataType types[(size_t)Target::count];
+};
+
+static const ClassifiedLine corpus[] = {
+    {"ok\n", 0, {ack, ack, ack, ack, ack, ack}},
+    {"ok", 0, {ack, ack, ack, ack, ack, ack}},
+    {"  \tok\r\n", 0, {ack, ack, ack, ack, ack, ack}},
+    {"ok T:25.00 /120.00 B:25.00 /0.00\n", 0, {ack, ack, ack, ack, ack, ack}},
+    {"ok T0:23.00 /0.00 B:22.62 /0.00\n", 0, {ack, ack, ack, ack, ack, ack}},
+    {"okay\n", 0, {unk, unk, unk, ack, ack, unk}},
+    {"o`\n", 0, {unk, unk, unk, ack, unk, unk}},
+    {"`k\n", 0, {unk, unk, unk, ack, unk, unk}},
+    {"echo:ok\n", 0, {rsp, rsp, rsp, ack, ack, rsp}},
+    {"N10 ok\n", 0, {unk, unk, unk, ack, ack, unk}},
+    {"error:20\n", 20, {err, unk, unk, unk, unk, unk}},
+    {"Error:9\n", 9, {err, err, err, err, err, err}},
+    {"Error:Line Number is not Last Line Number+1\n", 0,
+     {err, err, err, err, err, err}},
+    {"Resend: 42\n", 42, {rsd, rsd, rsd, rsd, rsd, rsd}},
+    {"rs 42\n", 0, {unk, unk, unk, unk, unk, unk}},
+    {"<Idle|MPos:0.000,0.000,0.000|FS:0,0>\n", 0,
+     {sts, unk, unk, unk, unk, unk}},
+    {"<Run|WPos:1.000,2.000,3.000|Bf:15,128>\n", 0,
+     {sts, unk, unk, unk, unk, unk}},
+    {"echo:busy: processing\n", 0, {sts, sts, sts, sts, sts, sts}},
+    {"echo:heating\n", 0, {sts, sts, sts, sts, sts, sts}},
+    {"echo:Unknown command\n", 0, {rsp, rsp, rsp, rsp, rsp, rsp}},
+    {"busy: processing\n", 0, {sts, sts, sts, sts, sts, sts}},
+    {"processing\n", 0, {sts, sts, sts, sts, sts, sts}},
+    {"heating\n", 0, {sts, sts, sts, sts, sts, sts}},
+    {"wait\n", 0, {unk, unk, unk, unk, unk, unk}},
+    {"\n", 0, {nl, nl, nl, nl, nl, nl}},
+    {"\r\n", 0, {nl, nl, nl, nl, nl, nl}},
+    {"  \t\n", 0, {nl, nl, nl, nl, nl, nl}},
+    {"; comment\n", 0, {cmt, cmt, cmt, cmt, cmt, cmt}},
+    {"# comment\n", 0, {cmt, cmt, cmt, cmt, cmt, cmt}},
+    {"T:25.00 /0.00 B:25.00 /50.00\n", 0, {rsp, rsp, rsp, rsp, rsp, rsp}},
+    {"T0:25.00 /0.00\n", 0, {rsp, rsp, rsp, rsp, rsp, rsp}},
+    {"X:0.00 Y:0.00 Z:0.00\n", 0, {rsp, rsp, rsp, rsp, rsp, rsp}},
+    {"Not SD printing\n", 0, {rsp, rsp, rsp, rsp, rsp, rsp}},
+    {"Done printing file\n", 0, {rsp, rsp, rsp, rsp, rsp, rsp}},
+    {"SD printing byte 10/100\n", 0, {rsp, rsp, rsp, rsp, rsp, rsp}},
+    {"Current file: part.gco\n", 0, {rsp, rsp, rsp, rsp, rsp, rsp}},
+    {"FR:100%\n", 0, {rsp, rsp, rsp, rsp, rsp, rsp}},
+    {"Cap:AUTOREPORT_TEMP:1\n", 0, {rsp, rsp, rsp, rsp, rsp, rsp}},
+    {"FIRMWARE_NAME:Marlin 2.1\n", 0, {rsp, rsp, rsp, rsp, rsp, rsp}},
+    {"[OPT:VNMZL,35,1024]\n", 0, {rsp, rsp, rsp, unk, unk, unk}},
+    {"[ESP800]\n", 0, {esp, esp, esp, esp, esp, esp}},
+    {"[ESP]\n", 0, {esp, esp, esp, esp, esp, esp}},
+    {"[ESP701]PAUSE\n", 0, {emg, emg, emg, emg, emg, emg}},
+    {"[ESPX]\n", 0, {unk, unk, unk, unk, unk, unk}},
+    {"[MSG:Pgm End]\n", 0, {unk, unk, unk, unk, unk, unk}},
+    {"[GC:G0 G54 G17 G21 G90 G94 M5 M9 T0 F0 S0]\n", 0,
+     {unk, unk, unk, unk, unk, unk}},
+    {"ALARM:1\n", 0, {unk, unk, unk, unk, unk, unk}},
+    {"Grbl 1.1f ['$' for help]\n", 0, {unk, unk, unk, unk, unk, unk}},
+    {"$110=5000.000\n", 0, {unk, unk, unk, unk, unk, unk}},
+    {"G0 X10\n", 0, {unk, unk, unk, unk, unk, unk}},
+    {"", 0, {unk, unk, unk, unk, unk, unk}},
+};
+
+static void test_corpus() {
+  ESP3DGCodeParserService parser;
+  for (const ClassifiedLine &entry : corpus) {
+    uint32_t value = 0;
+    ESP3DDataType type = parser.getType(entry.line, &value);
+    ESP3DDataType expected = entry.types[(size_t)target];
+    uint32_t expected_value =
+        expected == T::error || expected == T::resend ? entry.value : 0;
+    if (type != expected || value != expected_value) {
+      printf("\"%s\": type %d value %u\n", entry.line, (int)type,
+             (unsigned)value);
+    }
+    ESP3D_CHECK(type == expected);
+    ESP3D_CHECK_EQ(value, expected_value);
+  }
+  ESP3D_CHECK(parser.getType(nullptr) == ESP3DDataType::empty_line);
+}
+
+// [OPT:] gives the RX buffer size, one byte kept free, and on grblHAL the
+// planner blocks. 3D printers firmwares keep the default size
+static void test_build_options() {
+  ESP3DGCodeParserService parser;
+  size_t initial = parser.getRxBufferSize();
+  parser.getType("[OPT:VNMZL,35,1024,3,0]\n");
+  if (target == Target::grblhal || target == Target::grbl ||
+      target == Target::fluidnc) {
+    ESP3D_CHECK_EQ(initial, 0);
+    ESP3D_CHECK_EQ(parser.getRxBufferSize(), 1023);
+  } else {
+    ESP3D_CHECK_EQ(initial, ESP3D_RX_BUFFER_SIZE);
+    ESP3D_CHECK_EQ(parser.getRxBufferSize(), ESP3D_RX_BUFFER_SIZE);
+  }
+#if defined(ESP3D_TEST_TARGET_GRBLHAL)
+  ESP3D_CHECK_EQ(parser.getPlannerBlocksCount(), 35);
+#endif
+  // truncated reports keep what was known
+  size_t known = parser.getRxBufferSize();
+  parser.getType("[OPT:V,\n");
+  parser.getType("[OPT:\n");
+  ESP3D_CHECK_EQ(parser.getRxBufferSize(), known);
+}
+
+// Line in a buffer of its exact size, so sanitizers see any read past it
+static ESP3DDataType classifyExact(ESP3DGCodeParserService &parser,
+                                   const char *line, size_t length,
+                                   uint32_t *value) {
+  char *buffer = (char *)malloc(length + 1);
+  memcpy(buffer, line, length);
+  buffer[length] = '\0';
+  ESP3DDataType type = parser.getType(buffer, value);
+  free(buffer);
+  return type;
+}
+
+// Each known line cut at every length
+static void test_truncated_lines() {
+  ESP3DGCodeParserService parser;
+  for (const ClassifiedLine &entry : corpus) {
+    size_t length = strlen(entry.line);
+    for (size_t cut = 0; cut <= length; cut++) {
+      uint32_t value = 0;
+      classifyExact(parser, entry.line, cut, &value);
+    }
+  }
+}
+
+// Marlin and Repetier take "ok" anywhere in the line, Marlin even altered
+static bool hasAck(const char *line) {
+  if (target == Target::marlin) {
+    return strstr(line, "ok") || strstr(line, "o`") || strstr(line, "`k");
+  }
+  if (target == Target::repetier) {
+    return strstr(line, "ok");
+  }
+  return strncmp(line, "ok", 2) == 0;
+}
+
+// Random lines made of pieces of known prefixes and random bytes, the
+// result must be stable and consistent with the line start
+static void test_fuzz() {
+  static const char *pieces[] = {"ok", "error:", "Error:", "Resend: ", "<",
+                                 "echo:", "busy", "[OPT:", "[ESP", "701]",
+                                 ",", "\n", "\r", " ", "\t", "T:", "X:"};
+  std::mt19937 random(1234);
+  ESP3DGCodeParserService parser;
+  uint32_t inconsistent = 0;
+  for (int i = 0; i < 200000; i++) {
+    std::string line;
+    int count = random() % 6;
+    for (int j = 0; j < count; j++) {
+      if (random() % 2) {
+        line += pieces[random() % (sizeof(pieces) / sizeof(pieces[0]))];
+      } else {
+        line += (char)(1 + random() % 255);
+      }
+    }
+    uint32_t value = 0;
+    uint32_t again = 0;
+    ESP3DDataType type =
+        classifyExact(parser, line.c_str(), strlen(line.c_str()), &value);
+    if (type != classifyExact(parser, line.c_str(), strlen(line.c_str()),
+                              &again) ||
+        value != again) {
+      inconsistent++;
+    }
+    const char *start = line.c_str() + strspn(line.c_str(), " \t");
+    if ((type == ESP3DDataType::ack && !hasAck(start)) ||
+        (type == ESP3DDataType::error && strncmp(start + 1, "rror:", 5) != 0) ||
+        (type == ESP3DDataType::resend &&
+         strncmp(start, "Resend: ", 8) != 0)) {
+      inconsistent++;
+    }
+  }
+  ESP3D_CHECK_EQ(inconsistent, 0);
+}
+
+int main() {
+  ESP3D_RUN(test_corpus);
+  ESP3D_RUN(test_build_options);
+  ESP3D_RUN(test_truncated_lines);
+  ESP3D_RUN(test_fuzz);
+  return ESP3D_TEST_RESULT();
+}
@@ -0,0 +1,139 @@
+/*
+  test_line_scanner
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Host test of the line scanner of streamed files: stripped commands, skipped
+// lines, lines split by a chunk boundary and too long lines
+
+#include "gcode_host/esp3d_gcode_line_scanner.h"
+
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "esp3d_stubs.h"
+#include "esp3d_test.h"
+
+static const char *program =
+    "G21\r\n"
+    "; header comment\n"
+    "\n"
+    "(only a comment)\r\n"
+    "  G0 X1 (move) ; end\n"
+    "(MSG,Start)\n"
+    "G1 Y2 F100\n"
+    "M5";
+
+// Scan text as the gcode host does, in chunks of chunk_size bytes, the end
+// of a last line without '\n' is left in command
+static std::vector<std::string> scanText(ESP3DGcodeLineScanner *scanner,
+                                         const char *text, size_t chunk_size,
+                                         std::string *command,
+                                         uint64_t *position) {
+  std::vector<std::string> commands;
+  size_t length = strlen(text);
+  size_t offset = 0;
+  command->clear();
+  *position = 0;
+  scanner->reset();
+  while (offset < length || !scanner->needChunk()) {
+    if (scanner->needChunk()) {
+      size_t size = length - offset < chunk_size ? length - offset : chunk_size;
+      scanner->setChunk(text + offset, size);
+      offset += size;
+    }
+    ESP3DGcodeLineScan result = scanner->scan(command, position);
+    if (result == ESP3DGcodeLineScan::too_long) {
+      break;
+    }
+    if (result == ESP3DGcodeLineScan::command) {
+      commands.push_back(*command);
+      command->clear();
+    }
+  }
+  return commands;
+}
+
+static void test_commands() {
+  ESP3DGcodeLineScanner scanner;
+  std::string command;
+  uint64_t position = 0;
+  std::vector<std::string> commands =
+      scanText(&scanner, program, 1024, &command, &position);
+  ESP3D_CHECK_EQ(commands.size(), 4);
+  if (commands.size() == 4) {
+    ESP3D_CHECK_STR(commands[0].c_str(), "G21");
+    ESP3D_CHECK_STR(commands[1].c_str(), "G0 X1");
+    ESP3D_CHECK_STR(commands[2].c_str(), "(MSG,Start)");
+    ESP3D_CHECK_STR(commands[3].c_str(), "G1 Y2 F100");
+  }
+  // last line has no end of line, it is left to the end of file handling
+  ESP3D_CHECK_STR(command.c_str(), "M5");
+  ESP3D_CHECK_EQ(position, strlen(program));
+  ESP3D_CHECK_EQ(scanner.getScannedLines(), 7);
+  ESP3D_CHECK_EQ(scanner.getStraddledLines(), 1);
+}
+
+static void test_chunk_boundaries() {
+  ESP3DGcodeLineScanner scanner;
+  std::string command;
+  uint64_t position = 0;
+  std::vector<std::string> expected =
+      scanText(&scanner, program, 1024, &command, &position);
+  for (size_t chunk_size = 1; chunk_size <= strlen(program); chunk_size++) {
+    scanner.resetStats();
+    std::vector<std::string> commands =
+        scanText(&scanner, program, chunk_size, &command, &position);
+    ESP3D_CHECK(commands == expected);
+    ESP3D_CHECK_STR(command.c_str(), "M5");
+    ESP3D_CHECK_EQ(position, strlen(program));
+    ESP3D_CHECK_EQ(scanner.getScannedLines(), 7);
+  }
+}
+
+static void test_too_long() {
+  ESP3DGcodeLineScanner scanner;
+  std::string command;
+  uint64_t position = 0;
+  std::string text = "G1 X" + std::string(ESP3D_GCODE_MAX_LINE_LENGTH - 4, '1');
+  text += "\nG1 X" + std::string(ESP3D_GCODE_MAX_LINE_LENGTH - 3, '2') + "\n";
+  // split in the middle of the first line, the carry counts in the length
+  std::vector<std::string> commands =
+      scanText(&scanner, text.c_str(), 100, &command, &position);
+  ESP3D_CHECK_EQ(commands.size(), 1);
+  if (commands.size() == 1) {
+    ESP3D_CHECK_EQ(commands[0].length(), ESP3D_GCODE_MAX_LINE_LENGTH);
+  }
+  ESP3D_CHECK_EQ(scanner.getScannedLines(), 1);
+  // error is reported when the end of the line is read
+  std::string line = text.substr(ESP3D_GCODE_MAX_LINE_LENGTH + 1);
+  command.clear();
+  scanner.setChunk(line.c_str(), line.length());
+  ESP3D_CHECK(scanner.scan(&command, &position) ==
+              ESP3DGcodeLineScan::too_long);
+}
+
+int main() {
+  esp3d_stub_reset();
+  ESP3D_RUN(test_commands);
+  ESP3D_RUN(test_chunk_boundaries);
+  ESP3D_RUN(test_too_long);
+  return ESP3D_TEST_RESULT();
+}
@@ -0,0 +1,177 @@
+/*
+  test_message_pool
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Host test of message allocation: small payloads inline in the message,
+// others in reference counted slabs shared by copies
+
+#include <string.h>
+
+#include "esp3d_client.h"
+#include "esp3d_message_pool.h"
+#include "esp3d_test.h"
+
+static ESP3DMessage *newTextMsg(const char *text) {
+  return ESP3DClient::newMsg(ESP3DClientType::serial,
+                             ESP3DClientType::all_clients,
+                             (const uint8_t *)text, strlen(text));
+}
+
+static uint16_t slabUsed(uint8_t index) {
+  ESP3DMessagePoolStats stats;
+  esp3d_message_pool::getSlabStats(index, &stats);
+  return stats.used;
+}
+
+static uint16_t msgUsed() {
+  ESP3DMessagePoolStats stats;
+  esp3d_message_pool::getMsgStats(&stats);
+  return stats.used;
+}
+
+static void test_small_payload_is_inline() {
+  esp3d_message_pool::resetStats();
+  ESP3DMessage *msg = newTextMsg("ok\n");
+  ESP3D_CHECK(msg != nullptr);
+  ESP3D_CHECK(ESP3DClient::isInlineData(msg));
+  ESP3D_CHECK_STR((const char *)msg->data, "ok\n");
+  ESP3D_CHECK_EQ(msg->size, 3);
+  ESP3D_CHECK_EQ(esp3d_message_pool::getInlineCount(), 1);
+  ESP3D_CHECK_EQ(esp3d_message_pool::getDataAllocCount(), 0);
+  ESP3D_CHECK_EQ(slabUsed(0), 0);
+  ESP3DClient::deleteMsg(msg);
+  ESP3D_CHECK_EQ(msgUsed(), 0);
+}
+
+// Terminator must fit: ESP3D_MSG_INLINE_SIZE - 1 bytes are inline, one more
+// goes to a slab
+static void test_inline_boundary() {
+  char text[ESP3D_MSG_INLINE_SIZE + 1];
+  memset(text, 'a', sizeof(text));
+  text[ESP3D_MSG_INLINE_SIZE - 1] = '\0';
+  ESP3DMessage *msg = newTextMsg(text);
+  ESP3D_CHECK(ESP3DClient::isInlineData(msg));
+  ESP3D_CHECK_EQ(msg->size, ESP3D_MSG_INLINE_SIZE - 1);
+  ESP3DClient::deleteMsg(msg);
+
+  text[ESP3D_MSG_INLINE_SIZE - 1] = 'a';
+  text[ESP3D_MSG_INLINE_SIZE] = '\0';
+  msg = newTextMsg(text);
+  ESP3D_CHECK(!ESP3DClient::isInlineData(msg));
+  ESP3D_CHECK_EQ(slabUsed(0), 1);
+  ESP3DClient::deleteMsg(msg);
+  ESP3D_CHECK_EQ(slabUsed(0), 0);
+}
+
+// A unique message gets its missing end of line, which must fit too
+static void test_end_of_line_added() {
+  ESP3DMessage *msg = ESP3DClient::newMsg();
+  msg->type = ESP3DMessageType::unique;
+  ESP3D_CHECK(ESP3DClient::setDataContent(msg, (const uint8_t *)"$J=X1", 5));
+  ESP3D_CHECK(ESP3DClient::isInlineData(msg));
+  ESP3D_CHECK_STR((const char *)msg->data, "$J=X1\n");
+  ESP3D_CHECK_EQ(msg->size, 6);
+  ESP3DClient::deleteMsg(msg);
+}
+
+// Inline copy has its own bytes, it never shares the original message
+static void test_inline_copy() {
+  ESP3DMessage *msg = newTextMsg("<Idle|MPos:0.000,0.000,0.000>\n");
+  uint32_t shared = esp3d_message_pool::getSharedCount();
+  ESP3DMessage *copy = ESP3DClient::copyMsg(*msg);
+  ESP3D_CHECK(ESP3DClient::isInlineData(copy));
+  ESP3D_CHECK(copy->data != msg->data);
+  ESP3D_CHECK_STR((const char *)copy->data, (const char *)msg->data);
+  ESP3D_CHECK_EQ(copy->size, msg->size);
+  ESP3D_CHECK_EQ(esp3d_message_pool::getSharedCount(), shared);
+  ESP3DClient::deleteMsg(msg);
+  ESP3D_CHECK_STR((const char *)copy->data,
+                  "<Idle|MPos:0.000,0.000,0.000>\n");
+  ESP3DClient::deleteMsg(copy);
+}
+
+// Slab payload is shared by copies, last delete gives the block back
+static void test_shared_slab_copy() {
+  char text[100];
+  memset(text, 'g', sizeof(text) - 1);
+  text[sizeof(text) - 1] = '\0';
+  ESP3DMessage *msg = newTextMsg(text);
+  ESP3DMessage *copy = ESP3DClient::copyMsg(*msg);
+  ESP3D_CHECK(copy->data == msg->data);
+  ESP3D_CHECK_EQ(slabUsed(0), 1);
+  ESP3DClient::deleteMsg(msg);
+  ESP3D_CHECK_EQ(slabUsed(0), 1);
+  ESP3D_CHECK_EQ(strlen((const char *)copy->data), sizeof(text) - 1);
+  ESP3DClient::deleteMsg(copy);
+  ESP3D_CHECK_EQ(slabUsed(0), 0);
+}
+
+// Replacing content moves between inline and slab without leaking
+static void test_replace_content() {
+  char text[200];
+  memset(text, 'r', sizeof(text) - 1);
+  text[sizeof(text) - 1] = '\0';
+  ESP3DMessage *msg = newTextMsg("ok\n");
+  ESP3D_CHECK(ESP3DClient::setDataContent(msg, (const uint8_t *)text,
+                                          strlen(text)));
+  ESP3D_CHECK(!ESP3DClient::isInlineData(msg));
+  ESP3D_CHECK_EQ(slabUsed(1), 1);
+  ESP3D_CHECK(ESP3DClient::setDataContent(msg, (const uint8_t *)"ok\n", 3));
+  ESP3D_CHECK(ESP3DClient::isInlineData(msg));
+  ESP3D_CHECK_EQ(slabUsed(1), 0);
+  ESP3DClient::deleteMsg(msg);
+}
+
+// Payloads above largest slab and messages above pool size use the heap
+static void test_heap_fallbacks() {
+  esp3d_message_pool::resetStats();
+  static char text[ESP3D_MSG_SLAB_LARGE_SIZE + 10];
+  memset(text, 'h', sizeof(text) - 1);
+  text[sizeof(text) - 1] = '\0';
+  ESP3DMessage *msg = newTextMsg(text);
+  ESP3D_CHECK(msg != nullptr);
+  ESP3D_CHECK_EQ(esp3d_message_pool::getOversizedCount(), 1);
+  ESP3DClient::deleteMsg(msg);
+
+  ESP3DMessage *msgs[ESP3D_MSG_POOL_COUNT + 1];
+  for (int i = 0; i <= ESP3D_MSG_POOL_COUNT; i++) {
+    msgs[i] = newTextMsg("ok\n");
+    ESP3D_CHECK(msgs[i] != nullptr);
+  }
+  ESP3DMessagePoolStats stats;
+  esp3d_message_pool::getMsgStats(&stats);
+  ESP3D_CHECK_EQ(stats.used, ESP3D_MSG_POOL_COUNT);
+  ESP3D_CHECK_EQ(stats.fallbacks, 1);
+  for (int i = 0; i <= ESP3D_MSG_POOL_COUNT; i++) {
+    ESP3DClient::deleteMsg(msgs[i]);
+  }
+  ESP3D_CHECK_EQ(msgUsed(), 0);
+}
+
+int main() {
+  esp3d_stub_reset();
+  ESP3D_RUN(test_small_payload_is_inline);
+  ESP3D_RUN(test_inline_boundary);
+  ESP3D_RUN(test_end_of_line_added);
+  ESP3D_RUN(test_inline_copy);
+  ESP3D_RUN(test_shared_slab_copy);
+  ESP3D_RUN(test_replace_content);
+  ESP3D_RUN(test_heap_fallbacks);
+  return ESP3D_TEST_RESULT();
+}
@@ -0,0 +1,117 @@
+/*
+  test_message_ring
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Host test of the lock free ring used by client queues
+
+#include <stdint.h>
+
+#include <thread>
+
+#include "esp3d_message_ring.h"
+#include "esp3d_test.h"
+
+// Ring only stores pointers, messages are never dereferenced
+#define fakeMsg(value) ((ESP3DMessage *)(uintptr_t)(value))
+
+static void test_capacity_rounding() {
+  ESP3DMessageRing ring;
+  ESP3D_CHECK(!ring.started());
+  ESP3D_CHECK(ring.begin(5));
+  ESP3D_CHECK(ring.started());
+  ESP3D_CHECK_EQ(ring.capacity(), 8);
+  ESP3D_CHECK(ring.begin(1));
+  ESP3D_CHECK_EQ(ring.capacity(), 2);
+  ESP3D_CHECK(ring.begin(128));
+  ESP3D_CHECK_EQ(ring.capacity(), 128);
+  ring.end();
+  ESP3D_CHECK(!ring.started());
+}
+
+static void test_order_and_full() {
+  ESP3DMessageRing ring;
+  ESP3D_CHECK(ring.begin(4));
+  ESP3D_CHECK(ring.pop() == nullptr);
+  for (uintptr_t i = 1; i <= 4; i++) {
+    ESP3D_CHECK(ring.push(fakeMsg(i)));
+  }
+  ESP3D_CHECK_EQ(ring.count(), 4);
+  ESP3D_CHECK(!ring.push(fakeMsg(5)));
+  for (uintptr_t i = 1; i <= 4; i++) {
+    ESP3D_CHECK(ring.pop() == fakeMsg(i));
+  }
+  ESP3D_CHECK(ring.pop() == nullptr);
+  ESP3D_CHECK_EQ(ring.count(), 0);
+}
+
+// Indexes keep growing, slots are reused modulo capacity
+static void test_wrap_around() {
+  ESP3DMessageRing ring;
+  ESP3D_CHECK(ring.begin(4));
+  uintptr_t next_push = 1;
+  uintptr_t next_pop = 1;
+  for (int round = 0; round < 1000; round++) {
+    for (int i = 0; i < 3; i++) {
+      ESP3D_CHECK(ring.push(fakeMsg(next_push++)));
+    }
+    for (int i = 0; i < 3; i++) {
+      ESP3D_CHECK(ring.pop() == fakeMsg(next_pop++));
+    }
+  }
+  ESP3D_CHECK_EQ(ring.count(), 0);
+}
+
+// One producer thread and one consumer thread, every message comes out once
+// and in order
+static void test_two_threads() {
+  const uintptr_t total = 1000000;
+  ESP3DMessageRing ring;
+  ESP3D_CHECK(ring.begin(16));
+  std::thread producer([&ring, total]() {
+    for (uintptr_t i = 1; i <= total; i++) {
+      while (!ring.push(fakeMsg(i))) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  uintptr_t expected = 1;
+  uintptr_t errors = 0;
+  while (expected <= total) {
+    ESP3DMessage *msg = ring.pop();
+    if (!msg) {
+      std::this_thread::yield();
+      continue;
+    }
+    if (msg != fakeMsg(expected)) {
+      errors++;
+    }
+    expected++;
+  }
+  producer.join();
+  ESP3D_CHECK_EQ(errors, 0);
+  ESP3D_CHECK(ring.pop() == nullptr);
+}
+
+int main() {
+  ESP3D_RUN(test_capacity_rounding);
+  ESP3D_RUN(test_order_and_full);
+  ESP3D_RUN(test_wrap_around);
+  ESP3D_RUN(test_two_threads);
+  return ESP3D_TEST_RESULT();
+}
@@ -0,0 +1,171 @@
+/*
+  test_override_engine
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Host test of the override sequences: for every current and wanted
+// override, the realtime commands end on the wanted value once clamped by
+// the controller, and no shorter sequence exists, as found by a breadth
+// first search over the commands
+
+#include "esp3d_override_engine.h"
+
+#include <string.h>
+
+#include <deque>
+
+#include "esp3d_stubs.h"
+#include "esp3d_test.h"
+
+#define OVERRIDE_VALUES (ESP3D_OVERRIDE_MAX + 1)
+
+struct Commands {
+  uint8_t reset;
+  uint8_t plus_10;
+  uint8_t minus_10;
+  uint8_t plus_1;
+  uint8_t minus_1;
+};
+
+static const Commands feed = {
+    ESP3D_OVERRIDE_FEED_RESET, ESP3D_OVERRIDE_FEED_PLUS_10,
+    ESP3D_OVERRIDE_FEED_MINUS_10, ESP3D_OVERRIDE_FEED_PLUS_1,
+    ESP3D_OVERRIDE_FEED_MINUS_1};
+static const Commands spindle = {
+    ESP3D_OVERRIDE_SPINDLE_RESET, ESP3D_OVERRIDE_SPINDLE_PLUS_10,
+    ESP3D_OVERRIDE_SPINDLE_MINUS_10, ESP3D_OVERRIDE_SPINDLE_PLUS_1,
+    ESP3D_OVERRIDE_SPINDLE_MINUS_1};
+
+static int clampOverride(int value) {
+  if (value < ESP3D_OVERRIDE_MIN) {
+    return ESP3D_OVERRIDE_MIN;
+  }
+  if (value > ESP3D_OVERRIDE_MAX) {
+    return ESP3D_OVERRIDE_MAX;
+  }
+  return value;
+}
+
+// Override once the controller applied command, -1 if it is not one of cmds
+static int apply(const Commands &cmds, int value, uint8_t command) {
+  if (command == cmds.reset) {
+    return ESP3D_OVERRIDE_DEFAULT;
+  }
+  if (command == cmds.plus_10) {
+    return clampOverride(value + 10);
+  }
+  if (command == cmds.minus_10) {
+    return clampOverride(value - 10);
+  }
+  if (command == cmds.plus_1) {
+    return clampOverride(value + 1);
+  }
+  if (command == cmds.minus_1) {
+    return clampOverride(value - 1);
+  }
+  return -1;
+}
+
+// Fewest commands from current to every override value
+static void shortestDistances(int current, int *distances) {
+  for (int value = 0; value < OVERRIDE_VALUES; value++) {
+    distances[value] = -1;
+  }
+  const uint8_t all[] = {feed.reset, feed.plus_10, feed.minus_10, feed.plus_1,
+                         feed.minus_1};
+  std::deque<int> queue = {current};
+  distances[current] = 0;
+  while (!queue.empty()) {
+    int value = queue.front();
+    queue.pop_front();
+    for (uint8_t command : all) {
+      int next = apply(feed, value, command);
+      if (distances[next] < 0) {
+        distances[next] = distances[value] + 1;
+        queue.push_back(next);
+      }
+    }
+  }
+}
+
+static void checkTarget(ESP3DOverrideTarget target, const Commands &cmds) {
+  int distances[OVERRIDE_VALUES];
+  uint8_t commands[ESP3D_OVERRIDE_MAX_SEQUENCE];
+  int longest = 0;
+  int failures = esp3d_test_failures;
+  for (int current = ESP3D_OVERRIDE_MIN; current <= ESP3D_OVERRIDE_MAX;
+       current++) {
+    shortestDistances(current, distances);
+    for (int wanted = ESP3D_OVERRIDE_MIN; wanted <= ESP3D_OVERRIDE_MAX;
+         wanted++) {
+      memset(commands, 0, sizeof(commands));
+      uint8_t count = ESP3DOverrideEngine::buildSequence(
+          target, current, wanted, commands, sizeof(commands));
+      int value = current;
+      for (uint8_t i = 0; i < count && value >= 0; i++) {
+        value = apply(cmds, value, commands[i]);
+      }
+      if (count != distances[wanted] || value != wanted) {
+        printf("%d%% to %d%%: %d commands end on %d%%, shortest is %d\n",
+               current, wanted, count, value, distances[wanted]);
+        esp3d_test_failures++;
+      }
+      if (count > longest) {
+        longest = count;
+      }
+      // stop after a few reports, a bug would fail most pairs
+      if (esp3d_test_failures - failures > 10) {
+        return;
+      }
+    }
+  }
+  ESP3D_CHECK(longest < ESP3D_OVERRIDE_MAX_SEQUENCE);
+}
+
+static void test_feed_sequences() {
+  checkTarget(ESP3DOverrideTarget::feed, feed);
+}
+
+static void test_spindle_sequences() {
+  checkTarget(ESP3DOverrideTarget::spindle, spindle);
+}
+
+static void test_sequence_size() {
+  uint8_t commands[ESP3D_OVERRIDE_MAX_SEQUENCE];
+  // 100 to 155: +10 five times, then +1 five times
+  uint8_t count = ESP3DOverrideEngine::buildSequence(
+      ESP3DOverrideTarget::feed, 100, 155, commands, sizeof(commands));
+  ESP3D_CHECK_EQ(count, 10);
+  // no sequence fits a smaller buffer
+  ESP3D_CHECK_EQ(ESP3DOverrideEngine::buildSequence(
+                     ESP3DOverrideTarget::feed, 100, 155, commands, count - 1),
+                 0);
+  // nothing to send
+  ESP3D_CHECK_EQ(ESP3DOverrideEngine::buildSequence(
+                     ESP3DOverrideTarget::feed, 42, 42, commands,
+                     sizeof(commands)),
+                 0);
+}
+
+int main() {
+  esp3d_stub_reset();
+  ESP3D_RUN(test_feed_sequences);
+  ESP3D_RUN(test_spindle_sequences);
+  ESP3D_RUN(test_sequence_size);
+  return ESP3D_TEST_RESULT();
+}
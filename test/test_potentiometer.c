@@ -0,0 +1,243 @@
+/*
+  test_potentiometer
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Host test of the potentiometer filters, calibration and change
+// notifications, frames are given to the conversion done callback
+// as the ADC driver would
+
+#include "esp3d_test.h"
+
+// Filter state and interrupt callback are reached by building the driver here
+#include "phy_potentiometer.c"
+
+#define TEST_CHANNEL 6
+
+static int notify_calls;
+static bool notify_result;
+
+static bool notify(void *arg) {
+  ESP3D_CHECK(arg == &notify_calls);
+  notify_calls++;
+  return notify_result;
+}
+
+static phy_potentiometer_config_t make_config(bool continuous) {
+  phy_potentiometer_config_t config = {
+      .pin = GPIO_NUM_34,
+      .channel = TEST_CHANNEL,
+      .width = 12,
+      .atten = 3,
+      .filter_enabled = true,
+      .filter_samples = 4,
+      .continuous = continuous,
+      .sample_freq_hz = 20000,
+      .oversampling = 4,
+      .median_size = 1,
+      .iir_shift = 0,
+      .raw_min = 0,
+      .raw_max = PHY_POTENTIOMETER_MAX_VALUE,
+  };
+  return config;
+}
+
+// Driver keeps filter state across configurations, tests start from scratch
+static void configure(const phy_potentiometer_config_t *config) {
+  median_count = 0;
+  median_index = 0;
+  has_value = false;
+  notify_cb = NULL;
+  notify_calls = 0;
+  notify_result = false;
+  ESP3D_CHECK_EQ(phy_potentiometer_configure(config), ESP_OK);
+}
+
+// Frame of count samples of value, with as many samples of another channel
+static bool convert(uint32_t value, uint32_t count) {
+  uint8_t buffer[64];
+  uint32_t size = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    adc_digi_output_data_t own = {.type1 = {.data = value,
+                                            .channel = TEST_CHANNEL}};
+    adc_digi_output_data_t other = {.type1 = {.data = 4095 - value,
+                                              .channel = TEST_CHANNEL + 1}};
+    memcpy(&buffer[size], &own, sizeof(own));
+    size += sizeof(own);
+    memcpy(&buffer[size], &other, sizeof(other));
+    size += sizeof(other);
+  }
+  adc_continuous_evt_data_t edata = {.conv_frame_buffer = buffer,
+                                     .size = size};
+  return on_conversion_done(adc_continuous_handle, &edata, NULL);
+}
+
+static uint32_t read_value(void) {
+  uint32_t value = UINT32_MAX;
+  ESP3D_CHECK_EQ(phy_potentiometer_read(&value), ESP_OK);
+  return value;
+}
+
+static void test_invalid_config(void) {
+  ESP3D_CHECK_EQ(phy_potentiometer_configure(NULL), ESP_ERR_INVALID_ARG);
+  phy_potentiometer_config_t config = make_config(true);
+  config.pin = GPIO_NUM_NC;
+  ESP3D_CHECK_EQ(phy_potentiometer_configure(&config), ESP_ERR_INVALID_ARG);
+  config = make_config(true);
+  config.raw_min = config.raw_max;
+  ESP3D_CHECK_EQ(phy_potentiometer_configure(&config), ESP_ERR_INVALID_ARG);
+  config = make_config(true);
+  config.median_size = 0;
+  ESP3D_CHECK_EQ(phy_potentiometer_configure(&config), ESP_ERR_INVALID_ARG);
+  config.median_size = PHY_POTENTIOMETER_MEDIAN_MAX + 1;
+  ESP3D_CHECK_EQ(phy_potentiometer_configure(&config), ESP_ERR_INVALID_ARG);
+  config = make_config(true);
+  config.oversampling = 0;
+  ESP3D_CHECK_EQ(phy_potentiometer_configure(&config), ESP_ERR_INVALID_ARG);
+  config = make_config(true);
+  config.iir_shift = 9;
+  ESP3D_CHECK_EQ(phy_potentiometer_configure(&config), ESP_ERR_INVALID_ARG);
+}
+
+static void test_frame_average(void) {
+  phy_potentiometer_config_t config = make_config(true);
+  configure(&config);
+  // Samples of other channels are ignored
+  ESP3D_CHECK(!convert(1000, 4));
+  ESP3D_CHECK_EQ(read_value(), 1000);
+  phy_potentiometer_stats_t stats;
+  ESP3D_CHECK_EQ(phy_potentiometer_get_stats(&stats), ESP_OK);
+  ESP3D_CHECK_EQ(stats.values, 1);
+  ESP3D_CHECK_EQ(stats.samples, 4);
+  // Frame without own channel changes nothing
+  adc_digi_output_data_t other = {.type1 = {.data = 10, .channel = 0}};
+  adc_continuous_evt_data_t edata = {.conv_frame_buffer = (uint8_t *)&other,
+                                     .size = sizeof(other)};
+  ESP3D_CHECK(!on_conversion_done(adc_continuous_handle, &edata, NULL));
+  ESP3D_CHECK_EQ(read_value(), 1000);
+  ESP3D_CHECK_EQ(phy_potentiometer_get_stats(&stats), ESP_OK);
+  ESP3D_CHECK_EQ(stats.values, 1);
+}
+
+static void test_median(void) {
+  phy_potentiometer_config_t config = make_config(true);
+  config.median_size = 3;
+  configure(&config);
+  convert(1000, 2);
+  convert(1002, 2);
+  // One spike is dropped
+  convert(4000, 2);
+  ESP3D_CHECK_EQ(read_value(), 1002);
+  convert(1001, 2);
+  ESP3D_CHECK_EQ(read_value(), 1002);
+  // A move lasting two values goes through
+  convert(3000, 2);
+  ESP3D_CHECK_EQ(read_value(), 3000);
+}
+
+static void test_iir(void) {
+  phy_potentiometer_config_t config = make_config(true);
+  config.iir_shift = 2;
+  configure(&config);
+  // First value is taken as is
+  convert(0, 2);
+  ESP3D_CHECK_EQ(read_value(), 0);
+  // Then a quarter of each step
+  convert(1024, 2);
+  ESP3D_CHECK_EQ(read_value(), 256);
+  convert(1024, 2);
+  ESP3D_CHECK_EQ(read_value(), 448);
+  for (int i = 0; i < 40; i++) {
+    convert(1024, 2);
+  }
+  ESP3D_CHECK_EQ(read_value(), 1023);
+}
+
+static void test_calibration(void) {
+  phy_potentiometer_config_t config = make_config(true);
+  config.raw_min = 100;
+  config.raw_max = 3900;
+  configure(&config);
+  // Course ends read as full scale, whatever the pot resistance left
+  convert(50, 2);
+  ESP3D_CHECK_EQ(read_value(), 0);
+  configure(&config);
+  convert(4000, 2);
+  ESP3D_CHECK_EQ(read_value(), PHY_POTENTIOMETER_MAX_VALUE);
+  configure(&config);
+  convert(2000, 2);
+  ESP3D_CHECK_EQ(read_value(), (2000 - 100) * 4095 / 3800);
+}
+
+static void test_notify(void) {
+  phy_potentiometer_config_t config = make_config(true);
+  configure(&config);
+  convert(1000, 2);
+  ESP3D_CHECK_EQ(phy_potentiometer_set_notify(notify, &notify_calls), ESP_OK);
+  // First value after setting notifies, even unchanged
+  notify_result = true;
+  ESP3D_CHECK(convert(1000, 2));
+  ESP3D_CHECK_EQ(notify_calls, 1);
+  // Noise below the delta does not
+  ESP3D_CHECK(!convert(1000 + PHY_POTENTIOMETER_NOTIFY_DELTA - 1, 2));
+  ESP3D_CHECK(!convert(1000 - PHY_POTENTIOMETER_NOTIFY_DELTA + 1, 2));
+  ESP3D_CHECK_EQ(notify_calls, 1);
+  ESP3D_CHECK(convert(1000 + PHY_POTENTIOMETER_NOTIFY_DELTA, 2));
+  ESP3D_CHECK_EQ(notify_calls, 2);
+  // Delta is from last notified value, not from last value
+  ESP3D_CHECK(!convert(1000 + PHY_POTENTIOMETER_NOTIFY_DELTA * 2 - 1, 2));
+  ESP3D_CHECK(convert(1000, 2));
+  ESP3D_CHECK_EQ(notify_calls, 3);
+  phy_potentiometer_stats_t stats;
+  ESP3D_CHECK_EQ(phy_potentiometer_get_stats(&stats), ESP_OK);
+  ESP3D_CHECK_EQ(stats.notifications, 3);
+  // Woken task is reported to the interrupt
+  notify_result = false;
+  ESP3D_CHECK(!convert(2000, 2));
+  ESP3D_CHECK_EQ(notify_calls, 4);
+  ESP3D_CHECK_EQ(phy_potentiometer_set_notify(NULL, NULL), ESP_OK);
+  ESP3D_CHECK(!convert(3000, 2));
+  ESP3D_CHECK_EQ(notify_calls, 4);
+}
+
+static void test_oneshot(void) {
+  phy_potentiometer_config_t config = make_config(false);
+  configure(&config);
+  // No interrupt, the task polls
+  ESP3D_CHECK_EQ(phy_potentiometer_set_notify(notify, &notify_calls),
+                 ESP_ERR_NOT_SUPPORTED);
+  esp3d_stub_adc_raw = 2500;
+  ESP3D_CHECK_EQ(read_value(), 2500);
+  phy_potentiometer_stats_t stats;
+  ESP3D_CHECK_EQ(phy_potentiometer_get_stats(&stats), ESP_OK);
+  ESP3D_CHECK_EQ(stats.values, 1);
+  ESP3D_CHECK_EQ(stats.samples, config.filter_samples);
+  ESP3D_CHECK_EQ(stats.notifications, 0);
+}
+
+int main(void) {
+  esp3d_stub_reset();
+  ESP3D_RUN(test_invalid_config);
+  ESP3D_RUN(test_frame_average);
+  ESP3D_RUN(test_median);
+  ESP3D_RUN(test_iir);
+  ESP3D_RUN(test_calibration);
+  ESP3D_RUN(test_notify);
+  ESP3D_RUN(test_oneshot);
+  return ESP3D_TEST_RESULT();
+}
@@ -0,0 +1,205 @@
+/*
+  test_status_report
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Host test of grblHAL real time status reports parsing, and of values
+// published to the display when they change
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp3d_gcode_parser_service.h"
+#include "esp3d_machine_state.h"
+#include "esp3d_test.h"
+#include "esp3d_values.h"
+
+#define MM(value) ((int32_t)((value) * ESP3D_MACHINE_STATE_SCALE))
+
+static void test_full_report() {
+  ESP3DMachineState state;
+  esp3d_machine_state::init(&state);
+  ESP3D_CHECK(esp3d_machine_state::parseReport(
+      "<Idle|MPos:1.000,-2.500,3.125|Bf:15,128|FS:500,12000|Ov:100,50,120|"
+      "Pn:XZP|A:SF|Ln:42>",
+      &state));
+  ESP3D_CHECK(state.status == ESP3DMachineStatus::idle);
+  ESP3D_CHECK_EQ(state.axes, 3);
+  ESP3D_CHECK_EQ(state.decimals, 3);
+  ESP3D_CHECK_EQ(state.mpos[0], MM(1));
+  ESP3D_CHECK_EQ(state.mpos[1], MM(-2.5));
+  ESP3D_CHECK_EQ(state.mpos[2], MM(3.125));
+  ESP3D_CHECK_EQ(state.bf_blocks, 15);
+  ESP3D_CHECK_EQ(state.bf_bytes, 128);
+  ESP3D_CHECK_EQ(state.feed, MM(500));
+  ESP3D_CHECK_EQ(state.speed, MM(12000));
+  ESP3D_CHECK_EQ(state.ov_feed, 100);
+  ESP3D_CHECK_EQ(state.ov_rapid, 50);
+  ESP3D_CHECK_EQ(state.ov_spindle, 120);
+  ESP3D_CHECK_EQ(state.pins, (1 << 0) | (1 << 2) | (1 << 6));
+  ESP3D_CHECK_EQ(state.accessories, (1 << 0) | (1 << 2));
+  ESP3D_CHECK_EQ(state.line, 42);
+  ESP3D_CHECK_EQ(state.fields,
+                 ESP3D_MACHINE_FIELD_MPOS | ESP3D_MACHINE_FIELD_BF |
+                     ESP3D_MACHINE_FIELD_FEED | ESP3D_MACHINE_FIELD_SPEED |
+                     ESP3D_MACHINE_FIELD_OV | ESP3D_MACHINE_FIELD_PINS |
+                     ESP3D_MACHINE_FIELD_ACCESSORIES |
+                     ESP3D_MACHINE_FIELD_LINE);
+}
+
+// Work positions are stored as machine positions, with the cached WCO
+static void test_work_positions() {
+  ESP3DMachineState state;
+  esp3d_machine_state::init(&state);
+  ESP3D_CHECK(esp3d_machine_state::parseReport(
+      "<Run|WPos:1.000,2.000,3.000|WCO:10.000,0.000,-5.000>", &state));
+  ESP3D_CHECK(state.status == ESP3DMachineStatus::run);
+  ESP3D_CHECK_EQ(state.mpos[0], MM(11));
+  ESP3D_CHECK_EQ(state.mpos[2], MM(-2));
+  ESP3D_CHECK_EQ(esp3d_machine_state::getWorkPosition(&state, 0), MM(1));
+  // WCO is only sent every few reports
+  ESP3D_CHECK(esp3d_machine_state::parseReport("<Run|WPos:4.000,2.000,3.000>",
+                                               &state));
+  ESP3D_CHECK_EQ(state.mpos[0], MM(14));
+  ESP3D_CHECK_EQ(state.wco[2], MM(-5));
+  ESP3D_CHECK_EQ(esp3d_machine_state::getWorkPosition(&state, 6), 0);
+}
+
+// Sub state, inches with 4 decimals, and omitted Pn: and A:
+static void test_sub_state_and_omitted_fields() {
+  ESP3DMachineState state;
+  esp3d_machine_state::init(&state);
+  ESP3D_CHECK(esp3d_machine_state::parseReport(
+      "<Hold:1|MPos:0.1000,0.0000,-0.0500|Pn:Y|Ov:100,100,100|A:M>", &state));
+  ESP3D_CHECK(state.status == ESP3DMachineStatus::hold);
+  ESP3D_CHECK_EQ(state.sub_state, 1);
+  ESP3D_CHECK_EQ(state.decimals, 4);
+  ESP3D_CHECK_EQ(state.mpos[0], MM(0.1));
+  ESP3D_CHECK(state.pins != 0);
+  ESP3D_CHECK(state.accessories != 0);
+  // no Pn: means no pin, A: is only omitted with Ov: when all are off
+  ESP3D_CHECK(esp3d_machine_state::parseReport("<Hold:0|FS:0,0|A:M>", &state));
+  ESP3D_CHECK_EQ(state.pins, 0);
+  ESP3D_CHECK(state.accessories != 0);
+  ESP3D_CHECK(esp3d_machine_state::parseReport("<Idle|Ov:100,100,100>", &state));
+  ESP3D_CHECK_EQ(state.accessories, 0);
+  ESP3D_CHECK(state.status == ESP3DMachineStatus::idle);
+  ESP3D_CHECK_EQ(state.sub_state, 0);
+  ESP3D_CHECK(esp3d_machine_state::parseReport("<Bogus|F:100>", &state));
+  ESP3D_CHECK(state.status == ESP3DMachineStatus::unknown);
+}
+
+// An incomplete report changes nothing
+static void test_incomplete_report() {
+  ESP3DMachineState state;
+  esp3d_machine_state::init(&state);
+  ESP3D_CHECK(esp3d_machine_state::parseReport("<Idle|MPos:1.000,2.000,3.000>",
+                                               &state));
+  ESP3DMachineState before = state;
+  ESP3D_CHECK(!esp3d_machine_state::parseReport("<Run|MPos:9.000,9.0", &state));
+  ESP3D_CHECK(!esp3d_machine_state::parseReport("Idle|MPos:9.000>", &state));
+  ESP3D_CHECK(!esp3d_machine_state::parseReport(nullptr, &state));
+  ESP3D_CHECK(memcmp(&before, &state, sizeof(state)) == 0);
+}
+
+static void test_format_value() {
+  char buffer[24];
+  ESP3D_CHECK_STR(esp3d_machine_state::formatValue(MM(12.5), 3, buffer,
+                                                   sizeof(buffer)),
+                  "12.500");
+  ESP3D_CHECK_STR(esp3d_machine_state::formatValue(MM(-0.0001), 3, buffer,
+                                                   sizeof(buffer)),
+                  "0.000");
+  ESP3D_CHECK_STR(esp3d_machine_state::formatValue(MM(-1.2345), 4, buffer,
+                                                   sizeof(buffer)),
+                  "-1.2345");
+  ESP3D_CHECK_STR(esp3d_machine_state::formatValue(MM(1500), 0, buffer,
+                                                   sizeof(buffer)),
+                  "1500");
+  ESP3D_CHECK_STR(esp3d_machine_state::getStatusString(ESP3DMachineStatus::jog),
+                  "Jog");
+  ESP3D_CHECK_STR(
+      esp3d_machine_state::getStatusString(ESP3DMachineStatus::unknown), "?");
+}
+
+// Parser publishes all values once, then only the ones which changed
+static void test_published_values() {
+  ESP3DGCodeParserService parser;
+  esp3dTftValues.clear();
+  ESP3D_CHECK(parser.processCommand(
+      "<Hold:0|MPos:1.000,2.000,3.000|FS:0,0|Ov:100,100,100>\n"));
+  ESP3D_CHECK_STR(esp3dTftValues.get_string_value(ESP3DValuesIndex::state),
+                  "Hold:0");
+  ESP3D_CHECK_STR(
+      esp3dTftValues.get_string_value(ESP3DValuesIndex::m_position_y),
+      "2.000");
+  ESP3D_CHECK(esp3dTftValues.updates() > 0);
+
+  esp3dTftValues.clear();
+  ESP3D_CHECK(parser.processCommand(
+      "<Hold:0|MPos:1.000,2.000,3.000|FS:0,0|Ov:100,100,100>\n"));
+  ESP3D_CHECK_EQ(esp3dTftValues.updates(), 0);
+
+  ESP3D_CHECK(parser.processCommand(
+      "<Hold:0|MPos:1.000,2.500,3.000|FS:0,0|Ov:100,100,100>\n"));
+  // machine and work Y
+  ESP3D_CHECK_EQ(esp3dTftValues.updates(), 2);
+  ESP3D_CHECK_STR(
+      esp3dTftValues.get_string_value(ESP3DValuesIndex::w_position_y),
+      "2.500");
+
+  ESP3DMachineState snapshot;
+  parser.getMachineStateSnapshot(&snapshot);
+  ESP3D_CHECK_EQ(snapshot.mpos[1], MM(2.5));
+  ESP3D_CHECK(!parser.processCommand("ok\n"));
+}
+
+// Each report cut at every length, in a buffer of its exact size
+static void test_truncated_reports() {
+  static const char *reports[] = {
+      "<Idle|MPos:1.000,-2.500,3.125|Bf:15,128|FS:500,12000|Ov:100,50,120|"
+      "Pn:XZP|A:SF|Ln:42>",
+      "<Hold:1|WPos:0.1000,0.0000,-0.0500|WCO:1,2,3,4,5,6,7|Pn:|A:>",
+      "<Run|MPos:99999999999999.9999999,-,+,.,1|F:|Ov:1,2|Bf:,|Ln:>",
+  };
+  for (const char *report : reports) {
+    size_t length = strlen(report);
+    for (size_t cut = 0; cut <= length; cut++) {
+      char *buffer = (char *)malloc(cut + 1);
+      memcpy(buffer, report, cut);
+      buffer[cut] = '\0';
+      ESP3DMachineState state;
+      esp3d_machine_state::init(&state);
+      bool parsed = esp3d_machine_state::parseReport(buffer, &state);
+      ESP3D_CHECK(parsed == (cut == length));
+      free(buffer);
+    }
+  }
+}
+
+int main() {
+  esp3d_stub_reset();
+  ESP3D_RUN(test_full_report);
+  ESP3D_RUN(test_work_positions);
+  ESP3D_RUN(test_sub_state_and_omitted_fields);
+  ESP3D_RUN(test_incomplete_report);
+  ESP3D_RUN(test_format_value);
+  ESP3D_RUN(test_published_values);
+  ESP3D_RUN(test_truncated_reports);
+  return ESP3D_TEST_RESULT();
+}
@@ -0,0 +1,181 @@
+/*
+  test_touch
+
+  Copyright (c) 2022 Luc Lebosse. All rights reserved.
+
+  This code is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Host test of the touch controller reads, polled and woken by interrupt,
+// with spurious interrupts told by the INT level
+
+#include "esp3d_test.h"
+
+// Interrupt handler is reached by building the driver here
+#include "touch_ft6336u.c"
+
+#define TEST_INT_PIN GPIO_NUM_36
+
+static int notify_calls;
+
+static bool notify(void *arg) {
+  ESP3D_CHECK(arg == &notify_calls);
+  notify_calls++;
+  return false;
+}
+
+// Driver keeps the last touch across configurations, tests start released
+static void configure(int8_t int_pin) {
+  touch_ft6336u_deinit();
+  esp3d_stub_reset();
+  _touch_data.is_pressed = false;
+  notify_calls = 0;
+  touch_ft6336u_config_t config = {
+      .i2c_addr = 0x38,
+      .i2c_port = I2C_NUM_1,
+      .i2c_clk_speed = 400000,
+      .rst_pin = -1,
+      .int_pin = int_pin,
+      .sda_pin = 32,
+      .scl_pin = 25,
+      .x_max = 240,
+      .y_max = 320,
+  };
+  ESP3D_CHECK_EQ(touch_ft6336u_configure(&config), ESP_OK);
+  esp3d_stub_i2c_reads = 0;
+}
+
+// Registers of one point touched, or of no touch
+static void set_touch(bool pressed, uint16_t x, uint16_t y) {
+  memset(esp3d_stub_i2c_data, 0, sizeof(esp3d_stub_i2c_data));
+  esp3d_stub_i2c_data[FT6336U_TOUCH_POINTS] = pressed ? 1 : 0;
+  esp3d_stub_i2c_data[FT6336U_TOUCH1_XH] = 0x40 | (x >> 8);
+  esp3d_stub_i2c_data[FT6336U_TOUCH1_XL] = x & 0xFF;
+  esp3d_stub_i2c_data[FT6336U_TOUCH1_YH] = y >> 8;
+  esp3d_stub_i2c_data[FT6336U_TOUCH1_YL] = y & 0xFF;
+}
+
+static void test_polled(void) {
+  configure(-1);
+  ESP3D_CHECK_EQ(touch_ft6336u_set_notify(notify, &notify_calls),
+                 ESP_ERR_NOT_SUPPORTED);
+  // Each LVGL read is an I2C read, touched or not
+  set_touch(false, 0, 0);
+  touch_ft6336u_data_t data = touch_ft6336u_read();
+  ESP3D_CHECK(!data.is_pressed);
+  ESP3D_CHECK_EQ(data.x, -1);
+  set_touch(true, 260, 300);
+  data = touch_ft6336u_read();
+  ESP3D_CHECK(data.is_pressed);
+  ESP3D_CHECK_EQ(data.x, 260);
+  ESP3D_CHECK_EQ(data.y, 300);
+  ESP3D_CHECK_EQ(esp3d_stub_i2c_reads, 2);
+  touch_ft6336u_stats_t stats;
+  ESP3D_CHECK_EQ(touch_ft6336u_get_stats(&stats), ESP_OK);
+  ESP3D_CHECK_EQ(stats.reads, 2);
+  ESP3D_CHECK_EQ(stats.rejected, 0);
+  ESP3D_CHECK(!stats.interrupt_mode);
+}
+
+static void test_transformations(void) {
+  configure(-1);
+  _config.swap_xy = true;
+  _config.invert_x = true;
+  set_touch(true, 20, 30);
+  touch_ft6336u_data_t data = touch_ft6336u_read();
+  ESP3D_CHECK_EQ(data.x, 240 - 30);
+  ESP3D_CHECK_EQ(data.y, 20);
+}
+
+static void test_interrupt(void) {
+  configure(TEST_INT_PIN);
+  ESP3D_CHECK_EQ(touch_ft6336u_set_notify(notify, &notify_calls), ESP_OK);
+  // Idle: LVGL only copies the last touch
+  set_touch(true, 10, 20);
+  ESP3D_CHECK(!touch_ft6336u_read().is_pressed);
+  ESP3D_CHECK_EQ(esp3d_stub_i2c_reads, 0);
+  // Touch holds INT low, the woken reader reads it
+  esp3d_stub_gpio_level[TEST_INT_PIN] = 0;
+  touch_ft6336u_touch_isr_handler(NULL);
+  ESP3D_CHECK_EQ(notify_calls, 1);
+  ESP3D_CHECK_EQ(touch_ft6336u_update(), ESP_OK);
+  ESP3D_CHECK_EQ(esp3d_stub_i2c_reads, 1);
+  touch_ft6336u_data_t data = touch_ft6336u_read();
+  ESP3D_CHECK(data.is_pressed);
+  ESP3D_CHECK_EQ(data.x, 10);
+  ESP3D_CHECK_EQ(data.y, 20);
+  // Release raises INT, the touch is released without a read and is not a
+  // spurious interrupt
+  esp3d_stub_gpio_level[TEST_INT_PIN] = 1;
+  ESP3D_CHECK_EQ(touch_ft6336u_update(), ESP_OK);
+  ESP3D_CHECK(!touch_ft6336u_read().is_pressed);
+  ESP3D_CHECK_EQ(esp3d_stub_i2c_reads, 1);
+  touch_ft6336u_stats_t stats;
+  ESP3D_CHECK_EQ(touch_ft6336u_get_stats(&stats), ESP_OK);
+  ESP3D_CHECK_EQ(stats.interrupts, 1);
+  ESP3D_CHECK_EQ(stats.reads, 1);
+  ESP3D_CHECK_EQ(stats.rejected, 0);
+  ESP3D_CHECK(stats.interrupt_mode);
+}
+
+static void test_spurious_interrupts(void) {
+  configure(TEST_INT_PIN);
+  ESP3D_CHECK_EQ(touch_ft6336u_set_notify(notify, &notify_calls), ESP_OK);
+  set_touch(true, 10, 20);
+  // Edges seen on GPIO36 with INT high cost no I2C read
+  for (int i = 0; i < 5; i++) {
+    touch_ft6336u_touch_isr_handler(NULL);
+    ESP3D_CHECK_EQ(touch_ft6336u_update(), ESP_OK);
+  }
+  ESP3D_CHECK_EQ(notify_calls, 5);
+  ESP3D_CHECK_EQ(esp3d_stub_i2c_reads, 0);
+  ESP3D_CHECK(!touch_ft6336u_get_data().is_pressed);
+  touch_ft6336u_stats_t stats;
+  ESP3D_CHECK_EQ(touch_ft6336u_get_stats(&stats), ESP_OK);
+  ESP3D_CHECK_EQ(stats.interrupts, 5);
+  ESP3D_CHECK_EQ(stats.rejected, 5);
+  ESP3D_CHECK_EQ(stats.reads, 0);
+}
+
+// One idle second of LVGL reads, every 30 ms
+static uint32_t idle_transactions_per_s(void) {
+  set_touch(false, 0, 0);
+  for (int i = 0; i < 33; i++) {
+    touch_ft6336u_read();
+    esp3d_stub_time_us += 30000;
+  }
+  esp3d_stub_time_us += 10000;
+  touch_ft6336u_stats_t stats;
+  ESP3D_CHECK_EQ(touch_ft6336u_get_stats(&stats), ESP_OK);
+  return stats.transactions_per_s;
+}
+
+static void test_idle_traffic(void) {
+  // Block read is a register write then a read
+  configure(-1);
+  ESP3D_CHECK_EQ(idle_transactions_per_s(), 66);
+  configure(TEST_INT_PIN);
+  ESP3D_CHECK_EQ(touch_ft6336u_set_notify(notify, &notify_calls), ESP_OK);
+  ESP3D_CHECK_EQ(idle_transactions_per_s(), 0);
+}
+
+int main(void) {
+  ESP3D_RUN(test_polled);
+  ESP3D_RUN(test_transformations);
+  ESP3D_RUN(test_interrupt);
+  ESP3D_RUN(test_spurious_interrupts);
+  ESP3D_RUN(test_idle_traffic);
+  return ESP3D_TEST_RESULT();
+}